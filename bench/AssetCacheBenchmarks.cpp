@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <asset/AssetCache.hpp>
+#include <benchmark/benchmark.h>
+#include <core/Map.hpp>
+#include <memory>
+#include <random>
+#include <shared_mutex>
+#include <vector>
+
+namespace {
+	using apollo::EAssetType;
+
+	static constexpr uint32 g_NumAssets = 4096;
+
+	struct BenchAsset : public apollo::IAsset
+	{
+		using IAsset::IAsset;
+		GET_ASSET_TYPE_IMPL(EAssetType::Texture2D);
+	};
+
+	/// Reference implementation: this is how the asset manager's cache used to be protected
+	class LockedCache
+	{
+	public:
+		apollo::IAsset* Find(const apollo::ULID& id) const
+		{
+			std::shared_lock lock{ m_Mutex };
+			const auto it = m_Map.find(id);
+			return it == m_Map.end() ? nullptr : it->second;
+		}
+		void Insert(apollo::IAsset* asset)
+		{
+			std::unique_lock lock{ m_Mutex };
+			m_Map.try_emplace(asset->GetId(), asset);
+		}
+
+	private:
+		mutable std::shared_mutex m_Mutex;
+		apollo::ULIDMap<apollo::IAsset*> m_Map;
+	};
+
+	/// Shared by all benchmark threads, built on first use
+	template <class Cache>
+	struct Fixture
+	{
+		Fixture()
+		{
+			for (uint32 i = 0; i < g_NumAssets; ++i)
+			{
+				m_Assets.emplace_back(std::make_unique<BenchAsset>(apollo::ULID::Generate()));
+				m_Cache.Insert(m_Assets.back().get());
+			}
+		}
+
+		static Fixture& Get()
+		{
+			static Fixture s_Fixture;
+			return s_Fixture;
+		}
+
+		std::vector<std::unique_ptr<BenchAsset>> m_Assets;
+		Cache m_Cache;
+	};
+
+	/// Every thread resolves all assets in its own random order, as ECS systems would
+	template <class Cache>
+	void ConcurrentLookup(benchmark::State& state)
+	{
+		Fixture<Cache>& fixture = Fixture<Cache>::Get();
+		std::vector<apollo::ULID> ids;
+		for (const auto& asset : fixture.m_Assets)
+			ids.emplace_back(asset->GetId());
+		std::shuffle(ids.begin(), ids.end(), std::mt19937(state.thread_index()));
+
+		for (auto&& _ : state)
+		{
+			for (const apollo::ULID& id : ids)
+				benchmark::DoNotOptimize(fixture.m_Cache.Find(id));
+		}
+		state.SetItemsProcessed(state.iterations() * g_NumAssets);
+	}
+} // namespace
+
+BENCHMARK_TEMPLATE(ConcurrentLookup, LockedCache)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK_TEMPLATE(ConcurrentLookup, apollo::AssetCache)->ThreadRange(1, 32)->UseRealTime();
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include <benchmark/benchmark.h>
+#include <core/ThreadPool.hpp>
+#include <freetype/freetype.h>
+#include <msdfgen.h>
+#include <rendering/text/FontAtlas.hpp>
+#include <vector>
+
+namespace {
+	using namespace apollo;
+	using namespace apollo::rdr;
+
+	/**
+	 * \brief Rasterizes the Latin-1 glyphs of the example font
+	 * \details The range argument is the atlas resolution, in pixels per em. Glyph loading and
+	 * packing are done once, only the rasterization is measured.
+	 */
+	void AtlasGenerator_Rasterize(benchmark::State& state)
+	{
+		const uint32 resolution = uint32(state.range(0));
+		FT_Library library = nullptr;
+		FT_Face face = nullptr;
+		if (FT_Init_FreeType(&library) || FT_New_Face(library, APOLLO_BENCH_FONT, 0, &face))
+		{
+			state.SkipWithError("Failed to load " APOLLO_BENCH_FONT);
+			if (library)
+				FT_Done_FreeType(library);
+			return;
+		}
+
+		txt::AtlasGenerator generator{ face, 16 * resolution, resolution, 1.0 / resolution };
+		std::vector<txt::Glyph> glyphs;
+		std::vector<msdfgen::Shape> shapes;
+		std::vector<uint32> indices;
+		const glm::uvec2 size = generator.LoadGlyphRange({}, glyphs, shapes, indices);
+		std::vector<RGBAPixel<uint8>> pixels(size.x * size.y);
+
+		const BitmapView<RGBAPixel<uint8>> bitmap{ pixels.data(), size.x, size.y };
+
+		mt::ThreadPool threadPool;
+		for (auto&& _ : state)
+		{
+			generator.Rasterize(10.0, glyphs, shapes, bitmap, threadPool);
+			benchmark::DoNotOptimize(pixels.data());
+		}
+		state.SetItemsProcessed(state.iterations() * glyphs.size());
+		state.counters["Pixels"] = double(size.x) * size.y;
+
+		FT_Done_Face(face);
+		FT_Done_FreeType(library);
+	}
+} // namespace
+
+BENCHMARK(AtlasGenerator_Rasterize)
+	->Arg(32)
+	->Arg(64)
+	->Arg(128)
+	->Unit(benchmark::kMillisecond)
+	->UseRealTime();
\ No newline at end of file
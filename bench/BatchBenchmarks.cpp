@@ -0,0 +1,70 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <rendering/Batch.hpp>
+#include <rendering/text/BatchRenderer.hpp>
+#include <vector>
+
+namespace {
+	using namespace apollo::rdr;
+
+	static constexpr uint32 g_NumElements = 20'000;
+
+	/// Same size and alignment as a text glyph quad
+	struct Quad
+	{
+		alignas(alignof(txt::Renderer2d::GlyphQuad)) float m_Data[20];
+
+		[[nodiscard]] bool operator==(const Quad&) const noexcept = default;
+	};
+	static_assert(sizeof(Quad) == sizeof(txt::Renderer2d::GlyphQuad));
+
+	/**
+	 * \brief Re-records a batch every iteration, changing a fraction of its elements, and reports
+	 * how many bytes would be uploaded
+	 * \details The range argument is the number of changed elements, per 1000 elements.
+	 */
+	void Batch_PartialUpload(benchmark::State& state)
+	{
+		const uint32 numChanged = uint32(state.range(0) * g_NumElements / 1000);
+		std::mt19937 rng{ 42 };
+		std::vector<uint32> indices(g_NumElements);
+		for (uint32 i = 0; i < g_NumElements; ++i)
+			indices[i] = i;
+		std::shuffle(indices.begin(), indices.end(), rng);
+		std::vector<bool> changed(g_NumElements);
+		for (uint32 i = 0; i < numChanged; ++i)
+			changed[indices[i]] = true;
+
+		Batch<Quad> batch;
+		for (uint32 i = 0; i < g_NumElements; ++i)
+			batch.Add(Quad{ float(i) });
+
+		uint64 uploaded = 0;
+		uint64 numRanges = 0;
+		float frame = 0;
+		for (auto&& _ : state)
+		{
+			++frame;
+			batch.Clear();
+			batch.StartRecording();
+			for (uint32 i = 0; i < g_NumElements; ++i)
+				batch.Add(Quad{ float(i), changed[i] ? frame : 0.0f });
+
+			for (const Batch<Quad>::DirtyRange& range : batch.GetDirtyRanges())
+				uploaded += range.m_Count * sizeof(Quad);
+			numRanges += batch.GetDirtyRanges().size();
+			benchmark::DoNotOptimize(batch.GetDirtyRanges().data());
+		}
+		state.SetItemsProcessed(state.iterations() * g_NumElements);
+		state.counters["FullBytes"] = g_NumElements * sizeof(Quad);
+		state.counters["UploadedBytes"] = benchmark::Counter(
+			double(uploaded),
+			benchmark::Counter::kAvgIterations);
+		state.counters["Uploads"] = benchmark::Counter(
+			double(numRanges),
+			benchmark::Counter::kAvgIterations);
+	}
+} // namespace
+
+BENCHMARK(Batch_PartialUpload)->Arg(0)->Arg(1)->Arg(10)->Arg(100)->Arg(500)->Arg(1000);
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+#include <core/Json.hpp>
+#include <core/JsonStream.hpp>
+#include <core/ULID.hpp>
+#include <string>
+#include <vector>
+
+namespace {
+	struct BenchTransform
+	{
+		float3 m_Position = {};
+		glm::quat m_Rotation = {};
+		float3 m_Scale = { 1, 1, 1 };
+
+		static constexpr apollo::json::FieldList<
+			&BenchTransform::m_Position,
+			&BenchTransform::m_Rotation,
+			&BenchTransform::m_Scale>
+			JsonFields{ {
+				{ "position" },
+				{ "rotation" },
+				{ "scale" },
+			} };
+	};
+
+	/// Generates a scene file with \p numObjects game objects, each with a transform component
+	std::string MakeScene(int64 numObjects)
+	{
+		nlohmann::json objects = nlohmann::json::array();
+		for (int64 i = 0; i < numObjects; ++i)
+		{
+			const BenchTransform transform{
+				.m_Position = { float(i), float(i % 17), -float(i % 5) },
+				.m_Rotation = { 1, 0, 0, 0 },
+				.m_Scale = { 1, 2, 1 },
+			};
+			nlohmann::json& object = objects.emplace_back();
+			apollo::ULID::Generate().ToJson(object["id"]);
+			object["name"] = "object " + std::to_string(i);
+			nlohmann::json& comp = object["components"]["transform"];
+			apollo::json::Converter<float3>::ToJson(transform.m_Position, comp["position"]);
+			apollo::json::Converter<glm::quat>::ToJson(transform.m_Rotation, comp["rotation"]);
+			apollo::json::Converter<float3>::ToJson(transform.m_Scale, comp["scale"]);
+		}
+		nlohmann::json scene;
+		scene["gameObjects"] = std::move(objects);
+		return scene.dump();
+	}
+
+	bool LoadObject(const nlohmann::json& object, BenchTransform& out_transform)
+	{
+		const auto compIt = object.find("components");
+		if (compIt == object.end())
+			return false;
+		return apollo::json::Visit(out_transform, *compIt, "transform");
+	}
+
+	/// Reference implementation: the whole document is parsed before any object gets loaded
+	void ParseDom(benchmark::State& state)
+	{
+		const std::string scene = MakeScene(state.range(0));
+		std::vector<BenchTransform> transforms;
+		for (auto&& _ : state)
+		{
+			transforms.clear();
+			const nlohmann::json json = nlohmann::json::parse(scene);
+			for (const nlohmann::json& object : json["gameObjects"])
+			{
+				if (LoadObject(object, transforms.emplace_back()))
+					continue;
+				transforms.pop_back();
+			}
+			benchmark::DoNotOptimize(transforms.data());
+		}
+		state.SetBytesProcessed(state.iterations() * int64(scene.size()));
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	/// Objects are loaded as they get parsed, only one of them is in memory at a time
+	void ParseStream(benchmark::State& state)
+	{
+		const std::string scene = MakeScene(state.range(0));
+		std::vector<BenchTransform> transforms;
+		for (auto&& _ : state)
+		{
+			transforms.clear();
+			apollo::json::StreamParser parser;
+			parser.StreamArray(
+				"gameObjects",
+				[&transforms](const nlohmann::json& object)
+				{
+					if (!LoadObject(object, transforms.emplace_back()))
+						transforms.pop_back();
+					return true;
+				});
+			benchmark::DoNotOptimize(parser.Parse(scene));
+			benchmark::DoNotOptimize(transforms.data());
+		}
+		state.SetBytesProcessed(state.iterations() * int64(scene.size()));
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+} // namespace
+
+BENCHMARK(ParseDom)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(ParseStream)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
\ No newline at end of file
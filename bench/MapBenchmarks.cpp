@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <core/Map.hpp>
+#include <core/ULID.hpp>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+	/// Reference implementation: this is what HashMap used to alias
+	template <class T>
+	using StdULIDMap = std::unordered_map<apollo::ULID, T, apollo::Hash<apollo::ULID>>;
+
+	std::vector<apollo::ULID> MakeKeys(size_t n)
+	{
+		std::vector<apollo::ULID> keys(n);
+		for (apollo::ULID& id : keys)
+			id = apollo::ULID::Generate();
+		return keys;
+	}
+
+	template <class Map>
+	Map MakeMap(const std::vector<apollo::ULID>& keys)
+	{
+		Map map;
+		for (size_t i = 0; i < keys.size(); ++i)
+			map.try_emplace(keys[i], uint64(i));
+		return map;
+	}
+
+	template <class Map>
+	void Insert(benchmark::State& state)
+	{
+		const std::vector<apollo::ULID> keys = MakeKeys(state.range(0));
+		for (auto&& _ : state)
+		{
+			Map map;
+			for (size_t i = 0; i < keys.size(); ++i)
+				map.try_emplace(keys[i], uint64(i));
+			benchmark::DoNotOptimize(map);
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	/// Lookups of existing keys, in a different order than the insertion one
+	template <class Map>
+	void LookupHit(benchmark::State& state)
+	{
+		std::vector<apollo::ULID> keys = MakeKeys(state.range(0));
+		const Map map = MakeMap<Map>(keys);
+		std::shuffle(keys.begin(), keys.end(), std::mt19937{ 42 });
+		for (auto&& _ : state)
+		{
+			for (const apollo::ULID& id : keys)
+				benchmark::DoNotOptimize(map.find(id));
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	template <class Map>
+	void LookupMiss(benchmark::State& state)
+	{
+		const Map map = MakeMap<Map>(MakeKeys(state.range(0)));
+		const std::vector<apollo::ULID> missing = MakeKeys(state.range(0));
+		for (auto&& _ : state)
+		{
+			for (const apollo::ULID& id : missing)
+				benchmark::DoNotOptimize(map.find(id));
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	/// Erases every key, then puts them back outside of the timed region
+	template <class Map>
+	void Erase(benchmark::State& state)
+	{
+		const std::vector<apollo::ULID> keys = MakeKeys(state.range(0));
+		Map map = MakeMap<Map>(keys);
+		for (auto&& _ : state)
+		{
+			for (const apollo::ULID& id : keys)
+				benchmark::DoNotOptimize(map.erase(id));
+
+			state.PauseTiming();
+			for (size_t i = 0; i < keys.size(); ++i)
+				map.try_emplace(keys[i], uint64(i));
+			state.ResumeTiming();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+} // namespace
+
+#define MAP_BENCHMARK(func)                                                                        \
+	BENCHMARK_TEMPLATE(func, StdULIDMap<uint64>)->Arg(1000)->Arg(100000)->Arg(1000000);            \
+	BENCHMARK_TEMPLATE(func, apollo::ULIDMap<uint64>)->Arg(1000)->Arg(100000)->Arg(1000000)
+
+MAP_BENCHMARK(Insert);
+MAP_BENCHMARK(LookupHit);
+MAP_BENCHMARK(LookupMiss);
+MAP_BENCHMARK(Erase);
\ No newline at end of file
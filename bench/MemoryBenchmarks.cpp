@@ -1,5 +1,10 @@
+#include <atomic>
 #include <benchmark/benchmark.h>
+#include <core/Bit.hpp>
 #include <core/Memory.hpp>
+#include <list>
+#include <memory_resource>
+#include <vector>
 
 namespace {
 	static constexpr int32 g_ElemCount = 1000;
@@ -108,6 +113,146 @@ namespace {
 			}
 		}
 	}
+
+	static constexpr uint32 g_ConcurrentBlockSize = 64;
+	static constexpr uint32 g_BatchSize = 64;
+
+	struct NewDeleteResource
+	{
+		static std::pmr::memory_resource* Get() { return std::pmr::new_delete_resource(); }
+	};
+	struct SynchronizedPoolResource
+	{
+		static std::pmr::memory_resource* Get()
+		{
+			static std::pmr::synchronized_pool_resource s_Resource;
+			return &s_Resource;
+		}
+	};
+	struct ConcurrentPoolResource
+	{
+		static std::pmr::memory_resource* Get()
+		{
+			static apollo::ConcurrentMemoryPool s_Resource{ g_ConcurrentBlockSize };
+			return &s_Resource;
+		}
+	};
+
+	/// Every thread allocates then frees batches of blocks
+	template <class Resource>
+	void Concurrent_LocalFree(benchmark::State& state)
+	{
+		std::pmr::memory_resource* const resource = Resource::Get();
+		void* blocks[g_BatchSize];
+		for (auto&& _ : state)
+		{
+			for (void*& block : blocks)
+				block = resource->allocate(g_ConcurrentBlockSize);
+			for (void* block : blocks)
+				resource->deallocate(block, g_ConcurrentBlockSize);
+		}
+		state.SetItemsProcessed(state.iterations() * g_BatchSize);
+	}
+
+	/// Allocated blocks are linked together, and handed over to whichever thread comes next:
+	/// most of them get freed by a thread other than the one which allocated them
+	template <class Resource>
+	void Concurrent_RemoteFree(benchmark::State& state)
+	{
+		struct Block
+		{
+			Block* m_Next;
+		};
+		static std::atomic<Block*> s_Mailbox = nullptr;
+
+		std::pmr::memory_resource* const resource = Resource::Get();
+		const auto release = [resource](Block* block)
+		{
+			while (block)
+			{
+				Block* const next = block->m_Next;
+				resource->deallocate(block, g_ConcurrentBlockSize);
+				block = next;
+			}
+		};
+
+		for (auto&& _ : state)
+		{
+			Block* batch = nullptr;
+			for (uint32 i = 0; i < g_BatchSize; ++i)
+				batch = new (resource->allocate(g_ConcurrentBlockSize)) Block{ batch };
+			release(s_Mailbox.exchange(batch, std::memory_order_acq_rel));
+		}
+		// all threads are done iterating at this point
+		release(s_Mailbox.exchange(nullptr, std::memory_order_acq_rel));
+		state.SetItemsProcessed(state.iterations() * g_BatchSize);
+	}
+
+	/// Reference implementation: this is how MemoryPool used to look for free blocks, one bit at a
+	/// time
+	size_t FindZeroRun_BitByBit(const uint64* words, size_t begin, size_t end, size_t n)
+	{
+		const apollo::BitIterator last{ words + end / 64, end % 64 };
+		size_t runLength = 0;
+		size_t offset = begin;
+		for (apollo::BitIterator it{ words + begin / 64, begin % 64 }; it != last; ++it)
+		{
+			++runLength;
+			if (*it)
+			{
+				offset += runLength;
+				runLength = 0;
+			}
+			else if (runLength == n)
+				return offset;
+		}
+		return end;
+	}
+
+	/// Worst case for the search: every other bit is set, and the only run long enough is at the
+	/// very end
+	std::vector<uint64> MakeCheckerboard(size_t numBits)
+	{
+		std::vector<uint64> words(numBits / 64, 0x5555555555555555);
+		apollo::ClearBits(words.data(), numBits - 2, 2);
+		return words;
+	}
+
+	template <size_t (*Find)(const uint64*, size_t, size_t, size_t)>
+	void Bitmap_FindRun(benchmark::State& state)
+	{
+		const size_t numBits = size_t(state.range(0));
+		const std::vector<uint64> words = MakeCheckerboard(numBits);
+		for (auto&& _ : state)
+			benchmark::DoNotOptimize(Find(words.data(), 0, numBits, 2));
+		state.SetItemsProcessed(state.iterations() * numBits);
+	}
+
+	/// Allocates then frees 2 blocks from a single, badly fragmented chunk
+	void Fragmentation_Worst(benchmark::State& state, bool nearlyFull)
+	{
+		const uint32 numBlocks = uint32(state.range(0));
+		apollo::MemoryPool pool{ 8, numBlocks };
+		std::vector<void*> blocks;
+		for (uint32 i = 0; i < numBlocks; ++i)
+			blocks.emplace_back(pool.AllocateBlocks(1));
+
+		if (nearlyFull)
+			pool.DeallocateBlocks(blocks[0], 1);
+		else
+		{
+			for (uint32 i = 0; i < numBlocks - 2; i += 2)
+				pool.DeallocateBlocks(blocks[i], 1);
+		}
+		pool.DeallocateBlocks(blocks[numBlocks - 2], 2);
+
+		for (auto&& _ : state)
+		{
+			void* const ptr = pool.AllocateBlocks(2);
+			benchmark::DoNotOptimize(ptr);
+			pool.DeallocateBlocks(ptr, 2);
+		}
+	}
 } // namespace
 
 BENCHMARK_CAPTURE(Vector_New, "NoReserve", 100);
@@ -132,4 +277,25 @@ BENCHMARK_CAPTURE(
 	Fragmentation_Pool,
 	"Fragmented Pool",
 	g_ElemCount,
-	apollo::MemoryPool{ 24, g_ElemCount });
\ No newline at end of file
+	apollo::MemoryPool{ 24, g_ElemCount });
+
+BENCHMARK_TEMPLATE(Bitmap_FindRun, FindZeroRun_BitByBit)->Arg(4096)->Arg(65536);
+BENCHMARK_TEMPLATE(Bitmap_FindRun, apollo::FindZeroRun)->Arg(4096)->Arg(65536);
+BENCHMARK_CAPTURE(Fragmentation_Worst, "Checkerboard", false)->Arg(4096)->Arg(65536);
+BENCHMARK_CAPTURE(Fragmentation_Worst, "Nearly Full", true)->Arg(4096)->Arg(65536);
+
+BENCHMARK_TEMPLATE(Concurrent_LocalFree, NewDeleteResource)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK_TEMPLATE(Concurrent_LocalFree, SynchronizedPoolResource)
+	->ThreadRange(1, 32)
+	->UseRealTime();
+BENCHMARK_TEMPLATE(Concurrent_LocalFree, ConcurrentPoolResource)
+	->ThreadRange(1, 32)
+	->UseRealTime();
+
+BENCHMARK_TEMPLATE(Concurrent_RemoteFree, NewDeleteResource)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK_TEMPLATE(Concurrent_RemoteFree, SynchronizedPoolResource)
+	->ThreadRange(1, 32)
+	->UseRealTime();
+BENCHMARK_TEMPLATE(Concurrent_RemoteFree, ConcurrentPoolResource)
+	->ThreadRange(1, 32)
+	->UseRealTime();
\ No newline at end of file
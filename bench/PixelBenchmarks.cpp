@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include <rendering/Pixel.hpp>
+#include <vector>
+
+namespace {
+	using namespace apollo;
+	using namespace apollo::rdr;
+
+	static constexpr uint32 g_NumPixels = 1 << 20;
+
+	std::vector<RGBAPixel<float>> GeneratePixels()
+	{
+		std::mt19937 rng{ 42 };
+		std::uniform_real_distribution<float> dist{ -0.1f, 1.1f };
+		std::vector<RGBAPixel<float>> pixels(g_NumPixels);
+		for (RGBAPixel<float>& px : pixels)
+			px = { dist(rng), dist(rng), dist(rng), dist(rng) };
+		return pixels;
+	}
+
+	/// Reference implementation: the per-channel conversion the atlas generator used to do
+	void Pixel_ConvertScalar(benchmark::State& state)
+	{
+		const std::vector<RGBAPixel<float>> in = GeneratePixels();
+		std::vector<RGBAPixel<uint8>> out(g_NumPixels);
+		for (auto&& _ : state)
+		{
+			for (uint32 i = 0; i < g_NumPixels; ++i)
+			{
+				out[i] = RGBAPixel<uint8>{
+					uint8(255 * Clamp(in[i].r, 0.0f, 1.0f) + 0.5),
+					uint8(255 * Clamp(in[i].g, 0.0f, 1.0f) + 0.5),
+					uint8(255 * Clamp(in[i].b, 0.0f, 1.0f) + 0.5),
+					uint8(255 * Clamp(in[i].a, 0.0f, 1.0f) + 0.5),
+				};
+			}
+			benchmark::DoNotOptimize(out.data());
+		}
+		state.SetItemsProcessed(state.iterations() * g_NumPixels);
+	}
+
+	void Pixel_ConvertToRGBA8(benchmark::State& state)
+	{
+		const std::vector<RGBAPixel<float>> in = GeneratePixels();
+		std::vector<RGBAPixel<uint8>> out(g_NumPixels);
+		for (auto&& _ : state)
+		{
+			ConvertToRGBA8(in, out.data());
+			benchmark::DoNotOptimize(out.data());
+		}
+		state.SetItemsProcessed(state.iterations() * g_NumPixels);
+	}
+} // namespace
+
+BENCHMARK(Pixel_ConvertScalar);
+BENCHMARK(Pixel_ConvertToRGBA8);
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include <benchmark/benchmark.h>
+#include <freetype/freetype.h>
+#include <map>
+#include <msdfgen.h>
+#include <rendering/RectPacker.hpp>
+#include <rendering/text/FontAtlas.hpp>
+#include <vector>
+
+namespace {
+	using namespace apollo;
+	using namespace apollo::rdr;
+
+	static constexpr const char* g_Fonts[] = {
+		APOLLO_BENCH_FONT_DIR "/ARIAL.TTF",
+		APOLLO_BENCH_FONT_DIR "/Empire.OTF",
+	};
+
+	/**
+	 * \brief Loads the bitmap sizes of the glyphs from U+0020 to U+04FF (Latin, Greek and
+	 * Cyrillic), at the given resolution. Results are cached across benchmarks.
+	 */
+	const std::vector<RectU32>* LoadGlyphRects(uint32 font, uint32 resolution)
+	{
+		static std::map<std::pair<uint32, uint32>, std::vector<RectU32>> s_Cache;
+		if (const auto it = s_Cache.find({ font, resolution }); it != s_Cache.end())
+			return &it->second;
+
+		FT_Library library = nullptr;
+		FT_Face face = nullptr;
+		if (FT_Init_FreeType(&library) || FT_New_Face(library, g_Fonts[font], 0, &face))
+		{
+			if (library)
+				FT_Done_FreeType(library);
+			return nullptr;
+		}
+
+		txt::AtlasGenerator generator{ face, 16 * resolution, resolution, 1.0 / resolution };
+		std::vector<txt::Glyph> glyphs;
+		std::vector<msdfgen::Shape> shapes;
+		std::vector<uint32> indices;
+		generator.LoadGlyphRange({ U' ', 0x4FF }, glyphs, shapes, indices);
+
+		std::vector<RectU32>& rects = s_Cache[{ font, resolution }];
+		for (const txt::Glyph& glyph : glyphs)
+			rects.push_back({ 0, 0, glyph.m_Uv.GetWidth(), glyph.m_Uv.GetHeight() });
+
+		FT_Done_Face(face);
+		FT_Done_FreeType(library);
+		return &rects;
+	}
+
+	/**
+	 * \brief Packs the glyphs of a font
+	 * \details Arguments: font index, resolution in pixels per em, EPackingStrategy,
+	 * EPackingOrder. The strip is 16 em wide, like the atlases generated by the engine. Reports the
+	 * packing efficiency (glyph area over atlas area) and the atlas size.
+	 */
+	void RectPacker_PackGlyphs(benchmark::State& state)
+	{
+		const uint32 font = uint32(state.range(0));
+		const uint32 resolution = uint32(state.range(1));
+		const std::vector<RectU32>* glyphRects = LoadGlyphRects(font, resolution);
+		if (!glyphRects)
+		{
+			state.SkipWithError("Failed to load font");
+			return;
+		}
+
+		RectPacker packer{
+			16 * resolution,
+			EPackingStrategy(state.range(2)),
+			EPackingOrder(state.range(3)),
+		};
+		std::vector<RectU32> rects;
+		glm::uvec2 size{ 0, 0 };
+		for (auto&& _ : state)
+		{
+			rects = *glyphRects;
+			size = packer.Pack(rects);
+			benchmark::DoNotOptimize(rects.data());
+		}
+		state.SetItemsProcessed(state.iterations() * rects.size());
+		state.counters["Efficiency"] = RectPacker::ComputeEfficiency(rects, size);
+		state.counters["Height"] = size.y;
+		state.counters["Pixels"] = double(size.x) * size.y;
+	}
+} // namespace
+
+BENCHMARK(RectPacker_PackGlyphs)
+	->ArgNames({ "font", "res", "strategy", "order" })
+	->ArgsProduct({
+		{ 0, 1 },
+		{ 32, 64, 128 },
+		{
+			int64(apollo::rdr::EPackingStrategy::Shelf),
+			int64(apollo::rdr::EPackingStrategy::Skyline),
+			int64(apollo::rdr::EPackingStrategy::MaxRects),
+		},
+		{
+			int64(apollo::rdr::EPackingOrder::None),
+			int64(apollo::rdr::EPackingOrder::Height),
+			int64(apollo::rdr::EPackingOrder::Area),
+			int64(apollo::rdr::EPackingOrder::MaxSide),
+		},
+	})
+	->Unit(benchmark::kMicrosecond);
\ No newline at end of file
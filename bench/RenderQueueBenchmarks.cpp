@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <rendering/Buffer.hpp>
+#include <rendering/RenderQueue.hpp>
+#include <vector>
+
+namespace {
+	using namespace apollo::rdr;
+
+	static constexpr uint32 g_NumPackets = 1'000'000;
+	static constexpr uint32 g_NumMaterials = 64;
+	static constexpr uint32 g_NumInstancesPerMaterial = 16;
+	static constexpr uint32 g_NumMeshes = 256;
+
+	/// Counts commands instead of recording them, so only the queue's own work is measured
+	struct CountingSink
+	{
+		void BindMaterialInstance(const MaterialInstance&) { ++m_Count; }
+		void BindVertexBuffer(const Buffer&) { ++m_Count; }
+		void BindIndexBuffer(const Buffer&) { ++m_Count; }
+		void BindVertexStorageBuffer(const Buffer&) { ++m_Count; }
+		void PushVertexShaderConstants(const void*, size_t, uint32) { ++m_Count; }
+		void DrawPrimitives(const DrawCall&) { ++m_Count; }
+		void DrawIndexedPrimitives(const IndexedDrawCall&) { ++m_Count; }
+
+		uint64 m_Count = 0;
+	};
+
+	/// Material instances are never dereferenced, and can't be created without a GPU device
+	alignas(MaterialInstance) std::byte
+		g_MaterialStorage[g_NumMaterials * g_NumInstancesPerMaterial * sizeof(MaterialInstance)];
+
+	const MaterialInstance* GetMaterial(uint32 material, uint32 instance)
+	{
+		const uint32 index = material * g_NumInstancesPerMaterial + instance;
+		return reinterpret_cast<const MaterialInstance*>(
+			g_MaterialStorage + index * sizeof(MaterialInstance));
+	}
+
+	std::vector<DrawPacket> GeneratePackets(std::span<const Buffer> buffers)
+	{
+		std::mt19937 rng{ 42 };
+		std::uniform_real_distribution<float> depth{ 0.0f, 1.0f };
+		std::vector<DrawPacket> packets(g_NumPackets);
+		for (DrawPacket& packet : packets)
+		{
+			const uint32 material = rng() % g_NumMaterials;
+			const uint32 instance = rng() % g_NumInstancesPerMaterial;
+			const uint32 mesh = rng() % g_NumMeshes;
+			const uint32 materialKey = MaterialInstanceKey::s_DepthWriteBit |
+									   (material << 15) | instance;
+
+			packet = DrawPacket{
+				.m_Key = RenderQueue::ComputeKey(materialKey, depth(rng)),
+				.m_Material = GetMaterial(material, instance),
+				.m_VertexBuffer = &buffers[mesh],
+				.m_IndexBuffer = &buffers[g_NumMeshes + mesh],
+				.m_NumElements = 36,
+			};
+		}
+		return packets;
+	}
+
+	void RenderQueue_StdSort(benchmark::State& state)
+	{
+		const std::vector<Buffer> buffers(2 * g_NumMeshes);
+		const std::vector<DrawPacket> packets = GeneratePackets(buffers);
+		std::vector<DrawPacket> sorted;
+		for (auto&& _ : state)
+		{
+			sorted = packets;
+			std::stable_sort(
+				sorted.begin(),
+				sorted.end(),
+				[](const DrawPacket& a, const DrawPacket& b) { return a.m_Key < b.m_Key; });
+			benchmark::DoNotOptimize(sorted.data());
+		}
+		state.SetItemsProcessed(state.iterations() * g_NumPackets);
+	}
+
+	void RenderQueue_RadixSort(benchmark::State& state)
+	{
+		const std::vector<Buffer> buffers(2 * g_NumMeshes);
+		const std::vector<DrawPacket> packets = GeneratePackets(buffers);
+		RenderQueue queue;
+		queue.Reserve(g_NumPackets);
+		for (auto&& _ : state)
+		{
+			queue.Clear();
+			for (const DrawPacket& packet : packets)
+				queue.Submit(packet);
+			queue.Sort();
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * g_NumPackets);
+	}
+
+	/// Sorts then emits the packets, deduplicating material and buffer binds
+	void RenderQueue_SortAndEmit(benchmark::State& state)
+	{
+		const std::vector<Buffer> buffers(2 * g_NumMeshes);
+		const std::vector<DrawPacket> packets = GeneratePackets(buffers);
+		RenderQueue queue;
+		queue.Reserve(g_NumPackets);
+		RenderQueue::Stats stats;
+		for (auto&& _ : state)
+		{
+			queue.Clear();
+			for (const DrawPacket& packet : packets)
+				queue.Submit(packet);
+			queue.Sort();
+			CountingSink sink;
+			stats = queue.Emit(sink);
+			benchmark::DoNotOptimize(sink.m_Count);
+		}
+		state.SetItemsProcessed(state.iterations() * g_NumPackets);
+		state.counters["MaterialBinds"] = stats.m_NumMaterialBinds;
+		state.counters["BufferBinds"] = stats.m_NumVertexBufferBinds +
+										stats.m_NumIndexBufferBinds;
+	}
+} // namespace
+
+BENCHMARK(RenderQueue_StdSort)->Unit(benchmark::kMillisecond);
+BENCHMARK(RenderQueue_RadixSort)->Unit(benchmark::kMillisecond);
+BENCHMARK(RenderQueue_SortAndEmit)->Unit(benchmark::kMillisecond);
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include <benchmark/benchmark.h>
+#include <condition_variable>
+#include <core/ThreadPool.hpp>
+#include <latch>
+
+namespace {
+	static constexpr uint32 g_TinyJobCount = 10000;
+	static constexpr uint32 g_FanOut = 64;
+
+	/// Reference implementation: this is the single mutex/condition variable pool the engine used
+	/// before mt::ThreadPool was switched to work-stealing
+	class LockingThreadPool
+	{
+	public:
+		explicit LockingThreadPool(uint32 n)
+		{
+			while (n--)
+				m_Threads.emplace_back(&LockingThreadPool::Loop, this);
+		}
+		~LockingThreadPool()
+		{
+			{
+				std::unique_lock lock{ m_Mutex };
+				m_Running = false;
+			}
+			m_Cv.notify_all();
+			for (std::thread& th : m_Threads)
+				th.join();
+		}
+
+		template <class F>
+		void Enqueue(F&& func)
+		{
+			{
+				std::unique_lock lock{ m_Mutex };
+				m_Jobs.AddEmplace(std::forward<F>(func));
+			}
+			m_Cv.notify_one();
+		}
+
+	private:
+		void Loop()
+		{
+			for (;;)
+			{
+				std::unique_lock lock{ m_Mutex };
+				while (m_Running && !m_Jobs.GetSize())
+					m_Cv.wait(lock);
+				if (!m_Running)
+					return;
+
+				apollo::UniqueFunction job = m_Jobs.PopAndGetFront();
+				lock.unlock();
+				job();
+			}
+		}
+
+		std::vector<std::thread> m_Threads;
+		std::mutex m_Mutex;
+		std::condition_variable m_Cv;
+		apollo::Queue<apollo::UniqueFunction<void()>> m_Jobs;
+		bool m_Running = true;
+	};
+
+	/// Lots of very small jobs, all submitted from the main thread
+	template <class Pool>
+	void TinyJobs(benchmark::State& state)
+	{
+		Pool pool{ uint32(state.range(0)) };
+		for (auto&& _ : state)
+		{
+			std::latch latch{ g_TinyJobCount };
+			for (uint32 i = 0; i < g_TinyJobCount; ++i)
+			{
+				pool.Enqueue(
+					[&]()
+					{
+						latch.count_down();
+					});
+			}
+			latch.wait();
+		}
+		state.SetItemsProcessed(state.iterations() * g_TinyJobCount);
+	}
+
+	/// One root job which spawns g_FanOut children, each of which spawns g_FanOut leaf jobs. All
+	/// jobs but the root one get enqueued from worker threads.
+	template <class Pool>
+	void FanOut(benchmark::State& state)
+	{
+		Pool pool{ uint32(state.range(0)) };
+		for (auto&& _ : state)
+		{
+			std::latch latch{ g_FanOut * g_FanOut };
+			pool.Enqueue(
+				[&]()
+				{
+					for (uint32 i = 0; i < g_FanOut; ++i)
+					{
+						pool.Enqueue(
+							[&]()
+							{
+								for (uint32 j = 0; j < g_FanOut; ++j)
+								{
+									pool.Enqueue(
+										[&latch, j]()
+										{
+											uint32 x = j;
+											for (uint32 k = 0; k < 256; ++k)
+												benchmark::DoNotOptimize(x = x * 1664525u + k);
+											latch.count_down();
+										});
+								}
+							});
+					}
+				});
+			latch.wait();
+		}
+		state.SetItemsProcessed(state.iterations() * g_FanOut * g_FanOut);
+	}
+} // namespace
+
+BENCHMARK_TEMPLATE(TinyJobs, LockingThreadPool)->RangeMultiplier(2)->Range(1, 32)->UseRealTime();
+BENCHMARK_TEMPLATE(TinyJobs, apollo::mt::ThreadPool)
+	->RangeMultiplier(2)
+	->Range(1, 32)
+	->UseRealTime();
+
+BENCHMARK_TEMPLATE(FanOut, LockingThreadPool)->RangeMultiplier(2)->Range(1, 32)->UseRealTime();
+BENCHMARK_TEMPLATE(FanOut, apollo::mt::ThreadPool)->RangeMultiplier(2)->Range(1, 32)->UseRealTime();
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include <benchmark/benchmark.h>
+#include <core/GameTime.hpp>
+#include <core/Transform.hpp>
+#include <core/ThreadPool.hpp>
+#include <entt/entity/registry.hpp>
+#include <random>
+#include <systems/TransformComponent.hpp>
+#include <systems/TransformSystem.hpp>
+#include <vector>
+
+namespace {
+	static constexpr uint32 g_NumNodes = 100000;
+	static constexpr uint32 g_BranchingFactor = 4;
+	/// 1% of the nodes move every frame
+	static constexpr uint32 g_NumMoving = g_NumNodes / 100;
+
+	struct SceneGraph
+	{
+		/// Builds \p numRoots trees of the same size, where each node has up to 4 children
+		explicit SceneGraph(uint32 numRoots, apollo::mt::ThreadPool* pool = nullptr)
+			: m_System(pool)
+		{
+			const uint32 treeSize = g_NumNodes / numRoots;
+			m_Entities.resize(g_NumNodes);
+			m_World.create(m_Entities.begin(), m_Entities.end());
+			for (uint32 i = 0; i < g_NumNodes; ++i)
+			{
+				apollo::TransformComponent& transform =
+					m_World.emplace<apollo::TransformComponent>(m_Entities[i]);
+				transform.m_Position = { float(i % 7), float(i % 5), float(i % 3) };
+				const uint32 indexInTree = i % treeSize;
+				if (indexInTree)
+				{
+					const uint32 parent = i - indexInTree + (indexInTree - 1) / g_BranchingFactor;
+					m_World.emplace<apollo::ParentComponent>(m_Entities[i], m_Entities[parent]);
+				}
+			}
+			// builds the hierarchy, outside of the timed region
+			Update();
+		}
+
+		void Update() { m_System.Update(m_World, m_Time); }
+
+		void Move(entt::entity entity)
+		{
+			m_World.get<apollo::TransformComponent>(entity).m_Position.x += 0.01f;
+			m_World.emplace_or_replace<apollo::TransformDirtyComponent>(entity);
+		}
+
+		/// Moves \p count random nodes
+		void MoveRandom(uint32 count)
+		{
+			std::uniform_int_distribution<uint32> dist{ 0, g_NumNodes - 1 };
+			for (uint32 i = 0; i < count; ++i)
+				Move(m_Entities[dist(m_Rng)]);
+		}
+
+		entt::registry m_World;
+		apollo::GameTime m_Time;
+		apollo::TransformSystem m_System;
+		std::vector<entt::entity> m_Entities;
+		std::mt19937 m_Rng{ 42 };
+	};
+
+	/// Reference: every transform is recomputed every frame
+	void FullUpdate(benchmark::State& state)
+	{
+		SceneGraph graph{ uint32(state.range(0)) };
+		for (auto&& _ : state)
+		{
+			for (const entt::entity entity : graph.m_Entities)
+				graph.Move(entity);
+			graph.Update();
+		}
+		state.SetItemsProcessed(state.iterations() * g_NumNodes);
+	}
+
+	void DirtyUpdate(benchmark::State& state)
+	{
+		SceneGraph graph{ uint32(state.range(0)) };
+		for (auto&& _ : state)
+		{
+			graph.MoveRandom(g_NumMoving);
+			graph.Update();
+		}
+		state.SetItemsProcessed(state.iterations() * g_NumNodes);
+	}
+
+	void DirtyUpdateParallel(benchmark::State& state)
+	{
+		apollo::mt::ThreadPool pool;
+		SceneGraph graph{ uint32(state.range(0)), &pool };
+		for (auto&& _ : state)
+		{
+			graph.MoveRandom(g_NumMoving);
+			graph.Update();
+		}
+		state.SetItemsProcessed(state.iterations() * g_NumNodes);
+	}
+
+	struct TransformArrays
+	{
+		explicit TransformArrays(size_t count)
+		{
+			std::mt19937 rng{ 42 };
+			std::uniform_real_distribution<float> dist{ -1.0f, 1.0f };
+			for (size_t i = 0; i < count; ++i)
+			{
+				m_Positions.emplace_back(dist(rng), dist(rng), dist(rng));
+				m_Scales.emplace_back(dist(rng), dist(rng), dist(rng));
+				m_Rotations.emplace_back(dist(rng), dist(rng), dist(rng), dist(rng));
+			}
+			m_Matrices.resize(count);
+		}
+
+		std::vector<float3> m_Positions, m_Scales;
+		std::vector<glm::quat> m_Rotations;
+		std::vector<glm::mat4x4> m_Matrices;
+	};
+
+	/// Reference implementation: one ComputeTransformMatrix call per transform
+	void ComputeMatricesScalar(benchmark::State& state)
+	{
+		TransformArrays arrays{ size_t(state.range(0)) };
+		for (auto&& _ : state)
+		{
+			for (size_t i = 0; i < arrays.m_Matrices.size(); ++i)
+			{
+				arrays.m_Matrices[i] = apollo::ComputeTransformMatrix(
+					arrays.m_Positions[i],
+					arrays.m_Scales[i],
+					arrays.m_Rotations[i]);
+			}
+			benchmark::DoNotOptimize(arrays.m_Matrices.data());
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	void ComputeMatricesBatch(benchmark::State& state)
+	{
+		TransformArrays arrays{ size_t(state.range(0)) };
+		for (auto&& _ : state)
+		{
+			apollo::ComputeTransformMatrices(
+				arrays.m_Positions,
+				arrays.m_Scales,
+				arrays.m_Rotations,
+				arrays.m_Matrices.data());
+			benchmark::DoNotOptimize(arrays.m_Matrices.data());
+			benchmark::ClobberMemory();
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+} // namespace
+
+// number of independent roots
+BENCHMARK(FullUpdate)->Arg(1)->Arg(100)->Arg(10000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(DirtyUpdate)->Arg(1)->Arg(100)->Arg(10000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(DirtyUpdateParallel)->Arg(1)->Arg(100)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(ComputeMatricesScalar)->RangeMultiplier(10)->Range(10000, 1000000);
+BENCHMARK(ComputeMatricesBatch)->RangeMultiplier(10)->Range(10000, 1000000);
\ No newline at end of file
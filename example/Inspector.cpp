@@ -192,7 +192,10 @@ namespace apollo::demo {
 		}
 
 		if (TransformComponent* transform = world.try_get<TransformComponent>(selection->m_Entity))
-			TransformWidget(*transform, m_Euler, selectionChanged);
+		{
+			if (TransformWidget(*transform, m_Euler, selectionChanged))
+				world.emplace_or_replace<TransformDirtyComponent>(selection->m_Entity);
+		}
 
 		if (MeshComponent* meshComp = world.try_get<MeshComponent>(selection->m_Entity);
 			meshComp && meshComp->m_Material)
@@ -23,113 +23,6 @@ namespace apollo::demo {
 			100.f);
 	}
 
-	template <class UInt, uint8 P>
-	[[nodiscard]] UInt ToFixedPoint(float x)
-	{
-		const UInt pow2 = UInt(1) << P;
-		constexpr UInt mask = pow2 - 1;
-		const float rounding = x < 0 ? -0.5f : 0.5f;
-
-		return static_cast<UInt>((x * pow2 + rounding)) & mask;
-	}
-
-	uint64 ComputeKey(const rdr::MaterialInstance& material, float distance)
-	{
-		const auto matKey = material.GetKey();
-		if (matKey.WritesToDepthBuffer())
-		{
-			return ((uint64)matKey << 24) | ToFixedPoint<uint64, 24>(distance);
-		}
-		else
-		{
-			return BIT(54) | (ToFixedPoint<uint64, 24>(-distance) << 30) | (uint64)matKey;
-		}
-	}
-
-	VisualElement::VisualElement(
-		const MeshComponent& meshComp,
-		const TransformComponent& transform,
-		float3 camPos,
-		float3 viewVec)
-		: m_Transform(&transform)
-		, m_MeshComp(&meshComp)
-		, m_Type(EType::Mesh)
-	{
-		const float distance = glm::dot(transform.m_Position - camPos, viewVec) / 100.f;
-		m_Key = ComputeKey(*meshComp.m_Material, distance);
-	}
-	VisualElement::VisualElement(
-		const GridComponent& gridComponent,
-		const TransformComponent& transform,
-		float3 camPos,
-		float3 viewVec)
-		: m_Transform(&transform)
-		, m_Grid(&gridComponent)
-		, m_Type(EType::Grid)
-	{
-		const float distance = glm::dot(transform.m_Position - camPos, viewVec) / 100.f;
-		m_Key = ComputeKey(*gridComponent.m_Mat, distance);
-	}
-
-	void VisualElement::Draw(SDL_GPUCommandBuffer* cmdBuffer, SDL_GPURenderPass* pass) const
-	{
-		switch (m_Type)
-		{
-		case EType::Mesh: DrawMesh(cmdBuffer, pass); break;
-		case EType::Grid:
-			DrawGrid(cmdBuffer, pass);
-			break;
-
-		[[unlikely]] default:
-			APOLLO_LOG_CRITICAL("Invalid visual element type: {}", ToUnderlying(m_Type));
-			DEBUG_BREAK();
-			break;
-		}
-	}
-
-	void VisualElement::DrawMesh(SDL_GPUCommandBuffer* cmdBuffer, SDL_GPURenderPass* pass) const
-	{
-		m_MeshComp->m_Material->Bind(pass);
-		m_MeshComp->m_Material->PushFragmentConstants(cmdBuffer);
-		const auto modelMat = ComputeTransformMatrix(
-			m_Transform->m_Position,
-			m_Transform->m_Scale,
-			m_Transform->m_Rotation);
-		SDL_PushGPUVertexUniformData(cmdBuffer, 1u, &modelMat, sizeof(modelMat));
-		const auto& vBuffer = m_MeshComp->m_Mesh->GetVertexBuffer();
-		SDL_GPUBufferBinding binding{ .buffer = vBuffer.GetHandle() };
-		SDL_BindGPUVertexBuffers(pass, 0, &binding, 1);
-		const auto& iBuffer = m_MeshComp->m_Mesh->GetIndexBuffer();
-		if (iBuffer)
-		{
-			binding.buffer = iBuffer.GetHandle();
-			SDL_BindGPUIndexBuffer(pass, &binding, SDL_GPU_INDEXELEMENTSIZE_32BIT);
-			SDL_DrawGPUIndexedPrimitives(pass, m_MeshComp->m_Mesh->GetNumIndices(), 1, 0, 0, 0);
-		}
-		else
-		{
-			SDL_DrawGPUPrimitives(pass, m_MeshComp->m_Mesh->GetNumVertices(), 1, 0, 0);
-		}
-	}
-	void VisualElement::DrawGrid(SDL_GPUCommandBuffer* cmdBuffer, SDL_GPURenderPass* pass) const
-	{
-		const struct VertexData
-		{
-			glm::mat4x4 Transform;
-			uint32 Width;
-		} vertexData{
-			ComputeTransformMatrix(
-				m_Transform->m_Position,
-				m_Transform->m_Scale,
-				m_Transform->m_Rotation),
-			m_Grid->m_GridWidth,
-		};
-		SDL_PushGPUVertexUniformData(cmdBuffer, 1u, &vertexData, sizeof(vertexData));
-		m_Grid->m_Mat->Bind(pass);
-		const uint32 numInstances = vertexData.Width * vertexData.Width;
-		SDL_DrawGPUPrimitives(pass, 4, numInstances, 0, 0);
-	}
-
 	VisualSystem::VisualSystem(
 		apollo::Window& window,
 		apollo::rdr::Context& renderer,
@@ -173,17 +66,29 @@ namespace apollo::demo {
 
 	void VisualSystem::EmitGPUCommands(const entt::registry& world)
 	{
+		// instance data is uploaded through the main command buffer
+		SDL_GPUCommandBuffer* const cmdBuffer = m_RenderContext.GetMainCommandBuffer();
+		if (!cmdBuffer) [[unlikely]]
+			return;
+
 		const auto vpMatrix = GetProjMatrix(m_TargetViewport) * m_CamSystem.GetViewMatrix();
 		m_RenderContext.PushVertexShaderConstants(vpMatrix, 0);
 		m_RenderContext.BeginRenderPass(m_RenderPass);
 		m_RenderContext.SetViewport(m_TargetViewport.m_Rectangle);
 
-		const auto meshView = world.view<const MeshComponent, const TransformComponent>();
-		const auto gridView = world.view<const GridComponent, const TransformComponent>();
+		// world matrices are cached by the TransformSystem
+		const auto meshView = world.view<const MeshComponent, const WorldTransformComponent>();
+		const auto gridView = world.view<const GridComponent, const WorldTransformComponent>();
 
-		m_VisualElements.clear();
-		m_VisualElements.reserve(meshView.size_hint() + gridView.size_hint());
+		m_RenderQueue.Clear();
+		m_MeshInstances.Clear();
 		const Camera& cam = m_CamSystem.GetCamera();
+		const auto computeKey = [&](const rdr::MaterialInstance& mat, const float3& position)
+		{
+			const float3 offset = position - cam.GetTranslate();
+			const float distance = glm::dot(offset, cam.GetForward()) / 100.f;
+			return rdr::RenderQueue::ComputeKey(mat.GetKey(), distance);
+		};
 
 		for (const auto entt : meshView)
 		{
@@ -192,8 +97,36 @@ namespace apollo::demo {
 				!mesh.m_Material->IsLoaded())
 				continue;
 
-			const auto& transform = meshView.get<const TransformComponent>(entt);
-			m_VisualElements.emplace_back(mesh, transform, cam.GetTranslate(), cam.GetForward());
+			const glm::mat4x4& modelMat = meshView.get<const WorldTransformComponent>(entt).m_Matrix;
+			const uint64 key = computeKey(*mesh.m_Material, float3{ modelMat[3] });
+			// transparent meshes have to be drawn back to front, one at a time
+			if (mesh.m_Material->GetKey().WritesToDepthBuffer())
+				m_MeshInstances.Add(*mesh.m_Mesh, *mesh.m_Material, key, modelMat);
+			else
+				m_MeshInstances.AddSingle(*mesh.m_Mesh, *mesh.m_Material, key, modelMat);
+		}
+		if (m_MeshInstances.GetInstanceCount())
+		{
+			m_MeshInstances.Pack(m_ModelMatrices);
+			auto* copyPass = SDL_BeginGPUCopyPass(cmdBuffer);
+			m_ModelMatrices.EndRecording(copyPass);
+			SDL_EndGPUCopyPass(copyPass);
+		}
+		for (const auto& group : m_MeshInstances.GetGroups())
+		{
+			const auto& iBuffer = group.m_Mesh->GetIndexBuffer();
+			const rdr::DrawPacket packet{
+				.m_Key = group.m_Key,
+				.m_Material = group.m_Material,
+				.m_VertexBuffer = &group.m_Mesh->GetVertexBuffer(),
+				.m_IndexBuffer = iBuffer ? &iBuffer : nullptr,
+				.m_VertexStorageBuffer = &m_ModelMatrices.GetBuffer(),
+				.m_NumElements = iBuffer ? group.m_Mesh->GetNumIndices()
+										 : group.m_Mesh->GetNumVertices(),
+				.m_NumInstances = group.m_NumInstances,
+			};
+			// SV_InstanceID doesn't include the draw's first instance on every backend
+			m_RenderQueue.Submit(packet, group.m_FirstInstance, 1);
 		}
 		for (const auto entt : gridView)
 		{
@@ -201,22 +134,25 @@ namespace apollo::demo {
 			if (!grid.m_Mat || !grid.m_Mat->IsLoaded() || !grid.m_GridWidth)
 				continue;
 
-			const auto& transform = meshView.get<const TransformComponent>(entt);
-			m_VisualElements.emplace_back(grid, transform, cam.GetTranslate(), cam.GetForward());
-		}
-		std::sort(m_VisualElements.begin(), m_VisualElements.end());
-
-		m_RenderContext.AddCustomCommand(
-			[this](rdr::Context& ctx)
+			const glm::mat4x4& modelMat = gridView.get<const WorldTransformComponent>(entt).m_Matrix;
+			const struct VertexData
 			{
-				auto* pass = ctx.GetCurrentRenderPass()->GetHandle();
-				auto* const cmdBuffer = ctx.GetMainCommandBuffer();
-
-				for (const auto& e : m_VisualElements)
-				{
-					e.Draw(cmdBuffer, pass);
-				}
-			});
+				glm::mat4x4 Transform;
+				uint32 Width;
+			} vertexData{
+				modelMat,
+				grid.m_GridWidth,
+			};
+			const rdr::DrawPacket packet{
+				.m_Key = computeKey(*grid.m_Mat, float3{ modelMat[3] }),
+				.m_Material = grid.m_Mat.Get(),
+				.m_NumElements = 4,
+				.m_NumInstances = grid.m_GridWidth * grid.m_GridWidth,
+			};
+			m_RenderQueue.Submit(packet, vertexData, 1);
+		}
+		m_RenderQueue.Sort();
+		m_RenderQueue.Emit(m_RenderContext);
 	}
 
 	void VisualSystem::Update(entt::registry& world, const apollo::GameTime&)
@@ -4,48 +4,11 @@
 
 #include "CameraSystem.hpp"
 #include "Inspector.hpp"
+#include <rendering/Batch.hpp>
+#include <rendering/Instancing.hpp>
+#include <rendering/RenderQueue.hpp>
 
 namespace apollo::demo {
-	struct VisualElement
-	{
-		enum EType : uint8
-		{
-			Mesh,
-			Grid,
-		};
-
-		VisualElement(
-			const MeshComponent& meshComp,
-			const TransformComponent& transform,
-			float3 camPos,
-			float3 viewVec);
-		VisualElement(
-			const GridComponent& gridComponent,
-			const TransformComponent& transform,
-			float3 camPos,
-			float3 viewVec);
-
-		void Draw(SDL_GPUCommandBuffer* cmdBuffer, SDL_GPURenderPass* pass) const;
-		[[nodiscard]] uint64 GetKey() const noexcept { return m_Key; }
-
-	private:
-		void DrawMesh(SDL_GPUCommandBuffer* cmdBuffer, SDL_GPURenderPass* pass) const;
-		void DrawGrid(SDL_GPUCommandBuffer* cmdBuffer, SDL_GPURenderPass* pass) const;
-
-		const TransformComponent* m_Transform;
-		union {
-			const MeshComponent* m_MeshComp;
-			const GridComponent* m_Grid;
-		};
-		uint64 m_Key;
-		EType m_Type;
-	};
-
-	[[nodiscard]] inline bool operator<(const VisualElement& lhs, const VisualElement& rhs) noexcept
-	{
-		return lhs.GetKey() < rhs.GetKey();
-	}
-
 	struct VisualSystem
 	{
 		VisualSystem(
@@ -72,7 +35,9 @@ namespace apollo::demo {
 		rdr::RenderPass m_RenderPass;
 		uint32 m_CurrentScene;
 
-		std::vector<VisualElement> m_VisualElements;
+		rdr::RenderQueue m_RenderQueue;
+		rdr::InstanceBatcher<glm::mat4x4> m_MeshInstances;
+		rdr::Batch<glm::mat4x4> m_ModelMatrices;
 	};
 
 } // namespace apollo::demo
\ No newline at end of file
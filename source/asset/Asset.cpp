@@ -26,6 +26,29 @@ namespace apollo {
 		: m_Id(ULID::Generate())
 	{}
 
+	void IAsset::AddWaiter(AssetWaiter& waiter) const noexcept
+	{
+		waiter.m_Next = m_Waiters.load(std::memory_order_relaxed);
+		while (!m_Waiters.compare_exchange_weak(waiter.m_Next, &waiter))
+			;
+
+		// if the state changed before we made it into the list, nobody else is going to resume us
+		if (!IsLoading())
+			ResumeWaiters();
+	}
+
+	void IAsset::ResumeWaiters() const noexcept
+	{
+		AssetWaiter* waiter = m_Waiters.exchange(nullptr);
+		while (waiter)
+		{
+			// resuming may destroy the waiter
+			AssetWaiter* const next = waiter->m_Next;
+			waiter->m_Resume(*waiter);
+			waiter = next;
+		}
+	}
+
 	[[nodiscard]] std::string_view IAsset::GetTypeName() const noexcept
 	{
 		const EAssetType type = GetType();
@@ -47,6 +47,20 @@ namespace apollo {
 	 */
 	[[nodiscard]] APOLLO_API std::string_view GetAssetTypeName(const EAssetType type) noexcept;
 
+	/**
+	 * \brief Intrusive node used to get notified once an asset has finished loading
+	 * \details Waiters are typically embedded in a larger object, which \ref m_Resume casts back
+	 * to.
+	 * \sa IAsset::AddWaiter
+	 */
+	struct AssetWaiter
+	{
+		using ResumeFunc = void(AssetWaiter& waiter);
+
+		ResumeFunc* m_Resume = nullptr; /*!< Invoked once the awaited asset is no longer loading */
+		AssetWaiter* m_Next = nullptr;
+	};
+
 	/**
 	 * \brief Abstract Asset interface. All asset classes implement this.
 	 * \details This class uses an internal ref counter to manage the asset's lifetime.
@@ -96,16 +110,38 @@ namespace apollo {
 		}
 		/** @} */
 
+		/**
+		 * \brief Registers \p waiter, to be resumed once the asset is no longer loading
+		 * \details The waiter is resumed from whichever thread changes the state of the asset, or
+		 * right away from the calling thread if the asset isn't loading anymore. Either way, it is
+		 * resumed exactly once, and must stay alive until then. This function is lock-free.
+		 */
+		APOLLO_API void AddWaiter(AssetWaiter& waiter) const noexcept;
+
 		[[nodiscard]] virtual APOLLO_API EAssetType GetType() const noexcept = 0;
 		[[nodiscard]] APOLLO_API std::string_view GetTypeName() const noexcept;
 
 	protected:
+		/**
+		 * \brief Updates the state of the asset. If it isn't loading anymore (e.g. it is now
+		 * Loaded or LoadingFailed), all registered waiters are resumed.
+		 */
+		void SetState(EAssetState state) noexcept
+		{
+			m_State = state;
+			if (!bool(state & EAssetState::Loading))
+				ResumeWaiters();
+		}
+
 		apollo::ULID m_Id;
 		std::atomic<EAssetState> m_State = EAssetState::Invalid;
 		std::atomic_uint32_t m_RefCount = 0;
 
 	private:
-		void SetState(EAssetState state) noexcept { m_State = state; }
+		/// Detaches the whole waiter list and resumes every waiter in it
+		APOLLO_API void ResumeWaiters() const noexcept;
+
+		mutable std::atomic<AssetWaiter*> m_Waiters = nullptr;
 
 		friend class IAssetManager;
 		friend struct AssetLoadRequest;
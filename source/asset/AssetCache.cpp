@@ -0,0 +1,152 @@
+#include "AssetCache.hpp"
+#include <algorithm>
+#include <bit>
+
+namespace apollo {
+	IAsset* AssetCache::Find(const ULID& id) const noexcept
+	{
+		const uint64 hash = HashId(id);
+		const Table* const table = GetShard(hash).m_Table.load(std::memory_order_acquire);
+		if (!table)
+			return nullptr;
+
+		// tables are never full, the probe always ends on an empty slot
+		const uint32 mask = table->m_Capacity - 1;
+		for (uint32 i = uint32(hash) & mask;; i = (i + 1) & mask)
+		{
+			const Slot& slot = table->m_Slots[i];
+			IAsset* const asset = slot.m_Asset.load(std::memory_order_acquire);
+			if (!asset)
+				return nullptr;
+			// IDs are unique within a table, so the first match is the only one
+			if (slot.m_Id == id)
+				return asset == GetTombstone() ? nullptr : asset;
+		}
+	}
+
+	IAsset* AssetCache::Insert(IAsset* asset)
+	{
+		const ULID id = asset->GetId();
+		const uint64 hash = HashId(id);
+		Shard& shard = GetShard(hash);
+		std::unique_lock lock{ shard.m_Mutex };
+
+		Table* table = shard.m_Tables.empty() ? nullptr : shard.m_Tables.back().get();
+		if (table)
+		{
+			const uint32 mask = table->m_Capacity - 1;
+			for (uint32 i = uint32(hash) & mask;; i = (i + 1) & mask)
+			{
+				Slot& slot = table->m_Slots[i];
+				IAsset* const current = slot.m_Asset.load(std::memory_order_relaxed);
+				if (!current)
+					break;
+				if (slot.m_Id != id)
+					continue;
+
+				if (current != GetTombstone())
+					return current;
+
+				slot.m_Asset.store(asset, std::memory_order_release);
+				++shard.m_Size;
+				return asset;
+			}
+		}
+
+		// keep the load factor under 3/4, so that probe sequences stay short
+		if (!table || (table->m_NumUsed + 1) * 4 > table->m_Capacity * 3)
+			table = &Rebuild(shard);
+
+		const uint32 mask = table->m_Capacity - 1;
+		uint32 i = uint32(hash) & mask;
+		while (table->m_Slots[i].m_Asset.load(std::memory_order_relaxed))
+			i = (i + 1) & mask;
+
+		Slot& slot = table->m_Slots[i];
+		slot.m_Id = id;
+		slot.m_Asset.store(asset, std::memory_order_release);
+		++table->m_NumUsed;
+		++shard.m_Size;
+		return asset;
+	}
+
+	bool AssetCache::Erase(const ULID& id)
+	{
+		const uint64 hash = HashId(id);
+		Shard& shard = GetShard(hash);
+		std::unique_lock lock{ shard.m_Mutex };
+		if (shard.m_Tables.empty())
+			return false;
+
+		Table& table = *shard.m_Tables.back();
+		const uint32 mask = table.m_Capacity - 1;
+		for (uint32 i = uint32(hash) & mask;; i = (i + 1) & mask)
+		{
+			Slot& slot = table.m_Slots[i];
+			IAsset* const current = slot.m_Asset.load(std::memory_order_relaxed);
+			if (!current)
+				return false;
+			if (slot.m_Id != id)
+				continue;
+			if (current == GetTombstone())
+				return false;
+
+			slot.m_Asset.store(GetTombstone(), std::memory_order_release);
+			--shard.m_Size;
+			return true;
+		}
+	}
+
+	uint32 AssetCache::GetSize() const noexcept
+	{
+		uint32 size = 0;
+		for (const Shard& shard : m_Shards)
+			size += shard.m_Size.load(std::memory_order_relaxed);
+		return size;
+	}
+
+	void AssetCache::ReclaimRetiredTables()
+	{
+		for (Shard& shard : m_Shards)
+		{
+			std::unique_lock lock{ shard.m_Mutex };
+			if (shard.m_Tables.size() > 1)
+				shard.m_Tables.erase(shard.m_Tables.begin(), shard.m_Tables.end() - 1);
+		}
+	}
+
+	auto AssetCache::Rebuild(Shard& shard) -> Table&
+	{
+		const Table* const oldTable = shard.m_Tables.empty() ? nullptr
+															  : shard.m_Tables.back().get();
+		const uint32 numLive = shard.m_Size.load(std::memory_order_relaxed);
+		// room for one more entry, at a load factor of at most 1/2
+		uint32 capacity = std::max(MinCapacity, std::bit_ceil(2 * (numLive + 1)));
+		if (oldTable)
+			capacity = std::max(capacity, oldTable->m_Capacity);
+
+		Table& table = *shard.m_Tables.emplace_back(std::make_unique<Table>(capacity));
+		if (oldTable)
+		{
+			const uint32 mask = capacity - 1;
+			for (uint32 i = 0; i < oldTable->m_Capacity; ++i)
+			{
+				const Slot& oldSlot = oldTable->m_Slots[i];
+				IAsset* const asset = oldSlot.m_Asset.load(std::memory_order_relaxed);
+				if (!IsLive(asset))
+					continue;
+
+				uint32 index = uint32(HashId(oldSlot.m_Id)) & mask;
+				while (table.m_Slots[index].m_Asset.load(std::memory_order_relaxed))
+					index = (index + 1) & mask;
+				table.m_Slots[index].m_Id = oldSlot.m_Id;
+				table.m_Slots[index].m_Asset.store(asset, std::memory_order_relaxed);
+				++table.m_NumUsed;
+			}
+		}
+
+		// the release store makes the whole table visible to readers which load it
+		shard.m_Table.store(&table, std::memory_order_release);
+		return table;
+	}
+} // namespace apollo
\ No newline at end of file
@@ -0,0 +1,153 @@
+#pragma once
+
+/** \file AssetCache.hpp
+ * \brief Concurrent ULID to asset map, used by the asset manager
+ */
+
+#include <PCH.hpp>
+
+#include "Asset.hpp"
+#include <atomic>
+#include <core/ULID.hpp>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace apollo {
+	/**
+	 * \brief Maps asset IDs to loaded assets, with lookups that never take a lock.
+	 * \details The cache is split into shards, each of them holding a linear probing table that
+	 * gets published through an atomic pointer. Writers serialize on the shard's mutex, and only
+	 * ever touch slots in a way that concurrent readers can observe safely:
+	 * - A slot's ID is written once, before its asset pointer gets published with release
+	 * semantics. It never changes for the lifetime of the table.
+	 * - Erasing replaces the asset pointer with a tombstone. A tombstone can be revived by
+	 * inserting an asset with the same ID again, but never gets reused for another ID.
+	 * - When a table runs out of free slots, its live entries are copied to a brand new table,
+	 * which then replaces it. The old table is retired instead of freed, since readers may still
+	 * be probing it. Retired tables are released by ReclaimRetiredTables(), at a point where no
+	 * reader can be active, or along with the cache.
+	 *
+	 * Tables never shrink, and only grow when the number of live entries requires it.
+	 */
+	class AssetCache
+	{
+	public:
+		static constexpr uint32 NumShards = 16;
+
+		AssetCache() = default;
+		AssetCache(const AssetCache&) = delete;
+		AssetCache& operator=(const AssetCache&) = delete;
+
+		/**
+		 * \brief Looks up an asset. Lock-free and safe to call from any thread at any time.
+		 * \returns The cached asset, or nullptr if there is none with this ID
+		 */
+		[[nodiscard]] APOLLO_API IAsset* Find(const ULID& id) const noexcept;
+
+		/**
+		 * \brief Adds \p asset to the cache, unless an asset with the same ID is already in it.
+		 * \returns The asset stored in the cache after the call: either \p asset, or the one
+		 * which was already there.
+		 */
+		APOLLO_API IAsset* Insert(IAsset* asset);
+
+		/**
+		 * \brief Removes an asset from the cache. The asset itself isn't destroyed.
+		 * \returns Whether an asset with this ID was found
+		 */
+		APOLLO_API bool Erase(const ULID& id);
+
+		/**
+		 * \brief Frees the tables which were replaced since the last call.
+		 * \warning No other thread may call Find() concurrently, nor hold on to a table from an
+		 * earlier Find() call.
+		 */
+		APOLLO_API void ReclaimRetiredTables();
+
+		/// Number of cached assets. Only accurate if no other thread is modifying the cache.
+		[[nodiscard]] APOLLO_API uint32 GetSize() const noexcept;
+
+		/**
+		 * \brief Invokes \p func on every cached asset.
+		 * \warning Each shard is locked while its assets are visited: \p func must not insert
+		 * into nor erase from the cache.
+		 */
+		template <class F>
+		void ForEach(F&& func) const requires(std::invocable<F&, IAsset*>);
+
+	private:
+		struct Slot
+		{
+			std::atomic<IAsset*> m_Asset = nullptr;
+			ULID m_Id;
+		};
+
+		struct Table
+		{
+			explicit Table(uint32 capacity)
+				: m_Capacity(capacity)
+				, m_Slots(std::make_unique<Slot[]>(capacity))
+			{}
+
+			const uint32 m_Capacity;
+			uint32 m_NumUsed = 0; /*!< Live entries and tombstones */
+			std::unique_ptr<Slot[]> m_Slots;
+		};
+
+		struct alignas(64) Shard
+		{
+			std::atomic<const Table*> m_Table = nullptr;
+			std::atomic_uint32_t m_Size = 0;
+			mutable std::mutex m_Mutex;
+			/// The current table is always the last one, the others are retired
+			std::vector<std::unique_ptr<Table>> m_Tables;
+		};
+
+		static constexpr uint32 MinCapacity = 64;
+
+		[[nodiscard]] static bool IsLive(const IAsset* asset) noexcept
+		{
+			return asset && asset != GetTombstone();
+		}
+		[[nodiscard]] static IAsset* GetTombstone() noexcept
+		{
+			return reinterpret_cast<IAsset*>(const_cast<std::byte*>(&s_Tombstone));
+		}
+
+		[[nodiscard]] static uint64 HashId(const ULID& id) noexcept { return Hash<ULID>{}(id); }
+		[[nodiscard]] const Shard& GetShard(uint64 hash) const noexcept
+		{
+			return m_Shards[hash >> 60];
+		}
+		[[nodiscard]] Shard& GetShard(uint64 hash) noexcept { return m_Shards[hash >> 60]; }
+
+		/// Copies the live entries of the shard's current table into a new one and publishes it
+		static Table& Rebuild(Shard& shard);
+
+		static_assert(NumShards == 16, "GetShard uses the top 4 bits of the hash");
+		/// Its address marks erased slots
+		alignas(IAsset) static inline const std::byte s_Tombstone{};
+
+		Shard m_Shards[NumShards];
+	};
+
+	template <class F>
+	void AssetCache::ForEach(F&& func) const requires(std::invocable<F&, IAsset*>)
+	{
+		for (const Shard& shard : m_Shards)
+		{
+			std::unique_lock lock{ shard.m_Mutex };
+			const Table* const table = shard.m_Table.load(std::memory_order_relaxed);
+			if (!table)
+				continue;
+
+			for (uint32 i = 0; i < table->m_Capacity; ++i)
+			{
+				IAsset* const asset = table->m_Slots[i].m_Asset.load(std::memory_order_relaxed);
+				if (IsLive(asset))
+					func(asset);
+			}
+		}
+	}
+} // namespace apollo
\ No newline at end of file
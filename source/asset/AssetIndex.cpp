@@ -0,0 +1,180 @@
+#include "AssetIndex.hpp"
+#include "AssetManager.hpp"
+#include <algorithm>
+#include <core/Errno.hpp>
+#include <core/Log.hpp>
+#include <core/NumConv.hpp>
+#include <core/ULIDFormatter.hpp>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace apollo {
+	bool AssetIndex::Load(const std::string& path)
+	{
+		std::ifstream file{ path, std::ios::binary | std::ios::ate };
+		if (!file.is_open())
+		{
+			APOLLO_LOG_ERROR("Failed to open asset index {}: {}", path, GetErrnoMessage(errno));
+			return false;
+		}
+		const uint64 size = file.tellg();
+		AssetIndexHeader header;
+		if (size < sizeof(header))
+		{
+			APOLLO_LOG_ERROR("Asset index {} is too small", path);
+			return false;
+		}
+
+		auto data = std::make_unique_for_overwrite<std::byte[]>(size);
+		file.seekg(0, std::ios::beg);
+		if (!file.read(reinterpret_cast<char*>(data.get()), size))
+		{
+			APOLLO_LOG_ERROR("Failed to read asset index {}: {}", path, GetErrnoMessage(errno));
+			return false;
+		}
+
+		std::memcpy(&header, data.get(), sizeof(header));
+		if (header.m_Magic != AssetIndexHeader::Magic ||
+			header.m_Version != AssetIndexHeader::CurrentVersion)
+		{
+			APOLLO_LOG_ERROR("{} is not a valid asset index", path);
+			return false;
+		}
+		const uint64 recordsSize = uint64(header.m_NumRecords) * sizeof(AssetIndexRecord);
+		if (sizeof(header) + recordsSize + header.m_StringTableSize != size)
+		{
+			APOLLO_LOG_ERROR("Asset index {} is corrupted: invalid size", path);
+			return false;
+		}
+
+		const auto* const records = reinterpret_cast<const AssetIndexRecord*>(
+			data.get() + sizeof(header));
+		for (uint32 i = 0; i < header.m_NumRecords; ++i)
+		{
+			const AssetIndexRecord& record = records[i];
+			if (uint64(record.m_NameOffset) + record.m_NameLength > header.m_StringTableSize ||
+				uint64(record.m_PathOffset) + record.m_PathLength > header.m_StringTableSize ||
+				record.m_Type <= EAssetType::Invalid || record.m_Type >= EAssetType::NTypes ||
+				(i && !(records[i - 1].m_Id < record.m_Id)))
+			{
+				APOLLO_LOG_ERROR(
+					"Asset index {} is corrupted: invalid record {}",
+					path,
+					record.m_Id);
+				return false;
+			}
+		}
+
+		m_Records = records;
+		m_NumRecords = header.m_NumRecords;
+		m_StringTable = reinterpret_cast<const char*>(data.get() + sizeof(header) + recordsSize);
+		m_Data = std::move(data);
+		return true;
+	}
+
+	const AssetIndexRecord* AssetIndex::FindRecord(const ULID& id) const noexcept
+	{
+		const AssetIndexRecord* const end = m_Records + m_NumRecords;
+		const AssetIndexRecord* const it = std::lower_bound(
+			m_Records,
+			end,
+			id,
+			[](const AssetIndexRecord& record, const ULID& id)
+			{
+				return record.m_Id < id;
+			});
+		return (it != end && it->m_Id == id) ? it : nullptr;
+	}
+
+	AssetMetadata AssetIndex::MakeMetadata(
+		const AssetIndexRecord& record,
+		const std::string& assetRoot) const
+	{
+		return AssetMetadata{
+			.m_Id = record.m_Id,
+			.m_Name = std::string{ GetName(record) },
+			.m_FilePath = (std::filesystem::path{ assetRoot } / GetPath(record)).string(),
+			.m_Offset = record.m_Offset,
+			.m_Size = record.m_Size,
+			.m_Type = record.m_Type,
+		};
+	}
+
+	void AssetIndexWriter::AddAsset(
+		const ULID& id,
+		EAssetType type,
+		std::string_view name,
+		std::string_view path,
+		uint64 offset,
+		uint64 size)
+	{
+		m_Records.emplace_back(
+			AssetIndexRecord{
+				.m_Id = id,
+				.m_Offset = offset,
+				.m_Size = size,
+				.m_NameOffset = Intern(name),
+				.m_NameLength = NumCast<uint32>(name.size()),
+				.m_PathOffset = Intern(path),
+				.m_PathLength = NumCast<uint32>(path.size()),
+				.m_Type = type,
+			});
+	}
+
+	uint32 AssetIndexWriter::Intern(std::string_view str)
+	{
+		const auto [it, inserted] = m_StringOffsets.try_emplace(
+			std::string{ str },
+			NumCast<uint32>(m_StringTable.size()));
+		if (inserted)
+			m_StringTable += str;
+		return it->second;
+	}
+
+	bool AssetIndexWriter::Write(const std::string& path)
+	{
+		std::sort(
+			m_Records.begin(),
+			m_Records.end(),
+			[](const AssetIndexRecord& lhs, const AssetIndexRecord& rhs)
+			{
+				return lhs.m_Id < rhs.m_Id;
+			});
+		const auto duplicate = std::adjacent_find(
+			m_Records.begin(),
+			m_Records.end(),
+			[](const AssetIndexRecord& lhs, const AssetIndexRecord& rhs)
+			{
+				return lhs.m_Id == rhs.m_Id;
+			});
+		if (duplicate != m_Records.end())
+		{
+			APOLLO_LOG_ERROR("Asset {} was added to the index more than once", duplicate->m_Id);
+			return false;
+		}
+
+		const AssetIndexHeader header{
+			.m_NumRecords = NumCast<uint32>(m_Records.size()),
+			.m_StringTableSize = NumCast<uint32>(m_StringTable.size()),
+		};
+
+		std::ofstream out{ path, std::ios::binary | std::ios::trunc };
+		if (!out.is_open())
+		{
+			APOLLO_LOG_ERROR("Failed to open {} for writing: {}", path, GetErrnoMessage(errno));
+			return false;
+		}
+		out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		out.write(
+			reinterpret_cast<const char*>(m_Records.data()),
+			m_Records.size() * sizeof(AssetIndexRecord));
+		out.write(m_StringTable.data(), m_StringTable.size());
+		if (!out)
+		{
+			APOLLO_LOG_ERROR("Failed to write asset index {}: {}", path, GetErrnoMessage(errno));
+			return false;
+		}
+		return true;
+	}
+} // namespace apollo
\ No newline at end of file
@@ -0,0 +1,155 @@
+#pragma once
+
+/** \file AssetIndex.hpp
+ * \brief Precompiled asset metadata index
+ */
+
+#include <PCH.hpp>
+
+#include "Asset.hpp"
+#include <core/ULID.hpp>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace apollo {
+	struct AssetMetadata;
+
+	/**
+	 * \brief Header found at the beginning of an index file.
+	 * \details The header is immediately followed by the records, sorted by ULID, then by the
+	 * string table. Strings are interned: every distinct name or path is only stored once, no
+	 * matter how many records reference it.
+	 */
+	struct AssetIndexHeader
+	{
+		static constexpr uint32 Magic = 'A' | ('I' << 8) | ('D' << 16) | ('X' << 24);
+		static constexpr uint32 CurrentVersion = 1;
+
+		uint32 m_Magic = Magic;
+		uint32 m_Version = CurrentVersion;
+		uint32 m_NumRecords = 0;
+		uint32 m_StringTableSize = 0;
+	};
+
+	/// Fixed size metadata record for a single asset
+	struct AssetIndexRecord
+	{
+		ULID m_Id;
+		uint64 m_Offset = 0; /*!< \sa AssetMetadata::m_Offset */
+		uint64 m_Size = 0;	 /*!< \sa AssetMetadata::m_Size */
+		uint32 m_NameOffset = 0;
+		uint32 m_NameLength = 0;
+		uint32 m_PathOffset = 0; /*!< Path relative to the asset folder */
+		uint32 m_PathLength = 0;
+		EAssetType m_Type = EAssetType::Invalid;
+		uint8 m_Padding[7] = {};
+	};
+
+	static_assert(sizeof(AssetIndexHeader) == 16);
+	static_assert(sizeof(AssetIndexRecord) == 56);
+	static_assert(std::is_trivially_copyable_v<AssetIndexRecord>);
+
+	/**
+	 * \brief In-memory asset metadata index.
+	 * \details The file is read in one go and used as is: loading it costs a single allocation,
+	 * regardless of the number of assets. Lookups are binary searches over the records.
+	 */
+	class AssetIndex
+	{
+	public:
+		static constexpr const char FileName[] = "metadata.idx";
+
+		/**
+		 * \brief Reads and validates the index file at \p path
+		 * \returns Whether the index was loaded successfully. Errors are logged.
+		 */
+		APOLLO_API bool Load(const std::string& path);
+
+		[[nodiscard]] bool IsLoaded() const noexcept { return bool(m_Data); }
+
+		[[nodiscard]] std::span<const AssetIndexRecord> GetRecords() const noexcept
+		{
+			return { m_Records, m_NumRecords };
+		}
+
+		/**
+		 * \brief Looks up a record from its ULID
+		 * \returns The record, or nullptr if the asset isn't in the index
+		 */
+		[[nodiscard]] APOLLO_API const AssetIndexRecord* FindRecord(const ULID& id) const noexcept;
+
+		[[nodiscard]] std::string_view GetName(const AssetIndexRecord& record) const noexcept
+		{
+			return { m_StringTable + record.m_NameOffset, record.m_NameLength };
+		}
+		[[nodiscard]] std::string_view GetPath(const AssetIndexRecord& record) const noexcept
+		{
+			return { m_StringTable + record.m_PathOffset, record.m_PathLength };
+		}
+
+		/**
+		 * \brief Creates the full metadata object for a record
+		 * \param record: The index record
+		 * \param assetRoot: The folder record paths are relative to
+		 */
+		[[nodiscard]] APOLLO_API AssetMetadata MakeMetadata(
+			const AssetIndexRecord& record,
+			const std::string& assetRoot) const;
+
+	private:
+		std::unique_ptr<std::byte[]> m_Data;
+		const AssetIndexRecord* m_Records = nullptr;
+		uint32 m_NumRecords = 0;
+		const char* m_StringTable = nullptr;
+	};
+
+	/**
+	 * \brief Builds asset index files
+	 */
+	class AssetIndexWriter
+	{
+	public:
+		/**
+		 * \brief Adds a record to the index
+		 * \param id: The asset's ID
+		 * \param type: The asset's type
+		 * \param name: The asset's name
+		 * \param path: The path of the asset's file, relative to the asset folder
+		 * \param offset, size: Where the asset data lives in the file. A size of 0 means the whole
+		 * file.
+		 */
+		APOLLO_API void AddAsset(
+			const ULID& id,
+			EAssetType type,
+			std::string_view name,
+			std::string_view path,
+			uint64 offset = 0,
+			uint64 size = 0);
+
+		[[nodiscard]] uint32 GetNumAssets() const noexcept
+		{
+			return static_cast<uint32>(m_Records.size());
+		}
+		[[nodiscard]] uint32 GetStringTableSize() const noexcept
+		{
+			return static_cast<uint32>(m_StringTable.size());
+		}
+
+		/**
+		 * \brief Writes all records added so far to \p path
+		 * \returns false if the file couldn't be written, or if an ID was added more than once
+		 */
+		APOLLO_API bool Write(const std::string& path);
+
+	private:
+		uint32 Intern(std::string_view str);
+
+		std::vector<AssetIndexRecord> m_Records;
+		std::string m_StringTable;
+		std::unordered_map<std::string, uint32> m_StringOffsets;
+	};
+} // namespace apollo
\ No newline at end of file
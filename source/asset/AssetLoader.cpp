@@ -4,11 +4,35 @@
 #include <asset/AssetManager.hpp>
 #include <core/App.hpp>
 #include <core/Log.hpp>
+#include <core/NumConv.hpp>
+#include <core/ThreadPool.hpp>
 #include <rendering/Device.hpp>
+#include <utility>
 
 namespace {
 	thread_local SDL_GPUCommandBuffer* g_CommandBuffer = nullptr;
 	thread_local SDL_GPUCopyPass* g_CopyPass = nullptr;
+
+	/// Load request waiting on another asset. It is owned by that asset's waiter list until the
+	/// asset completes, at which point the request is handed back to the loader.
+	struct ParkedRequest : public apollo::AssetWaiter
+	{
+		ParkedRequest(apollo::AssetLoader& loader, apollo::AssetLoadRequest request)
+			: AssetWaiter{ &Resume }
+			, m_Loader(loader)
+			, m_Request(std::move(request))
+		{}
+
+		static void Resume(apollo::AssetWaiter& waiter)
+		{
+			auto* const self = static_cast<ParkedRequest*>(&waiter);
+			self->m_Loader.AddRequest(std::move(self->m_Request));
+			delete self;
+		}
+
+		apollo::AssetLoader& m_Loader;
+		apollo::AssetLoadRequest m_Request;
+	};
 } // namespace
 
 namespace apollo {
@@ -88,10 +112,22 @@ namespace apollo {
 		return result;
 	}
 
+	const IAsset* AssetLoadRequest::GetAwaitedAsset() const noexcept
+	{
+		if (!m_Task)
+			return m_Asset.Get();
+		return m_Task->GetAwaitedAsset();
+	}
+
 	void AssetLoader::AddRequest(AssetLoadRequest req)
 	{
 		std::unique_lock lock{ m_Mutex };
 		m_Requests.AddEmplace(std::move(req));
+
+		// no active worker means we're either idle or wrapping up: the request will be picked up
+		// by the next batch
+		if (m_ActiveWorkers)
+			StartWorkers(1);
 	}
 
 	SDL_GPUCommandBuffer* AssetLoader::GetCurrentCommandBuffer() noexcept
@@ -106,28 +142,72 @@ namespace apollo {
 
 	void AssetLoader::ProcessRequests()
 	{
-		// if batch size is non-zero, a thread is already processing the assets, we don't need to do
+		std::unique_lock lock{ m_Mutex };
+		// if a batch is running, workers are already processing the assets, we don't need to do
 		// anything else
 		if (m_RunningBatch || !m_Requests.GetSize())
 			return;
 
 		APOLLO_LOG_TRACE("Starting asset load batch");
 		m_RunningBatch = true;
-		m_ThreadPool.Enqueue(
-			[this]()
-			{
-				DoProcessRequests();
-			});
+		StartWorkers(NumCast<uint32>(m_Requests.GetSize()));
 	}
 
-	void AssetLoader::DoProcessRequests()
+	void AssetLoader::StartWorkers(uint32 count)
+	{
+		const uint32 maxWorkers = m_ThreadPool.GetThreadCount();
+		count = Min(count, maxWorkers - Min(m_ActiveWorkers, maxWorkers));
+		m_ActiveWorkers += count;
+		while (count--)
+		{
+			m_ThreadPool.Enqueue(
+				[this]()
+				{
+					DoProcessRequests();
+				});
+		}
+	}
+
+	void AssetLoader::ParkRequest(AssetLoadRequest request)
+	{
+		const IAsset* const awaited = request.GetAwaitedAsset();
+		if (!awaited) [[unlikely]]
+		{
+			AddRequest(std::move(request));
+			return;
+		}
+		// if the awaited asset already completed, this resumes the request immediately
+		awaited->AddWaiter(*new ParkedRequest{ *this, std::move(request) });
+	}
+
+	rdr::UploadHeap* AssetLoader::AcquireUploadHeap()
 	{
-		if (m_Device) [[likely]]
+		std::unique_lock lock{ m_UploadHeapsMutex };
+		if (m_IdleUploadHeaps.empty())
 		{
-			g_CommandBuffer = SDL_AcquireGPUCommandBuffer(m_Device.GetHandle());
-			g_CopyPass = SDL_BeginGPUCopyPass(g_CommandBuffer);
+			m_UploadHeaps.emplace_back(std::make_unique<rdr::UploadHeap>(m_Device.GetHandle()));
+			return m_UploadHeaps.back().get();
 		}
+		rdr::UploadHeap* heap = m_IdleUploadHeaps.back();
+		m_IdleUploadHeaps.pop_back();
+		return heap;
+	}
 
+	void AssetLoader::ReleaseUploadHeap(rdr::UploadHeap* heap)
+	{
+		std::unique_lock lock{ m_UploadHeapsMutex };
+		m_IdleUploadHeaps.emplace_back(heap);
+	}
+
+	void AssetLoader::DoProcessRequests()
+	{
+		// this thread may already be in the middle of something else: the main thread has its own
+		// heap, and a loader job waiting on a job graph can pick up more requests. That context is
+		// put back once we're done helping out
+		SDL_GPUCommandBuffer* const previousCommandBuffer = std::exchange(g_CommandBuffer, nullptr);
+		SDL_GPUCopyPass* const previousCopyPass = std::exchange(g_CopyPass, nullptr);
+		rdr::UploadHeap* const previousHeap = rdr::UploadHeap::GetThreadHeap();
+		bool triedAcquire = false;
 		for (;;)
 		{
 			std::unique_lock lock{ m_Mutex };
@@ -137,30 +217,64 @@ namespace apollo {
 			AssetLoadRequest request = m_Requests.PopAndGetFront();
 			lock.unlock();
 
-			const EAssetLoadResult result = request();
-			if (result == EAssetLoadResult::TryAgain)
+			// the upload context is only acquired once this worker actually has something to do
+			if (!triedAcquire && m_Device) [[unlikely]]
 			{
-				m_Requests.AddEmplace(std::move(request));
+				triedAcquire = true;
+				g_CommandBuffer = SDL_AcquireGPUCommandBuffer(m_Device.GetHandle());
+				if (g_CommandBuffer) [[likely]]
+				{
+					g_CopyPass = SDL_BeginGPUCopyPass(g_CommandBuffer);
+					rdr::UploadHeap::SetThreadHeap(AcquireUploadHeap());
+				}
+				else
+				{
+					// the outer heap can't be used without its own copy pass either
+					APOLLO_LOG_ERROR("Failed to acquire upload command buffer: {}", SDL_GetError());
+					rdr::UploadHeap::SetThreadHeap(nullptr);
+				}
 			}
+
+			// requests waiting on this asset get queued again as soon as its state is updated, no
+			// need to do it here
+			if (request() == EAssetLoadResult::TryAgain)
+				ParkRequest(std::move(request));
 		}
 
+		// command buffers can't be shared across threads, so each worker submits its own
 		if (g_CopyPass) [[likely]]
 		{
 			SDL_EndGPUCopyPass(g_CopyPass);
-			g_CopyPass = nullptr;
 		}
 		if (g_CommandBuffer) [[likely]]
 		{
-			SDL_SubmitGPUCommandBuffer(g_CommandBuffer);
-			g_CommandBuffer = nullptr;
+			// the heap's blocks are fenced with the command buffer they were used in
+			rdr::UploadHeap* heap = rdr::UploadHeap::GetThreadHeap();
+			heap->EndFrame(SDL_SubmitGPUCommandBufferAndAcquireFence(g_CommandBuffer));
+			ReleaseUploadHeap(heap);
 		}
+		rdr::UploadHeap::SetThreadHeap(previousHeap);
+		g_CommandBuffer = previousCommandBuffer;
+		g_CopyPass = previousCopyPass;
 
-		DispatchCallbacks();
+		std::unique_lock lock{ m_Mutex };
+		--m_ActiveWorkers;
+		if (m_Requests.GetSize())
 		{
-			std::unique_lock lock{ m_Mutex };
-			m_RunningBatch = false;
+			// requests came in while we were submitting, and nobody was started to handle them
+			StartWorkers(1);
+			return;
 		}
-		m_Cond.notify_one();
+		if (m_ActiveWorkers)
+			return;
+		lock.unlock();
+
+		// last worker out: the batch is complete
+		DispatchCallbacks();
+		lock.lock();
+		m_RunningBatch = false;
+		lock.unlock();
+		m_Cond.notify_all();
 	}
 
 	void AssetLoader::WaitForCompletion()
@@ -12,7 +12,9 @@
 #include <core/Coroutine.hpp>
 #include <core/Queue.hpp>
 #include <core/UniqueFunction.hpp>
+#include <memory>
 #include <mutex>
+#include <rendering/UploadHeap.hpp>
 
 struct SDL_GPUCommandBuffer;
 struct SDL_GPUCopyPass;
@@ -55,12 +57,23 @@ namespace apollo {
 
 		/// Invokes the load task
 		EAssetLoadResult operator()();
+
+		/**
+		 * \brief Returns the asset this request is currently blocked on, if any
+		 * \details For regular requests, this is the asset the load task is suspended on. For
+		 * callback-only requests, this is the target asset itself.
+		 */
+		[[nodiscard]] const IAsset* GetAwaitedAsset() const noexcept;
 	};
 
 	/**
 	 * \brief This class is in charge of processing all asset load requests from the \ref
 	 * IAssetManager "asset manager"
-	 * \details Assets are loaded on a separate thread using mt::ThreadPool.
+	 * \details Requests are processed in batches, spread across the workers of an mt::ThreadPool.
+	 * Each worker taking part in a batch records uploads into its own command buffer and copy
+	 * pass, see GetCurrentCopyPass(). A request whose load task is waiting on another asset is
+	 * registered as a waiter on that asset (see IAsset::AddWaiter), and only gets queued again
+	 * once the asset completes.
 	 */
 	class AssetLoader
 	{
@@ -85,17 +98,26 @@ namespace apollo {
 		APOLLO_API void ProcessRequests();
 		/**
 		 * \brief Waits for the current asset batch to finish.
-		 * \details This function blocks until the worker thread is done processing all pending
+		 * \details This function blocks until the worker threads are done processing all pending
 		 * requests, e.g. after loading a scene.
 		 */
 		APOLLO_API void WaitForCompletion();
+		/// \brief Whether workers are currently processing a batch of requests
+		[[nodiscard]] bool IsRunningBatch() const noexcept { return m_RunningBatch; }
 		/**
 		 * \brief Clears the queue
+		 * \note Requests waiting on another asset aren't part of the queue: they get added back
+		 * when that asset completes.
 		 */
 		APOLLO_API void Clear();
 
+		/** \name Upload context
+		 * \brief Returns the command buffer and copy pass owned by the calling worker thread for
+		 * the current batch. Only valid from within a load task.
+		 * @{ */
 		static APOLLO_API SDL_GPUCommandBuffer* GetCurrentCommandBuffer() noexcept;
 		static APOLLO_API SDL_GPUCopyPass* GetCurrentCopyPass() noexcept;
+		/** @} */
 
 		/**
 		 * \brief Registers a callback which will be called after all assets in a batch have been
@@ -118,14 +140,26 @@ namespace apollo {
 	private:
 		void DispatchCallbacks();
 		void DoProcessRequests();
+		/// Starts up to \p count additional batch workers. Requires m_Mutex to be locked.
+		void StartWorkers(uint32 count);
+		/// Parks a request until its awaited asset completes
+		void ParkRequest(AssetLoadRequest request);
+		/// \brief Takes an idle upload heap, or creates a new one if all are in use
+		rdr::UploadHeap* AcquireUploadHeap();
+		void ReleaseUploadHeap(rdr::UploadHeap* heap);
 
 		rdr::GPUDevice& m_Device;
 		mt::ThreadPool& m_ThreadPool;
 		std::condition_variable m_Cond;
 		Queue<AssetLoadRequest> m_Requests;
+		uint32 m_ActiveWorkers = 0;
 		std::atomic_bool m_RunningBatch = false;
 		std::vector<UniqueFunction<void()>> m_LoadCallbacks;
 		std::mutex m_Mutex;
+		/// One heap per worker command buffer, kept alive across batches
+		std::vector<std::unique_ptr<rdr::UploadHeap>> m_UploadHeaps;
+		std::vector<rdr::UploadHeap*> m_IdleUploadHeaps;
+		std::mutex m_UploadHeapsMutex;
 	};
 
 	/**
@@ -152,6 +186,8 @@ namespace apollo {
 			return !(m_Awaiting && m_Awaiting->IsLoading());
 		}
 		[[nodiscard]] EAssetLoadResult GetResult() const noexcept { return m_Result; }
+		/// Returns the last asset the coroutine awaited on, or nullptr
+		[[nodiscard]] const IAsset* GetAwaitedAsset() const noexcept { return m_Awaiting.Get(); }
 
 		bool await_ready() const noexcept { return m_Result != EAssetLoadResult::TryAgain; }
 
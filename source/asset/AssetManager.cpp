@@ -2,12 +2,13 @@
 #include <core/Assert.hpp>
 #include <core/Json.hpp>
 #include <core/Log.hpp>
+#include <vector>
 
 namespace {
 	void ProcessUnloadRequests(
 		apollo::Queue<apollo::IAsset*>& queue,
-		apollo::ULIDMap<apollo::IAsset*>& cache,
-		std::shared_mutex& mutex)
+		apollo::AssetCache& cache,
+		std::mutex& mutex)
 	{
 		for (;;)
 		{
@@ -21,7 +22,7 @@ namespace {
 				continue;
 
 			const apollo::ULID& id = ptr->GetId();
-			DEBUG_CHECK(cache.erase(id))
+			DEBUG_CHECK(cache.Erase(id))
 			{
 				APOLLO_LOG_WARN(
 					"Asset {} was marked for unload but wasn't found in asset cache",
@@ -39,24 +40,34 @@ namespace apollo {
 
 	IAssetManager::~IAssetManager()
 	{
+		// requests waiting on another asset keep references to their assets: send them back to the
+		// loader so that they get cleared along with the rest
+		m_Cache.ForEach(
+			[](IAsset* asset)
+			{
+				asset->ResumeWaiters();
+			});
 		m_Loader.Clear();
 
-		while (m_Cache.size())
+		std::vector<IAsset*> unused;
+		while (m_Cache.GetSize())
 		{
-			auto it = m_Cache.begin();
-			while (it != m_Cache.end())
-			{
-				if (AssetRetainTraits::GetCount(it->second)) // asset still in use, delete later
+			m_Cache.ForEach(
+				[&](IAsset* asset)
 				{
-					++it;
-					continue;
-				}
+					// assets still in use get deleted later
+					if (!AssetRetainTraits::GetCount(asset))
+						unused.push_back(asset);
+				});
 
-				const auto [id, asset] = *it;
-				it = m_Cache.erase(it);
+			for (IAsset* asset : unused)
+			{
+				const ULID id = asset->GetId();
+				m_Cache.Erase(id);
 				APOLLO_LOG_TRACE("Unloading asset {}", id);
 				delete asset;
 			}
+			unused.clear();
 		}
 	}
 
@@ -77,71 +88,69 @@ namespace apollo {
 			type < EAssetType::NTypes && type > EAssetType::Invalid,
 			"Invalid asset type {}",
 			int32(type));
+		IAsset* asset = m_Cache.Find(id);
+		if (!asset)
 		{
-			std::shared_lock lock{ m_Mutex };
-			const auto it = m_Cache.find(id);
-			if (it != m_Cache.end())
+			const AssetTypeInfo& info = GetTypeInfo(type);
+
+			DEBUG_CHECK(info)
 			{
-				IAsset* const asset = it->second;
-				const EAssetType actualType = asset->GetType();
-				DEBUG_CHECK(actualType == type)
-				{
-					APOLLO_LOG_ERROR(
-						"Asset {} has type {} instead of the expected {}",
-						id,
-						GetAssetTypeName(actualType),
-						GetAssetTypeName(type));
-					return nullptr;
-				}
-
-				if (cbk)
-				{
-					if (asset->IsLoading())
-					{
-						m_Loader.AddRequest(
-							AssetLoadRequest{
-								.m_Asset = AssetRef{ asset },
-								.m_Callback = std::move(cbk),
-							});
-					}
-					else
-					{
-						cbk(*asset);
-					}
-				}
-
-				return asset;
+				APOLLO_LOG_CRITICAL("Asset type {} is not implemented!", int32(type));
+				return nullptr;
+			}
+			const auto* metadata = GetAssetMetadata(id);
+			if (!metadata)
+			{
+				APOLLO_LOG_ERROR("No asset found for id {}", id);
+				return nullptr;
+			}
+			auto ptr = info.m_Create(id);
+			// the state has to be set before the asset becomes visible to other threads
+			ptr->SetState(EAssetState::Loading);
+			asset = m_Cache.Insert(ptr);
+			if (asset == ptr)
+			{
+				m_Loader.AddRequest(
+					AssetLoadRequest{
+						AssetRef<IAsset>{ ptr },
+						info.m_LoadFunc(*ptr, *metadata),
+						metadata,
+						std::move(cbk),
+					});
+				return ptr;
 			}
+			// another thread requested the same asset in the meantime
+			delete ptr;
 		}
 
-		const AssetTypeInfo& info = GetTypeInfo(type);
-
-		DEBUG_CHECK(info)
-		{
-			APOLLO_LOG_CRITICAL("Asset type {} is not implemented!", int32(type));
-			return nullptr;
-		}
-		const auto* metadata = GetAssetMetadata(id);
-		if (!metadata)
+		const EAssetType actualType = asset->GetType();
+		DEBUG_CHECK(actualType == type)
 		{
-			APOLLO_LOG_ERROR("No asset found for id {}", id);
+			APOLLO_LOG_ERROR(
+				"Asset {} has type {} instead of the expected {}",
+				id,
+				GetAssetTypeName(actualType),
+				GetAssetTypeName(type));
 			return nullptr;
 		}
-		auto ptr = info.m_Create(id);
+
+		if (cbk)
 		{
-			std::unique_lock lock{ m_Mutex };
-			m_Cache.emplace(id, ptr);
+			if (asset->IsLoading())
+			{
+				m_Loader.AddRequest(
+					AssetLoadRequest{
+						.m_Asset = AssetRef{ asset },
+						.m_Callback = std::move(cbk),
+					});
+			}
+			else
+			{
+				cbk(*asset);
+			}
 		}
 
-		ptr->SetState(EAssetState::Loading);
-		m_Loader.AddRequest(
-			AssetLoadRequest{
-				AssetRef<IAsset>{ ptr },
-				info.m_LoadFunc(*ptr, *metadata),
-				metadata,
-				std::move(cbk),
-			});
-		return ptr;
+		return asset;
 	}
 
 	const AssetMetadata* IAssetManager::GetAssetMetadata(const ULID& id) const noexcept
@@ -162,6 +171,13 @@ namespace apollo {
 
 	void IAssetManager::Update()
 	{
+		// retired tables may only go once no other thread can be reading from them. Assets are
+		// looked up by load tasks, and by systems which the scheduler runs in parallel: this relies
+		// on ecs::Manager::Update joining all system jobs before returning, which it does before
+		// App::Update calls this again. So while no batch is running, this thread is the only
+		// reader left.
+		if (!m_Loader.IsRunningBatch())
+			m_Cache.ReclaimRetiredTables();
 		m_Loader.ProcessRequests();
 		ProcessUnloadRequests(m_UnloadQueue, m_Cache, m_Mutex);
 	}
@@ -5,13 +5,16 @@
 #include <PCH.hpp>
 
 #include "Asset.hpp"
+#include "AssetCache.hpp"
 #include "AssetFunctions.hpp"
 #include "AssetLoader.hpp"
 #include "AssetRef.hpp"
+#include <core/Assert.hpp>
+#include <core/BinaryStream.hpp>
 #include <core/ULID.hpp>
 
 #include <memory>
-#include <shared_mutex>
+#include <mutex>
 #include <string>
 
 namespace apollo::rdr {
@@ -37,7 +40,8 @@ namespace apollo {
 		ULID m_Id;
 		std::string m_Name;
 		std::string m_FilePath;
-		uint32 m_Offset = 0;
+		uint64 m_Offset = 0; /*!< Where the asset data starts in m_FilePath */
+		uint64 m_Size = 0;	 /*!< Size of the asset data. 0 means up to the end of the file */
 		EAssetType m_Type = EAssetType::Invalid;
 	};
 
@@ -131,13 +135,13 @@ namespace apollo {
 		AssetRef<A> AddTempAsset(Args&&... args) requires(std::constructible_from<A, Args...>)
 		{
 			A* ptr = new A{ std::forward<Args>(args)... };
-			m_Cache.emplace(ptr->GetId(), ptr);
+			m_Cache.Insert(ptr);
 			return AssetRef{ ptr };
 		}
 
 		/** \brief Retrieves the metadata for a given asset ID. Returns nullptr if the asset wasn't
 		 * found in the bank */
-		[[nodiscard]] APOLLO_API const AssetMetadata* GetAssetMetadata(
+		[[nodiscard]] virtual APOLLO_API const AssetMetadata* GetAssetMetadata(
 			const ULID& id) const noexcept;
 
 		/**
@@ -181,8 +185,8 @@ namespace apollo {
 		virtual const AssetTypeInfo& GetTypeInfo(EAssetType type) const = 0;
 
 		ULIDMap<AssetMetadata> m_MetadataBank;
-		std::shared_mutex m_Mutex;
-		ULIDMap<IAsset*> m_Cache;
+		std::mutex m_Mutex; /*!< Guards the unload queue */
+		AssetCache m_Cache;
 
 		std::string m_AssetsPath;
 		AssetLoader m_Loader;
@@ -222,4 +226,57 @@ namespace apollo::json {
 		return true;
 	}
 	/** @} */
-} // namespace apollo::json
\ No newline at end of file
+} // namespace apollo::json
+
+namespace apollo {
+	/**
+	 * \brief Asset references are stored as the ULID of the asset, null for empty references.
+	 * Reading a reference requests the asset from the asset manager.
+	 */
+	template <class A>
+	requires(
+		std::is_base_of_v<IAsset, A>&& A::AssetType > EAssetType::Invalid &&
+		A::AssetType < EAssetType::NTypes) struct BinaryCodec<AssetRef<A>>
+	{
+		static void Write(BinaryWriter& out, const AssetRef<A>& ref)
+		{
+			out.Write(ref ? ref->GetId() : ULID{});
+		}
+
+		[[nodiscard]] static bool Read(BinaryReader& in, AssetRef<A>& out_ref)
+		{
+			ULID id;
+			if (!in.Read(id))
+				return false;
+			if (!id)
+			{
+				out_ref = {};
+				return true;
+			}
+			auto* assetManager = IAssetManager::GetInstance();
+			APOLLO_ASSERT(assetManager, "Asset manager has not been initialized");
+			// unknown assets leave the reference empty, without failing the rest of the data
+			out_ref = assetManager->template GetAsset<A>(id);
+			return true;
+		}
+
+		/// Converts the ULID without loading the asset
+		[[nodiscard]] static bool FromJson(BinaryWriter& out, const nlohmann::json& value)
+		{
+			ULID id;
+			if (!id.FromJson(value))
+				return false;
+			out.Write(id);
+			return true;
+		}
+
+		[[nodiscard]] static bool ToJson(BinaryReader& in, nlohmann::json& out_value)
+		{
+			ULID id;
+			if (!in.Read(id))
+				return false;
+			id.ToJson(out_value);
+			return true;
+		}
+	};
+} // namespace apollo
\ No newline at end of file
@@ -0,0 +1,344 @@
+#include "AssetPack.hpp"
+#include <algorithm>
+#include <core/Errno.hpp>
+#include <core/Log.hpp>
+#include <core/NumConv.hpp>
+#include <core/ULIDFormatter.hpp>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+	constexpr uint64 AlignUp(uint64 value, uint64 alignment) noexcept
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	/// Checks that [offset, offset + size) lies within [0, total), without overflowing
+	constexpr bool IsInRange(uint64 offset, uint64 size, uint64 total) noexcept
+	{
+		return offset <= total && size <= total - offset;
+	}
+
+	/// Maps the whole file at \p path in memory, read-only
+	const std::byte* MapFile(
+		const std::string& path,
+		uint64& out_size,
+		[[maybe_unused]] void*& out_file,
+		[[maybe_unused]] void*& out_mapping)
+	{
+#ifdef _WIN32
+		HANDLE file = CreateFileA(
+			path.c_str(),
+			GENERIC_READ,
+			FILE_SHARE_READ,
+			nullptr,
+			OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL,
+			nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			APOLLO_LOG_ERROR("Failed to open asset pack {}: error {}", path, GetLastError());
+			return nullptr;
+		}
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || !size.QuadPart)
+		{
+			APOLLO_LOG_ERROR("Failed to open asset pack {}: invalid file size", path);
+			CloseHandle(file);
+			return nullptr;
+		}
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+		if (!data)
+		{
+			APOLLO_LOG_ERROR("Failed to map asset pack {}: error {}", path, GetLastError());
+			if (mapping)
+				CloseHandle(mapping);
+			CloseHandle(file);
+			return nullptr;
+		}
+		out_size = size.QuadPart;
+		out_file = file;
+		out_mapping = mapping;
+		return static_cast<const std::byte*>(data);
+#else
+		const int fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+		{
+			APOLLO_LOG_ERROR(
+				"Failed to open asset pack {}: {}",
+				path,
+				apollo::GetErrnoMessage(errno));
+			return nullptr;
+		}
+		struct stat info;
+		if (fstat(fd, &info) || !info.st_size)
+		{
+			APOLLO_LOG_ERROR("Failed to open asset pack {}: invalid file size", path);
+			close(fd);
+			return nullptr;
+		}
+		void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		// the mapping keeps its own reference to the file
+		close(fd);
+		if (data == MAP_FAILED)
+		{
+			APOLLO_LOG_ERROR(
+				"Failed to map asset pack {}: {}",
+				path,
+				apollo::GetErrnoMessage(errno));
+			return nullptr;
+		}
+		out_size = info.st_size;
+		return static_cast<const std::byte*>(data);
+#endif
+	}
+
+	template <class T>
+	bool WriteValue(std::ofstream& out, const T& value)
+	{
+		return bool(out.write(reinterpret_cast<const char*>(&value), sizeof(T)));
+	}
+} // namespace
+
+namespace apollo {
+	bool AssetPack::Open(const std::string& path)
+	{
+		Close();
+		void* file = nullptr;
+		void* mapping = nullptr;
+		m_Data = MapFile(path, m_Size, file, mapping);
+		if (!m_Data)
+			return false;
+
+#ifdef _WIN32
+		m_File = file;
+		m_Mapping = mapping;
+#endif
+		m_Path = path;
+		if (Validate())
+			return true;
+
+		Close();
+		return false;
+	}
+
+	bool AssetPack::Validate()
+	{
+		AssetPackHeader header;
+		if (m_Size < sizeof(header))
+		{
+			APOLLO_LOG_ERROR("Asset pack {} is too small", m_Path);
+			return false;
+		}
+		std::memcpy(&header, m_Data, sizeof(header));
+		if (header.m_Magic != AssetPackHeader::Magic)
+		{
+			APOLLO_LOG_ERROR("{} is not an asset pack", m_Path);
+			return false;
+		}
+		if (header.m_Version != AssetPackHeader::CurrentVersion)
+		{
+			APOLLO_LOG_ERROR(
+				"Asset pack {} has version {}, expected {}",
+				m_Path,
+				header.m_Version,
+				AssetPackHeader::CurrentVersion);
+			return false;
+		}
+
+		const uint64 entriesSize = uint64(header.m_NumEntries) * sizeof(AssetPackEntry);
+		if (header.m_EntriesOffset % alignof(AssetPackEntry) ||
+			!IsInRange(header.m_EntriesOffset, entriesSize, m_Size) ||
+			!IsInRange(header.m_StringTableOffset, header.m_StringTableSize, m_Size))
+		{
+			APOLLO_LOG_ERROR("Asset pack {} is corrupted: invalid table offsets", m_Path);
+			return false;
+		}
+
+		m_Entries = reinterpret_cast<const AssetPackEntry*>(m_Data + header.m_EntriesOffset);
+		m_NumEntries = header.m_NumEntries;
+		m_StringTable = reinterpret_cast<const char*>(m_Data + header.m_StringTableOffset);
+
+		for (uint32 i = 0; i < m_NumEntries; ++i)
+		{
+			const AssetPackEntry& entry = m_Entries[i];
+			if (!IsInRange(entry.m_Offset, entry.m_Size, m_Size) ||
+				uint64(entry.m_NameOffset) + entry.m_NameLength > header.m_StringTableSize ||
+				entry.m_Type <= EAssetType::Invalid || entry.m_Type >= EAssetType::NTypes)
+			{
+				APOLLO_LOG_ERROR(
+					"Asset pack {} is corrupted: invalid entry {}",
+					m_Path,
+					entry.m_Id);
+				return false;
+			}
+			if (i && !(m_Entries[i - 1].m_Id < entry.m_Id))
+			{
+				APOLLO_LOG_ERROR("Asset pack {} is corrupted: entries aren't sorted", m_Path);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void AssetPack::Close() noexcept
+	{
+		if (!m_Data)
+			return;
+
+#ifdef _WIN32
+		UnmapViewOfFile(m_Data);
+		CloseHandle(m_Mapping);
+		CloseHandle(m_File);
+		m_File = m_Mapping = nullptr;
+#else
+		munmap(const_cast<std::byte*>(m_Data), m_Size);
+#endif
+		m_Data = nullptr;
+		m_Size = 0;
+		m_Entries = nullptr;
+		m_NumEntries = 0;
+		m_StringTable = nullptr;
+		m_Path.clear();
+	}
+
+	const AssetPackEntry* AssetPack::FindEntry(const ULID& id) const noexcept
+	{
+		const AssetPackEntry* const end = m_Entries + m_NumEntries;
+		const AssetPackEntry* const it = std::lower_bound(
+			m_Entries,
+			end,
+			id,
+			[](const AssetPackEntry& entry, const ULID& id)
+			{
+				return entry.m_Id < id;
+			});
+		return (it != end && it->m_Id == id) ? it : nullptr;
+	}
+
+	void AssetPack::Swap(AssetPack& other) noexcept
+	{
+		std::swap(m_Path, other.m_Path);
+		std::swap(m_Data, other.m_Data);
+		std::swap(m_Size, other.m_Size);
+		std::swap(m_Entries, other.m_Entries);
+		std::swap(m_NumEntries, other.m_NumEntries);
+		std::swap(m_StringTable, other.m_StringTable);
+#ifdef _WIN32
+		std::swap(m_File, other.m_File);
+		std::swap(m_Mapping, other.m_Mapping);
+#endif
+	}
+
+	void AssetPackWriter::AddAsset(
+		const ULID& id,
+		EAssetType type,
+		std::string_view name,
+		std::span<const std::byte> data)
+	{
+		m_Assets.emplace_back(
+			Item{
+				.m_Id = id,
+				.m_Type = type,
+				.m_Name = std::string{ name },
+				.m_Data = std::vector<std::byte>{ data.begin(), data.end() },
+			});
+	}
+
+	bool AssetPackWriter::Write(const std::string& path)
+	{
+		std::sort(
+			m_Assets.begin(),
+			m_Assets.end(),
+			[](const Item& lhs, const Item& rhs)
+			{
+				return lhs.m_Id < rhs.m_Id;
+			});
+		const auto duplicate = std::adjacent_find(
+			m_Assets.begin(),
+			m_Assets.end(),
+			[](const Item& lhs, const Item& rhs)
+			{
+				return lhs.m_Id == rhs.m_Id;
+			});
+		if (duplicate != m_Assets.end())
+		{
+			APOLLO_LOG_ERROR("Asset {} was added to the pack more than once", duplicate->m_Id);
+			return false;
+		}
+
+		AssetPackHeader header;
+		header.m_NumEntries = NumCast<uint32>(m_Assets.size());
+		header.m_EntriesOffset = sizeof(AssetPackHeader);
+		header.m_StringTableOffset = header.m_EntriesOffset +
+									 m_Assets.size() * sizeof(AssetPackEntry);
+
+		std::vector<AssetPackEntry> entries;
+		entries.reserve(m_Assets.size());
+		std::string stringTable;
+		for (const Item& item : m_Assets)
+		{
+			entries.emplace_back(
+				AssetPackEntry{
+					.m_Id = item.m_Id,
+					.m_Size = item.m_Data.size(),
+					.m_NameOffset = NumCast<uint32>(stringTable.size()),
+					.m_NameLength = NumCast<uint32>(item.m_Name.size()),
+					.m_Type = item.m_Type,
+				});
+			stringTable += item.m_Name;
+		}
+		header.m_StringTableSize = NumCast<uint32>(stringTable.size());
+
+		uint64 offset = header.m_StringTableOffset + stringTable.size();
+		for (AssetPackEntry& entry : entries)
+		{
+			offset = AlignUp(offset, AssetPack::DataAlignment);
+			entry.m_Offset = offset;
+			offset += entry.m_Size;
+		}
+
+		std::ofstream out{ path, std::ios::binary | std::ios::trunc };
+		if (!out.is_open())
+		{
+			APOLLO_LOG_ERROR("Failed to open {} for writing: {}", path, GetErrnoMessage(errno));
+			return false;
+		}
+
+		bool ok = WriteValue(out, header);
+		ok = ok && out.write(
+					   reinterpret_cast<const char*>(entries.data()),
+					   entries.size() * sizeof(AssetPackEntry));
+		ok = ok && out.write(stringTable.data(), stringTable.size());
+
+		constexpr char zeros[AssetPack::DataAlignment] = {};
+		uint64 pos = header.m_StringTableOffset + stringTable.size();
+		for (size_t i = 0; ok && i < entries.size(); ++i)
+		{
+			ok = bool(out.write(zeros, entries[i].m_Offset - pos));
+			ok = ok && out.write(
+						   reinterpret_cast<const char*>(m_Assets[i].m_Data.data()),
+						   m_Assets[i].m_Data.size());
+			pos = entries[i].m_Offset + entries[i].m_Size;
+		}
+
+		if (!ok)
+		{
+			APOLLO_LOG_ERROR("Failed to write asset pack {}: {}", path, GetErrnoMessage(errno));
+			return false;
+		}
+		return true;
+	}
+} // namespace apollo
\ No newline at end of file
@@ -0,0 +1,201 @@
+#pragma once
+
+/** \file AssetPack.hpp
+ * \brief Binary container for cooked assets
+ */
+
+#include <PCH.hpp>
+
+#include "Asset.hpp"
+#include <core/ULID.hpp>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace apollo {
+	/**
+	 * \brief Header found at the very beginning of an asset pack.
+	 * \details A pack is laid out as follows:
+	 * - The header
+	 * - The table of contents: an array of AssetPackEntry objects, sorted by ULID
+	 * - The string table, which holds the asset names
+	 * - The asset data blobs, each of them aligned on AssetPack::DataAlignment bytes
+	 *
+	 * All offsets are relative to the beginning of the file.
+	 */
+	struct AssetPackHeader
+	{
+		static constexpr uint32 Magic = 'A' | ('P' << 8) | ('A' << 16) | ('K' << 24);
+		static constexpr uint32 CurrentVersion = 1;
+
+		uint32 m_Magic = Magic;
+		uint32 m_Version = CurrentVersion;
+		uint32 m_NumEntries = 0;
+		uint32 m_StringTableSize = 0;
+		uint64 m_EntriesOffset = 0;
+		uint64 m_StringTableOffset = 0;
+	};
+
+	/// Fixed size table of contents entry, describing a single asset in the pack
+	struct AssetPackEntry
+	{
+		ULID m_Id;
+		uint64 m_Offset = 0;
+		uint64 m_Size = 0;
+		uint32 m_NameOffset = 0; /*!< Offset of the name, relative to the string table */
+		uint32 m_NameLength = 0;
+		EAssetType m_Type = EAssetType::Invalid;
+		uint8 m_Padding[7] = {};
+	};
+
+	static_assert(sizeof(AssetPackHeader) == 32);
+	static_assert(sizeof(AssetPackEntry) == 48);
+	static_assert(std::is_trivially_copyable_v<AssetPackEntry>);
+
+	/** \name Cooked asset formats
+	 * \brief Headers written at the beginning of cooked asset blobs. Types which aren't listed
+	 * here are stored in their source format.
+	 * @{ */
+
+	/// Followed by the raw pixel data, ready to be copied into a transfer buffer
+	struct CookedTextureHeader
+	{
+		uint32 m_Width = 0;
+		uint32 m_Height = 0;
+		int32 m_Format = -1; /*!< rdr::EPixelFormat value */
+		uint32 m_PixelSize = 0;
+	};
+
+	/// Followed by m_NumVertices rdr::Vertex3d objects, then m_NumIndices 32-bit indices
+	struct CookedMeshHeader
+	{
+		uint32 m_NumVertices = 0;
+		uint32 m_NumIndices = 0;
+	};
+
+	/// Followed by the entry point name, then by the serialized Slang module
+	struct CookedShaderHeader
+	{
+		uint32 m_EntryPointLength = 0;
+		uint32 m_ModuleSize = 0;
+	};
+	/** @} */
+
+	/**
+	 * \brief Read-only view of an asset pack file.
+	 * \details The whole file is memory mapped: nothing is read until the data actually gets
+	 * accessed, and asset blobs can be uploaded straight from the mapping without intermediate
+	 * copies.
+	 */
+	class AssetPack
+	{
+	public:
+		/// Alignment of every data blob in the file
+		static constexpr uint64 DataAlignment = 64;
+
+		AssetPack() = default;
+		AssetPack(const AssetPack&) = delete;
+		AssetPack(AssetPack&& other) noexcept { Swap(other); }
+		AssetPack& operator=(const AssetPack&) = delete;
+		AssetPack& operator=(AssetPack&& other) noexcept
+		{
+			Swap(other);
+			return *this;
+		}
+		~AssetPack() { Close(); }
+
+		/**
+		 * \brief Maps the file at \p path, and validates its header and table of contents.
+		 * \returns Whether the pack was opened successfully. If it wasn't, the errors are logged.
+		 */
+		APOLLO_API bool Open(const std::string& path);
+		APOLLO_API void Close() noexcept;
+
+		[[nodiscard]] bool IsOpen() const noexcept { return m_Data; }
+		[[nodiscard]] const std::string& GetPath() const noexcept { return m_Path; }
+		[[nodiscard]] uint64 GetSize() const noexcept { return m_Size; }
+
+		[[nodiscard]] std::span<const AssetPackEntry> GetEntries() const noexcept
+		{
+			return { m_Entries, m_NumEntries };
+		}
+
+		/**
+		 * \brief Looks up an asset with a binary search over the table of contents
+		 * \returns The corresponding entry, or nullptr if the asset isn't in the pack
+		 */
+		[[nodiscard]] APOLLO_API const AssetPackEntry* FindEntry(const ULID& id) const noexcept;
+
+		/** \name GetData
+		 * \brief Returns a view of an asset's data, directly in the mapped file
+		 * @{ */
+		[[nodiscard]] std::span<const std::byte> GetData(const AssetPackEntry& entry) const noexcept
+		{
+			return GetData(entry.m_Offset, entry.m_Size);
+		}
+		[[nodiscard]] std::span<const std::byte> GetData(uint64 offset, uint64 size) const noexcept
+		{
+			return { m_Data + offset, size };
+		}
+		/** @} */
+
+		[[nodiscard]] std::string_view GetName(const AssetPackEntry& entry) const noexcept
+		{
+			return { m_StringTable + entry.m_NameOffset, entry.m_NameLength };
+		}
+
+		APOLLO_API void Swap(AssetPack& other) noexcept;
+
+	private:
+		bool Validate();
+
+		std::string m_Path;
+		const std::byte* m_Data = nullptr;
+		uint64 m_Size = 0;
+		const AssetPackEntry* m_Entries = nullptr;
+		uint32 m_NumEntries = 0;
+		const char* m_StringTable = nullptr;
+#ifdef _WIN32
+		void* m_File = nullptr;
+		void* m_Mapping = nullptr;
+#endif
+	};
+
+	/**
+	 * \brief Builds asset pack files
+	 */
+	class AssetPackWriter
+	{
+	public:
+		/**
+		 * \brief Adds an asset to the pack. The data is copied.
+		 */
+		APOLLO_API void AddAsset(
+			const ULID& id,
+			EAssetType type,
+			std::string_view name,
+			std::span<const std::byte> data);
+
+		[[nodiscard]] uint32 GetNumAssets() const noexcept
+		{
+			return static_cast<uint32>(m_Assets.size());
+		}
+
+		/**
+		 * \brief Writes all assets added so far to \p path
+		 * \returns false if the file couldn't be written, or if an ID was added more than once
+		 */
+		APOLLO_API bool Write(const std::string& path);
+
+	private:
+		struct Item
+		{
+			ULID m_Id;
+			EAssetType m_Type;
+			std::string m_Name;
+			std::vector<std::byte> m_Data;
+		};
+		std::vector<Item> m_Assets;
+	};
+} // namespace apollo
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include "GameAssetManager.hpp"
+#include <core/Log.hpp>
+#include <core/ULIDFormatter.hpp>
+#include <filesystem>
+
+namespace apollo {
+	GameAssetManager::GameAssetManager(
+		const std::string& path,
+		rdr::GPUDevice& device,
+		mt::ThreadPool& threadPool)
+		: IAssetManager(path, device, threadPool)
+	{}
+
+	bool GameAssetManager::ImportMetadataBank()
+	{
+		const std::string indexPath = (std::filesystem::path{ m_AssetsPath } /
+									   AssetIndex::FileName)
+										  .string();
+		APOLLO_LOG_INFO("Loading asset index {}", indexPath);
+		return m_Index.Load(indexPath);
+	}
+
+	const AssetMetadata* GameAssetManager::GetAssetMetadata(const ULID& id) const noexcept
+	{
+		{
+			std::shared_lock lock{ m_MetadataMutex };
+			if (const auto it = m_ResolvedMetadata.find(id); it != m_ResolvedMetadata.end())
+				return it->second.get();
+		}
+
+		const AssetIndexRecord* const record = m_Index.FindRecord(id);
+		if (!record)
+		{
+			APOLLO_LOG_ERROR("Couldn't find metadata for asset {}", id);
+			return nullptr;
+		}
+
+		auto metadata = std::make_unique<AssetMetadata>(
+			m_Index.MakeMetadata(*record, m_AssetsPath));
+		std::unique_lock lock{ m_MetadataMutex };
+		// another thread may have beaten us to it, in which case its object is kept
+		return m_ResolvedMetadata.try_emplace(id, std::move(metadata)).first->second.get();
+	}
+} // namespace apollo
\ No newline at end of file
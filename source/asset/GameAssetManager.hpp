@@ -0,0 +1,48 @@
+#pragma once
+
+/** \file GameAssetManager.hpp */
+
+#include <PCH.hpp>
+
+#include "AssetIndex.hpp"
+#include "AssetManager.hpp"
+#include <shared_mutex>
+
+namespace apollo {
+	/**
+	 * \brief Base class for the asset managers used by shipped games
+	 * \details Instead of parsing `metadata.csv`, the metadata bank is a precompiled
+	 * AssetIndex, which lives at `<assetsPath>/metadata.idx`. Importing it is a single file read,
+	 * and metadata objects are only created for assets which actually get requested.
+	 * Derived classes provide the loaders through GetTypeInfo.
+	 */
+	class GameAssetManager : public IAssetManager
+	{
+	public:
+		APOLLO_API GameAssetManager(
+			const std::string& path,
+			rdr::GPUDevice& device,
+			mt::ThreadPool& threadPool);
+
+		/**
+		 * \brief Loads the metadata index
+		 */
+		APOLLO_API bool ImportMetadataBank() override;
+
+		/**
+		 * \brief Looks up the asset in the index, and creates its metadata on first access
+		 */
+		[[nodiscard]] APOLLO_API const AssetMetadata* GetAssetMetadata(
+			const ULID& id) const noexcept override;
+
+		[[nodiscard]] const AssetIndex& GetIndex() const noexcept { return m_Index; }
+
+	protected:
+		AssetIndex m_Index;
+
+	private:
+		mutable std::shared_mutex m_MetadataMutex;
+		// the metadata objects are boxed, as pointers to them must survive later insertions
+		mutable ULIDMap<std::unique_ptr<AssetMetadata>> m_ResolvedMetadata;
+	};
+} // namespace apollo
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+
+/** \file MetadataCsv.hpp
+ * \brief Parsing of the project's asset metadata file
+ */
+
+#include <PCH.hpp>
+
+#include "AssetManager.hpp"
+
+namespace apollo {
+	/**
+	 * \brief Loads all asset metadata from `<assetRoot>/metadata.csv`
+	 * \details Each line of the file is formatted as `ULID,type,name,path`, the first line being
+	 * the header. Asset paths are relative to \p assetRoot, and get converted to full paths.
+	 * Invalid lines are skipped, and so are IDs which already are in \p out_bank.
+	 * \returns false if the file couldn't be read
+	 */
+	[[nodiscard]] APOLLO_API bool ImportMetadataCsv(
+		const std::string& assetRoot,
+		ULIDMap<AssetMetadata>& out_bank);
+} // namespace apollo
\ No newline at end of file
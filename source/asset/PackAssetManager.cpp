@@ -0,0 +1,336 @@
+#include "PackAssetManager.hpp"
+#include "Scene.hpp"
+#include "SceneFile.hpp"
+#include <SDL3/SDL_gpu.h>
+#include <core/App.hpp>
+#include <core/Assert.hpp>
+#include <core/JsonStream.hpp>
+#include <core/Log.hpp>
+#include <core/NumConv.hpp>
+#include <core/ULIDFormatter.hpp>
+#include <cstring>
+#include <ecs/ComponentRegistry.hpp>
+#include <filesystem>
+#include <rendering/Context.hpp>
+#include <rendering/Material.hpp>
+#include <rendering/Mesh.hpp>
+#include <rendering/Shader.hpp>
+#include <rendering/Texture.hpp>
+#include <rendering/UploadHeap.hpp>
+#include <rendering/VertexTypes.hpp>
+#include <rendering/text/FontAtlas.hpp>
+#include <systems/SceneLoadingSystem.hpp>
+#include <tools/ShaderCompiler.hpp>
+
+namespace {
+	/// Views the data of an asset in the pack mapped by the current manager
+	std::span<const std::byte> GetAssetData(const apollo::AssetMetadata& metadata)
+	{
+		auto* const manager = static_cast<apollo::PackAssetManager*>(
+			apollo::IAssetManager::GetInstance());
+		return manager->GetAssetData(metadata);
+	}
+
+	/// Views the data of an asset stored in its source format, which is text
+	std::string_view GetSourceText(const apollo::AssetMetadata& metadata)
+	{
+		const std::span data = GetAssetData(metadata);
+		return { reinterpret_cast<const char*>(data.data()), data.size() };
+	}
+
+	/// Retrieves the data of a cooked asset, and reads the header at its beginning
+	template <class Header>
+	std::span<const std::byte> GetCookedData(
+		Header& out_header,
+		const apollo::AssetMetadata& metadata)
+	{
+		const std::span data = GetAssetData(metadata);
+		if (data.size() < sizeof(Header))
+		{
+			APOLLO_LOG_ERROR(
+				"Failed to load {}({}): cooked data is too small",
+				metadata.m_Name,
+				metadata.m_Id);
+			return {};
+		}
+		std::memcpy(&out_header, data.data(), sizeof(Header));
+		return data.subspan(sizeof(Header));
+	}
+
+	template <class ShaderType>
+	bool LoadShader(ShaderType& out_shader, const apollo::AssetMetadata& metadata)
+	{
+		using namespace apollo;
+		CookedShaderHeader header;
+		const std::span data = GetCookedData(header, metadata);
+		if (!header.m_ModuleSize ||
+			data.size() != uint64(header.m_EntryPointLength) + header.m_ModuleSize)
+		{
+			APOLLO_LOG_ERROR(
+				"Failed to load shader {}({}): corrupted data",
+				metadata.m_Name,
+				metadata.m_Id);
+			return false;
+		}
+
+		const std::string entryPoint{
+			reinterpret_cast<const char*>(data.data()),
+			header.m_EntryPointLength,
+		};
+		using Blob = rdr::ShaderCompiler::Blob;
+		Slang::ComPtr code{ Blob::Allocate(
+			header.m_ModuleSize,
+			data.data() + header.m_EntryPointLength) };
+
+		Slang::ComPtr<slang::IBlob> diagnostics;
+		slang::IModule* const module = App::GetShaderCompiler().LoadFromIntermediate(
+			metadata.m_Name.c_str(),
+			code,
+			nullptr,
+			diagnostics.writeRef());
+		if (!module)
+		{
+			APOLLO_LOG_ERROR(
+				"Failed to load shader {}\n{:.{}}",
+				metadata.m_Name,
+				static_cast<const char*>(diagnostics->getBufferPointer()),
+				diagnostics->getBufferSize());
+			return false;
+		}
+		out_shader = ShaderType{ metadata.m_Id, *module, entryPoint.c_str() };
+		return out_shader;
+	}
+} // namespace
+
+namespace apollo {
+	template <>
+	AssetLoadTask PackAssetHelper<rdr::Texture2D>::LoadAsync(
+		IAsset& out_asset,
+		const AssetMetadata& metadata)
+	{
+		CookedTextureHeader header;
+		const std::span pixels = GetCookedData(header, metadata);
+		if (pixels.size() != uint64(header.m_Width) * header.m_Height * header.m_PixelSize ||
+			pixels.empty())
+		{
+			APOLLO_LOG_ERROR(
+				"Failed to load texture {}({}): corrupted data",
+				metadata.m_Name,
+				metadata.m_Id);
+			co_return false;
+		}
+
+		rdr::Texture2D& texture = static_cast<rdr::Texture2D&>(out_asset);
+		texture = rdr::Texture2D(
+			metadata.m_Id,
+			rdr::TextureSettings{
+				.m_Width = header.m_Width,
+				.m_Height = header.m_Height,
+				.m_Format = rdr::EPixelFormat(header.m_Format),
+				.m_Usage = rdr::ETextureUsageFlags::Sampled,
+			});
+		DEBUG_CHECK(texture.GetHandle())
+		{
+			co_return false;
+		}
+
+		rdr::UploadHeap* const heap = rdr::UploadHeap::GetThreadHeap();
+		const rdr::UploadHeap::Allocation upload = heap->Map(
+			NumCast<uint32>(pixels.size()),
+			rdr::UploadHeap::TextureAlignment);
+		std::memcpy(upload.m_Ptr, pixels.data(), pixels.size());
+
+		const SDL_GPUTextureRegion region{
+			.texture = texture.GetHandle(),
+			.w = header.m_Width,
+			.h = header.m_Height,
+			.d = 1,
+		};
+		heap->UploadToTexture(AssetLoader::GetCurrentCopyPass(), upload, region);
+
+		co_return true;
+	}
+
+	template <>
+	AssetLoadTask PackAssetHelper<rdr::Mesh>::LoadAsync(
+		IAsset& out_asset,
+		const AssetMetadata& metadata)
+	{
+		CookedMeshHeader header;
+		const std::span data = GetCookedData(header, metadata);
+		const uint64 vertSize = uint64(header.m_NumVertices) * sizeof(rdr::Vertex3d);
+		const uint64 indSize = uint64(header.m_NumIndices) * sizeof(uint32);
+		if (!vertSize || data.size() != vertSize + indSize)
+		{
+			APOLLO_LOG_ERROR(
+				"Failed to load mesh {}({}): corrupted data",
+				metadata.m_Name,
+				metadata.m_Id);
+			co_return false;
+		}
+
+		rdr::Mesh& mesh = static_cast<rdr::Mesh&>(out_asset);
+		mesh.m_NumVertices = header.m_NumVertices;
+		mesh.m_NumIndices = header.m_NumIndices;
+		mesh.m_VBuffer = rdr::Buffer(rdr::EBufferFlags::Vertex, NumCast<uint32>(vertSize));
+		mesh.m_IBuffer = rdr::Buffer(rdr::EBufferFlags::Index, NumCast<uint32>(indSize));
+
+		auto* const copyPass = AssetLoader::GetCurrentCopyPass();
+		mesh.m_VBuffer.UploadData(copyPass, data.data(), NumCast<uint32>(vertSize));
+		mesh.m_IBuffer.UploadData(copyPass, data.data() + vertSize, NumCast<uint32>(indSize));
+
+		co_return true;
+	}
+
+	template <>
+	AssetLoadTask PackAssetHelper<rdr::Material>::LoadAsync(
+		IAsset& out_asset,
+		const AssetMetadata& metadata)
+	{
+		const std::string_view text = GetSourceText(metadata);
+		return static_cast<rdr::Material&>(out_asset)
+			.LoadFromJson(nlohmann::json::parse(text, nullptr, false), metadata);
+	}
+
+	template <>
+	AssetLoadTask PackAssetHelper<rdr::MaterialInstance>::LoadAsync(
+		IAsset& out_asset,
+		const AssetMetadata& metadata)
+	{
+		const std::string_view text = GetSourceText(metadata);
+		return static_cast<rdr::MaterialInstance&>(out_asset)
+			.LoadFromJson(nlohmann::json::parse(text, nullptr, false), metadata);
+	}
+
+	template <>
+	AssetLoadTask PackAssetHelper<rdr::txt::FontAtlas>::LoadAsync(
+		IAsset& out_asset,
+		const AssetMetadata& metadata)
+	{
+		auto& atlas = static_cast<rdr::txt::FontAtlas&>(out_asset);
+		// the pre-rendered texture and glyphs an atlas may refer to aren't cooked: the atlas is
+		// always generated from the font file
+		json::StreamParser parser;
+		parser.StreamArray(
+			"glyphs",
+			[](const nlohmann::json&)
+			{
+				return true;
+			});
+		if (!parser.Parse(GetSourceText(metadata)))
+		{
+			APOLLO_LOG_ERROR(
+				"Failed to load font {}({}) from JSON",
+				metadata.m_Name,
+				metadata.m_Id);
+			co_return false;
+		}
+		if (!atlas.LoadFace(parser.GetRoot()))
+			co_return false;
+		atlas.GenerateTexture(parser.GetRoot());
+		co_return true;
+	}
+
+	template <>
+	AssetLoadTask PackAssetHelper<Scene>::LoadAsync(
+		IAsset& out_asset,
+		const AssetMetadata& metadata)
+	{
+		Scene& scene = static_cast<Scene&>(out_asset);
+		entt::registry& world = SceneLoadingSystem::GetTempWorld();
+		const auto& registry = *ecs::ComponentRegistry::GetInstance();
+
+		// scenes are stored in their source format, either binary or JSON
+		const std::span data = GetAssetData(metadata);
+		if (IsBinaryScene(data))
+			co_return LoadBinaryScene(data, registry, world, scene.m_GameObjects);
+		if (!LoadJsonScene(GetSourceText(metadata), registry, world, scene.m_GameObjects))
+		{
+			APOLLO_LOG_ERROR("Failed to load scene {}({})", metadata.m_Name, metadata.m_Id);
+			co_return false;
+		}
+		co_return true;
+	}
+
+	template <>
+	AssetLoadTask PackAssetHelper<rdr::VertexShader>::LoadAsync(
+		IAsset& out_asset,
+		const AssetMetadata& metadata)
+	{
+		co_return LoadShader(static_cast<rdr::VertexShader&>(out_asset), metadata);
+	}
+
+	template <>
+	AssetLoadTask PackAssetHelper<rdr::FragmentShader>::LoadAsync(
+		IAsset& out_asset,
+		const AssetMetadata& metadata)
+	{
+		co_return LoadShader(static_cast<rdr::FragmentShader&>(out_asset), metadata);
+	}
+} // namespace apollo
+
+namespace {
+	template <apollo::Asset A>
+	consteval apollo::AssetTypeInfo CreateTypeInfo()
+	{
+		return apollo::AssetTypeInfo{
+			.m_Create = &apollo::ConstructAsset<A>,
+			.m_LoadFunc = &apollo::PackAssetHelper<A>::LoadAsync,
+		};
+	}
+
+	constexpr apollo::AssetTypeInfo g_TypeInfo[] = {
+		CreateTypeInfo<apollo::rdr::Texture2D>(),
+		CreateTypeInfo<apollo::rdr::VertexShader>(),
+		CreateTypeInfo<apollo::rdr::FragmentShader>(),
+		CreateTypeInfo<apollo::rdr::Material>(),
+		CreateTypeInfo<apollo::rdr::MaterialInstance>(),
+		CreateTypeInfo<apollo::rdr::Mesh>(),
+		CreateTypeInfo<apollo::rdr::txt::FontAtlas>(),
+		CreateTypeInfo<apollo::Scene>(),
+	};
+	static_assert(STATIC_ARRAY_SIZE(g_TypeInfo) == size_t(apollo::EAssetType::NTypes));
+} // namespace
+
+namespace apollo {
+	PackAssetManager::PackAssetManager(
+		const std::string& path,
+		rdr::GPUDevice& device,
+		mt::ThreadPool& threadPool)
+		: GameAssetManager(path, device, threadPool)
+	{}
+
+	bool PackAssetManager::ImportMetadataBank()
+	{
+		if (!GameAssetManager::ImportMetadataBank())
+			return false;
+
+		const std::string packPath = (std::filesystem::path{ m_AssetsPath } / PackFileName)
+										 .string();
+		APOLLO_LOG_INFO("Loading asset pack {}", packPath);
+		return m_Pack.Open(packPath);
+	}
+
+	std::span<const std::byte> PackAssetManager::GetAssetData(
+		const AssetMetadata& metadata) const noexcept
+	{
+		// the index isn't validated against the pack, so check without overflowing
+		const uint64 packSize = m_Pack.GetSize();
+		if (metadata.m_Offset > packSize || metadata.m_Size > packSize - metadata.m_Offset)
+		{
+			APOLLO_LOG_ERROR(
+				"Asset {}({}) isn't in the asset pack",
+				metadata.m_Name,
+				metadata.m_Id);
+			return {};
+		}
+		// a size of 0 means up to the end of the file
+		const uint64 size = metadata.m_Size ? metadata.m_Size : packSize - metadata.m_Offset;
+		return m_Pack.GetData(metadata.m_Offset, size);
+	}
+
+	const AssetTypeInfo& PackAssetManager::GetTypeInfo(EAssetType type) const
+	{
+		return g_TypeInfo[size_t(type)];
+	}
+} // namespace apollo
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+/** \file PackAssetManager.hpp */
+
+#include <PCH.hpp>
+
+#include "AssetPack.hpp"
+#include "GameAssetManager.hpp"
+
+namespace apollo {
+	/**
+	 * \brief Loaders for cooked assets, which read straight from the pack mapped by the current
+	 * PackAssetManager
+	 */
+	template <class A>
+	struct PackAssetHelper
+	{
+		static AssetLoadTask LoadAsync(IAsset& out_asset, const AssetMetadata& metadata);
+	};
+
+	/**
+	 * \brief Game asset manager, which loads cooked assets from a single pack file
+	 * \details The pack is expected to live at `<assetsPath>/assets.pak`, and is memory mapped
+	 * for as long as the manager exists. The metadata index written by the cooker alongside the
+	 * pack gives the location of each asset in the file. Texture, mesh and shader data is stored
+	 * in a GPU-ready form and gets uploaded directly from the mapping. The other asset types are
+	 * stored in their source format, and parsed with the same code as in the editor. Font atlases
+	 * are always generated from their font file, which isn't part of the pack.
+	 * \sa AssetPack, GameAssetManager
+	 */
+	class PackAssetManager : public GameAssetManager
+	{
+	public:
+		static constexpr const char PackFileName[] = "assets.pak";
+
+		APOLLO_API PackAssetManager(
+			const std::string& path,
+			rdr::GPUDevice& device,
+			mt::ThreadPool& threadPool);
+
+		/**
+		 * \brief Loads the metadata index, and opens the pack file
+		 */
+		APOLLO_API bool ImportMetadataBank() override;
+
+		/**
+		 * \brief Returns a view of an asset's data in the mapped pack file. The view is empty if
+		 * the metadata doesn't point inside the pack.
+		 */
+		[[nodiscard]] APOLLO_API std::span<const std::byte> GetAssetData(
+			const AssetMetadata& metadata) const noexcept;
+
+		[[nodiscard]] const AssetPack& GetPack() const noexcept { return m_Pack; }
+
+	protected:
+		APOLLO_API const AssetTypeInfo& GetTypeInfo(EAssetType type) const override;
+
+		AssetPack m_Pack;
+	};
+} // namespace apollo
\ No newline at end of file
@@ -31,7 +31,7 @@ namespace apollo {
 					[this](IAsset& temp)
 					{
 						Swap(static_cast<Scene&>(temp));
-						m_State = temp.GetState();
+						SetState(temp.GetState());
 					},
 				},
 			});
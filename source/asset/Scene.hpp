@@ -18,6 +18,9 @@ namespace apollo::editor {
 }
 
 namespace apollo {
+	class IAssetManager;
+	template <class>
+	struct PackAssetHelper;
 	namespace ecs {
 		struct ComponentInfo;
 	}
@@ -69,6 +72,7 @@ namespace apollo {
 
 	private:
 		friend struct editor::AssetHelper<Scene>;
+		friend struct PackAssetHelper<Scene>;
 		ULIDMap<GameObject> m_GameObjects;
 	};
-} // namespace apollo
+} // namespace apollo
\ No newline at end of file
@@ -0,0 +1,457 @@
+#include "SceneFile.hpp"
+#include <core/Assert.hpp>
+#include <core/BinaryStream.hpp>
+#include <core/Json.hpp>
+#include <core/JsonStream.hpp>
+#include <core/Log.hpp>
+#include <core/ULIDFormatter.hpp>
+#include <ecs/ComponentRegistry.hpp>
+
+namespace {
+	using apollo::BinaryReader;
+
+	struct SceneData
+	{
+		std::vector<apollo::ULID> m_Ids;
+		std::vector<std::string_view> m_Names;
+		uint32 m_NumColumns = 0;
+	};
+
+	struct Column
+	{
+		std::string_view m_Name;
+		std::vector<uint32> m_Objects;
+		BinaryReader m_Data{ {} };
+	};
+
+	bool ReadObjects(BinaryReader& reader, SceneData& out_scene)
+	{
+		apollo::SceneFileHeader header;
+		if (!reader.Read(header) || header.m_Magic != apollo::SceneFileHeader::Magic ||
+			header.m_Version != apollo::SceneFileHeader::CurrentVersion)
+		{
+			APOLLO_LOG_ERROR("Data is not a valid binary scene");
+			return false;
+		}
+		// each object takes at least an ID and a name length: check before allocating anything
+		const size_t objectSize = sizeof(apollo::ULID) + sizeof(uint32);
+		if (size_t(header.m_NumObjects) * objectSize > reader.GetRemaining())
+		{
+			APOLLO_LOG_ERROR("Binary scene is corrupted: invalid number of game objects");
+			return false;
+		}
+
+		out_scene.m_Ids.resize(header.m_NumObjects);
+		out_scene.m_Names.resize(header.m_NumObjects);
+		bool res = reader.Read(
+			out_scene.m_Ids.data(),
+			out_scene.m_Ids.size() * sizeof(apollo::ULID));
+		for (std::string_view& name : out_scene.m_Names)
+			res = res && reader.ReadString(name);
+		if (!res)
+		{
+			APOLLO_LOG_ERROR("Binary scene is corrupted: truncated game objects");
+			return false;
+		}
+		out_scene.m_NumColumns = header.m_NumColumns;
+		return true;
+	}
+
+	/**
+	 * \param columnIndex, lastColumn: Used to detect game objects which appear twice in the same
+	 * column. lastColumn holds, for each object, the index of the last column it was found in.
+	 */
+	bool ReadColumn(
+		BinaryReader& reader,
+		uint32 columnIndex,
+		std::vector<uint32>& lastColumn,
+		Column& out_column)
+	{
+		uint32 count = 0;
+		uint64 size = 0;
+		if (!reader.ReadString(out_column.m_Name) || !reader.Read(count) ||
+			size_t(count) * sizeof(uint32) > reader.GetRemaining())
+			return false;
+
+		out_column.m_Objects.resize(count);
+		if (!reader.Read(out_column.m_Objects.data(), count * sizeof(uint32)) ||
+			!reader.Read(size) || !reader.ReadBlock(size, out_column.m_Data))
+			return false;
+
+		for (const uint32 index : out_column.m_Objects)
+		{
+			if (index >= lastColumn.size() || lastColumn[index] == columnIndex)
+				return false;
+			lastColumn[index] = columnIndex;
+		}
+		return true;
+	}
+
+	/// Checks all columns which follow \p reader's position, without reading their data
+	bool ValidateColumns(BinaryReader reader, uint32 numColumns, uint32 numObjects)
+	{
+		Column column;
+		std::vector<uint32> lastColumn(numObjects, UINT32_MAX);
+		for (uint32 c = 0; c < numColumns; ++c)
+		{
+			if (!ReadColumn(reader, c, lastColumn, column))
+			{
+				APOLLO_LOG_ERROR("Binary scene is corrupted: invalid column {}", c);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool LoadGameObject(
+		apollo::GameObject& out_go,
+		entt::registry& world,
+		const nlohmann::json& json,
+		const apollo::ecs::ComponentRegistry& registry)
+	{
+		if (!apollo::json::Visit(out_go.m_Id, json, "id"))
+		{
+			APOLLO_LOG_ERROR("Failed to load game object: no valid ULID");
+			return false;
+		}
+		apollo::json::Visit(out_go.m_Name, json, "name");
+		nlohmann::json compJson;
+		if (!apollo::json::Visit(compJson, json, "components"))
+		{
+			APOLLO_LOG_ERROR("Failed to load game object {}: no components", out_go.m_Id);
+			return false;
+		}
+		if (!compJson.is_object())
+		{
+			APOLLO_LOG_ERROR(
+				"Failed to load game object {}: 'components' is not an object",
+				out_go.m_Id);
+			return false;
+		}
+		out_go.m_Entity = world.create();
+		out_go.m_Components.reserve(compJson.size());
+
+		for (auto it = compJson.begin(); it != compJson.end(); ++it)
+		{
+			std::string_view compName = it.key();
+			const apollo::ecs::ComponentInfo* info = registry.GetInfo(compName);
+			DEBUG_CHECK(info)
+			{
+				APOLLO_LOG_ERROR("Unknown component type: {}", compName);
+				continue;
+			}
+			if (!info->m_Deserialize(out_go.m_Entity, world, &it.value()))
+			{
+				APOLLO_LOG_ERROR(
+					"Component {} failed to load for GameObject {}",
+					compName,
+					out_go.m_Id);
+				continue;
+			}
+			out_go.m_Components.emplace_back(info);
+		}
+		return true;
+	}
+
+	/// Destroys the entities of game objects which were created before a scene failed to load
+	void DiscardGameObjects(
+		apollo::ULIDMap<apollo::GameObject>& objects,
+		entt::registry& world)
+	{
+		for (auto& [id, object] : objects)
+			world.destroy(object.m_Entity);
+		objects.clear();
+	}
+
+	template <class Source>
+	bool LoadJsonSceneFrom(
+		Source& source,
+		const apollo::ecs::ComponentRegistry& registry,
+		entt::registry& world,
+		apollo::ULIDMap<apollo::GameObject>& out_objects)
+	{
+		// game objects are loaded as they get parsed, the whole document is never held in memory
+		apollo::json::StreamParser parser;
+		apollo::ULIDMap<apollo::GameObject> objects;
+		apollo::GameObject object;
+		parser.StreamArray(
+			"gameObjects",
+			[&](const nlohmann::json& o)
+			{
+				if (LoadGameObject(object, world, o, registry))
+					objects.emplace(object.m_Id, std::move(object));
+				return true;
+			});
+		// objects are created before the end of the document is known to be valid: they must not
+		// be left behind in the world
+		if (!parser.Parse(source))
+		{
+			APOLLO_LOG_ERROR("Failed to parse scene as JSON");
+			DiscardGameObjects(objects, world);
+			return false;
+		}
+
+		nlohmann::json objectsJson;
+		if (!apollo::json::Visit(objectsJson, parser.GetRoot(), "gameObjects"))
+		{
+			DiscardGameObjects(objects, world);
+			return false;
+		}
+		if (!objectsJson.is_array())
+		{
+			APOLLO_LOG_ERROR("Failed to load game objects from JSON: not an array");
+			DiscardGameObjects(objects, world);
+			return false;
+		}
+
+		out_objects.reserve(out_objects.size() + objects.size());
+		for (auto& [id, loaded] : objects)
+			out_objects.emplace(id, std::move(loaded));
+		return true;
+	}
+} // namespace
+
+namespace apollo {
+	bool IsBinaryScene(std::span<const std::byte> data) noexcept
+	{
+		uint32 magic = 0;
+		return BinaryReader{ data }.Read(magic) && magic == SceneFileHeader::Magic;
+	}
+
+	bool LoadBinaryScene(
+		std::span<const std::byte> data,
+		const ecs::ComponentRegistry& registry,
+		entt::registry& world,
+		ULIDMap<GameObject>& out_objects)
+	{
+		BinaryReader reader{ data };
+		SceneData scene;
+		if (!ReadObjects(reader, scene))
+			return false;
+
+		// nothing may be added to the world if the scene is rejected, so the columns are all
+		// checked before creating anything
+		const uint32 numObjects = NumCast<uint32>(scene.m_Ids.size());
+		if (!ValidateColumns(reader, scene.m_NumColumns, numObjects))
+			return false;
+
+		std::vector<entt::entity> entities(numObjects);
+		world.create(entities.begin(), entities.end());
+
+		std::vector<GameObject> objects(numObjects);
+		for (uint32 i = 0; i < numObjects; ++i)
+		{
+			objects[i].m_Id = scene.m_Ids[i];
+			objects[i].m_Name = scene.m_Names[i];
+			objects[i].m_Entity = entities[i];
+		}
+
+		Column column;
+		std::vector<uint32> lastColumn(numObjects, UINT32_MAX);
+		std::vector<entt::entity> columnEntities;
+		for (uint32 c = 0; c < scene.m_NumColumns; ++c)
+		{
+			// already validated
+			const bool valid = ReadColumn(reader, c, lastColumn, column);
+			APOLLO_ASSERT(valid, "Column {} changed since it was validated", c);
+			const ecs::ComponentInfo* info = registry.GetInfo(column.m_Name);
+			if (!info)
+			{
+				APOLLO_LOG_ERROR("Unknown component type: {}", column.m_Name);
+				continue;
+			}
+			if (!info->m_LoadColumn)
+			{
+				APOLLO_LOG_ERROR("Component {} can't be loaded from binary data", column.m_Name);
+				continue;
+			}
+
+			columnEntities.clear();
+			for (const uint32 index : column.m_Objects)
+				columnEntities.emplace_back(entities[index]);
+			if (!info->m_LoadColumn(columnEntities, world, column.m_Data))
+			{
+				// column data is only checked while decoding it: what was created so far goes
+				APOLLO_LOG_ERROR(
+					"Binary scene is corrupted: invalid column of component {}",
+					column.m_Name);
+				world.destroy(entities.begin(), entities.end());
+				return false;
+			}
+			for (const uint32 index : column.m_Objects)
+				objects[index].m_Components.emplace_back(info);
+		}
+
+		out_objects.reserve(out_objects.size() + numObjects);
+		for (GameObject& object : objects)
+		{
+			const ULID id = object.m_Id;
+			out_objects.emplace(id, std::move(object));
+		}
+		return true;
+	}
+
+	bool LoadJsonScene(
+		std::istream& stream,
+		const ecs::ComponentRegistry& registry,
+		entt::registry& world,
+		ULIDMap<GameObject>& out_objects)
+	{
+		return LoadJsonSceneFrom(stream, registry, world, out_objects);
+	}
+
+	bool LoadJsonScene(
+		std::string_view str,
+		const ecs::ComponentRegistry& registry,
+		entt::registry& world,
+		ULIDMap<GameObject>& out_objects)
+	{
+		return LoadJsonSceneFrom(str, registry, world, out_objects);
+	}
+
+	bool SceneJsonToBinary(
+		const nlohmann::json& json,
+		const ecs::ComponentRegistry& registry,
+		std::vector<std::byte>& out_data)
+	{
+		const auto objectsIt = json.find("gameObjects");
+		if (objectsIt == json.end() || !objectsIt->is_array())
+		{
+			APOLLO_LOG_ERROR("Scene has no 'gameObjects' array");
+			return false;
+		}
+
+		struct JsonColumn
+		{
+			const ecs::ComponentInfo* m_Info = nullptr;
+			std::vector<uint32> m_Objects;
+			std::vector<const nlohmann::json*> m_Components;
+		};
+		std::vector<JsonColumn> columns;
+		HashedStringMap<uint32> columnIndices;
+		std::vector<ULID> ids;
+		std::vector<std::string> names;
+
+		for (const nlohmann::json& object : *objectsIt)
+		{
+			const uint32 index = NumCast<uint32>(ids.size());
+			ULID& id = ids.emplace_back();
+			if (!json::Visit(id, object, "id"))
+			{
+				APOLLO_LOG_ERROR("Game object {} has no valid ULID", index);
+				return false;
+			}
+			json::Visit(names.emplace_back(), object, "name");
+
+			const auto compIt = object.find("components");
+			if (compIt == object.end() || !compIt->is_object())
+			{
+				APOLLO_LOG_ERROR("Game object {} has no 'components' object", id);
+				return false;
+			}
+			for (auto it = compIt->begin(); it != compIt->end(); ++it)
+			{
+				const ecs::ComponentInfo* info = registry.GetInfo(std::string_view{ it.key() });
+				if (!info)
+				{
+					APOLLO_LOG_ERROR("Unknown component type: {}", it.key());
+					return false;
+				}
+				if (!info->m_JsonToColumn)
+				{
+					APOLLO_LOG_ERROR("Component {} can't be converted to binary data", it.key());
+					return false;
+				}
+				const auto [colIt, inserted] = columnIndices.try_emplace(
+					info->m_Name,
+					NumCast<uint32>(columns.size()));
+				if (inserted)
+					columns.emplace_back().m_Info = info;
+				columns[colIt->second].m_Objects.emplace_back(index);
+				columns[colIt->second].m_Components.emplace_back(&it.value());
+			}
+		}
+
+		BinaryWriter writer{ out_data };
+		writer.Write(
+			SceneFileHeader{
+				.m_NumObjects = NumCast<uint32>(ids.size()),
+				.m_NumColumns = NumCast<uint32>(columns.size()),
+			});
+		writer.Write(ids.data(), ids.size() * sizeof(ULID));
+		for (const std::string& name : names)
+			writer.WriteString(name);
+
+		for (const JsonColumn& column : columns)
+		{
+			writer.WriteString(column.m_Info->m_Name);
+			writer.Write(NumCast<uint32>(column.m_Objects.size()));
+			writer.Write(column.m_Objects.data(), column.m_Objects.size() * sizeof(uint32));
+
+			const size_t sizeOffset = writer.GetSize();
+			writer.Write(uint64(0));
+			if (!column.m_Info->m_JsonToColumn(column.m_Components, writer))
+			{
+				APOLLO_LOG_ERROR("Failed to convert component {}", column.m_Info->m_Name);
+				return false;
+			}
+			writer.Patch(sizeOffset, uint64(writer.GetSize() - sizeOffset - sizeof(uint64)));
+		}
+		return true;
+	}
+
+	bool SceneBinaryToJson(
+		std::span<const std::byte> data,
+		const ecs::ComponentRegistry& registry,
+		nlohmann::json& out_json)
+	{
+		BinaryReader reader{ data };
+		SceneData scene;
+		if (!ReadObjects(reader, scene))
+			return false;
+
+		nlohmann::json objects = nlohmann::json::array();
+		for (size_t i = 0; i < scene.m_Ids.size(); ++i)
+		{
+			nlohmann::json& object = objects.emplace_back();
+			scene.m_Ids[i].ToJson(object["id"]);
+			object["name"] = scene.m_Names[i];
+			object["components"] = nlohmann::json::object();
+		}
+
+		Column column;
+		std::vector<uint32> lastColumn(scene.m_Ids.size(), UINT32_MAX);
+		std::vector<nlohmann::json*> components;
+		for (uint32 c = 0; c < scene.m_NumColumns; ++c)
+		{
+			if (!ReadColumn(reader, c, lastColumn, column))
+			{
+				APOLLO_LOG_ERROR("Binary scene is corrupted: invalid column {}", c);
+				return false;
+			}
+			const ecs::ComponentInfo* info = registry.GetInfo(column.m_Name);
+			if (!info || !info->m_ColumnToJson)
+			{
+				APOLLO_LOG_ERROR("Can't convert component {} to JSON", column.m_Name);
+				return false;
+			}
+
+			// objects don't move anymore: pointers to their components stay valid
+			components.clear();
+			for (const uint32 index : column.m_Objects)
+			{
+				nlohmann::json& object = objects[index]["components"];
+				components.emplace_back(&object[std::string{ column.m_Name }]);
+			}
+			if (!info->m_ColumnToJson(column.m_Data, components))
+			{
+				APOLLO_LOG_ERROR("Failed to convert the column of component {}", column.m_Name);
+				return false;
+			}
+		}
+
+		out_json = nlohmann::json::object();
+		out_json["gameObjects"] = std::move(objects);
+		return true;
+	}
+} // namespace apollo
\ No newline at end of file
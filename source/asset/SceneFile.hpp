@@ -0,0 +1,107 @@
+#pragma once
+
+/** \file SceneFile.hpp
+ * \brief Binary scene format
+ */
+
+#include <PCH.hpp>
+
+#include "Scene.hpp"
+#include <core/Map.hpp>
+#include <entt/entity/fwd.hpp>
+#include <iosfwd>
+#include <nlohmann/json_fwd.hpp>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace apollo {
+	namespace ecs {
+		class ComponentRegistry;
+	}
+
+	/**
+	 * \brief Header found at the beginning of a binary scene file.
+	 * \details The header is followed by:
+	 * - The ULIDs of all game objects
+	 * - The names of all game objects, as strings (a uint32 length followed by the characters)
+	 * - One column per component type. A column holds the name of the component type, the number
+	 * of components, the index of the game object of each component, the size of the column data
+	 * in bytes as a uint64, then the data itself.
+	 *
+	 * The layout of the column data is generated from the component's reflection information: see
+	 * ecs::ComponentInfo::m_LoadColumn.
+	 */
+	struct SceneFileHeader
+	{
+		static constexpr uint32 Magic = 'A' | ('S' << 8) | ('C' << 16) | ('N' << 24);
+		static constexpr uint32 CurrentVersion = 1;
+
+		uint32 m_Magic = Magic;
+		uint32 m_Version = CurrentVersion;
+		uint32 m_NumObjects = 0;
+		uint32 m_NumColumns = 0;
+	};
+
+	static_assert(sizeof(SceneFileHeader) == 16);
+
+	/// \brief Tests whether \p data starts like a binary scene file
+	[[nodiscard]] APOLLO_API bool IsBinaryScene(std::span<const std::byte> data) noexcept;
+
+	/**
+	 * \brief Loads a binary scene into \p world.
+	 * \details All entities are created at once, then each column is inserted into the storage of
+	 * its component type in one go. Columns of unknown component types are skipped. Corrupted data
+	 * is detected before any entity gets created, except for the contents of the columns, which
+	 * must decode to exactly their declared size: the entities created so far are destroyed if
+	 * they don't.
+	 * \param out_objects: Receives the game objects of the scene
+	 * \returns Whether the scene was loaded successfully. Errors are logged.
+	 */
+	APOLLO_API bool LoadBinaryScene(
+		std::span<const std::byte> data,
+		const ecs::ComponentRegistry& registry,
+		entt::registry& world,
+		ULIDMap<GameObject>& out_objects);
+
+	/**
+	 * \name LoadJsonScene
+	 * \brief Loads a JSON scene (the contents of a .scn file) into \p world
+	 * \details Game objects are created as they get parsed, the whole document is never held in
+	 * memory. If the document turns out to be invalid, the entities created so far are destroyed.
+	 * \param out_objects: Receives the game objects of the scene
+	 * \returns Whether the scene was loaded successfully. Errors are logged.
+	 * @{
+	 */
+	APOLLO_API bool LoadJsonScene(
+		std::istream& stream,
+		const ecs::ComponentRegistry& registry,
+		entt::registry& world,
+		ULIDMap<GameObject>& out_objects);
+	APOLLO_API bool LoadJsonScene(
+		std::string_view str,
+		const ecs::ComponentRegistry& registry,
+		entt::registry& world,
+		ULIDMap<GameObject>& out_objects);
+	/** @} */
+
+	/**
+	 * \brief Converts a JSON scene (the contents of a .scn file) to the binary format
+	 * \details Asset references are converted as ULIDs, without loading the assets.
+	 * \returns false if the scene is invalid, or uses components which are unknown or can't be
+	 * serialized to binary. Errors are logged.
+	 */
+	APOLLO_API bool SceneJsonToBinary(
+		const nlohmann::json& json,
+		const ecs::ComponentRegistry& registry,
+		std::vector<std::byte>& out_data);
+
+	/**
+	 * \brief Converts a binary scene back to JSON
+	 * \returns false if the data is invalid or uses unknown components. Errors are logged.
+	 */
+	APOLLO_API bool SceneBinaryToJson(
+		std::span<const std::byte> data,
+		const ecs::ComponentRegistry& registry,
+		nlohmann::json& out_json);
+} // namespace apollo
\ No newline at end of file
@@ -159,6 +159,7 @@ namespace apollo {
 		m_ImGuiContext = InitImGui(m_Window.GetHandle(), device.GetHandle());
 
 		m_ECSManager = &ecs::Manager::Init();
+		m_ECSManager->SetThreadPool(&m_MainThreadPool);
 		RegisterCoreSystems(*this, *m_ECSManager, *m_AssetManager);
 
 		APOLLO_ASSERT(m_EntryPoint.m_GameState, "No game state was created. There is no game!");
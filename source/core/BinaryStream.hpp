@@ -0,0 +1,205 @@
+#pragma once
+
+/** \file BinaryStream.hpp
+ * \brief Helpers to write and read flat binary data
+ */
+
+#include <PCH.hpp>
+
+#include "NumConv.hpp"
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace apollo {
+	/**
+	 * \brief Appends binary data to a byte buffer.
+	 * \details Values are written as is, without any padding: only use this for data read back on
+	 * machines with the same endianness.
+	 */
+	class BinaryWriter
+	{
+	public:
+		explicit BinaryWriter(std::vector<std::byte>& out_buffer) noexcept
+			: m_Buffer(out_buffer)
+		{}
+
+		void Write(const void* data, size_t size)
+		{
+			const auto* bytes = static_cast<const std::byte*>(data);
+			m_Buffer.insert(m_Buffer.end(), bytes, bytes + size);
+		}
+
+		template <class T>
+		void Write(const T& value) requires(std::is_trivially_copyable_v<T>)
+		{
+			Write(&value, sizeof(T));
+		}
+
+		/// \brief Writes the length of \p str as a uint32, followed by its characters
+		void WriteString(std::string_view str)
+		{
+			Write(NumCast<uint32>(str.size()));
+			Write(str.data(), str.size());
+		}
+
+		/**
+		 * \brief Overwrites a value written earlier, typically a size which wasn't known yet
+		 * \param offset: The offset of the value, as returned by GetSize() before writing it
+		 */
+		template <class T>
+		void Patch(size_t offset, const T& value) noexcept requires(std::is_trivially_copyable_v<T>)
+		{
+			std::memcpy(m_Buffer.data() + offset, &value, sizeof(T));
+		}
+
+		[[nodiscard]] size_t GetSize() const noexcept { return m_Buffer.size(); }
+
+	private:
+		std::vector<std::byte>& m_Buffer;
+	};
+
+	/**
+	 * \brief Reads binary data from a buffer, checking bounds.
+	 * \details Reads past the end of the buffer fail without reading anything, and leave the
+	 * reader at the same position.
+	 */
+	class BinaryReader
+	{
+	public:
+		explicit BinaryReader(std::span<const std::byte> data) noexcept
+			: m_Data(data)
+		{}
+
+		[[nodiscard]] bool Read(void* out_data, size_t size) noexcept
+		{
+			if (size > GetRemaining())
+				return false;
+			std::memcpy(out_data, m_Data.data() + m_Offset, size);
+			m_Offset += size;
+			return true;
+		}
+
+		template <class T>
+		[[nodiscard]] bool Read(T& out_value) noexcept requires(std::is_trivially_copyable_v<T>)
+		{
+			return Read(&out_value, sizeof(T));
+		}
+
+		/**
+		 * \brief Reads a string written by BinaryWriter::WriteString
+		 * \param out_str: Receives a view into the reader's buffer
+		 */
+		[[nodiscard]] bool ReadString(std::string_view& out_str) noexcept
+		{
+			uint32 size = 0;
+			const size_t start = m_Offset;
+			if (!Read(size))
+				return false;
+			if (size > GetRemaining())
+			{
+				m_Offset = start;
+				return false;
+			}
+			out_str = { reinterpret_cast<const char*>(m_Data.data() + m_Offset), size };
+			m_Offset += size;
+			return true;
+		}
+
+		/**
+		 * \brief Splits the next \p size bytes off into their own reader
+		 * \param out_reader: Receives a reader over these bytes
+		 */
+		[[nodiscard]] bool ReadBlock(size_t size, BinaryReader& out_reader) noexcept
+		{
+			if (size > GetRemaining())
+				return false;
+			out_reader = BinaryReader{ m_Data.subspan(m_Offset, size) };
+			m_Offset += size;
+			return true;
+		}
+
+		[[nodiscard]] size_t GetOffset() const noexcept { return m_Offset; }
+		[[nodiscard]] size_t GetRemaining() const noexcept { return m_Data.size() - m_Offset; }
+
+	private:
+		std::span<const std::byte> m_Data;
+		size_t m_Offset = 0;
+	};
+
+	/**
+	 * \brief Converts values of type \p T to and from binary data.
+	 * \details Specializations must provide:
+	 * - `static void Write(BinaryWriter& out, const T& value)`
+	 * - `static bool Read(BinaryReader& in, T& out_value)`
+	 *
+	 * Specializations may also provide:
+	 * - `static bool FromJson(BinaryWriter& out, const nlohmann::json& value)`
+	 * - `static bool ToJson(BinaryReader& in, nlohmann::json& out_value)`
+	 *
+	 * which convert between the JSON and binary representations directly. This is only required
+	 * when going through an actual \p T object isn't desirable, e.g. for asset references, which
+	 * would load the asset.
+	 */
+	template <class T>
+	struct BinaryCodec;
+
+	/**
+	 * \brief Trivially copyable types are stored as is, except for views which would dangle.
+	 * \details bool and enums are excluded: not all bit patterns are valid values of these types,
+	 * so reading corrupted data into them would be undefined behaviour. bool has its own codec,
+	 * enums need a specialization which validates their values.
+	 * \warning Aggregates are copied byte for byte too, so they must not hold bool or enum members
+	 */
+	template <class T>
+	requires(
+		std::is_trivially_copyable_v<T> && !std::is_pointer_v<T> &&
+		!std::is_same_v<T, std::string_view> && !std::is_same_v<T, bool> &&
+		!std::is_enum_v<T>) struct BinaryCodec<T>
+	{
+		static void Write(BinaryWriter& out, const T& value) { out.Write(value); }
+		[[nodiscard]] static bool Read(BinaryReader& in, T& out_value) noexcept
+		{
+			return in.Read(out_value);
+		}
+	};
+
+	/// Stored as a single byte, anything other than 0 or 1 is rejected
+	template <>
+	struct BinaryCodec<bool>
+	{
+		static void Write(BinaryWriter& out, bool value) { out.Write(uint8(value)); }
+		[[nodiscard]] static bool Read(BinaryReader& in, bool& out_value) noexcept
+		{
+			uint8 byte = 0;
+			if (!in.Read(byte) || byte > 1)
+				return false;
+			out_value = byte;
+			return true;
+		}
+	};
+
+	template <>
+	struct BinaryCodec<std::string>
+	{
+		static void Write(BinaryWriter& out, const std::string& str) { out.WriteString(str); }
+		[[nodiscard]] static bool Read(BinaryReader& in, std::string& out_str)
+		{
+			std::string_view view;
+			if (!in.ReadString(view))
+				return false;
+			out_str = view;
+			return true;
+		}
+	};
+
+	/// \brief Tests whether BinaryCodec is specialized for \p T
+	template <class T>
+	concept BinarySerializable = requires(BinaryWriter& out, BinaryReader& in, T& a, const T& b)
+	{
+		BinaryCodec<T>::Write(out, b);
+		{ BinaryCodec<T>::Read(in, a) }->std::convertible_to<bool>;
+	};
+} // namespace apollo
\ No newline at end of file
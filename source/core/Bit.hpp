@@ -161,4 +161,116 @@ namespace apollo {
 		T* m_Start = nullptr;
 		size_t m_Size = 0;
 	};
+
+	/** \name Word-at-a-time bitmap functions
+	 * \brief Operate on bitmaps stored as arrays of `uint64`, where bit `i` is bit `i % 64` of
+	 * word `i / 64`. All positions and counts are in bits.
+	 * @{ */
+
+	namespace _internal {
+		/// \brief Mask of \p count bits starting at \p bit, which must fit in a single word
+		[[nodiscard]] constexpr uint64 WordMask(size_t bit, size_t count) noexcept
+		{
+			return (count == 64 ? ~0ull : (1ull << count) - 1) << bit;
+		}
+	} // namespace _internal
+
+	/// \brief Finds the first bit equal to \p value in [\p begin, \p end)
+	/// \returns The bit's position, or \p end if there is none
+	[[nodiscard]] constexpr size_t FindBit(
+		const uint64* words,
+		size_t begin,
+		size_t end,
+		bool value) noexcept
+	{
+		const uint64 flip = value ? 0 : ~0ull;
+		for (size_t pos = begin; pos < end;)
+		{
+			const size_t bit = pos % 64;
+			if (const uint64 word = (words[pos / 64] ^ flip) >> bit)
+				return Min(pos + std::countr_zero(word), end);
+			pos += 64 - bit;
+		}
+		return end;
+	}
+
+	/// \brief Finds the first run of \p n consecutive cleared bits in [\p begin, \p end)
+	/// \details The bitmap is processed a whole word at a time. For each word, we check in turn:
+	/// - Whether the cleared bits at the start of the word complete the run carried over from
+	/// the previous words, using `std::countr_one`.
+	/// - If \p n is at most 64, whether the word holds a complete run. Each bit of the word is
+	/// AND-ed with the following ones, doubling the checked length at each step.
+	/// - How many cleared bits at the end of the word carry over to the next one, using
+	/// `std::countl_one`.
+	/// \returns The position of the run's first bit, or \p end if there is no such run
+	[[nodiscard]] constexpr size_t FindZeroRun(
+		const uint64* words,
+		size_t begin,
+		size_t end,
+		size_t n) noexcept
+	{
+		size_t runLength = 0; // cleared bits right before pos
+		for (size_t pos = begin; pos < end;)
+		{
+			const size_t bit = pos % 64;
+			const size_t available = Min(64 - bit, end - pos);
+			// set bits flag cleared ones, only keeping the bits in [pos, end)
+			const uint64 cleared = (~words[pos / 64] >> bit) & _internal::WordMask(0, available);
+
+			const size_t prefix = std::countr_one(cleared);
+			if (runLength + prefix >= n)
+				return pos - runLength;
+			if (prefix == available)
+			{
+				runLength += available;
+				pos += available;
+				continue;
+			}
+
+			if (n <= 64)
+			{
+				// bit i ends up set iff bits [i, i + n) are cleared
+				uint64 starts = cleared;
+				for (size_t length = 1; length < n && starts;)
+				{
+					const size_t shift = Min(length, n - length);
+					starts &= starts >> shift;
+					length += shift;
+				}
+				if (starts)
+					return pos + std::countr_zero(starts);
+			}
+
+			runLength = std::countl_one(cleared << (64 - available));
+			pos += available;
+		}
+		return end;
+	}
+
+	/// \brief Sets \p n bits starting at \p pos
+	constexpr void SetBits(uint64* words, size_t pos, size_t n) noexcept
+	{
+		while (n)
+		{
+			const size_t bit = pos % 64;
+			const size_t count = Min(n, 64 - bit);
+			words[pos / 64] |= _internal::WordMask(bit, count);
+			pos += count;
+			n -= count;
+		}
+	}
+
+	/// \brief Clears \p n bits starting at \p pos
+	constexpr void ClearBits(uint64* words, size_t pos, size_t n) noexcept
+	{
+		while (n)
+		{
+			const size_t bit = pos % 64;
+			const size_t count = Min(n, 64 - bit);
+			words[pos / 64] &= ~_internal::WordMask(bit, count);
+			pos += count;
+			n -= count;
+		}
+	}
+	/** @} */
 } // namespace apollo
\ No newline at end of file
@@ -0,0 +1,696 @@
+#pragma once
+
+/** \file FlatHashMap.hpp */
+
+#include <PCH.hpp>
+
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define APOLLO_FLAT_MAP_SSE2 1
+#include <emmintrin.h>
+#else
+#define APOLLO_FLAT_MAP_SSE2 0
+#endif
+
+namespace apollo {
+	template <class>
+	struct Hash;
+
+	namespace _internal::flat_map {
+		/**
+		 * \brief Per-slot metadata byte.
+		 * \details Full slots store the low 7 bits of the hash (H2) with the high bit cleared,
+		 * empty and deleted slots both have the high bit set.
+		 */
+		using Ctrl = int8;
+		inline constexpr Ctrl Empty = -128;
+		inline constexpr Ctrl Deleted = -2;
+
+		[[nodiscard]] constexpr bool IsFull(Ctrl c) noexcept
+		{
+			return c >= 0;
+		}
+
+		/**
+		 * \brief Bitmask of matching slots within a group
+		 * \tparam Shift: log2 of the number of bits used by each slot in the mask
+		 */
+		template <class T, uint32 Shift>
+		struct BitMask
+		{
+			T m_Mask;
+
+			[[nodiscard]] explicit operator bool() const noexcept { return m_Mask; }
+			[[nodiscard]] uint32 LowestBitSet() const noexcept
+			{
+				return uint32(std::countr_zero(m_Mask)) >> Shift;
+			}
+			/// Number of unmatched slots at the beginning of the group
+			[[nodiscard]] uint32 TrailingZeros() const noexcept { return LowestBitSet(); }
+			/// Number of unmatched slots at the end of the group
+			[[nodiscard]] uint32 LeadingZeros() const noexcept
+			{
+				return uint32(std::countl_zero(m_Mask)) >> Shift;
+			}
+
+			// range-for support, iterates over the matching slot indices
+			[[nodiscard]] BitMask begin() const noexcept { return *this; }
+			[[nodiscard]] BitMask end() const noexcept { return { 0 }; }
+			[[nodiscard]] uint32 operator*() const noexcept { return LowestBitSet(); }
+			BitMask& operator++() noexcept
+			{
+				m_Mask &= m_Mask - 1;
+				return *this;
+			}
+			[[nodiscard]] bool operator!=(const BitMask& other) const noexcept
+			{
+				return m_Mask != other.m_Mask;
+			}
+		};
+
+#if APOLLO_FLAT_MAP_SSE2
+		/// 16 control bytes, matched with a single SSE2 compare
+		struct Group
+		{
+			static constexpr uint32 Width = 16;
+			using Mask = BitMask<uint16, 0>;
+
+			explicit Group(const Ctrl* ctrl) noexcept
+				: m_Ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl)))
+			{}
+
+			[[nodiscard]] Mask Match(Ctrl h2) const noexcept
+			{
+				return { uint16(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_Ctrl))) };
+			}
+			[[nodiscard]] Mask MatchEmpty() const noexcept
+			{
+				return { uint16(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(Empty), m_Ctrl))) };
+			}
+			[[nodiscard]] Mask MatchEmptyOrDeleted() const noexcept
+			{
+				return { uint16(_mm_movemask_epi8(m_Ctrl)) };
+			}
+
+			__m128i m_Ctrl;
+		};
+#else
+		/// 8 control bytes, matched with 64-bit integer arithmetic
+		struct Group
+		{
+			static constexpr uint32 Width = 8;
+			using Mask = BitMask<uint64, 3>;
+
+			static_assert(std::endian::native == std::endian::little);
+			static constexpr uint64 Lsbs = 0x0101010101010101ull;
+			static constexpr uint64 Msbs = 0x8080808080808080ull;
+
+			explicit Group(const Ctrl* ctrl) noexcept
+			{
+				std::memcpy(&m_Ctrl, ctrl, sizeof(m_Ctrl));
+			}
+
+			/// \note This can report false positives, which get filtered out by the key comparison
+			[[nodiscard]] Mask Match(Ctrl h2) const noexcept
+			{
+				const uint64 x = m_Ctrl ^ (Lsbs * uint8(h2));
+				return { (x - Lsbs) & ~x & Msbs };
+			}
+			[[nodiscard]] Mask MatchEmpty() const noexcept
+			{
+				// only Empty has the high bit set and the second lowest bit cleared
+				return { m_Ctrl & ~(m_Ctrl << 6) & Msbs };
+			}
+			[[nodiscard]] Mask MatchEmptyOrDeleted() const noexcept { return { m_Ctrl & Msbs }; }
+
+			uint64 m_Ctrl;
+		};
+#endif
+
+		/// Spreads the entropy of user hashes, which may be as weak as the identity function
+		[[nodiscard]] constexpr uint64 Mix(uint64 h) noexcept
+		{
+			h ^= h >> 33;
+			h *= 0xff51afd7ed558ccdull;
+			h ^= h >> 33;
+			h *= 0xc4ceb9fe1a85ec53ull;
+			h ^= h >> 33;
+			return h;
+		}
+	} // namespace _internal::flat_map
+
+	/**
+	 * \brief Open addressing hash map, based on the SwissTable design.
+	 * \details Values are stored inline in a single array of slots, along with one control byte
+	 * per slot. Lookups hash the key once, then probe whole groups of control bytes at a time:
+	 * the low 7 bits of the hash are compared against the group in parallel (with SSE2 when
+	 * available), and only the candidates get compared with the actual key.
+	 *
+	 * The interface follows std::unordered_map closely enough to be used in its place, with one
+	 * notable difference: <b>inserting may move existing elements</b>, which invalidates all
+	 * iterators, references and pointers to them. Erasing only invalidates the erased element.
+	 * \tparam K: The key type
+	 * \tparam T: The mapped type
+	 * \tparam H: The hasher type, see \ref Hasher
+	 * \tparam Eq: The key equality predicate
+	 */
+	template <class K, class T, class H = Hash<K>, class Eq = std::equal_to<K>>
+	class FlatHashMap
+	{
+		using Ctrl = _internal::flat_map::Ctrl;
+		using Group = _internal::flat_map::Group;
+
+	public:
+		using key_type = K;
+		using mapped_type = T;
+		using value_type = std::pair<const K, T>;
+		using size_type = size_t;
+		using hasher = H;
+		using key_equal = Eq;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+
+		template <bool Const>
+		class Iterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = FlatHashMap::value_type;
+			using difference_type = ptrdiff_t;
+			using reference = std::conditional_t<Const, const value_type&, value_type&>;
+			using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+
+			Iterator() = default;
+			/// Non-const to const conversion
+			template <bool C = Const>
+			Iterator(const Iterator<false>& other) noexcept requires(C)
+				: m_Ctrl(other.m_Ctrl)
+				, m_CtrlEnd(other.m_CtrlEnd)
+				, m_Slot(other.m_Slot)
+			{}
+
+			[[nodiscard]] reference operator*() const noexcept { return *m_Slot; }
+			[[nodiscard]] pointer operator->() const noexcept { return m_Slot; }
+
+			Iterator& operator++() noexcept
+			{
+				++m_Ctrl;
+				++m_Slot;
+				SkipEmptySlots();
+				return *this;
+			}
+			Iterator operator++(int) noexcept
+			{
+				Iterator tmp = *this;
+				++*this;
+				return tmp;
+			}
+
+			[[nodiscard]] bool operator==(const Iterator& other) const noexcept
+			{
+				return m_Slot == other.m_Slot;
+			}
+
+		private:
+			friend class FlatHashMap;
+			template <bool>
+			friend class Iterator;
+
+			Iterator(const Ctrl* ctrl, const Ctrl* ctrlEnd, pointer slot) noexcept
+				: m_Ctrl(ctrl)
+				, m_CtrlEnd(ctrlEnd)
+				, m_Slot(slot)
+			{}
+
+			void SkipEmptySlots() noexcept
+			{
+				while (m_Ctrl != m_CtrlEnd && !_internal::flat_map::IsFull(*m_Ctrl))
+				{
+					++m_Ctrl;
+					++m_Slot;
+				}
+			}
+
+			const Ctrl* m_Ctrl = nullptr;
+			const Ctrl* m_CtrlEnd = nullptr;
+			pointer m_Slot = nullptr;
+		};
+
+		using iterator = Iterator<false>;
+		using const_iterator = Iterator<true>;
+
+		FlatHashMap() = default;
+		FlatHashMap(std::initializer_list<value_type> values);
+		FlatHashMap(const FlatHashMap& other);
+		FlatHashMap(FlatHashMap&& other) noexcept { swap(other); }
+		~FlatHashMap() { Release(); }
+
+		FlatHashMap& operator=(const FlatHashMap& other);
+		FlatHashMap& operator=(FlatHashMap&& other) noexcept;
+
+		[[nodiscard]] iterator begin() noexcept;
+		[[nodiscard]] const_iterator begin() const noexcept;
+		[[nodiscard]] const_iterator cbegin() const noexcept { return begin(); }
+		[[nodiscard]] iterator end() noexcept { return { nullptr, nullptr, m_Slots + m_Capacity }; }
+		[[nodiscard]] const_iterator end() const noexcept
+		{
+			return { nullptr, nullptr, m_Slots + m_Capacity };
+		}
+		[[nodiscard]] const_iterator cend() const noexcept { return end(); }
+
+		[[nodiscard]] size_t size() const noexcept { return m_Size; }
+		[[nodiscard]] bool empty() const noexcept { return !m_Size; }
+		/// Number of slots currently allocated. At most 7/8th of them can be occupied.
+		[[nodiscard]] size_t capacity() const noexcept { return m_Capacity; }
+
+		/**
+		 * \brief Destroys all elements.
+		 * \details The memory is kept around, unless the table was very large compared to its
+		 * number of elements.
+		 */
+		void clear() noexcept;
+		/// Makes enough room for \p n elements, so that inserting them doesn't rehash
+		void reserve(size_t n);
+
+		/** \name Lookup
+		 * @{ */
+		[[nodiscard]] iterator find(const K& key);
+		[[nodiscard]] const_iterator find(const K& key) const;
+		[[nodiscard]] bool contains(const K& key) const { return FindIndex(key) != NPos; }
+		[[nodiscard]] size_t count(const K& key) const { return contains(key); }
+		/**
+		 * \throws std::out_of_range if \p key isn't in the map
+		 */
+		[[nodiscard]] T& at(const K& key);
+		[[nodiscard]] const T& at(const K& key) const;
+		/** @} */
+
+		/** \name Insertion
+		 * \brief These functions don't do anything if the key already is in the map. In any case,
+		 * the returned iterator points to the element with the given key, and the boolean tells
+		 * whether it was inserted.
+		 * @{ */
+		template <class... Args>
+		std::pair<iterator, bool> try_emplace(const K& key, Args&&... args);
+		template <class... Args>
+		std::pair<iterator, bool> try_emplace(K&& key, Args&&... args);
+		template <class KArg, class TArg>
+		std::pair<iterator, bool> emplace(KArg&& key, TArg&& value)
+		{
+			return try_emplace(K(std::forward<KArg>(key)), std::forward<TArg>(value));
+		}
+		template <class Pair>
+		std::pair<iterator, bool> emplace(Pair&& pair)
+		{
+			return emplace(
+				std::get<0>(std::forward<Pair>(pair)),
+				std::get<1>(std::forward<Pair>(pair)));
+		}
+		std::pair<iterator, bool> insert(const value_type& value)
+		{
+			return try_emplace(value.first, value.second);
+		}
+		std::pair<iterator, bool> insert(value_type&& value)
+		{
+			return try_emplace(value.first, std::move(value.second));
+		}
+		/** @} */
+
+		T& operator[](const K& key) { return try_emplace(key).first->second; }
+		T& operator[](K&& key) { return try_emplace(std::move(key)).first->second; }
+
+		/** \name Erasure
+		 * @{ */
+		/// \returns The number of erased elements, i.e. 0 or 1
+		size_t erase(const K& key);
+		/// \returns An iterator to the element following the erased one
+		iterator erase(const_iterator it);
+		iterator erase(iterator it) { return erase(const_iterator{ it }); }
+		/** @} */
+
+		void swap(FlatHashMap& other) noexcept;
+
+	private:
+		static constexpr size_t NPos = ~size_t(0);
+		static constexpr size_t MinCapacity = 16;
+		static_assert(MinCapacity >= Group::Width);
+
+		[[nodiscard]] static uint64 HashKey(const K& key)
+		{
+			return _internal::flat_map::Mix(uint64(H{}(key)));
+		}
+		[[nodiscard]] static constexpr size_t MaxLoad(size_t capacity) noexcept
+		{
+			return capacity - capacity / 8;
+		}
+
+		[[nodiscard]] size_t FindIndex(const K& key) const
+		{
+			return m_Size ? FindIndex(key, HashKey(key)) : NPos;
+		}
+		/// \pre The table must be allocated
+		[[nodiscard]] size_t FindIndex(const K& key, uint64 hash) const;
+		/// First empty or deleted slot on the probe sequence of \p hash
+		[[nodiscard]] size_t FindFirstNonFull(uint64 hash) const noexcept;
+		template <class KArg, class... Args>
+		std::pair<iterator, bool> TryEmplaceImpl(KArg&& key, Args&&... args);
+
+		/// Writes a control byte, along with its copy past the end of the array
+		void SetCtrl(size_t index, Ctrl value) noexcept;
+		void Rehash(size_t newCapacity);
+		void DestroySlots() noexcept;
+		void Release() noexcept;
+
+		[[nodiscard]] iterator MakeIterator(size_t index) noexcept
+		{
+			return { m_Ctrl + index, m_Ctrl + m_Capacity, m_Slots + index };
+		}
+
+		/* Single allocation: m_Capacity slots, followed by m_Capacity + Group::Width control
+		 * bytes. The extra bytes mirror the first group, so that groups can be loaded from any
+		 * position without wrapping around. */
+		value_type* m_Slots = nullptr;
+		Ctrl* m_Ctrl = nullptr;
+		size_t m_Capacity = 0;
+		size_t m_Size = 0;
+		size_t m_GrowthLeft = 0;
+	};
+
+	template <class K, class T, class H, class Eq>
+	FlatHashMap<K, T, H, Eq>::FlatHashMap(std::initializer_list<value_type> values)
+	{
+		reserve(values.size());
+		for (const value_type& val : values)
+			insert(val);
+	}
+
+	template <class K, class T, class H, class Eq>
+	FlatHashMap<K, T, H, Eq>::FlatHashMap(const FlatHashMap& other)
+	{
+		reserve(other.m_Size);
+		for (const value_type& val : other)
+			insert(val);
+	}
+
+	template <class K, class T, class H, class Eq>
+	auto FlatHashMap<K, T, H, Eq>::operator=(const FlatHashMap& other) -> FlatHashMap&
+	{
+		if (this != &other)
+		{
+			FlatHashMap tmp{ other };
+			swap(tmp);
+		}
+		return *this;
+	}
+
+	template <class K, class T, class H, class Eq>
+	auto FlatHashMap<K, T, H, Eq>::operator=(FlatHashMap&& other) noexcept -> FlatHashMap&
+	{
+		FlatHashMap tmp{ std::move(other) };
+		swap(tmp);
+		return *this;
+	}
+
+	template <class K, class T, class H, class Eq>
+	auto FlatHashMap<K, T, H, Eq>::begin() noexcept -> iterator
+	{
+		iterator it{ m_Ctrl, m_Ctrl + m_Capacity, m_Slots };
+		it.SkipEmptySlots();
+		return it;
+	}
+
+	template <class K, class T, class H, class Eq>
+	auto FlatHashMap<K, T, H, Eq>::begin() const noexcept -> const_iterator
+	{
+		const_iterator it{ m_Ctrl, m_Ctrl + m_Capacity, m_Slots };
+		it.SkipEmptySlots();
+		return it;
+	}
+
+	template <class K, class T, class H, class Eq>
+	void FlatHashMap<K, T, H, Eq>::clear() noexcept
+	{
+		if (!m_Capacity)
+			return;
+
+		// don't keep a huge table around for just a few elements
+		if (m_Capacity > 128 && m_Size < m_Capacity / 8)
+		{
+			Release();
+			return;
+		}
+		DestroySlots();
+		std::memset(m_Ctrl, _internal::flat_map::Empty, m_Capacity + Group::Width);
+		m_Size = 0;
+		m_GrowthLeft = MaxLoad(m_Capacity);
+	}
+
+	template <class K, class T, class H, class Eq>
+	void FlatHashMap<K, T, H, Eq>::reserve(size_t n)
+	{
+		size_t capacity = MinCapacity;
+		while (MaxLoad(capacity) < n)
+			capacity *= 2;
+		if (capacity > m_Capacity)
+			Rehash(capacity);
+	}
+
+	template <class K, class T, class H, class Eq>
+	size_t FlatHashMap<K, T, H, Eq>::FindIndex(const K& key, uint64 hash) const
+	{
+		const Ctrl h2 = Ctrl(hash & 0x7f);
+		const size_t mask = m_Capacity - 1;
+		size_t offset = (hash >> 7) & mask;
+		// triangular probing visits every group exactly once, as the capacity is a power of 2
+		for (size_t step = Group::Width;; step += Group::Width)
+		{
+			const Group group{ m_Ctrl + offset };
+			for (const uint32 i : group.Match(h2))
+			{
+				const size_t index = (offset + i) & mask;
+				if (Eq{}(m_Slots[index].first, key)) [[likely]]
+					return index;
+			}
+			if (group.MatchEmpty())
+				return NPos;
+			offset = (offset + step) & mask;
+		}
+	}
+
+	template <class K, class T, class H, class Eq>
+	size_t FlatHashMap<K, T, H, Eq>::FindFirstNonFull(uint64 hash) const noexcept
+	{
+		const size_t mask = m_Capacity - 1;
+		size_t offset = (hash >> 7) & mask;
+		for (size_t step = Group::Width;; step += Group::Width)
+		{
+			if (const auto match = Group{ m_Ctrl + offset }.MatchEmptyOrDeleted())
+				return (offset + match.LowestBitSet()) & mask;
+			offset = (offset + step) & mask;
+		}
+	}
+
+	template <class K, class T, class H, class Eq>
+	auto FlatHashMap<K, T, H, Eq>::find(const K& key) -> iterator
+	{
+		const size_t index = FindIndex(key);
+		return index == NPos ? end() : MakeIterator(index);
+	}
+
+	template <class K, class T, class H, class Eq>
+	auto FlatHashMap<K, T, H, Eq>::find(const K& key) const -> const_iterator
+	{
+		const size_t index = FindIndex(key);
+		if (index == NPos)
+			return end();
+		return { m_Ctrl + index, m_Ctrl + m_Capacity, m_Slots + index };
+	}
+
+	template <class K, class T, class H, class Eq>
+	T& FlatHashMap<K, T, H, Eq>::at(const K& key)
+	{
+		const size_t index = FindIndex(key);
+		if (index == NPos)
+			throw std::out_of_range{ "FlatHashMap::at: key not found" };
+		return m_Slots[index].second;
+	}
+
+	template <class K, class T, class H, class Eq>
+	const T& FlatHashMap<K, T, H, Eq>::at(const K& key) const
+	{
+		return const_cast<FlatHashMap*>(this)->at(key);
+	}
+
+	template <class K, class T, class H, class Eq>
+	template <class... Args>
+	auto FlatHashMap<K, T, H, Eq>::try_emplace(const K& key, Args&&... args)
+		-> std::pair<iterator, bool>
+	{
+		return TryEmplaceImpl(key, std::forward<Args>(args)...);
+	}
+
+	template <class K, class T, class H, class Eq>
+	template <class... Args>
+	auto FlatHashMap<K, T, H, Eq>::try_emplace(K&& key, Args&&... args)
+		-> std::pair<iterator, bool>
+	{
+		return TryEmplaceImpl(std::move(key), std::forward<Args>(args)...);
+	}
+
+	template <class K, class T, class H, class Eq>
+	template <class KArg, class... Args>
+	auto FlatHashMap<K, T, H, Eq>::TryEmplaceImpl(KArg&& key, Args&&... args)
+		-> std::pair<iterator, bool>
+	{
+		const uint64 hash = HashKey(key);
+		if (m_Size)
+		{
+			if (const size_t index = FindIndex(key, hash); index != NPos)
+				return { MakeIterator(index), false };
+		}
+
+		size_t index = m_Capacity ? FindFirstNonFull(hash) : NPos;
+		// deleted slots can be reused without consuming the growth budget
+		if (index == NPos || (!m_GrowthLeft && m_Ctrl[index] != _internal::flat_map::Deleted))
+		{
+			// lots of tombstones: cleaning them up is enough to make room
+			if (m_Capacity && m_Size < MaxLoad(m_Capacity) / 2)
+				Rehash(m_Capacity);
+			else
+				Rehash(m_Capacity ? m_Capacity * 2 : MinCapacity);
+			index = FindFirstNonFull(hash);
+		}
+
+		std::construct_at(
+			m_Slots + index,
+			std::piecewise_construct,
+			std::forward_as_tuple(std::forward<KArg>(key)),
+			std::forward_as_tuple(std::forward<Args>(args)...));
+		m_GrowthLeft -= m_Ctrl[index] == _internal::flat_map::Empty;
+		SetCtrl(index, Ctrl(hash & 0x7f));
+		++m_Size;
+		return { MakeIterator(index), true };
+	}
+
+	template <class K, class T, class H, class Eq>
+	size_t FlatHashMap<K, T, H, Eq>::erase(const K& key)
+	{
+		const size_t index = FindIndex(key);
+		if (index == NPos)
+			return 0;
+		erase(const_iterator{ m_Ctrl + index, m_Ctrl + m_Capacity, m_Slots + index });
+		return 1;
+	}
+
+	template <class K, class T, class H, class Eq>
+	auto FlatHashMap<K, T, H, Eq>::erase(const_iterator it) -> iterator
+	{
+		const size_t index = size_t(it.m_Slot - m_Slots);
+		std::destroy_at(m_Slots + index);
+		--m_Size;
+
+		/* If the slot never was part of a full window of Group::Width slots, no probe sequence
+		 * ever went past it, and it can be marked as empty again. Otherwise, a tombstone is
+		 * required to keep the following elements reachable. */
+		const size_t mask = m_Capacity - 1;
+		const auto emptyBefore = Group{ m_Ctrl + ((index - Group::Width) & mask) }.MatchEmpty();
+		const auto emptyAfter = Group{ m_Ctrl + index }.MatchEmpty();
+		const bool wasNeverFull = emptyBefore && emptyAfter &&
+								  emptyAfter.TrailingZeros() + emptyBefore.LeadingZeros() <
+									  Group::Width;
+		SetCtrl(index, wasNeverFull ? _internal::flat_map::Empty : _internal::flat_map::Deleted);
+		m_GrowthLeft += wasNeverFull;
+
+		iterator next = MakeIterator(index);
+		++next;
+		return next;
+	}
+
+	template <class K, class T, class H, class Eq>
+	void FlatHashMap<K, T, H, Eq>::swap(FlatHashMap& other) noexcept
+	{
+		std::swap(m_Slots, other.m_Slots);
+		std::swap(m_Ctrl, other.m_Ctrl);
+		std::swap(m_Capacity, other.m_Capacity);
+		std::swap(m_Size, other.m_Size);
+		std::swap(m_GrowthLeft, other.m_GrowthLeft);
+	}
+
+	template <class K, class T, class H, class Eq>
+	void FlatHashMap<K, T, H, Eq>::SetCtrl(size_t index, Ctrl value) noexcept
+	{
+		m_Ctrl[index] = value;
+		if (index < Group::Width)
+			m_Ctrl[m_Capacity + index] = value;
+	}
+
+	template <class K, class T, class H, class Eq>
+	void FlatHashMap<K, T, H, Eq>::Rehash(size_t newCapacity)
+	{
+		const size_t slotsSize = newCapacity * sizeof(value_type);
+		void* const mem = ::operator new(
+			slotsSize + newCapacity + Group::Width,
+			std::align_val_t{ alignof(value_type) });
+
+		value_type* const oldSlots = m_Slots;
+		const Ctrl* const oldCtrl = m_Ctrl;
+		const size_t oldCapacity = m_Capacity;
+
+		m_Slots = static_cast<value_type*>(mem);
+		m_Ctrl = reinterpret_cast<Ctrl*>(static_cast<std::byte*>(mem) + slotsSize);
+		m_Capacity = newCapacity;
+		m_GrowthLeft = MaxLoad(newCapacity) - m_Size;
+		std::memset(m_Ctrl, _internal::flat_map::Empty, newCapacity + Group::Width);
+
+		for (size_t i = 0; i < oldCapacity; ++i)
+		{
+			if (!_internal::flat_map::IsFull(oldCtrl[i]))
+				continue;
+
+			value_type& slot = oldSlots[i];
+			const uint64 hash = HashKey(slot.first);
+			const size_t index = FindFirstNonFull(hash);
+			std::construct_at(m_Slots + index, std::move(slot));
+			std::destroy_at(&slot);
+			SetCtrl(index, Ctrl(hash & 0x7f));
+		}
+
+		if (oldSlots)
+			::operator delete(oldSlots, std::align_val_t{ alignof(value_type) });
+	}
+
+	template <class K, class T, class H, class Eq>
+	void FlatHashMap<K, T, H, Eq>::DestroySlots() noexcept
+	{
+		if constexpr (!std::is_trivially_destructible_v<value_type>)
+		{
+			for (size_t i = 0; i < m_Capacity; ++i)
+			{
+				if (_internal::flat_map::IsFull(m_Ctrl[i]))
+					std::destroy_at(m_Slots + i);
+			}
+		}
+	}
+
+	template <class K, class T, class H, class Eq>
+	void FlatHashMap<K, T, H, Eq>::Release() noexcept
+	{
+		if (!m_Slots)
+			return;
+
+		DestroySlots();
+		::operator delete(m_Slots, std::align_val_t{ alignof(value_type) });
+		m_Slots = nullptr;
+		m_Ctrl = nullptr;
+		m_Capacity = m_Size = m_GrowthLeft = 0;
+	}
+} // namespace apollo
\ No newline at end of file
@@ -0,0 +1,168 @@
+#include "JobGraph.hpp"
+#include <mutex>
+#include <vector>
+
+namespace {
+	/// Number of times JobHandle::Wait yields before parking, once no pending job could be found
+	constexpr uint32 g_WaitSpinCount = 64;
+}
+
+namespace apollo::mt::_internal {
+	struct JobState
+	{
+		using Ref = RetainPtr<JobState, JobRetainTraits>;
+
+		JobState(ThreadPool& pool, UniqueFunction<void()> func)
+			: m_Pool(&pool)
+			, m_Func(std::move(func))
+		{}
+
+		/// Registers \p next as depending on *this
+		void AddContinuation(Ref next)
+		{
+			{
+				std::unique_lock lock{ m_Mutex };
+				if (!m_Done)
+				{
+					m_Continuations.emplace_back(std::move(next));
+					return;
+				}
+			}
+			next->ReleaseDependency();
+		}
+
+		/// Called once per completed dependency, plus once after the job was fully set up
+		void ReleaseDependency()
+		{
+			if (--m_PendingCount)
+				return;
+
+			if (!m_Func)
+			{
+				Complete();
+				return;
+			}
+			// a stopped pool would never run the job, and anyone waiting on it would hang
+			if (!m_Pool->IsRunning()) [[unlikely]]
+			{
+				Run();
+				return;
+			}
+
+			m_Pool->Enqueue(
+				[self = Ref{ this }]() mutable
+				{
+					self->Run();
+				});
+		}
+
+		void Run()
+		{
+			m_Func();
+			m_Func.Reset();
+			Complete();
+		}
+
+		void Complete()
+		{
+			std::vector<Ref> continuations;
+			{
+				std::unique_lock lock{ m_Mutex };
+				m_Done = true;
+				continuations.swap(m_Continuations);
+			}
+			m_Done.notify_all();
+
+			for (Ref& next : continuations)
+				next->ReleaseDependency();
+		}
+
+		ThreadPool* m_Pool;
+		UniqueFunction<void()> m_Func;
+		std::atomic_uint32_t m_RefCount = 0;
+		std::atomic_uint32_t m_PendingCount = 1;
+		std::atomic_bool m_Done = false;
+		std::mutex m_Mutex;
+		std::vector<Ref> m_Continuations;
+	};
+} // namespace apollo::mt::_internal
+
+namespace apollo::mt {
+	void JobRetainTraits::Increment(_internal::JobState* ptr) noexcept
+	{
+		++ptr->m_RefCount;
+	}
+
+	void JobRetainTraits::Decrement(_internal::JobState* ptr) noexcept
+	{
+		if (!--ptr->m_RefCount)
+			delete ptr;
+	}
+
+	uint32 JobRetainTraits::GetCount(const _internal::JobState* ptr) noexcept
+	{
+		return ptr->m_RefCount;
+	}
+
+	bool JobHandle::IsDone() const noexcept
+	{
+		return !m_State || m_State->m_Done;
+	}
+
+	ThreadPool* JobHandle::GetThreadPool() const noexcept
+	{
+		return m_State ? m_State->m_Pool : nullptr;
+	}
+
+	void JobHandle::Wait() const
+	{
+		if (!m_State)
+			return;
+
+		ThreadPool& pool = *m_State->m_Pool;
+		uint32 idleCount = 0;
+		while (!m_State->m_Done)
+		{
+			if (pool.RunPendingJob())
+			{
+				idleCount = 0;
+				continue;
+			}
+			if (++idleCount < g_WaitSpinCount)
+			{
+				std::this_thread::yield();
+				continue;
+			}
+			m_State->m_Done.wait(false);
+		}
+	}
+
+	JobHandle Schedule(
+		ThreadPool& pool,
+		UniqueFunction<void()> func,
+		std::span<const JobHandle> dependencies)
+	{
+		using _internal::JobState;
+		JobState::Ref state{ new JobState{ pool, std::move(func) } };
+
+		for (const JobHandle& dep : dependencies)
+		{
+			if (!dep)
+				continue;
+
+			// handles are immutable, but the shared state isn't
+			auto* const depState = const_cast<JobState*>(dep.m_State.Get());
+			++state->m_PendingCount;
+			depState->AddContinuation(state);
+		}
+
+		JobHandle handle{ state };
+		state->ReleaseDependency();
+		return handle;
+	}
+
+	JobHandle WhenAll(ThreadPool& pool, std::span<const JobHandle> jobs)
+	{
+		return Schedule(pool, UniqueFunction<void()>{}, jobs);
+	}
+} // namespace apollo::mt
\ No newline at end of file
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <PCH.hpp>
+
+#include "RetainPtr.hpp"
+#include "ThreadPool.hpp"
+#include "UniqueFunction.hpp"
+#include <atomic>
+#include <initializer_list>
+#include <memory>
+#include <span>
+
+/** \file JobGraph.hpp
+ * \brief Fork/join primitives built on top of mt::ThreadPool
+ */
+
+namespace apollo::mt {
+	namespace _internal {
+		struct JobState;
+	}
+
+	/**
+	 * \brief Retain traits for the internal job state
+	 */
+	struct APOLLO_API JobRetainTraits
+	{
+		static void Increment(_internal::JobState* ptr) noexcept;
+		static void Decrement(_internal::JobState* ptr) noexcept;
+		static uint32 GetCount(const _internal::JobState* ptr) noexcept;
+
+		static constexpr Retain_t DefaultAction{};
+	};
+
+	/**
+	 * \brief Reference to a job scheduled through mt::Schedule, mt::WhenAll or mt::ParallelFor
+	 * \details A job is submitted to the thread pool as soon as all of its dependencies have
+	 * completed. Handles are cheap to copy, and keep the job state alive as long as needed: it is
+	 * perfectly fine to drop a handle without waiting on it.
+	 */
+	class JobHandle
+	{
+	public:
+		JobHandle() = default;
+		explicit JobHandle(RetainPtr<_internal::JobState, JobRetainTraits> state) noexcept
+			: m_State(std::move(state))
+		{}
+
+		[[nodiscard]] operator bool() const noexcept { return bool(m_State); }
+
+		/**
+		 * \brief Checks whether the job has completed. A null handle is always considered done.
+		 */
+		[[nodiscard]] APOLLO_API bool IsDone() const noexcept;
+
+		/**
+		 * \brief Blocks until the job completes.
+		 * \details Instead of simply sleeping, the calling thread runs pending jobs from the pool
+		 * while it waits. It only parks once no pending job could be found. This also holds once
+		 * the pool was stopped: jobs its workers left behind are run by the waiting thread.
+		 */
+		APOLLO_API void Wait() const;
+
+		/**
+		 * \brief Schedules a continuation, which will run once this job has completed.
+		 */
+		template <class F>
+		JobHandle Then(F&& func) const requires(std::is_invocable_r_v<void, F>);
+
+		[[nodiscard]] ThreadPool* GetThreadPool() const noexcept;
+
+	private:
+		friend APOLLO_API JobHandle Schedule(
+			ThreadPool& pool,
+			UniqueFunction<void()> func,
+			std::span<const JobHandle> dependencies);
+
+		RetainPtr<_internal::JobState, JobRetainTraits> m_State;
+	};
+
+	/** \name Schedule
+	 * \brief Creates a new job
+	 * \details If \p pool was stopped by the time the dependencies complete, the job runs on the
+	 * thread which completed the last of them, or on the calling thread if there were none.
+	 * \param pool: The thread pool the job will run on
+	 * \param func: The function to invoke
+	 * \param dependencies: Jobs which must complete before \p func can run. Null handles are
+	 * ignored.
+	 * \returns A handle to the new job
+	 * @{ */
+	APOLLO_API JobHandle Schedule(
+		ThreadPool& pool,
+		UniqueFunction<void()> func,
+		std::span<const JobHandle> dependencies = {});
+
+	template <class F>
+	JobHandle Schedule(ThreadPool& pool, F&& func, std::span<const JobHandle> dependencies = {})
+		requires(
+			std::is_invocable_r_v<void, F> &&
+			!std::is_same_v<std::decay_t<F>, UniqueFunction<void()>>)
+	{
+		return Schedule(pool, UniqueFunction<void()>{ std::forward<F>(func) }, dependencies);
+	}
+
+	template <class F>
+	JobHandle Schedule(ThreadPool& pool, F&& func, std::initializer_list<JobHandle> dependencies)
+		requires(std::is_invocable_r_v<void, F>)
+	{
+		return Schedule(
+			pool,
+			std::forward<F>(func),
+			std::span{ dependencies.begin(), dependencies.size() });
+	}
+	/** @} */
+
+	/** \name WhenAll
+	 * \brief Creates a job which completes once all provided jobs have.
+	 * \details The returned job does not occupy a worker: it completes on whichever thread
+	 * finishes the last dependency.
+	 * @{ */
+	APOLLO_API JobHandle WhenAll(ThreadPool& pool, std::span<const JobHandle> jobs);
+
+	inline JobHandle WhenAll(ThreadPool& pool, std::initializer_list<JobHandle> jobs)
+	{
+		return WhenAll(pool, std::span{ jobs.begin(), jobs.size() });
+	}
+	/** @} */
+
+	namespace _internal {
+		template <class F>
+		struct ParallelForState
+		{
+			template <class Body>
+			ParallelForState(Body&& body, uint32 first, uint32 last, uint32 minChunk, uint32 div)
+				: m_Body(std::forward<Body>(body))
+				, m_Next(first)
+				, m_End(last)
+				, m_MinChunkSize(minChunk)
+				, m_Divisor(div)
+			{}
+
+			F m_Body;
+			std::atomic_uint32_t m_Next;
+			uint32 m_End;
+			uint32 m_MinChunkSize;
+			uint32 m_Divisor;
+
+			/// Guided self-scheduling: chunks shrink as the remaining range does, which keeps
+			/// the number of atomic operations low while still balancing the tail end
+			bool RunChunk()
+			{
+				uint32 first = m_Next.load(std::memory_order_relaxed);
+				uint32 last;
+				do
+				{
+					if (first >= m_End)
+						return false;
+					const uint32 remaining = m_End - first;
+					last = first + Min(remaining, Max(m_MinChunkSize, remaining / m_Divisor));
+				} while (!m_Next.compare_exchange_weak(first, last, std::memory_order_relaxed));
+
+				if constexpr (std::is_invocable_v<F&, uint32, uint32>)
+				{
+					m_Body(first, last);
+				}
+				else
+				{
+					for (uint32 i = first; i < last; ++i)
+						m_Body(i);
+				}
+				return true;
+			}
+		};
+	} // namespace _internal
+
+	/**
+	 * \brief Runs \p body over the range [\p first, \p last) in parallel.
+	 * \param pool: The thread pool to run on
+	 * \param first, last: The index range
+	 * \param body: Either invocable as `body(uint32 index)`, or as `body(uint32 chunkFirst,
+	 * uint32 chunkLast)` to process whole chunks at once (e.g. to reuse scratch memory between
+	 * iterations). It will be invoked concurrently, possibly from several threads.
+	 * \param minChunkSize: The minimum number of indices processed in a single invocation.
+	 * \param dependencies: Jobs which must complete before the loop can start
+	 * \details The range is not split up front: every job repeatedly grabs a chunk whose size is
+	 * proportional to the remaining work, so that large chunks are handed out first and small ones
+	 * at the end. Busy workers therefore end up with less work than idle ones.
+	 * \returns A handle which completes once the whole range has been processed
+	 */
+	template <class F>
+	JobHandle ParallelFor(
+		ThreadPool& pool,
+		uint32 first,
+		uint32 last,
+		F&& body,
+		uint32 minChunkSize = 1,
+		std::span<const JobHandle> dependencies = {})
+		requires(
+			std::is_invocable_v<std::decay_t<F>&, uint32> ||
+			std::is_invocable_v<std::decay_t<F>&, uint32, uint32>)
+	{
+		if (first >= last)
+			return WhenAll(pool, dependencies);
+
+		minChunkSize = Max(minChunkSize, 1u);
+		const uint32 threadCount = pool.GetThreadCount();
+		const uint32 count = last - first;
+		const uint32 jobCount = Min(threadCount, (count - 1) / minChunkSize + 1);
+
+		using StateType = _internal::ParallelForState<std::decay_t<F>>;
+		auto state = std::make_shared<StateType>(
+			std::forward<F>(body),
+			first,
+			last,
+			minChunkSize,
+			2 * threadCount);
+
+		JobHandle* const jobs = Alloca(JobHandle, jobCount);
+		for (uint32 i = 0; i < jobCount; ++i)
+		{
+			new (jobs + i) JobHandle{ Schedule(
+				pool,
+				[state]()
+				{
+					while (state->RunChunk())
+						;
+				},
+				dependencies) };
+		}
+		JobHandle result = WhenAll(pool, std::span{ jobs, jobCount });
+		std::destroy_n(jobs, jobCount);
+		return result;
+	}
+
+	template <class F>
+	JobHandle JobHandle::Then(F&& func) const requires(std::is_invocable_r_v<void, F>)
+	{
+		APOLLO_ASSERT(m_State, "Called Then on a null job handle");
+		return Schedule(*GetThreadPool(), std::forward<F>(func), { *this });
+	}
+} // namespace apollo::mt
\ No newline at end of file
@@ -275,6 +275,14 @@ namespace apollo::json {
 			return Visit(out_q.x, j, "x") && Visit(out_q.y, j, "y") && Visit(out_q.z, j, "z") &&
 				   Visit(out_q.w, j, "w");
 		}
+
+		static void ToJson(const glm::quat& q, nlohmann::json& out_json)
+		{
+			out_json["x"] = q.x;
+			out_json["y"] = q.y;
+			out_json["z"] = q.z;
+			out_json["w"] = q.w;
+		}
 	};
 
 	template <class T>
@@ -0,0 +1,141 @@
+#include "JsonStream.hpp"
+#include "Log.hpp"
+#include <istream>
+
+namespace apollo::json {
+	/**
+	 * \brief SAX handler building the document, except for the elements of streamed arrays, which
+	 * are built one by one.
+	 * \details m_Stack holds the containers being built. A null entry stands for a streamed array:
+	 * its elements are built in m_Element instead of being appended to the array.
+	 */
+	class StreamParser::Handler
+	{
+	public:
+		using Json = nlohmann::json;
+
+		explicit Handler(StreamParser& parser) noexcept
+			: m_Parser(parser)
+		{}
+
+		bool null() { return HandleValue(Json{}); }
+		bool boolean(bool val) { return HandleValue(Json(val)); }
+		bool number_integer(Json::number_integer_t val) { return HandleValue(Json(val)); }
+		bool number_unsigned(Json::number_unsigned_t val) { return HandleValue(Json(val)); }
+		bool number_float(Json::number_float_t val, const Json::string_t&)
+		{
+			return HandleValue(Json(val));
+		}
+		bool string(Json::string_t& val) { return HandleValue(Json(std::move(val))); }
+		bool binary(Json::binary_t& val) { return HandleValue(Json::binary(std::move(val))); }
+
+		bool start_object(size_t)
+		{
+			m_Stack.emplace_back(Emplace(Json::object()));
+			return true;
+		}
+		bool key(Json::string_t& val)
+		{
+			m_Key = std::move(val);
+			return true;
+		}
+		bool end_object() { return EndContainer(); }
+
+		bool start_array(size_t)
+		{
+			if (m_Stack.size() == 1 && m_Stack[0]->is_object())
+			{
+				for (Stream& stream : m_Parser.m_Streams)
+				{
+					if (stream.m_Key != m_Key)
+						continue;
+					(*m_Stack[0])[m_Key] = Json::array();
+					m_Stream = &stream;
+					m_Stack.emplace_back(nullptr);
+					return true;
+				}
+			}
+			m_Stack.emplace_back(Emplace(Json::array()));
+			return true;
+		}
+		bool end_array()
+		{
+			if (m_Stack.back())
+				return EndContainer();
+			m_Stack.pop_back();
+			m_Stream = nullptr;
+			return true;
+		}
+
+		bool parse_error(size_t, const std::string&, const Json::exception& ex)
+		{
+			APOLLO_LOG_ERROR("Failed to parse JSON: {}", ex.what());
+			return false;
+		}
+
+	private:
+		/// Adds \p value to the current container, or makes it the element of a streamed array
+		Json* Emplace(Json&& value)
+		{
+			if (m_Stack.empty())
+			{
+				m_Parser.m_Root = std::move(value);
+				return &m_Parser.m_Root;
+			}
+			Json* const parent = m_Stack.back();
+			if (!parent)
+			{
+				m_Element = std::move(value);
+				return &m_Element;
+			}
+			if (parent->is_array())
+			{
+				parent->push_back(std::move(value));
+				return &parent->back();
+			}
+			Json& member = (*parent)[m_Key];
+			member = std::move(value);
+			return &member;
+		}
+
+		bool HandleValue(Json&& value)
+		{
+			Emplace(std::move(value));
+			// scalars can be elements of streamed arrays too
+			return m_Stack.empty() || m_Stack.back() || EmitElement();
+		}
+
+		bool EndContainer()
+		{
+			m_Stack.pop_back();
+			return m_Stack.empty() || m_Stack.back() || EmitElement();
+		}
+
+		bool EmitElement()
+		{
+			const bool res = m_Stream->m_Callback(m_Element);
+			m_Element = nullptr;
+			return res;
+		}
+
+		StreamParser& m_Parser;
+		std::vector<Json*> m_Stack;
+		Json::string_t m_Key;
+		Json m_Element;
+		Stream* m_Stream = nullptr;
+	};
+
+	bool StreamParser::Parse(std::istream& stream)
+	{
+		m_Root = nullptr;
+		Handler handler{ *this };
+		return nlohmann::json::sax_parse(stream, &handler);
+	}
+
+	bool StreamParser::Parse(std::string_view str)
+	{
+		m_Root = nullptr;
+		Handler handler{ *this };
+		return nlohmann::json::sax_parse(str.data(), str.data() + str.size(), &handler);
+	}
+} // namespace apollo::json
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+/** \file JsonStream.hpp
+ * \brief Streaming JSON parser, for documents too large to be held in memory at once
+ */
+
+#include <PCH.hpp>
+
+#include "UniqueFunction.hpp"
+#include <iosfwd>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace apollo::json {
+	/**
+	 * \brief Parses a JSON document without building all of it in memory.
+	 * \details The root of the document is expected to be an object. The elements of the arrays
+	 * registered with StreamArray are parsed one at a time: each element is handed to its callback
+	 * as soon as it is complete, then discarded. Everything else is kept, and can be accessed with
+	 * GetRoot() once parsing is done.
+	 *
+	 * Peak memory therefore depends on the size of the largest element, instead of the size of the
+	 * whole document. Elements are regular nlohmann::json values, so they can be loaded with
+	 * json::Visit and json::Converter as usual.
+	 * \warning Elements are destroyed as soon as their callback returns: views into them, like
+	 * std::string_view fields, must not outlive the callback.
+	 */
+	class StreamParser
+	{
+	public:
+		/// \brief Called with each element of a streamed array. Returning false stops parsing.
+		using ElementCallback = UniqueFunction<bool(const nlohmann::json& element)>;
+
+		/**
+		 * \brief Streams the elements of the array found under \p key in the root object.
+		 * \details The array is left empty in the root. If the value under \p key isn't an array,
+		 * it is kept in the root as is.
+		 */
+		template <class F>
+		void StreamArray(std::string_view key, F&& callback)
+			requires(std::is_invocable_r_v<bool, F, const nlohmann::json&>)
+		{
+			m_Streams.emplace_back(
+				Stream{ std::string{ key }, ElementCallback{ std::forward<F>(callback) } });
+		}
+
+		/**
+		 * \name Parse
+		 * \brief Parses a whole document, invoking callbacks as streamed elements get parsed
+		 * \returns false if the document is invalid or a callback returned false. Syntax errors
+		 * are logged.
+		 * @{
+		 */
+		APOLLO_API bool Parse(std::istream& stream);
+		APOLLO_API bool Parse(std::string_view str);
+		/** @} */
+
+		/// \brief The document, without the elements of streamed arrays
+		[[nodiscard]] const nlohmann::json& GetRoot() const noexcept { return m_Root; }
+
+	private:
+		struct Stream
+		{
+			std::string m_Key;
+			ElementCallback m_Callback;
+		};
+
+		class Handler;
+
+		std::vector<Stream> m_Streams;
+		nlohmann::json m_Root;
+	};
+} // namespace apollo::json
\ No newline at end of file
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <unordered_map>
+#include "FlatHashMap.hpp"
 
 /**
  * \file Map.hpp
@@ -15,12 +15,15 @@ namespace apollo {
 	struct HashedString;
 
 	/**
-	 * \brief std::unordered_map specialization using apollo::Hash
+	 * \brief FlatHashMap specialization using apollo::Hash
 
 	 This is typically the specialization used all across the engine.
+	 \warning Unlike std::unordered_map, insertions can invalidate references to existing elements.
+	 Maps which hand out pointers to their elements should only be filled up once, or store their
+	 values behind a pointer.
 	 */
 	template <class K, class T>
-	using HashMap = std::unordered_map<K, T, Hash<K>>;
+	using HashMap = FlatHashMap<K, T, Hash<K>>;
 
 	template <class T>
 	using ULIDMap = HashMap<ULID, T>;
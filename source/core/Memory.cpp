@@ -1,58 +1,84 @@
 #include "Memory.hpp"
 #include <core/Assert.hpp>
+#include <bit>
 #include <core/Bit.hpp>
 #include <memory_resource>
+#include <thread>
 
 namespace apollo {
 	struct MemoryPool::Chunk
 	{
+		/// \brief Number of blocks tracked by each bit of the summary bitmap
+		/// \details A summary bit is set when all blocks of its group are allocated, which lets
+		/// searches skip full groups without looking at their bits.
+		static constexpr uint32 GroupSize = 4096;
+
 		Chunk* m_Next = nullptr;
 		uint32 m_Capacity = 0;
-		uint32 m_FirstAvailable = 0;
+		uint32 m_FirstAvailable = 0; /*!< All blocks before this one are allocated */
 		uint32 m_ByteSize = 0;
 
+		/// Size of the block bitmap, in words
+		[[nodiscard]] static uint32 GetBitsetSize(uint32 capacity) noexcept
+		{
+			return (capacity - 1) / 64 + 1;
+		}
+		/// Size of the group bitmap, in words
+		[[nodiscard]] static uint32 GetSummarySize(uint32 capacity) noexcept
+		{
+			return (capacity - 1) / (64 * GroupSize) + 1;
+		}
+		/// Total size of a chunk: header, blocks, then both bitmaps
+		[[nodiscard]] static uint32 GetAllocationSize(uint32 capacity, uint32 byteSize) noexcept
+		{
+			const uint32 numWords = GetBitsetSize(capacity) + GetSummarySize(capacity);
+			return sizeof(Chunk) + byteSize + numWords * sizeof(uint64);
+		}
+
 		void* GetBuffer() noexcept { return this + 1; }
 		[[nodiscard]] uint64* GetBits(PointerDiff pos = 0)
 		{
 			pos.m_Value += m_ByteSize;
 			return static_cast<uint64*>(GetBuffer() + pos);
 		}
+		[[nodiscard]] uint64* GetSummary() { return GetBits() + GetBitsetSize(m_Capacity); }
+		[[nodiscard]] uint32 GetGroupCount() const noexcept
+		{
+			return (m_Capacity - 1) / GroupSize + 1;
+		}
 
 		void* TryAllocateBlocks(uint32 n, uint32 blockSize)
 		{
 			if (n > (m_Capacity - m_FirstAvailable))
 				return nullptr;
 
-			uint64* const state = GetBits();
-			BitIterator pos{ state + m_FirstAvailable / 64, m_FirstAvailable % 64 };
-			BitIterator end{ state + m_Capacity / 64, m_Capacity % 64 };
-			uint32 runLength = 0;
-			uint32 offset = m_FirstAvailable;
-
-			for (auto it = pos; it != end; ++it)
+			const uint64* const bits = GetBits();
+			const uint64* const summary = GetSummary();
+			const uint32 numGroups = GetGroupCount();
+			uint32 offset = m_Capacity;
+			// runs can't go through full groups: search each span of non full groups separately
+			for (uint32 pos = m_FirstAvailable; pos < m_Capacity;)
 			{
-				++runLength;
-				if (*it)
+				const uint32 group = uint32(FindBit(summary, pos / GroupSize, numGroups, false));
+				if (group == numGroups)
+					break;
+				const uint32 nextFull = uint32(FindBit(summary, group, numGroups, true));
+				const uint32 first = Max(pos, group * GroupSize);
+				const uint32 last = Min(m_Capacity, nextFull * GroupSize);
+				if (const size_t res = FindZeroRun(bits, first, last, n); res != last)
 				{
-					++(pos = it);
-					offset += runLength;
-					runLength = 0;
-					continue;
+					offset = uint32(res);
+					break;
 				}
-				else if (runLength == n)
-					goto DO_ALLOCATE;
+				pos = last;
 			}
-			return nullptr;
+			if (offset == m_Capacity)
+				return nullptr;
 
-		DO_ALLOCATE:
+			SetBits(GetBits(), offset, n);
 			if (offset == m_FirstAvailable)
-			{
-				m_FirstAvailable += n;
-			}
-			while (n--)
-			{
-				pos.Set()++;
-			}
+				m_FirstAvailable = uint32(FindBit(bits, offset + n, m_Capacity, false));
+			UpdateSummary(offset, n);
 			return GetBuffer() + PointerDiff{ offset * blockSize };
 		}
 		bool TryDeallocate(void* ptr, uint32 n, uint32 blockSize)
@@ -66,22 +92,41 @@ namespace apollo {
 			if (offset >= m_Capacity)
 				return false;
 
-			BitIterator it{ GetBits() + offset / 64, offset % 64 };
+			uint64* const bits = GetBits();
+			APOLLO_ASSERT(
+				FindBit(bits, offset, offset + n, false) == offset + n,
+				"Some blocks at address {} were already free",
+				ptr);
+			ClearBits(bits, offset, n);
+			const uint32 firstGroup = offset / GroupSize;
+			const uint32 lastGroup = (offset + n - 1) / GroupSize;
+			ClearBits(GetSummary(), firstGroup, lastGroup - firstGroup + 1);
 			m_FirstAvailable = Min(offset, m_FirstAvailable);
-			while (n--)
-			{
-				APOLLO_ASSERT(*it, "Block at address {} was already free", ptr);
-				it.Clear()++;
-			}
 
 			return true;
 		}
 
+		/// \brief Flags the groups overlapping [offset, offset + n) which became full
+		void UpdateSummary(uint32 offset, uint32 n)
+		{
+			const uint64* const bits = GetBits();
+			uint64* const summary = GetSummary();
+			const uint32 lastGroup = (offset + n - 1) / GroupSize;
+			for (uint32 group = offset / GroupSize; group <= lastGroup; ++group)
+			{
+				// blocks before m_FirstAvailable are known to be allocated
+				const uint32 first = Max(group * GroupSize, m_FirstAvailable);
+				const uint32 last = Min(m_Capacity, (group + 1) * GroupSize);
+				if (first >= last || FindBit(bits, first, last, false) == last)
+					SetBits(summary, group, 1);
+			}
+		}
+
 		void Clear()
 		{
 			m_FirstAvailable = 0;
 			uint64* it = GetBits();
-			uint64* end = it + (m_Capacity - 1) / 64 + 1;
+			uint64* end = it + GetBitsetSize(m_Capacity) + GetSummarySize(m_Capacity);
 			while (it != end)
 				*it++ = 0;
 		}
@@ -142,35 +187,23 @@ namespace apollo {
 
 	MemoryPool::Chunk* MemoryPool::AllocateChunk(uint32 n, uint32 prealloc)
 	{
-		const uint32 bitsetSize = ((n - 1) / 64 + 1);
 		const uint32 chunkSize = Align(n * m_BlockSize, alignof(uint64));
 		n = chunkSize / m_BlockSize; // re-compute block count to account for padding
 
-		const PointerDiff bitsetOffset = sizeof(Chunk) + chunkSize;
-		const uint32 allocSize = bitsetOffset + bitsetSize * 8;
-
-		void* ptr = m_UpstreamResource->allocate(allocSize, alignof(Chunk));
+		void* ptr = m_UpstreamResource->allocate(
+			Chunk::GetAllocationSize(n, chunkSize),
+			alignof(Chunk));
 
 		Chunk* chunk = new (ptr) Chunk{
 			.m_Capacity = n,
-			.m_FirstAvailable = prealloc,
 			.m_ByteSize = chunkSize,
 		};
-		uint64* it = static_cast<uint64*>(ptr + bitsetOffset);
-		uint64* const end = it + bitsetSize;
-
-		while (prealloc >= 64)
+		chunk->Clear();
+		chunk->m_FirstAvailable = prealloc;
+		if (prealloc)
 		{
-			*it++ = ~0ull;
-			prealloc -= 64;
-		}
-		if (const uint64 tail = (1ull << prealloc) - 1)
-		{
-			*it++ = tail;
-		}
-		while (it != end)
-		{
-			*it++ = 0;
+			SetBits(chunk->GetBits(), 0, prealloc);
+			chunk->UpdateSummary(0, prealloc);
 		}
 		return chunk;
 	}
@@ -178,10 +211,9 @@ namespace apollo {
 	MemoryPool::Chunk* MemoryPool::DeallocateChunk(Chunk* ptr)
 	{
 		Chunk* const next = ptr->m_Next;
-		const uint32 bitsetSize = (ptr->m_Capacity - 1) / 64 + 1;
 		m_UpstreamResource->deallocate(
 			ptr,
-			sizeof(Chunk) + ptr->m_ByteSize + 8 * bitsetSize,
+			Chunk::GetAllocationSize(ptr->m_Capacity, ptr->m_ByteSize),
 			alignof(Chunk));
 
 		return next;
@@ -192,6 +224,357 @@ namespace apollo {
 		for (auto it = m_First; it; it = it->m_Next)
 			it->Clear();
 	}
+
+	/// Header placed at the start of each slab, blocks follow it
+	struct alignas(64) ConcurrentMemoryPool::Slab
+	{
+		ThreadCache* m_Owner = nullptr;
+		Slab* m_Next = nullptr;
+	};
+
+	struct alignas(64) ConcurrentMemoryPool::ThreadCache
+	{
+		/// Free blocks store a pointer to the next one
+		struct Block
+		{
+			Block* m_Next;
+		};
+
+		explicit ThreadCache(std::thread::id thread) noexcept
+			: m_Thread(thread)
+		{}
+
+		const std::thread::id m_Thread;
+		/* Only ever accessed by the owning thread */
+		Block* m_FreeList = nullptr;
+		std::byte* m_BumpPtr = nullptr;
+		std::byte* m_BumpEnd = nullptr;
+		Slab* m_Slabs = nullptr;
+		/// Blocks freed by other threads, on a cache line of its own
+		alignas(64) std::atomic<Block*> m_RemoteFree = nullptr;
+	};
+
+	namespace {
+		/// IDs of the resources keeping per-thread state, never reused
+		std::atomic_uint64_t g_NextResourceId = 1;
+
+		/// \brief Remembers the per-thread state used by the calling thread in the last few
+		/// resources it allocated from
+		/// \details Since resource IDs are never reused, entries of destroyed resources can't be
+		/// mistaken for those of new ones.
+		struct ThreadStateCache
+		{
+			struct Entry
+			{
+				uint64 m_ResourceId = 0;
+				void* m_State = nullptr;
+			};
+
+			[[nodiscard]] void* Find(uint64 resourceId) const noexcept
+			{
+				for (const Entry& entry : m_Entries)
+				{
+					if (entry.m_ResourceId == resourceId)
+						return entry.m_State;
+				}
+				return nullptr;
+			}
+			void Add(uint64 resourceId, void* state) noexcept
+			{
+				m_Entries[m_Next] = { resourceId, state };
+				m_Next = (m_Next + 1) % std::size(m_Entries);
+			}
+
+			Entry m_Entries[4];
+			uint32 m_Next = 0;
+		};
+		thread_local ThreadStateCache t_ThreadStates;
+
+		/// Finds the state owned by the calling thread, or creates it. The list must be locked.
+		template <class State, class... Args>
+		State& FindOrAddThreadState(std::vector<std::unique_ptr<State>>& states, Args&&... args)
+		{
+			const std::thread::id thread = std::this_thread::get_id();
+			for (const auto& state : states)
+			{
+				if (state->m_Thread == thread)
+					return *state;
+			}
+			return *states.emplace_back(
+				std::make_unique<State>(thread, std::forward<Args>(args)...));
+		}
+	} // namespace
+
+	ConcurrentMemoryPool::ConcurrentMemoryPool(
+		uint32 blockSize,
+		uint32 slabSize,
+		std::pmr::memory_resource* upstreamResource)
+		: m_UpstreamResource(upstreamResource ? upstreamResource : std::pmr::new_delete_resource())
+		, m_BlockSize(Align(Max(blockSize, 1u), alignof(ThreadCache::Block)))
+		, m_SlabSize(slabSize)
+		, m_Id(g_NextResourceId.fetch_add(1, std::memory_order_relaxed))
+	{
+		APOLLO_ASSERT(blockSize, "Passed 0 as the block size to ConcurrentMemoryPool");
+		APOLLO_ASSERT(
+			std::has_single_bit(slabSize) && slabSize >= sizeof(Slab) + m_BlockSize,
+			"Invalid slab size {} for blocks of {} bytes",
+			slabSize,
+			m_BlockSize);
+		// blocks start on a slab header boundary, and are laid out every m_BlockSize bytes
+		m_BlockAlignment = Min(uint32(alignof(Slab)), 1u << std::countr_zero(m_BlockSize));
+	}
+
+	ConcurrentMemoryPool::~ConcurrentMemoryPool()
+	{
+		for (const auto& cache : m_Caches)
+		{
+			for (Slab* slab = cache->m_Slabs; slab;)
+			{
+				Slab* const next = slab->m_Next;
+				m_UpstreamResource->deallocate(slab, m_SlabSize, m_SlabSize);
+				slab = next;
+			}
+		}
+	}
+
+	void* ConcurrentMemoryPool::AllocateBlock()
+	{
+		ThreadCache& cache = GetThreadCache();
+		if (!cache.m_FreeList)
+		{
+			if (cache.m_BumpPtr != cache.m_BumpEnd)
+			{
+				void* const ptr = cache.m_BumpPtr;
+				cache.m_BumpPtr += m_BlockSize;
+				return ptr;
+			}
+			// take back everything other threads have freed in one go
+			cache.m_FreeList = cache.m_RemoteFree.exchange(nullptr, std::memory_order_acquire);
+			if (!cache.m_FreeList)
+				return AllocateSlab(cache);
+		}
+
+		ThreadCache::Block* const block = cache.m_FreeList;
+		cache.m_FreeList = block->m_Next;
+		return block;
+	}
+
+	void ConcurrentMemoryPool::DeallocateBlock(void* ptr) noexcept
+	{
+		if (!ptr)
+			return;
+
+		const uintptr_t slabAddress = reinterpret_cast<uintptr_t>(ptr) & ~uintptr_t(m_SlabSize - 1);
+		ThreadCache& owner = *reinterpret_cast<Slab*>(slabAddress)->m_Owner;
+		ThreadCache::Block* const block = static_cast<ThreadCache::Block*>(ptr);
+		if (owner.m_Thread == std::this_thread::get_id())
+		{
+			block->m_Next = owner.m_FreeList;
+			owner.m_FreeList = block;
+			return;
+		}
+
+		// only the owner pops from the remote stack, and it always takes the whole of it: the
+		// usual ABA problem of lock-free stacks can't happen
+		block->m_Next = owner.m_RemoteFree.load(std::memory_order_relaxed);
+		while (!owner.m_RemoteFree.compare_exchange_weak(
+			block->m_Next,
+			block,
+			std::memory_order_release,
+			std::memory_order_relaxed))
+		{}
+	}
+
+	uint32 ConcurrentMemoryPool::GetThreadCacheCount() const
+	{
+		std::unique_lock lock{ m_Mutex };
+		return uint32(m_Caches.size());
+	}
+
+	auto ConcurrentMemoryPool::GetThreadCache() -> ThreadCache&
+	{
+		if (void* cache = t_ThreadStates.Find(m_Id))
+			return *static_cast<ThreadCache*>(cache);
+
+		std::unique_lock lock{ m_Mutex };
+		ThreadCache& cache = FindOrAddThreadState(m_Caches);
+		t_ThreadStates.Add(m_Id, &cache);
+		return cache;
+	}
+
+	void* ConcurrentMemoryPool::AllocateSlab(ThreadCache& cache)
+	{
+		void* ptr = nullptr;
+		{
+			std::unique_lock lock{ m_Mutex };
+			ptr = m_UpstreamResource->allocate(m_SlabSize, m_SlabSize);
+		}
+
+		Slab* const slab = new (ptr) Slab{ .m_Owner = &cache, .m_Next = cache.m_Slabs };
+		cache.m_Slabs = slab;
+
+		std::byte* const blocks = static_cast<std::byte*>(ptr) + sizeof(Slab);
+		const uint32 numBlocks = (m_SlabSize - sizeof(Slab)) / m_BlockSize;
+		// the first block is returned right away, the rest is handed out as needed
+		cache.m_BumpPtr = blocks + m_BlockSize;
+		cache.m_BumpEnd = blocks + numBlocks * m_BlockSize;
+		return blocks;
+	}
+
+	/// Header of the blocks obtained from upstream, the usable memory follows it
+	struct alignas(std::max_align_t) FrameArena::Block
+	{
+		Block* m_Next = nullptr;
+		size_t m_Size = 0; /*!< Usable size, header excluded */
+
+		[[nodiscard]] std::byte* GetBegin() noexcept
+		{
+			return reinterpret_cast<std::byte*>(this + 1);
+		}
+		[[nodiscard]] std::byte* GetEnd() noexcept { return GetBegin() + m_Size; }
+	};
+
+	struct alignas(64) FrameArena::ThreadArena
+	{
+		/// A frame's blocks, the ones before m_Current are used up
+		struct Frame
+		{
+			Block* m_First = nullptr;
+			Block* m_Current = nullptr;
+			std::byte* m_Ptr = nullptr;
+			std::byte* m_End = nullptr;
+
+			void Reset() noexcept
+			{
+				m_Current = m_First;
+				m_Ptr = m_First ? m_First->GetBegin() : nullptr;
+				m_End = m_First ? m_First->GetEnd() : nullptr;
+			}
+		};
+
+		ThreadArena(std::thread::id thread, uint32 numFrames)
+			: m_Thread(thread)
+			, m_Frames(std::make_unique<Frame[]>(numFrames))
+		{}
+
+		const std::thread::id m_Thread;
+		std::unique_ptr<Frame[]> m_Frames;
+	};
+
+	FrameArena::FrameArena(
+		uint32 numFrames,
+		uint32 blockSize,
+		std::pmr::memory_resource* upstreamResource)
+		: m_UpstreamResource(upstreamResource ? upstreamResource : std::pmr::new_delete_resource())
+		, m_NumFrames(numFrames)
+		, m_BlockSize(blockSize)
+		, m_Id(g_NextResourceId.fetch_add(1, std::memory_order_relaxed))
+	{
+		APOLLO_ASSERT(numFrames, "Passed 0 as the frame count to FrameArena");
+		APOLLO_ASSERT(blockSize, "Passed 0 as the block size to FrameArena");
+	}
+
+	FrameArena::~FrameArena()
+	{
+		for (const auto& arena : m_Arenas)
+		{
+			for (uint32 i = 0; i < m_NumFrames; ++i)
+			{
+				for (Block* block = arena->m_Frames[i].m_First; block;)
+				{
+					Block* const next = block->m_Next;
+					m_UpstreamResource->deallocate(
+						block,
+						sizeof(Block) + block->m_Size,
+						alignof(Block));
+					block = next;
+				}
+			}
+		}
+	}
+
+	void FrameArena::NextFrame()
+	{
+		const uint32 index = (m_FrameIndex.load(std::memory_order_relaxed) + 1) % m_NumFrames;
+		std::unique_lock lock{ m_Mutex };
+		for (const auto& arena : m_Arenas)
+			arena->m_Frames[index].Reset();
+		m_FrameIndex.store(index, std::memory_order_relaxed);
+	}
+
+	size_t FrameArena::GetUsedSize() const
+	{
+		const uint32 index = m_FrameIndex.load(std::memory_order_relaxed);
+		size_t size = 0;
+		std::unique_lock lock{ m_Mutex };
+		for (const auto& arena : m_Arenas)
+		{
+			const ThreadArena::Frame& frame = arena->m_Frames[index];
+			if (!frame.m_Current)
+				continue;
+			for (Block* block = frame.m_First; block != frame.m_Current; block = block->m_Next)
+				size += block->m_Size;
+			size += frame.m_Ptr - frame.m_Current->GetBegin();
+		}
+		return size;
+	}
+
+	void* FrameArena::do_allocate(size_t n, size_t alignment)
+	{
+		ThreadArena& arena = GetThreadArena();
+		ThreadArena::Frame& frame = arena.m_Frames[m_FrameIndex.load(std::memory_order_relaxed)];
+		if (frame.m_Ptr)
+		{
+			const uintptr_t address = reinterpret_cast<uintptr_t>(frame.m_Ptr);
+			const size_t padding = (alignment - address % alignment) % alignment;
+			if (size_t(frame.m_End - frame.m_Ptr) >= padding + n)
+			{
+				std::byte* const ptr = frame.m_Ptr + padding;
+				frame.m_Ptr = ptr + n;
+				return ptr;
+			}
+		}
+		return AllocateFromNewBlock(arena, n, alignment);
+	}
+
+	auto FrameArena::GetThreadArena() -> ThreadArena&
+	{
+		if (void* arena = t_ThreadStates.Find(m_Id))
+			return *static_cast<ThreadArena*>(arena);
+
+		std::unique_lock lock{ m_Mutex };
+		ThreadArena& arena = FindOrAddThreadState(m_Arenas, m_NumFrames);
+		t_ThreadStates.Add(m_Id, &arena);
+		return arena;
+	}
+
+	void* FrameArena::AllocateFromNewBlock(ThreadArena& arena, size_t n, size_t alignment)
+	{
+		ThreadArena::Frame& frame = arena.m_Frames[m_FrameIndex.load(std::memory_order_relaxed)];
+		// blocks are aligned on max_align_t, bigger alignments may need padding
+		const size_t required = n + (alignment > alignof(Block) ? alignment : 0);
+
+		// blocks kept from previous frames come first
+		Block* block = frame.m_Current ? frame.m_Current->m_Next : frame.m_First;
+		if (!block || block->m_Size < required)
+		{
+			const size_t size = Max(size_t(m_BlockSize), required);
+			void* ptr = nullptr;
+			{
+				std::unique_lock lock{ m_Mutex };
+				ptr = m_UpstreamResource->allocate(sizeof(Block) + size, alignof(Block));
+			}
+			block = new (ptr) Block{ .m_Next = block, .m_Size = size };
+			(frame.m_Current ? frame.m_Current->m_Next : frame.m_First) = block;
+		}
+
+		frame.m_Current = block;
+		const uintptr_t address = reinterpret_cast<uintptr_t>(block->GetBegin());
+		std::byte* const ptr = block->GetBegin() + (alignment - address % alignment) % alignment;
+		frame.m_Ptr = ptr + n;
+		frame.m_End = block->GetEnd();
+		return ptr;
+	}
 } // namespace apollo
 
 #undef VOID_PTR_ADD
\ No newline at end of file
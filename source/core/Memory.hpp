@@ -3,8 +3,12 @@
 /** \file Memory.hpp */
 
 #include <PCH.hpp>
+#include <atomic>
+#include <memory>
 #include <memory_resource>
+#include <mutex>
 #include <type_traits>
+#include <vector>
 
 namespace apollo {
 	/// \brief Generic memory resource, compatible with std::pmr::memory_resource
@@ -130,7 +134,9 @@ namespace apollo {
 	/// blocks
 	/// \details The pool maintains a linked list of chunks. Each chunk consists of a header,
 	/// the actual buffer containing a whole number of blocks and a bit set which tracks the
-	/// state of each block.
+	/// state of each block. A second bit set flags groups of 4096 blocks which are entirely
+	/// allocated, so that searching a mostly full chunk for free blocks can skip over them.
+	/// Both are scanned a whole word at a time.
 	/// \warning This resource ignores the alignment operator specified through the `allocate`
 	/// function. The returned address will be aligned to a block boundary, so you should make
 	/// sure whatever block size you specify includes additional padding to adhere to specific
@@ -264,6 +270,184 @@ namespace apollo {
 		Chunk* m_First = nullptr;
 	};
 
+	/// \brief Thread-safe fixed size block allocator, with a private cache for each thread
+	/// \details Each thread that allocates from the pool gets its own cache: a free list, the
+	/// unused tail of the slab it last obtained from upstream and a lock-free stack of blocks freed
+	/// by other threads. Allocating and deallocating never take a lock, unless the calling thread
+	/// has to fetch a new slab.
+	///
+	/// Slabs are aligned to their own size, and start with a header which points to the owning
+	/// cache. A block freed by a thread that doesn't own it is pushed onto the owner's remote
+	/// stack, which the owner takes back all at once when its free list runs dry. Blocks thus
+	/// always return to the thread which carved them out of a slab.
+	///
+	/// Requests bigger than the block size, or which need a stricter alignment than blocks
+	/// provide, are forwarded to the upstream resource. Calls to the upstream resource are
+	/// serialized by the pool, so it doesn't need to be thread-safe itself.
+	/// \warning Memory is only released to the upstream resource when the pool gets destroyed,
+	/// including the caches of threads which have exited in the meantime. The pool is meant
+	/// for long lived threads, such as \ref ThreadPool workers.
+	class ConcurrentMemoryPool : public std::pmr::memory_resource
+	{
+	public:
+		static constexpr uint32 DefaultSlabSize = 64 * 1024;
+
+		/// \brief Creates a new pool. No memory is allocated until the first allocation.
+		/// \param blockSize: The size of each block. Rounded up to a multiple of 8 bytes.
+		/// \param slabSize: The size of the slabs requested from upstream. Must be a power of 2
+		/// big enough to fit at least one block.
+		/// \param upstreamResource: The resource to get slabs from. Defaults to
+		/// [std::pmr::new_delete_resource()](https://en.cppreference.com/w/cpp/memory/new_delete_resource.html).
+		APOLLO_API ConcurrentMemoryPool(
+			uint32 blockSize,
+			uint32 slabSize = DefaultSlabSize,
+			std::pmr::memory_resource* upstreamResource = nullptr);
+		APOLLO_API ~ConcurrentMemoryPool();
+
+		ConcurrentMemoryPool(const ConcurrentMemoryPool&) = delete;
+		ConcurrentMemoryPool& operator=(const ConcurrentMemoryPool&) = delete;
+
+		[[nodiscard]] uint32 GetBlockSize() const noexcept { return m_BlockSize; }
+		[[nodiscard]] uint32 GetSlabSize() const noexcept { return m_SlabSize; }
+		/// \brief The alignment guaranteed for every block
+		[[nodiscard]] uint32 GetBlockAlignment() const noexcept { return m_BlockAlignment; }
+		[[nodiscard]] std::pmr::memory_resource& GetUpstreamResource() const noexcept
+		{
+			return *m_UpstreamResource;
+		}
+
+		/// \brief Allocates a single block, from the calling thread's cache
+		[[nodiscard]] APOLLO_API void* AllocateBlock();
+		/// \brief Returns a block to the cache of the thread which allocated it. Can be called
+		/// from any thread.
+		APOLLO_API void DeallocateBlock(void* ptr) noexcept;
+
+		/// \brief Number of threads which have allocated from this pool so far
+		[[nodiscard]] APOLLO_API uint32 GetThreadCacheCount() const;
+
+		template <class T>
+		[[nodiscard]] std::pmr::polymorphic_allocator<T> GetPolymorphicAllocator() noexcept
+		{
+			return { this };
+		}
+
+	private:
+		void* do_allocate(size_t n, size_t alignment) override
+		{
+			if (IsPooled(n, alignment))
+				return AllocateBlock();
+			std::unique_lock lock{ m_Mutex };
+			return m_UpstreamResource->allocate(n, alignment);
+		}
+		void do_deallocate(void* ptr, size_t n, size_t alignment) override
+		{
+			if (IsPooled(n, alignment))
+				return DeallocateBlock(ptr);
+			std::unique_lock lock{ m_Mutex };
+			m_UpstreamResource->deallocate(ptr, n, alignment);
+		}
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+		{
+			return this == &other;
+		}
+
+		[[nodiscard]] bool IsPooled(size_t n, size_t alignment) const noexcept
+		{
+			return n <= m_BlockSize && alignment <= m_BlockAlignment;
+		}
+
+		struct Slab;
+		struct ThreadCache;
+		ThreadCache& GetThreadCache();
+		void* AllocateSlab(ThreadCache& cache);
+
+		std::pmr::memory_resource* m_UpstreamResource = nullptr;
+		uint32 m_BlockSize = 0;
+		uint32 m_SlabSize = 0;
+		uint32 m_BlockAlignment = 0;
+		const uint64 m_Id; /*!< Never reused, identifies the pool in thread local lookups */
+		/// Guards the list of caches and calls to the upstream resource
+		mutable std::mutex m_Mutex;
+		std::vector<std::unique_ptr<ThreadCache>> m_Caches;
+	};
+
+	/// \brief Linear allocator for memory which only lives for a few frames
+	/// \details Allocating bumps a pointer, and deallocating does nothing: all memory allocated
+	/// during a frame is released at once, when the arena comes back to that frame's buffers.
+	/// There is one set of buffers for each of the frames in flight, so that memory allocated in
+	/// a frame stays valid until \ref FrameArena::NextFrame "NextFrame()" has been called
+	/// `GetFrameCount()` times.
+	///
+	/// Each thread allocates from its own sub-arena, without taking any lock. Memory is obtained
+	/// from the upstream resource in blocks which are kept for reuse in later frames, so that a
+	/// steady state frame never touches the upstream resource.
+	class FrameArena : public std::pmr::memory_resource
+	{
+	public:
+		static constexpr uint32 DefaultBlockSize = 256 * 1024;
+
+		/// \param numFrames: The number of frames in flight, each of them with their own buffers
+		/// \param blockSize: The size of the blocks requested from the upstream resource. Bigger
+		/// allocations get a block of their own.
+		/// \param upstreamResource: The resource to get blocks from. Defaults to
+		/// [std::pmr::new_delete_resource()](https://en.cppreference.com/w/cpp/memory/new_delete_resource.html).
+		APOLLO_API explicit FrameArena(
+			uint32 numFrames = 2,
+			uint32 blockSize = DefaultBlockSize,
+			std::pmr::memory_resource* upstreamResource = nullptr);
+		APOLLO_API ~FrameArena();
+
+		FrameArena(const FrameArena&) = delete;
+		FrameArena& operator=(const FrameArena&) = delete;
+
+		[[nodiscard]] uint32 GetFrameCount() const noexcept { return m_NumFrames; }
+		[[nodiscard]] uint32 GetBlockSize() const noexcept { return m_BlockSize; }
+		/// \brief Index of the buffers in use for the current frame, in [0, GetFrameCount())
+		[[nodiscard]] uint32 GetFrameIndex() const noexcept
+		{
+			return m_FrameIndex.load(std::memory_order_relaxed);
+		}
+
+		/// \brief Moves on to the next frame's buffers, and releases everything which was
+		/// allocated in them
+		/// \warning No other thread may be allocating from the arena during this call
+		APOLLO_API void NextFrame();
+
+		/// \brief Bytes allocated during the current frame by all threads, alignment padding
+		/// included. Only accurate if no other thread is allocating.
+		[[nodiscard]] APOLLO_API size_t GetUsedSize() const;
+
+		template <class T>
+		[[nodiscard]] std::pmr::polymorphic_allocator<T> GetPolymorphicAllocator() noexcept
+		{
+			return { this };
+		}
+
+	private:
+		struct Block;
+		struct ThreadArena;
+
+		void* do_allocate(size_t n, size_t alignment) override;
+		/// Memory is released in bulk by NextFrame
+		void do_deallocate(void*, size_t, size_t) override {}
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+		{
+			return this == &other;
+		}
+
+		ThreadArena& GetThreadArena();
+		void* AllocateFromNewBlock(ThreadArena& arena, size_t n, size_t alignment);
+
+		std::pmr::memory_resource* m_UpstreamResource = nullptr;
+		uint32 m_NumFrames = 0;
+		uint32 m_BlockSize = 0;
+		std::atomic_uint32_t m_FrameIndex = 0;
+		const uint64 m_Id; /*!< Never reused, identifies the arena in thread local lookups */
+		/// Guards the list of sub-arenas and calls to the upstream resource
+		mutable std::mutex m_Mutex;
+		std::vector<std::unique_ptr<ThreadArena>> m_Arenas;
+	};
+
 	// =================================================================
 
 	template <class T>
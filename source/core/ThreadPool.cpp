@@ -0,0 +1,205 @@
+#include "ThreadPool.hpp"
+
+namespace {
+	/// Number of failed attempts at finding a job before an idle worker parks itself
+	constexpr uint32 g_SpinCount = 64;
+
+	struct WorkerContext
+	{
+		const apollo::mt::ThreadPool* m_Pool = nullptr;
+		uint32 m_Index = 0;
+	};
+
+	thread_local WorkerContext t_CurrentWorker;
+} // namespace
+
+namespace apollo::mt {
+	struct ThreadPool::Worker
+	{
+		explicit Worker(uint32 index)
+			: m_Index(index)
+			, m_RngState(0x9e3779b9u * (index + 1))
+		{}
+
+		/// xorshift32, only used to pick the first victim when stealing
+		uint32 NextRandom() noexcept
+		{
+			m_RngState ^= m_RngState << 13;
+			m_RngState ^= m_RngState >> 17;
+			m_RngState ^= m_RngState << 5;
+			return m_RngState;
+		}
+
+		WorkStealingDeque<JobType> m_Jobs;
+		uint32 m_Index;
+		uint32 m_RngState;
+	};
+
+	ThreadPool::ThreadPool(uint32 n)
+	{
+		m_Workers.reserve(n);
+		for (uint32 i = 0; i < n; ++i)
+			m_Workers.emplace_back(std::make_unique<Worker>(i));
+
+		m_Threads.reserve(n);
+		for (uint32 i = 0; i < n; ++i)
+			m_Threads.emplace_back(&ThreadPool::Loop, this, i);
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		Stop();
+		for (std::thread& th : m_Threads)
+			th.join();
+
+		// all threads are gone, we can safely drain the queues from here
+		for (auto& worker : m_Workers)
+		{
+			while (JobType* job = worker->m_Jobs.Pop())
+				delete job;
+		}
+		while (m_InjectedJobs.GetSize())
+			delete m_InjectedJobs.PopAndGetFront();
+	}
+
+	bool ThreadPool::IsWorkerThread() const noexcept
+	{
+		return t_CurrentWorker.m_Pool == this;
+	}
+
+	void ThreadPool::Stop()
+	{
+		m_Running = false;
+		++m_WakeEpoch;
+		m_WakeEpoch.notify_all();
+	}
+
+	void ThreadPool::Submit(JobType* job)
+	{
+		if (t_CurrentWorker.m_Pool == this)
+		{
+			m_Workers[t_CurrentWorker.m_Index]->m_Jobs.Push(job);
+		}
+		else
+		{
+			std::unique_lock lock{ m_InjectionMutex };
+			m_InjectedJobs.AddEmplace(job);
+			++m_InjectedCount;
+		}
+		WakeOne();
+	}
+
+	void ThreadPool::WakeOne()
+	{
+		// pairs with the fence in Park(): either the sleeper sees the new job, or we see the
+		// sleeper
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (!m_SleepingCount.load(std::memory_order_relaxed))
+			return;
+
+		++m_WakeEpoch;
+		m_WakeEpoch.notify_one();
+	}
+
+	void ThreadPool::Park()
+	{
+		const uint32 epoch = m_WakeEpoch.load();
+		++m_SleepingCount;
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		if (m_Running && !HasPendingJobs())
+			m_WakeEpoch.wait(epoch);
+
+		--m_SleepingCount;
+	}
+
+	bool ThreadPool::HasPendingJobs() const noexcept
+	{
+		if (m_InjectedCount.load(std::memory_order_relaxed))
+			return true;
+
+		for (const auto& worker : m_Workers)
+		{
+			if (!worker->m_Jobs.IsEmpty())
+				return true;
+		}
+		return false;
+	}
+
+	auto ThreadPool::PopInjectedJob() -> JobType*
+	{
+		if (!m_InjectedCount.load(std::memory_order_acquire))
+			return nullptr;
+
+		std::unique_lock lock{ m_InjectionMutex };
+		if (!m_InjectedJobs.GetSize())
+			return nullptr;
+
+		--m_InjectedCount;
+		return m_InjectedJobs.PopAndGetFront();
+	}
+
+	auto ThreadPool::FindJob(Worker* worker) -> JobType*
+	{
+		if (worker)
+		{
+			if (JobType* job = worker->m_Jobs.Pop())
+				return job;
+		}
+
+		if (JobType* job = PopInjectedJob())
+			return job;
+
+		const uint32 n = NumCast<uint32>(m_Workers.size());
+		const uint32 start = worker ? worker->NextRandom() % n : 0;
+		for (uint32 i = 0; i < n; ++i)
+		{
+			Worker* const victim = m_Workers[(start + i) % n].get();
+			if (victim == worker)
+				continue;
+
+			if (JobType* job = victim->m_Jobs.Steal())
+				return job;
+		}
+		return nullptr;
+	}
+
+	bool ThreadPool::RunPendingJob()
+	{
+		Worker* const worker = IsWorkerThread() ? m_Workers[t_CurrentWorker.m_Index].get()
+												: nullptr;
+		std::unique_ptr<JobType> job{ FindJob(worker) };
+		if (!job)
+			return false;
+
+		(*job)();
+		return true;
+	}
+
+	void ThreadPool::Loop(uint32 index)
+	{
+		t_CurrentWorker = { this, index };
+		Worker* const worker = m_Workers[index].get();
+		uint32 idleCount = 0;
+
+		while (m_Running)
+		{
+			if (std::unique_ptr<JobType> job{ FindJob(worker) })
+			{
+				idleCount = 0;
+				(*job)();
+				continue;
+			}
+
+			if (++idleCount < g_SpinCount)
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			Park();
+			idleCount = 0;
+		}
+		t_CurrentWorker = {};
+	}
+} // namespace apollo::mt
\ No newline at end of file
@@ -5,9 +5,11 @@
 #include "NumConv.hpp"
 #include "Queue.hpp"
 #include "UniqueFunction.hpp"
-#include <condition_variable>
+#include "WorkStealingDeque.hpp"
+#include <atomic>
 #include <exception>
 #include <future>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <vector>
@@ -19,21 +21,31 @@
  * \brief Multithreading utilities
  */
 namespace apollo::mt {
-	/** \brief Simple thread pool implementation
+	/** \brief Work-stealing thread pool
 
 	This gets used internally in places where concurrency is desired, for example the AssetLoader.
-	Jobs are stored using a Queue container.
+	Every worker owns a WorkStealingDeque: jobs enqueued from one of the pool's worker threads are
+	pushed onto that worker's deque, whereas jobs enqueued from any other thread go through a shared
+	injection Queue. An idle worker pops from its own deque first (LIFO), then from the injection
+	queue (FIFO), and finally tries to steal from the other workers. If no job was found, it spins
+	for a little while before parking until new work gets submitted.
 	 */
 	class ThreadPool
 	{
 	public:
+		using JobType = UniqueFunction<void()>;
+
 		static inline const uint32 DefaultThreadCount = Max(1u, std::thread::hardware_concurrency());
 
 		/**
 		 * \brief Creates and immediately kicks off the threads.
 		 */
-		inline explicit ThreadPool(uint32 threadCount = DefaultThreadCount);
-		inline ~ThreadPool();
+		APOLLO_API explicit ThreadPool(uint32 threadCount = DefaultThreadCount);
+		/**
+		 * \brief Stops the pool and joins all threads. Jobs which didn't get the chance to run are
+		 * destroyed without being invoked.
+		 */
+		APOLLO_API ~ThreadPool();
 
 		ThreadPool(ThreadPool&&) = delete;
 		ThreadPool& operator=(ThreadPool&&) = delete;
@@ -41,9 +53,12 @@ namespace apollo::mt {
 		[[nodiscard]] bool IsRunning() const noexcept { return m_Running; }
 
 		/** \name Enqueue
-		 * \brief Adds a job add the end of the queue
+		 * \brief Adds a job to the pool
 		 * \note A job is not guaranteed to get executed: \ref ThreadPool::Stop "Stop()"
 		 * might get called before it gets the chance.
+		 * \note Jobs enqueued from outside the pool are started in submission order. Jobs enqueued
+		 * from a worker thread are started in reverse submission order by that worker, unless
+		 * they get stolen by another one.
 		 * @{ */
 
 		/**
@@ -61,7 +76,7 @@ namespace apollo::mt {
 		inline void Enqueue(F&& func, Args&&... args) requires(std::is_invocable_r_v<void, F, Args...>);
 
 		/** @} */
-		
+
 		/**
 		 * \brief Adds a job to the queue and returns an associated future
 		 * \retval std::future A future object through which the result will be made a available if the
@@ -77,77 +92,55 @@ namespace apollo::mt {
 			return NumCast<uint32>(m_Threads.size());
 		}
 
-		/** \brief Marks the pool as stopped and notifies all threads
+		/**
+		 * \brief Checks whether the calling thread is one of this pool's workers
+		 */
+		[[nodiscard]] APOLLO_API bool IsWorkerThread() const noexcept;
+
+		/**
+		 * \brief Runs at most one pending job on the calling thread
+		 * \details This allows threads which need to wait on some other job to help instead of
+		 * blocking. Worker threads look into their own queue first, other threads only take jobs
+		 * from the injection queue or steal from the workers. Jobs left behind by a stopped pool can
+		 * still be run this way.
+		 * \returns true if a job was executed, false if no job could be found
+		 */
+		APOLLO_API bool RunPendingJob();
+
+		/** \brief Marks the pool as stopped and wakes up all threads
 		 * \note This function does not block, but jobs might still be running by the time it
 		 * returns.
 		 */
-		inline void Stop();
+		APOLLO_API void Stop();
 
 	private:
-		inline void Loop();
+		struct Worker;
 
-		std::vector<std::thread> m_Threads;
-		std::mutex m_Mutex;
-		std::condition_variable m_Cv;
-		Queue<UniqueFunction<void()>> m_Jobs;
-
-		bool m_Running = true;
-	};
-
-	ThreadPool::ThreadPool(uint32 n)
-	{
-		m_Threads.reserve(n);
-		while (n--)
-		{
-			m_Threads.emplace_back(&ThreadPool::Loop, this);
-		}
-	}
-
-	ThreadPool::~ThreadPool()
-	{
-		Stop();
-		for (std::thread& th : m_Threads)
-			th.join();
-	}
+		APOLLO_API void Submit(JobType* job);
 
-	void ThreadPool::Loop()
-	{
-		for (;;)
-		{
-			std::unique_lock lock{ m_Mutex };
-			while (m_Running && !m_Jobs.GetSize())
-			{
-				m_Cv.wait(lock);
-			}
-			if (!m_Running)
-			{
-				return;
-			}
+		void Loop(uint32 index);
+		[[nodiscard]] JobType* FindJob(Worker* worker);
+		[[nodiscard]] JobType* PopInjectedJob();
+		[[nodiscard]] bool HasPendingJobs() const noexcept;
+		void Park();
+		void WakeOne();
 
-			UniqueFunction job = m_Jobs.PopAndGetFront();
-			lock.unlock();
+		std::vector<std::unique_ptr<Worker>> m_Workers;
+		std::vector<std::thread> m_Threads;
 
-			job();
-		}
-	}
+		std::mutex m_InjectionMutex;
+		Queue<JobType*> m_InjectedJobs;
+		std::atomic_uint32_t m_InjectedCount = 0;
 
-	void ThreadPool::Stop()
-	{
-		{
-			std::unique_lock lock{ m_Mutex };
-			m_Running = false;
-		}
-		m_Cv.notify_all();
-	}
+		std::atomic_uint32_t m_WakeEpoch = 0;
+		std::atomic_uint32_t m_SleepingCount = 0;
+		std::atomic_bool m_Running = true;
+	};
 
 	template <class F>
 	void ThreadPool::Enqueue(F&& func) requires(std::is_invocable_r_v<void, F>)
 	{
-		{
-			std::unique_lock lock{ m_Mutex };
-			m_Jobs.AddEmplace(std::forward<F>(func));
-		}
-		m_Cv.notify_one();
+		Submit(new JobType{ std::forward<F>(func) });
 	}
 
 	template <class F, class... Args>
@@ -157,15 +150,12 @@ namespace apollo::mt {
 		static_assert(
 			((!std::is_lvalue_reference_v<decltype(args)>) && ...),
 			"Don't pass arguments by reference, use std::ref or lambda captures or whatever");
-		{
-			std::unique_lock lock{ m_Mutex };
-			m_Jobs.AddEmplace(
-				[func = std::forward<F>(func), ... args = std::move(args)]() mutable
-				{
-					func(std::move(args)...);
-				});
-		}
-		m_Cv.notify_one();
+		Submit(new JobType{
+			[func = std::forward<F>(func), ... args = std::move(args)]() mutable
+			{
+				func(std::move(args)...);
+			},
+		});
 	}
 
 	template <class F, class... Args>
@@ -179,8 +169,7 @@ namespace apollo::mt {
 		using R = decltype(func(std::move(args)...));
 		std::promise<R> promise;
 		std::future future = promise.get_future();
-		std::unique_lock lock{ m_Mutex };
-		m_Jobs.AddEmplace(
+		Submit(new JobType{
 			[func = std::forward<F>(func),
 			 ... args = std::move(args),
 			 promise = std::move(promise)]() mutable
@@ -201,10 +190,8 @@ namespace apollo::mt {
 				{
 					promise.set_exception(std::current_exception());
 				}
-			});
-		lock.unlock();
-
-		m_Cv.notify_one();
+			},
+		});
 		return future;
 	}
 
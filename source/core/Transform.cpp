@@ -0,0 +1,205 @@
+#include "Transform.hpp"
+#include "Assert.hpp"
+
+// quaternions are loaded as (x, y, z, w)
+#if defined(GLM_FORCE_QUAT_DATA_WXYZ)
+#define APOLLO_TRANSFORM_SSE2 0
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define APOLLO_TRANSFORM_SSE2 1
+#include <emmintrin.h>
+#else
+#define APOLLO_TRANSFORM_SSE2 0
+#endif
+
+#if !APOLLO_TRANSFORM_SSE2 && !defined(GLM_FORCE_QUAT_DATA_WXYZ) &&                               \
+	(defined(__ARM_NEON) || defined(_M_ARM64)) && (defined(__aarch64__) || defined(_M_ARM64))
+#define APOLLO_TRANSFORM_NEON 1
+#include <arm_neon.h>
+#else
+#define APOLLO_TRANSFORM_NEON 0
+#endif
+
+namespace {
+	static_assert(sizeof(float3) == 3 * sizeof(float));
+	static_assert(sizeof(glm::quat) == 4 * sizeof(float));
+	static_assert(sizeof(glm::mat4x4) == 16 * sizeof(float));
+
+#if APOLLO_TRANSFORM_SSE2
+	using Vec = __m128;
+
+	Vec Add(Vec a, Vec b) noexcept
+	{
+		return _mm_add_ps(a, b);
+	}
+	Vec Sub(Vec a, Vec b) noexcept
+	{
+		return _mm_sub_ps(a, b);
+	}
+	Vec Mul(Vec a, Vec b) noexcept
+	{
+		return _mm_mul_ps(a, b);
+	}
+	Vec Splat(float x) noexcept
+	{
+		return _mm_set1_ps(x);
+	}
+
+	/// Loads 4 float3, and returns their x, y and z components in separate registers
+	void Load3x4(const float* in, Vec& out_x, Vec& out_y, Vec& out_z) noexcept
+	{
+		// a = x0 y0 z0 x1, b = y1 z1 x2 y2, c = z2 x3 y3 z3
+		const Vec a = _mm_loadu_ps(in);
+		const Vec b = _mm_loadu_ps(in + 4);
+		const Vec c = _mm_loadu_ps(in + 8);
+		out_x = _mm_shuffle_ps(
+			_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 0, 0)),
+			_mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)),
+			_MM_SHUFFLE(2, 0, 2, 0));
+		out_y = _mm_shuffle_ps(
+			_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+			_mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)),
+			_MM_SHUFFLE(2, 0, 2, 0));
+		out_z = _mm_shuffle_ps(
+			_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)),
+			_mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)),
+			_MM_SHUFFLE(2, 0, 2, 0));
+	}
+
+	/// Loads 4 quaternions, and returns their x, y, z and w components in separate registers
+	void Load4x4(const float* in, Vec& out_x, Vec& out_y, Vec& out_z, Vec& out_w) noexcept
+	{
+		out_x = _mm_loadu_ps(in);
+		out_y = _mm_loadu_ps(in + 4);
+		out_z = _mm_loadu_ps(in + 8);
+		out_w = _mm_loadu_ps(in + 12);
+		_MM_TRANSPOSE4_PS(out_x, out_y, out_z, out_w);
+	}
+
+	/// Stores the same column of 4 matrices: \p x holds the first component of each column, etc
+	void StoreColumns(float* out, Vec x, Vec y, Vec z, Vec w) noexcept
+	{
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+		_mm_storeu_ps(out, x);
+		_mm_storeu_ps(out + 16, y);
+		_mm_storeu_ps(out + 32, z);
+		_mm_storeu_ps(out + 48, w);
+	}
+#elif APOLLO_TRANSFORM_NEON
+	using Vec = float32x4_t;
+
+	Vec Add(Vec a, Vec b) noexcept
+	{
+		return vaddq_f32(a, b);
+	}
+	Vec Sub(Vec a, Vec b) noexcept
+	{
+		return vsubq_f32(a, b);
+	}
+	Vec Mul(Vec a, Vec b) noexcept
+	{
+		return vmulq_f32(a, b);
+	}
+	Vec Splat(float x) noexcept
+	{
+		return vdupq_n_f32(x);
+	}
+
+	void Load3x4(const float* in, Vec& out_x, Vec& out_y, Vec& out_z) noexcept
+	{
+		const float32x4x3_t v = vld3q_f32(in);
+		out_x = v.val[0];
+		out_y = v.val[1];
+		out_z = v.val[2];
+	}
+
+	void Load4x4(const float* in, Vec& out_x, Vec& out_y, Vec& out_z, Vec& out_w) noexcept
+	{
+		const float32x4x4_t v = vld4q_f32(in);
+		out_x = v.val[0];
+		out_y = v.val[1];
+		out_z = v.val[2];
+		out_w = v.val[3];
+	}
+
+	void StoreColumns(float* out, Vec x, Vec y, Vec z, Vec w) noexcept
+	{
+		const float32x4x2_t xy = vtrnq_f32(x, y);
+		const float32x4x2_t zw = vtrnq_f32(z, w);
+		vst1q_f32(out, vcombine_f32(vget_low_f32(xy.val[0]), vget_low_f32(zw.val[0])));
+		vst1q_f32(out + 16, vcombine_f32(vget_low_f32(xy.val[1]), vget_low_f32(zw.val[1])));
+		vst1q_f32(out + 32, vcombine_f32(vget_high_f32(xy.val[0]), vget_high_f32(zw.val[0])));
+		vst1q_f32(out + 48, vcombine_f32(vget_high_f32(xy.val[1]), vget_high_f32(zw.val[1])));
+	}
+#endif
+
+#if APOLLO_TRANSFORM_SSE2 || APOLLO_TRANSFORM_NEON
+	/// Same operations as glm::mat4_cast followed by ComputeTransformMatrix, 4 transforms at once
+	void ComputeTransformMatrix4(
+		const float3* pos,
+		const float3* scale,
+		const glm::quat* rot,
+		glm::mat4x4* out) noexcept
+	{
+		Vec px, py, pz, sx, sy, sz, qx, qy, qz, qw;
+		Load3x4(&pos->x, px, py, pz);
+		Load3x4(&scale->x, sx, sy, sz);
+		Load4x4(&rot->x, qx, qy, qz, qw);
+
+		const Vec qxx = Mul(qx, qx), qyy = Mul(qy, qy), qzz = Mul(qz, qz);
+		const Vec qxz = Mul(qx, qz), qxy = Mul(qx, qy), qyz = Mul(qy, qz);
+		const Vec qwx = Mul(qw, qx), qwy = Mul(qw, qy), qwz = Mul(qw, qz);
+		const Vec one = Splat(1), two = Splat(2), zero = Splat(0);
+
+		float* const dest = &out[0][0][0];
+		StoreColumns(
+			dest,
+			Mul(Sub(one, Mul(two, Add(qyy, qzz))), sx),
+			Mul(two, Add(qxy, qwz)),
+			Mul(two, Sub(qxz, qwy)),
+			zero);
+		StoreColumns(
+			dest + 4,
+			Mul(two, Sub(qxy, qwz)),
+			Mul(Sub(one, Mul(two, Add(qxx, qzz))), sy),
+			Mul(two, Add(qyz, qwx)),
+			zero);
+		StoreColumns(
+			dest + 8,
+			Mul(two, Add(qxz, qwy)),
+			Mul(two, Sub(qyz, qwx)),
+			Mul(Sub(one, Mul(two, Add(qxx, qyy))), sz),
+			zero);
+		StoreColumns(dest + 12, px, py, pz, one);
+	}
+#endif
+} // namespace
+
+namespace apollo {
+	void ComputeTransformMatrices(
+		std::span<const float3> positions,
+		std::span<const float3> scales,
+		std::span<const glm::quat> rotations,
+		glm::mat4x4* out_matrices)
+	{
+		APOLLO_ASSERT(
+			scales.size() == positions.size() && rotations.size() == positions.size(),
+			"Transform spans have different sizes: {}, {}, {}",
+			positions.size(),
+			scales.size(),
+			rotations.size());
+
+		size_t i = 0;
+#if APOLLO_TRANSFORM_SSE2 || APOLLO_TRANSFORM_NEON
+		for (; i + 4 <= positions.size(); i += 4)
+		{
+			ComputeTransformMatrix4(
+				positions.data() + i,
+				scales.data() + i,
+				rotations.data() + i,
+				out_matrices + i);
+		}
+#endif
+		for (; i < positions.size(); ++i)
+			out_matrices[i] = ComputeTransformMatrix(positions[i], scales[i], rotations[i]);
+	}
+} // namespace apollo
\ No newline at end of file
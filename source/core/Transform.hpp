@@ -2,6 +2,7 @@
 
 #include <PCH.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include <span>
 
 /** \file Transform.hpp
  * \brief 3D transform computation
@@ -23,4 +24,20 @@ namespace apollo {
 		m[3] = float4{ pos, 1 };
 		return m;
 	}
+
+	/**
+	 * \brief Computes transformation matrices in batch, see ComputeTransformMatrix
+	 * \details Processes 4 transforms at a time with SSE2 or NEON when available. The same
+	 * operations are performed in the same order as in ComputeTransformMatrix, but the results
+	 * are only equal up to rounding: the compiler may fuse multiplications and additions in the
+	 * scalar version (e.g. clang's default -ffp-contract=on on arm64), and not in the vectorized
+	 * one.
+	 * \param positions, scales, rotations: Must all have the same size
+	 * \param out_matrices: Must be able to hold `positions.size()` matrices
+	 */
+	APOLLO_API void ComputeTransformMatrices(
+		std::span<const float3> positions,
+		std::span<const float3> scales,
+		std::span<const glm::quat> rotations,
+		glm::mat4x4* out_matrices);
 } // namespace apollo
\ No newline at end of file
@@ -62,6 +62,8 @@ namespace apollo {
 
 		[[nodiscard]] constexpr bool operator==(const ULID other) const noexcept;
 		[[nodiscard]] constexpr bool operator!=(const ULID other) const noexcept;
+		/// Lexicographic ordering, which for ULIDs also means chronological ordering
+		[[nodiscard]] constexpr bool operator<(const ULID other) const noexcept;
 
 		/** \name JSON conversion functions
 		 * \sa json::Converter
@@ -189,4 +191,9 @@ namespace apollo {
 	{
 		return m_Left != other.m_Left || m_Right != other.m_Right;
 	}
+
+	inline constexpr bool apollo::ULID::operator<(const ULID other) const noexcept
+	{
+		return m_Left < other.m_Left || (m_Left == other.m_Left && m_Right < other.m_Right);
+	}
 } // namespace apollo
\ No newline at end of file
@@ -0,0 +1,179 @@
+#pragma once
+
+/** \file WorkStealingDeque.hpp */
+
+#include <PCH.hpp>
+
+#include "Assert.hpp"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace apollo::mt {
+	/**
+	 * \brief Lock-free single-producer, multi-consumer deque (Chase-Lev)
+	 * \tparam T: The pointed-to element type. The deque only stores pointers, and never takes
+	 * ownership of them.
+	 * \details The owning thread pushes and pops elements at the bottom end (LIFO), while any other
+	 * thread may steal elements from the top end (FIFO). The ring buffer grows as needed; previous
+	 * buffers are kept alive until the deque gets destroyed, because concurrent thieves might still
+	 * be reading from them.
+	 * \note Push() and Pop() must only ever be called from the owner thread.
+	 */
+	template <class T>
+	class WorkStealingDeque
+	{
+	public:
+		/**
+		 * \param capacity: The initial capacity. Must be a power of two.
+		 */
+		explicit WorkStealingDeque(uint32 capacity = 256);
+
+		WorkStealingDeque(const WorkStealingDeque&) = delete;
+		WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+		/// \brief Adds an element to the bottom of the deque. Owner thread only.
+		void Push(T* item);
+		/// \brief Removes the bottom-most element. Owner thread only.
+		/// \returns The element, or nullptr if the deque was empty
+		[[nodiscard]] T* Pop() noexcept;
+		/// \brief Attempts to remove the top-most element. Can be called from any thread.
+		/// \returns The element, or nullptr if the deque was empty or if another thread won the
+		/// race for the same element
+		[[nodiscard]] T* Steal() noexcept;
+
+		/// \brief Returns the number of elements in the deque.
+		/// \note The result is only a snapshot when the deque is accessed concurrently
+		[[nodiscard]] uint32 GetSize() const noexcept
+		{
+			const int64 b = m_Bottom.load(std::memory_order_relaxed);
+			const int64 t = m_Top.load(std::memory_order_relaxed);
+			return b > t ? uint32(b - t) : 0;
+		}
+		[[nodiscard]] bool IsEmpty() const noexcept { return !GetSize(); }
+
+	private:
+		struct Buffer
+		{
+			explicit Buffer(int64 capacity)
+				: m_Mask(capacity - 1)
+				, m_Slots(new std::atomic<T*>[capacity])
+			{}
+
+			[[nodiscard]] int64 GetCapacity() const noexcept { return m_Mask + 1; }
+			[[nodiscard]] T* Get(int64 i) const noexcept
+			{
+				return m_Slots[i & m_Mask].load(std::memory_order_relaxed);
+			}
+			void Put(int64 i, T* item) noexcept
+			{
+				m_Slots[i & m_Mask].store(item, std::memory_order_relaxed);
+			}
+
+			int64 m_Mask;
+			std::unique_ptr<std::atomic<T*>[]> m_Slots;
+		};
+
+		Buffer* Grow(Buffer* buf, int64 top, int64 bottom);
+
+		alignas(64) std::atomic<int64> m_Top = 0;
+		alignas(64) std::atomic<int64> m_Bottom = 0;
+		std::atomic<Buffer*> m_Buffer = nullptr;
+		std::vector<std::unique_ptr<Buffer>> m_Buffers;
+	};
+
+	template <class T>
+	WorkStealingDeque<T>::WorkStealingDeque(uint32 capacity)
+	{
+		APOLLO_ASSERT(
+			capacity && IsPowerOfTwo(capacity),
+			"WorkStealingDeque capacity must be a power of 2, got {}",
+			capacity);
+		m_Buffer.store(
+			m_Buffers.emplace_back(std::make_unique<Buffer>(capacity)).get(),
+			std::memory_order_relaxed);
+	}
+
+	template <class T>
+	auto WorkStealingDeque<T>::Grow(Buffer* buf, int64 top, int64 bottom) -> Buffer*
+	{
+		auto newBuf = std::make_unique<Buffer>(2 * buf->GetCapacity());
+		for (int64 i = top; i < bottom; ++i)
+			newBuf->Put(i, buf->Get(i));
+
+		Buffer* const ptr = m_Buffers.emplace_back(std::move(newBuf)).get();
+		m_Buffer.store(ptr, std::memory_order_release);
+		return ptr;
+	}
+
+	template <class T>
+	void WorkStealingDeque<T>::Push(T* item)
+	{
+		const int64 b = m_Bottom.load(std::memory_order_relaxed);
+		const int64 t = m_Top.load(std::memory_order_acquire);
+		Buffer* buf = m_Buffer.load(std::memory_order_relaxed);
+
+		if ((b - t) > (buf->GetCapacity() - 1)) [[unlikely]]
+			buf = Grow(buf, t, b);
+
+		buf->Put(b, item);
+		std::atomic_thread_fence(std::memory_order_release);
+		m_Bottom.store(b + 1, std::memory_order_relaxed);
+	}
+
+	template <class T>
+	T* WorkStealingDeque<T>::Pop() noexcept
+	{
+		const int64 b = m_Bottom.load(std::memory_order_relaxed) - 1;
+		Buffer* const buf = m_Buffer.load(std::memory_order_relaxed);
+		m_Bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64 t = m_Top.load(std::memory_order_relaxed);
+
+		if (t > b)
+		{
+			// deque was already empty
+			m_Bottom.store(b + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		T* item = buf->Get(b);
+		if (t == b)
+		{
+			// last element: race against thieves
+			if (!m_Top.compare_exchange_strong(
+					t,
+					t + 1,
+					std::memory_order_seq_cst,
+					std::memory_order_relaxed))
+			{
+				item = nullptr;
+			}
+			m_Bottom.store(b + 1, std::memory_order_relaxed);
+		}
+		return item;
+	}
+
+	template <class T>
+	T* WorkStealingDeque<T>::Steal() noexcept
+	{
+		int64 t = m_Top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const int64 b = m_Bottom.load(std::memory_order_acquire);
+
+		if (t >= b)
+			return nullptr;
+
+		Buffer* const buf = m_Buffer.load(std::memory_order_acquire);
+		T* const item = buf->Get(t);
+		if (!m_Top.compare_exchange_strong(
+				t,
+				t + 1,
+				std::memory_order_seq_cst,
+				std::memory_order_relaxed))
+		{
+			return nullptr;
+		}
+		return item;
+	}
+} // namespace apollo::mt
\ No newline at end of file
@@ -3,12 +3,15 @@
 /** \file ComponentRegistry.hpp */
 
 #include <PCH.hpp>
+#include <core/BinaryStream.hpp>
 #include <core/HashedString.hpp>
 #include <core/Json.hpp>
 #include <core/Log.hpp>
 #include <core/Map.hpp>
 #include <core/Singleton.hpp>
 #include <entt/entity/registry.hpp>
+#include <iterator>
+#include <vector>
 
 #include "Reflection.hpp"
 
@@ -33,6 +36,145 @@ private:
 };
 
 namespace apollo::ecs {
+	namespace _internal {
+		/// Writes the binary value of \p object[key]
+		template <class T>
+		bool FieldFromJson(BinaryWriter& out, const nlohmann::json& object, std::string_view key)
+		{
+			if constexpr (requires { BinaryCodec<T>::FromJson(out, object); })
+			{
+				const auto it = object.find(key);
+				return it != object.end() && BinaryCodec<T>::FromJson(out, *it);
+			}
+			else
+			{
+				T value{};
+				if (!json::Visit(value, object, key))
+					return false;
+				BinaryCodec<T>::Write(out, value);
+				return true;
+			}
+		}
+
+		/// Reads a binary value into \p out_json[key]
+		template <class T>
+		bool FieldToJson(BinaryReader& in, nlohmann::json& out_json, std::string_view key)
+		{
+			nlohmann::json& j = out_json[std::string{ key }];
+			if constexpr (requires { BinaryCodec<T>::ToJson(in, j); })
+			{
+				return BinaryCodec<T>::ToJson(in, j);
+			}
+			else
+			{
+				T value{};
+				if (!BinaryCodec<T>::Read(in, value))
+					return false;
+				if constexpr (json::JsonEnabledType<T>)
+					value.ToJson(j);
+				else if constexpr (requires { json::Converter<T>::ToJson(value, j); })
+					json::Converter<T>::ToJson(value, j);
+				else
+					j = value;
+				return true;
+			}
+		}
+
+		template <class C, class R = std::remove_const_t<decltype(C::Reflection)>>
+		struct Columns;
+
+		/// Column functions of ComponentInfo, generated from the reflected fields
+		template <class C, auto... M>
+		struct Columns<C, ComponentReflection<M...>>
+		{
+			template <auto Ptr>
+			using FieldType = typename meta::MemberObjectTraits<decltype(Ptr)>::MemberType;
+
+			static constexpr bool IsSerializable = (BinarySerializable<FieldType<M>> && ...);
+
+			static bool Load(
+				std::span<const entt::entity> entities,
+				entt::registry& world,
+				BinaryReader& data)
+			{
+				std::vector<C> components(entities.size());
+				// the fields must fill the whole column: leftover bytes mean it wasn't written with
+				// the same layout
+				if (!(ReadField<M>(components, data) && ...) || data.GetRemaining())
+					return false;
+
+				if constexpr (std::is_empty_v<C>)
+					world.insert<C>(entities.begin(), entities.end());
+				else
+				{
+					world.insert<C>(
+						entities.begin(),
+						entities.end(),
+						std::make_move_iterator(components.begin()));
+				}
+				return true;
+			}
+
+			static bool FromJson(
+				std::span<const nlohmann::json* const> components,
+				BinaryWriter& out)
+			{
+				uint32 index = 0;
+				return (FieldFromJson<M>(components, C::Reflection.m_Fields[index++], out) && ...);
+			}
+
+			static bool ToJson(
+				BinaryReader& data,
+				std::span<nlohmann::json* const> out_components)
+			{
+				uint32 index = 0;
+				const bool res = (
+					FieldToJson<M>(data, C::Reflection.m_Fields[index++], out_components) && ...);
+				return res && !data.GetRemaining();
+			}
+
+		private:
+			template <auto Ptr>
+			static bool ReadField(std::vector<C>& components, BinaryReader& data)
+			{
+				for (C& comp : components)
+				{
+					if (!BinaryCodec<FieldType<Ptr>>::Read(data, comp.*Ptr))
+						return false;
+				}
+				return true;
+			}
+
+			template <auto Ptr>
+			static bool FieldFromJson(
+				std::span<const nlohmann::json* const> components,
+				const HashedString& name,
+				BinaryWriter& out)
+			{
+				for (const nlohmann::json* comp : components)
+				{
+					if (!_internal::FieldFromJson<FieldType<Ptr>>(out, *comp, name.GetString()))
+						return false;
+				}
+				return true;
+			}
+
+			template <auto Ptr>
+			static bool FieldToJson(
+				BinaryReader& data,
+				const HashedString& name,
+				std::span<nlohmann::json* const> out_components)
+			{
+				for (nlohmann::json* comp : out_components)
+				{
+					if (!_internal::FieldToJson<FieldType<Ptr>>(data, *comp, name.GetString()))
+						return false;
+				}
+				return true;
+			}
+		};
+	} // namespace _internal
+
 	/**
 	 * \brief Holds runtime information about Component types
 	 * \details Components must be registered in here when runtime reflection is required.
@@ -46,6 +188,7 @@ namespace apollo::ecs {
 		/**
 		 * \brief Generates runtime information about the provided component type and adds it to the
 		 * internal map
+		 * \warning The returned reference is only valid until the next component gets registered
 		 */
 		template <Component C>
 		const ComponentInfo& RegisterComponent()
@@ -84,7 +227,7 @@ namespace apollo::ecs {
 		template <Component C>
 		static constexpr ComponentInfo CreateInfo()
 		{
-			return ComponentInfo{
+			ComponentInfo info{
 				.m_Name = C::Reflection.m_ComponentName.GetString(),
 				.m_Deserialize =
 					[](entt::entity e, entt::registry& world, const void* data)
@@ -103,6 +246,14 @@ namespace apollo::ecs {
 					return true;
 				},
 			};
+			using Columns = _internal::Columns<C>;
+			if constexpr (Columns::IsSerializable)
+			{
+				info.m_LoadColumn = &Columns::Load;
+				info.m_JsonToColumn = &Columns::FromJson;
+				info.m_ColumnToJson = &Columns::ToJson;
+			}
+			return info;
 		}
 	};
 } // namespace apollo::ecs
@@ -20,9 +20,11 @@ namespace apollo::ecs {
 
 	void Manager::Update(const GameTime& time)
 	{
-		for (SystemInstance& s : m_Systems)
+		if (m_ScheduleDirty)
 		{
-			s.Update(m_World, time);
+			m_Scheduler.Build(m_Systems, m_World);
+			m_ScheduleDirty = false;
 		}
+		m_Scheduler.Run(m_Systems, m_World, time, m_ThreadPool);
 	}
 } // namespace apollo::ecs
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <PCH.hpp>
 
+#include "Scheduler.hpp"
 #include "System.hpp"
 
 #include <core/Assert.hpp>
@@ -49,6 +50,7 @@ namespace apollo::ecs {
 			APOLLO_ASSERT(
 				GetSystemIndex<S>() == NumCast<uint32>(m_Systems.size()),
 				"Trying to add ECS system twice");
+			m_ScheduleDirty = true;
 			return *m_Systems.emplace_back(SystemInstance::Create<S>(std::forward<T>(args)...))
 						.template GetAs<S>();
 		}
@@ -60,10 +62,23 @@ namespace apollo::ecs {
 		 */
 		APOLLO_API void PostInit();
 		/**
-		 * \brief Updates all ECS systems, in the order they were added.
+		 * \brief Updates all ECS systems.
+		 * \details Systems which declare their component access (see ecs::Access) run in parallel
+		 * on the thread pool, unless they conflict with each other: conflicting systems run in the
+		 * order they were added. Other systems run alone on the calling thread, in order.
 		 * \param t: The global game timer.
 		 */
 		APOLLO_API void Update(const GameTime& t);
+		/**
+		 * \brief Sets the thread pool systems run on. If \b nullptr, which is the default, all
+		 * systems are updated serially on the calling thread.
+		 */
+		void SetThreadPool(mt::ThreadPool* pool) noexcept { m_ThreadPool = pool; }
+		/// \brief Update timings of the systems, in the order they were added
+		[[nodiscard]] std::span<const Scheduler::SystemStats> GetSystemStats() const noexcept
+		{
+			return m_Scheduler.GetStats();
+		}
 		/**
 		 * \brief Grants access to the entity world object. You don't usually need to call this
 		 * function.
@@ -84,5 +99,8 @@ namespace apollo::ecs {
 
 		entt::registry m_World;
 		std::vector<SystemInstance> m_Systems;
+		Scheduler m_Scheduler;
+		mt::ThreadPool* m_ThreadPool = nullptr;
+		bool m_ScheduleDirty = false;
 	};
 } // namespace apollo::ecs
\ No newline at end of file
@@ -3,9 +3,16 @@
 #include <PCH.hpp>
 #include <core/HashedString.hpp>
 #include <entt/entity/fwd.hpp>
+#include <nlohmann/json_fwd.hpp>
+#include <span>
 
 /** \file Reflection.hpp */
 
+namespace apollo {
+	class BinaryReader;
+	class BinaryWriter;
+} // namespace apollo
+
 namespace apollo::ecs {
 	/** \brief Reflection struct: gives static information about a component type
 
@@ -55,5 +62,28 @@ namespace apollo::ecs {
 		std::string_view m_Name;
 		bool (*m_Deserialize)(entt::entity entity, entt::registry& world, const void* data) =
 			nullptr;
+
+		/** \name Column functions
+		 * \brief Convert all the components of one type in a scene at once, to and from a binary
+		 * column. A column holds the reflected fields one after the other, and each field holds
+		 * the values of all components.
+		 * \note These are null if one of the reflected fields isn't BinarySerializable
+		 * @{ */
+
+		/// Creates the components of \p entities from the column in \p data. Fails without
+		/// creating anything if \p data isn't entirely consumed.
+		bool (*m_LoadColumn)(
+			std::span<const entt::entity> entities,
+			entt::registry& world,
+			BinaryReader& data) = nullptr;
+		/// Writes the column of \p components, which are JSON objects as found in scene files
+		bool (*m_JsonToColumn)(
+			std::span<const nlohmann::json* const> components,
+			BinaryWriter& out) = nullptr;
+		/// Reads a column back into JSON objects, one per component
+		bool (*m_ColumnToJson)(
+			BinaryReader& data,
+			std::span<nlohmann::json* const> out_components) = nullptr;
+		/** @} */
 	};
 } // namespace apollo::ecs
\ No newline at end of file
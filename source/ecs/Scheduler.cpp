@@ -0,0 +1,101 @@
+#include "Scheduler.hpp"
+#include <core/Assert.hpp>
+#include <entt/entity/registry.hpp>
+
+namespace apollo::ecs {
+	void Scheduler::Build(std::span<const SystemInstance> systems, entt::registry& world)
+	{
+		const uint32 count = NumCast<uint32>(systems.size());
+		m_Dependencies.assign(count, {});
+		m_Stats.resize(count);
+
+		// first system after the last exclusive one: earlier systems are done by the time it runs
+		uint32 groupStart = 0;
+		for (uint32 i = 0; i < count; ++i)
+		{
+			const AccessInfo* access = systems[i].GetAccess();
+			if (!access)
+			{
+				groupStart = i + 1;
+				continue;
+			}
+			if (access->m_Assure)
+				access->m_Assure(world);
+
+			for (uint32 j = groupStart; j < i; ++j)
+			{
+				if (access->ConflictsWith(*systems[j].GetAccess()))
+					m_Dependencies[i].emplace_back(j);
+			}
+		}
+	}
+
+	void Scheduler::RunSystem(uint32 index)
+	{
+		const GameTime::TimePoint start = GameTime::ClockType::now();
+		m_Context.m_Systems[index].Update(*m_Context.m_World, *m_Context.m_Time);
+		const GameTime::Duration duration = GameTime::ClockType::now() - start;
+
+		// each system's stats are only written by the job running it
+		SystemStats& stats = m_Stats[index];
+		stats.m_Last = duration;
+		stats.m_Average = stats.m_Average.count() ? (0.9f * stats.m_Average + 0.1f * duration)
+												  : duration;
+	}
+
+	void Scheduler::Run(
+		std::span<SystemInstance> systems,
+		entt::registry& world,
+		const GameTime& time,
+		mt::ThreadPool* pool)
+	{
+		APOLLO_ASSERT(
+			systems.size() == m_Dependencies.size(),
+			"Scheduler was built for {} systems, but got {}",
+			m_Dependencies.size(),
+			systems.size());
+
+		m_Context = { systems, &world, &time };
+		const uint32 count = NumCast<uint32>(systems.size());
+		if (!pool)
+		{
+			for (uint32 i = 0; i < count; ++i)
+				RunSystem(i);
+			return;
+		}
+
+		m_Jobs.assign(count, {});
+		uint32 groupStart = 0;
+		const auto waitForGroup = [&](uint32 end)
+		{
+			if (groupStart >= end)
+				return;
+			const std::span group{ m_Jobs.data() + groupStart, end - groupStart };
+			mt::WhenAll(*pool, group).Wait();
+		};
+
+		for (uint32 i = 0; i < count; ++i)
+		{
+			if (!systems[i].GetAccess())
+			{
+				waitForGroup(i);
+				RunSystem(i);
+				groupStart = i + 1;
+				continue;
+			}
+
+			m_Scratch.clear();
+			for (uint32 dep : m_Dependencies[i])
+				m_Scratch.emplace_back(m_Jobs[dep]);
+			m_Jobs[i] = mt::Schedule(
+				*pool,
+				[this, i]()
+				{
+					RunSystem(i);
+				},
+				m_Scratch);
+		}
+		waitForGroup(count);
+		m_Jobs.clear();
+	}
+} // namespace apollo::ecs
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <PCH.hpp>
+
+#include "System.hpp"
+#include <core/GameTime.hpp>
+#include <core/JobGraph.hpp>
+#include <span>
+#include <vector>
+
+/** \file Scheduler.hpp */
+
+namespace apollo::ecs {
+	/**
+	 * \brief Runs ECS systems, in parallel when their component accesses allow it.
+	 * \details Build computes, once, which systems each system must wait for: those registered
+	 * before it, whose access conflicts with its own (see AccessInfo::ConflictsWith). Conflicting
+	 * systems therefore always run in registration order, and never overlap.
+	 *
+	 * Exclusive systems, which don't declare their access, act as barriers: all systems registered
+	 * before them complete first, then they run alone on the calling thread.
+	 */
+	class Scheduler
+	{
+	public:
+		struct SystemStats
+		{
+			/// Duration of the last update
+			GameTime::Duration m_Last{};
+			/// Exponential moving average of the update duration
+			GameTime::Duration m_Average{};
+		};
+
+		/**
+		 * \brief Computes the dependencies between \p systems, and creates the storage of the
+		 * components they access in \p world
+		 */
+		APOLLO_API void Build(std::span<const SystemInstance> systems, entt::registry& world);
+
+		/**
+		 * \brief Updates \p systems, which must be the ones passed to Build.
+		 * \param pool: The thread pool to run systems on. If \b nullptr, all systems run serially
+		 * on the calling thread, in order.
+		 */
+		APOLLO_API void Run(
+			std::span<SystemInstance> systems,
+			entt::registry& world,
+			const GameTime& time,
+			mt::ThreadPool* pool);
+
+		/// \brief The systems \p system waits for, by index
+		[[nodiscard]] std::span<const uint32> GetDependencies(uint32 system) const noexcept
+		{
+			return m_Dependencies[system];
+		}
+		/// \brief Update timings, by system index
+		[[nodiscard]] std::span<const SystemStats> GetStats() const noexcept { return m_Stats; }
+
+	private:
+		void RunSystem(uint32 index);
+
+		std::vector<std::vector<uint32>> m_Dependencies;
+		std::vector<SystemStats> m_Stats;
+		std::vector<mt::JobHandle> m_Jobs;
+		std::vector<mt::JobHandle> m_Scratch;
+
+		/// Arguments of the current Run call, read by jobs
+		struct Context
+		{
+			std::span<SystemInstance> m_Systems;
+			entt::registry* m_World = nullptr;
+			const GameTime* m_Time = nullptr;
+		} m_Context;
+	};
+} // namespace apollo::ecs
\ No newline at end of file
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <PCH.hpp>
+#include <algorithm>
 #include <core/TypeInfo.hpp>
 #include <entt/entity/fwd.hpp>
+#include <vector>
 
 /** \file System.hpp */
 
@@ -11,14 +13,122 @@ namespace apollo {
 }
 
 namespace apollo::ecs {
+	/// Components a system reads, see Access
+	template <class... C>
+	struct Read
+	{};
+	/// Components a system writes, see Access
+	template <class... C>
+	struct Write
+	{};
+
+	/**
+	 * \brief Runtime description of the components a system reads and writes
+	 * \details Component types are identified by their TypeIndex, and sorted.
+	 */
+	struct AccessInfo
+	{
+		std::vector<uint32> m_Reads;
+		std::vector<uint32> m_Writes;
+		/// Creates the storage of all declared components, see Access::Assure
+		void (*m_Assure)(entt::registry&) = nullptr;
+
+		/**
+		 * \brief Whether two systems with these accesses can't run concurrently, i.e. one of them
+		 * writes a component the other one reads or writes
+		 */
+		[[nodiscard]] bool ConflictsWith(const AccessInfo& other) const noexcept
+		{
+			const auto intersect = [](const std::vector<uint32>& a, const std::vector<uint32>& b)
+			{
+				auto itA = a.begin(), itB = b.begin();
+				while (itA != a.end() && itB != b.end())
+				{
+					if (*itA == *itB)
+						return true;
+					*itA < *itB ? ++itA : ++itB;
+				}
+				return false;
+			};
+			return intersect(m_Writes, other.m_Writes) || intersect(m_Writes, other.m_Reads) ||
+				   intersect(m_Reads, other.m_Writes);
+		}
+	};
+
+	template <class R = Read<>, class W = Write<>>
+	struct Access;
+
+	/**
+	 * \brief Declares the components a system reads and writes
+	 * \details Systems expose it as a nested type:
+	 * \code
+	 * struct Physics
+	 * {
+	 *     using Access = ecs::Access<ecs::Read<Collider>, ecs::Write<Transform, RigidBody>>;
+	 *     void Update(entt::registry& world, const GameTime& time);
+	 * };
+	 * \endcode
+	 * Systems which declare their access may run concurrently with others on the thread pool, so
+	 * they must only touch the components they declare, and must not create or destroy entities,
+	 * or add or remove components. Systems which don't declare their access are exclusive: they run
+	 * alone, on the thread which calls Manager::Update.
+	 */
+	template <class... R, class... W>
+	struct Access<Read<R...>, Write<W...>>
+	{
+		[[nodiscard]] static const AccessInfo& GetInfo()
+		{
+			static const AccessInfo info = []()
+			{
+				AccessInfo res{
+					.m_Reads = { TypeIndex<std::remove_const_t<R>>::GetValue()... },
+					.m_Writes = { TypeIndex<std::remove_const_t<W>>::GetValue()... },
+					.m_Assure = &Assure<entt::registry>,
+				};
+				std::ranges::sort(res.m_Reads);
+				std::ranges::sort(res.m_Writes);
+				return res;
+			}();
+			return info;
+		}
+
+		/**
+		 * \brief Creates the storage of the declared components up front. entt creates it lazily,
+		 * which isn't safe to do from concurrent systems.
+		 */
+		template <class Registry>
+		static void Assure(Registry& world)
+		{
+			(world.template storage<std::remove_const_t<R>>(), ...);
+			(world.template storage<std::remove_const_t<W>>(), ...);
+		}
+	};
+
+	namespace _internal {
+		template <class T>
+		struct IsAccess : std::false_type
+		{};
+		template <class R, class W>
+		struct IsAccess<Access<R, W>> : std::true_type
+		{};
+
+		template <class S>
+		concept HasAccess = requires
+		{
+			typename S::Access;
+		};
+	} // namespace _internal
+
 	/**
 	 * \brief Tests whether a given type can be used as a System class.
+	 * \details If the type declares an Access type, it must be a specialization of ecs::Access.
 	 */
 	template <class S>
 	concept System = requires(S & instance, entt::registry& world, const GameTime& time)
 	{
 		{ instance.Update(world, time) };
-	};
+	}
+	&&(!_internal::HasAccess<S> || _internal::IsAccess<typename S::Access>::value);
 
 	namespace _internal {
 		template <class T>
@@ -53,6 +163,9 @@ namespace apollo::ecs {
 				delete static_cast<S*>(system);
 			};
 			void (*postInit)(void*) = nullptr;
+			const AccessInfo* access = nullptr;
+			if constexpr (_internal::HasAccess<S>)
+				access = &S::Access::GetInfo();
 			if constexpr (_internal::HasPostInit<S>)
 			{
 				postInit = [](void* ptr)
@@ -65,6 +178,7 @@ namespace apollo::ecs {
 					.m_Update = update,
 					.m_Delete = deleteFunc,
 					.m_PostInit = postInit,
+					.m_Access = access,
 				},
 				ptr,
 			};
@@ -95,6 +209,9 @@ namespace apollo::ecs {
 		void PostInit();
 		void Shutdown();
 
+		/// \brief The components the system accesses, or \b nullptr if it is exclusive
+		[[nodiscard]] const AccessInfo* GetAccess() const noexcept { return m_Impl.m_Access; }
+
 		template <class S>
 		S* GetAs() noexcept
 		{
@@ -119,6 +236,7 @@ namespace apollo::ecs {
 			UpdateFunc* m_Update = nullptr;
 			void (*m_Delete)(void*) = nullptr;
 			void (*m_PostInit)(void*) = nullptr;
+			const AccessInfo* m_Access = nullptr;
 		};
 
 		SystemInstance(const VTable& impl, void* ptr);
@@ -126,4 +244,4 @@ namespace apollo::ecs {
 		void* m_Ptr = nullptr;
 		VTable m_Impl;
 	};
-} // namespace apollo::ecs
+} // namespace apollo::ecs
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <core/NumConv.hpp>
 #include <rendering/Context.hpp>
 #include <rendering/Texture.hpp>
+#include <rendering/UploadHeap.hpp>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -50,7 +51,6 @@ namespace apollo::editor {
 		default: break;
 		}
 
-		rdr::GPUDevice& device = rdr::Context::GetInstance()->GetDevice();
 		out_texture = rdr::Texture2D(
 			metadata.m_Id,
 			rdr::TextureSettings{
@@ -65,19 +65,14 @@ namespace apollo::editor {
 			return false;
 		}
 
-		SDL_GPUTransferBufferCreateInfo transferBufferInfo{
-			.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
-			.size = width * height * pixelSize,
-		};
-		SDL_GPUTransferBuffer* transferBuffer = SDL_CreateGPUTransferBuffer(
-			device.GetHandle(),
-			&transferBufferInfo);
-		APOLLO_ASSERT(transferBuffer, "Failed to create transfer buffer: {}", SDL_GetError());
-		void* bufMem = SDL_MapGPUTransferBuffer(device.GetHandle(), transferBuffer, false);
+		rdr::UploadHeap* const heap = rdr::UploadHeap::GetThreadHeap();
+		const rdr::UploadHeap::Allocation upload = heap->Map(
+			NumCast<uint32>(width * height * pixelSize),
+			rdr::UploadHeap::TextureAlignment);
 
 		if (numChannels != 3)
 		{
-			std::memcpy(bufMem, data, transferBufferInfo.size);
+			std::memcpy(upload.m_Ptr, data, upload.m_Size);
 		}
 		else
 		{
@@ -88,7 +83,7 @@ namespace apollo::editor {
 			};
 			for (uint32 i = 0; i < NumCast<uint32>(width * height); ++i)
 			{
-				static_cast<RGBAPixel*>(bufMem)[i] = RGBAPixel{
+				static_cast<RGBAPixel*>(upload.m_Ptr)[i] = RGBAPixel{
 					data[3 * i],
 					data[3 * i + 1],
 					data[3 * i + 2],
@@ -96,16 +91,8 @@ namespace apollo::editor {
 				};
 			}
 		}
-
-		SDL_UnmapGPUTransferBuffer(device.GetHandle(), transferBuffer);
 		stbi_image_free(data);
 
-		SDL_GPUTextureTransferInfo transferInfo{
-			.transfer_buffer = transferBuffer,
-			.offset = 0,
-			.pixels_per_row = NumCast<uint32>(width),
-			.rows_per_layer = NumCast<uint32>(height),
-		};
 		const SDL_GPUTextureRegion region{
 			.texture = out_texture.m_Handle,
 			.x = 0,
@@ -114,10 +101,7 @@ namespace apollo::editor {
 			.h = NumCast<uint32>(height),
 			.d = 1,
 		};
-
-		SDL_UploadToGPUTexture(AssetLoader::GetCurrentCopyPass(), &transferInfo, &region, false);
-
-		SDL_ReleaseGPUTransferBuffer(device.GetHandle(), transferBuffer);
+		heap->UploadToTexture(AssetLoader::GetCurrentCopyPass(), upload, region);
 
 		return true;
 	}
@@ -1,11 +1,8 @@
 #include "Manager.hpp"
 #include "AssetHelper.hpp"
-#include <core/Errno.hpp>
-#include <core/HashedString.hpp>
+#include <asset/MetadataCsv.hpp>
 #include <core/Log.hpp>
 #include <core/ULIDFormatter.hpp>
-#include <filesystem>
-#include <fstream>
 
 #include <asset/Scene.hpp>
 #include <rendering/Material.hpp>
@@ -15,110 +12,6 @@
 #include <rendering/text/FontAtlas.hpp>
 
 namespace {
-	const apollo::HashedStringMap<apollo::EAssetType> g_AssetTypeMap{
-		{ "texture2d", apollo::EAssetType::Texture2D },
-		{ "vertexShader", apollo::EAssetType::VertexShader },
-		{ "fragmentShader", apollo::EAssetType::FragmentShader },
-		{ "material", apollo::EAssetType::Material },
-		{ "materialInstance", apollo::EAssetType::MaterialInstance },
-		{ "mesh", apollo::EAssetType::Mesh },
-		{ "fontAtlas", apollo::EAssetType::FontAtlas },
-		{ "scene", apollo::EAssetType::Scene },
-	};
-
-	struct Parser
-	{
-		std::string_view m_Line;
-		std::string_view GetNext()
-		{
-			if (m_Line.empty())
-				return {};
-
-			size_t endPos = m_Line.npos;
-			size_t suffixLen = 0;
-			size_t prefixLen = 0;
-
-			if (m_Line[0] == '"')
-			{
-				prefixLen = 1;
-				endPos = m_Line.find('"', 1);
-				if (endPos == m_Line.npos)
-				{
-					APOLLO_LOG_ERROR("CSV sequence is malformed: {}", m_Line);
-					return (m_Line = {});
-				}
-				if (endPos == (m_Line.length() - 1))
-				{
-					suffixLen = 1;
-				}
-				else if (m_Line[endPos + 1] == ',')
-				{
-					APOLLO_LOG_ERROR("CSV sequence is malformed: {}", m_Line);
-					return (m_Line = {});
-				}
-				else
-				{
-					suffixLen = 2;
-				}
-			}
-			else
-			{
-				endPos = m_Line.find(',');
-				suffixLen = endPos < m_Line.size();
-			}
-
-			std::string_view val = m_Line.substr(prefixLen, endPos - prefixLen);
-			if (endPos < m_Line.length())
-				m_Line.remove_prefix(std::min(endPos + suffixLen, m_Line.length()));
-			else
-				m_Line = {};
-			return val;
-		}
-
-#define CHECK_VAL(val, msg)                                                                        \
-	if ((val).empty())                                                                             \
-	{                                                                                              \
-		APOLLO_LOG_ERROR("Failed to parse asset metadata: " msg);                                  \
-		return false;                                                                              \
-	}
-
-		bool ParseMetadata(
-			apollo::AssetMetadata& out_metadata,
-			const std::filesystem::path& assetRoot)
-		{
-			std::string_view val = GetNext();
-			CHECK_VAL(val, "missing asset ULID");
-			out_metadata.m_Id = apollo::ULID::FromString(val);
-			if (!out_metadata.m_Id)
-			{
-				APOLLO_LOG_ERROR("Failed to parse asset metadata: invalid ULID {}", val);
-				return false;
-			}
-			val = GetNext();
-			CHECK_VAL(val, "missing asset type");
-			{
-				const auto it = g_AssetTypeMap.find(val);
-				if (it == g_AssetTypeMap.end())
-				{
-					APOLLO_LOG_ERROR("Failed to parse asset metadata: invalid type {}", val);
-					return false;
-				}
-				out_metadata.m_Type = it->second;
-			}
-
-			val = GetNext();
-			CHECK_VAL(val, "missing asset name");
-			out_metadata.m_Name = val;
-
-			val = GetNext();
-			CHECK_VAL(val, "missing asset path");
-			out_metadata.m_FilePath = (assetRoot / std::filesystem::path(val)).string();
-
-			return true;
-		}
-	};
-#undef CHECK_VAL
-
 	template <apollo::Asset A>
 	consteval apollo::AssetTypeInfo CreateTypeInfo()
 	{
@@ -172,42 +65,7 @@ namespace apollo::editor {
 		}
 
 		APOLLO_LOG_INFO("Loading project assets metadata from {}", m_AssetsPath);
-		const std::filesystem::path filePath = std::filesystem::path{ m_AssetsPath }.append(
-			"metadata.csv");
-
-		std::ifstream inFile{
-			filePath,
-			std::ios::binary,
-		};
-		std::string line;
-		if (!inFile.is_open())
-		{
-			APOLLO_LOG_ERROR("Failed to load {}: {}", filePath.string(), GetErrnoMessage(errno));
-			return false;
-		}
-		std::getline(inFile, line);
-		for (; inFile; std::getline(inFile, line))
-		{
-			if (line.empty() || line[0] == '\r')
-				continue;
-
-			Parser parser{ line };
-			if (line.back() == '\r')
-				parser.m_Line.remove_suffix(1);
-
-			AssetMetadata metadata;
-			if (!parser.ParseMetadata(metadata, m_AssetsPath))
-				continue;
-
-			auto res = m_MetadataBank.try_emplace(metadata.m_Id, std::move(metadata));
-			if (res.second)
-				continue;
-			APOLLO_LOG_ERROR(
-				"ULID {} is present multiple times in the metadata file. Only the first asset will "
-				"be registered",
-				metadata.m_Id);
-		}
-		return true;
+		return ImportMetadataCsv(m_AssetsPath, m_MetadataBank);
 	}
 
 	void AssetManager::RequestReload(IAsset& asset)
@@ -228,10 +86,9 @@ namespace apollo::editor {
 		{
 			const AssetTypeInfo& typeInfo = g_TypeInfo[size_t(type)];
 			IAsset* tempAsset = typeInfo.m_Create(ULID::Generate());
-			m_Cache.emplace(tempAsset->GetId(), tempAsset);
-
 			SetAssetState(*tempAsset, EAssetState::Loading);
 			SetAssetState(asset, EAssetState::Loading);
+			m_Cache.Insert(tempAsset);
 
 			m_Loader.AddRequest(
 				AssetLoadRequest{
@@ -1,26 +1,35 @@
 #include "Entry.hpp"
 
 #include <asset/AssetManager.hpp>
+#include <asset/PackAssetManager.hpp>
 #include <core/App.hpp>
 
 #include <filesystem>
 
 int main(int argc, const char** argv)
 {
+	using namespace apollo;
+
 	const std::span appArgs{ argv, static_cast<size_t>(argc) };
-	apollo::EntryPoint ep = apollo::GetEntryPoint(appArgs);
+	EntryPoint ep = apollo::GetEntryPoint(appArgs);
 
-	// note: this crashes, because right now we literally haven't implemented the asset manager for
-	// the game
-	auto& app = apollo::App::Init(ep, nullptr);
+	auto& app = apollo::App::Init(
+		ep,
+		[](const std::string& path, rdr::GPUDevice& device, mt::ThreadPool& tp) -> IAssetManager&
+		{
+			return IAssetManager::Init<PackAssetManager>(path, device, tp);
+		});
 
 	apollo::EAppResult res = app.GetResultCode();
 
 	if (res != apollo::EAppResult::Continue) [[unlikely]]
 		goto APP_END;
 
-	// not implemented yet
-	// apollo::AssetManager::GetInstance()->ImportMetadataBank();
+	if (!IAssetManager::GetInstance()->ImportMetadataBank())
+	{
+		res = EAppResult::Failure;
+		goto APP_END;
+	}
 
 	res = app.Run();
 
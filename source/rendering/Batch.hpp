@@ -5,8 +5,11 @@
 #include <PCH.hpp>
 
 #include "Buffer.hpp"
+#include <algorithm>
 #include <asset/AssetRef.hpp>
 #include <memory>
+#include <span>
+#include <vector>
 
 struct SDL_GPUCopyPass;
 struct SDL_GPUGraphicsPipeline;
@@ -14,6 +17,8 @@ struct SDL_GPUGraphicsPipeline;
 namespace apollo::rdr {
 	/**
 	 * \brief Utility class used to group multiple objects per draw-call
+	 * \details Elements are compared to the ones recorded during the previous frame, and only the
+	 * ranges which changed are uploaded to the GPU.
 	 */
 	template <class T>
 	requires(std::is_trivially_destructible_v<T>) class Batch
@@ -27,15 +32,26 @@ namespace apollo::rdr {
 			, m_Buffer(rdr::EBufferFlags::GraphicsStorage, m_Capacity * sizeof(T))
 		{}
 
+		/// Elements whose index lies in [m_First, m_First + m_Count) need to be uploaded
+		struct DirtyRange
+		{
+			uint32 m_First = 0;
+			uint32 m_Count = 0;
+		};
+		/// Dirty ranges separated by fewer bytes than this are merged: uploading a few clean
+		/// elements is cheaper than recording another copy
+		static constexpr uint32 MergeDistance = Max(uint32(256 / sizeof(T)), 1u);
+
 		Batch(Batch&& other) noexcept
 			: m_Elems(std::move(other.m_Elems))
-			, m_Capacity(other.m_Capacity)
 			, m_Size(other.m_Size)
-			, m_Dirty(other.m_Dirty)
+			, m_Capacity(other.m_Capacity)
+			, m_Buffer(std::move(other.m_Buffer))
+			, m_DirtyRanges(std::move(other.m_DirtyRanges))
 		{
 			other.m_Capacity = 0;
 			other.m_Size = {};
-			other.m_Dirty = false;
+			other.m_DirtyRanges.clear();
 		}
 
 		Batch& operator=(Batch&& other) noexcept
@@ -50,27 +66,41 @@ namespace apollo::rdr {
 			m_Elems.swap(other.m_Elems);
 			std::swap(m_Capacity, other.m_Capacity);
 			std::swap(m_Size, other.m_Size);
-			std::swap(m_Dirty, other.m_Dirty);
+			m_DirtyRanges.swap(other.m_DirtyRanges);
 		}
 
 		/// Marks the batch as ready to record new data
-		void StartRecording() { m_Dirty = false; }
+		void StartRecording() { m_DirtyRanges.clear(); }
 
 		/**
-		 * \brief Performs the data upload to the GPU if required
+		 * \brief Uploads the dirty ranges to the GPU, if any
+		 * \details If the batch outgrew its GPU buffer, a larger one is created and the previous
+		 * contents are copied over on the GPU.
 		 */
 		void EndRecording(SDL_GPUCopyPass* copyPass)
 		{
-			if (!m_Dirty)
+			if (m_DirtyRanges.empty())
 				return;
 
-			if (m_Buffer.GetSize() < (m_Capacity * sizeof(T)))
+			const uint32 capacityBytes = m_Capacity * sizeof(T);
+			if (m_Buffer.GetSize() < capacityBytes)
 			{
-				m_Buffer = rdr::Buffer(rdr::EBufferFlags::GraphicsStorage, m_Capacity * sizeof(T));
+				rdr::Buffer buffer(rdr::EBufferFlags::GraphicsStorage, capacityBytes);
+				if (m_Buffer)
+					buffer.CopyData(copyPass, m_Buffer, m_Buffer.GetSize());
+				// the old buffer is released at the end of the scope, once the copy is recorded
+				m_Buffer.Swap(buffer);
 			}
 
-			m_Buffer.UploadData(copyPass, m_Elems.get(), m_Size.m_Current * sizeof(T));
-			m_Dirty = false;
+			for (const DirtyRange& range : m_DirtyRanges)
+			{
+				m_Buffer.UploadData(
+					copyPass,
+					m_Elems.get() + range.m_First,
+					range.m_Count * sizeof(T),
+					range.m_First * sizeof(T));
+			}
+			m_DirtyRanges.clear();
 		}
 
 		/**
@@ -87,22 +117,51 @@ namespace apollo::rdr {
 		/**
 		 * \brief Adds an element to the batch.
 		 * \details The data was already present from a previous frame, the new element is compared
-		 * to the old one. The batch is only marked as dirty if they differ.
+		 * to the old one. The element is only marked as dirty if they differ.
 		 */
 		void Add(T&& elem)
 			requires(requires(const T& a, const T& b) { { a != b }->std::same_as<bool>; })
 		{
 			if (m_Size.m_Current >= m_Capacity)
-			{
 				Reallocate();
-				m_Dirty = true;
-			}
-			T* ptr = m_Elems.get() + m_Size.m_Current;
-			if (++m_Size.m_Current > m_Size.m_Prev || elem != *ptr)
+
+			const uint32 index = m_Size.m_Current++;
+			T* ptr = m_Elems.get() + index;
+			if (index >= m_Size.m_Prev || elem != *ptr)
 			{
 				new (ptr) T{ std::move(elem) };
-				m_Dirty = true;
+				MarkDirty(index, 1);
+			}
+		}
+
+		/**
+		 * \brief Marks \p count elements starting at \p first as dirty
+		 * \details Required after modifying elements through the non-const accessors. Marking
+		 * ranges in increasing order keeps them as tight as possible: a range overlapping previous
+		 * ones is merged with all of them, including the gaps in between.
+		 */
+		void MarkDirty(uint32 first, uint32 count)
+		{
+			if (!count)
+				return;
+			uint32 end = first + count;
+			while (!m_DirtyRanges.empty())
+			{
+				const DirtyRange& last = m_DirtyRanges.back();
+				const uint32 lastEnd = last.m_First + last.m_Count;
+				if (first > lastEnd + MergeDistance)
+					break;
+				first = Min(first, last.m_First);
+				end = Max(end, lastEnd);
+				m_DirtyRanges.pop_back();
 			}
+			m_DirtyRanges.emplace_back(first, end - first);
+		}
+
+		/// The ranges which will be uploaded by the next call to EndRecording
+		[[nodiscard]] std::span<const DirtyRange> GetDirtyRanges() const noexcept
+		{
+			return m_DirtyRanges;
 		}
 
 		[[nodiscard]] const rdr::Buffer& GetBuffer() const noexcept { return m_Buffer; }
@@ -143,11 +202,8 @@ namespace apollo::rdr {
 		void Reallocate()
 		{
 			m_Capacity = GrowCapacity(m_Capacity);
-			auto ptr = std::make_unique<T[]>(m_Capacity);
-			for (uint32 i = 0; i < m_Size.m_Current; ++i)
-			{
-				ptr[i] = m_Elems[i];
-			}
+			auto ptr = std::make_unique_for_overwrite<T[]>(m_Capacity);
+			std::copy_n(m_Elems.get(), m_Size.m_Current, ptr.get());
 			m_Elems = std::move(ptr);
 		}
 
@@ -157,8 +213,8 @@ namespace apollo::rdr {
 			uint32 m_Prev = 0;
 			uint32 m_Current = 0;
 		} m_Size;
-		uint32 m_Capacity;
+		uint32 m_Capacity = 0;
 		Buffer m_Buffer;
-		bool m_Dirty = false;
+		std::vector<DirtyRange> m_DirtyRanges;
 	};
 } // namespace apollo::rdr
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "Buffer.hpp"
 #include "Context.hpp"
+#include "UploadHeap.hpp"
 #include <SDL3/SDL_gpu.h>
 #include <core/Assert.hpp>
 
@@ -51,26 +52,31 @@ namespace apollo::rdr {
 	{
 		APOLLO_ASSERT(m_Handle, "Called UploadData on null buffer");
 
-		GPUDevice& device = Context::GetInstance()->GetDevice();
-		const SDL_GPUTransferBufferCreateInfo tBufferInfo{
-			.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
-			.size = size,
-		};
-		SDL_GPUTransferBuffer* transferBuffer = SDL_CreateGPUTransferBuffer(
-			device.GetHandle(),
-			&tBufferInfo);
-		APOLLO_ASSERT(transferBuffer, "Failed to create transfer buffer: {}", SDL_GetError());
-		void* dest = SDL_MapGPUTransferBuffer(device.GetHandle(), transferBuffer, false);
-		memcpy(dest, data, size);
-		SDL_UnmapGPUTransferBuffer(device.GetHandle(), transferBuffer);
+		UploadHeap* heap = UploadHeap::GetThreadHeap();
+		APOLLO_ASSERT(heap, "No upload heap was set for the calling thread");
+		heap->UploadToBuffer(copyPass, m_Handle, offset, data, size);
+	}
 
-		const SDL_GPUTransferBufferLocation location{ .transfer_buffer = transferBuffer };
-		const SDL_GPUBufferRegion destRegion{
+	void Buffer::CopyData(
+		SDL_GPUCopyPass* copyPass,
+		const Buffer& source,
+		uint32 size,
+		uint32 sourceOffset,
+		uint32 destOffset)
+	{
+		APOLLO_ASSERT(m_Handle && source, "Called CopyData with a null buffer");
+		APOLLO_ASSERT(
+			sourceOffset + size <= source.m_Size && destOffset + size <= m_Size,
+			"Buffer copy out of bounds");
+
+		const SDL_GPUBufferLocation sourceLocation{
+			.buffer = source.m_Handle,
+			.offset = sourceOffset,
+		};
+		const SDL_GPUBufferLocation destLocation{
 			.buffer = m_Handle,
-			.offset = offset,
-			.size = size,
+			.offset = destOffset,
 		};
-		SDL_UploadToGPUBuffer(copyPass, &location, &destRegion, false);
-		SDL_ReleaseGPUTransferBuffer(device.GetHandle(), transferBuffer);
+		SDL_CopyGPUBufferToBuffer(copyPass, &sourceLocation, &destLocation, size, false);
 	}
 } // namespace apollo::rdr
\ No newline at end of file
@@ -43,11 +43,20 @@ namespace apollo::rdr {
 			other.m_Size = 0;
 		}
 
+		/// \brief Records an upload of \p size bytes to the buffer, through the
+		/// \ref UploadHeap::GetThreadHeap "calling thread's upload heap"
 		APOLLO_API void UploadData(
 			SDL_GPUCopyPass* copyPass,
 			const void* data,
 			uint32 size,
 			uint32 destOffset = 0);
+		/// \brief Records a GPU-side copy of \p size bytes from \p source to this buffer
+		APOLLO_API void CopyData(
+			SDL_GPUCopyPass* copyPass,
+			const Buffer& source,
+			uint32 size,
+			uint32 sourceOffset = 0,
+			uint32 destOffset = 0);
 
 		void Swap(Buffer& other) noexcept
 		{
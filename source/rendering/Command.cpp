@@ -206,7 +206,12 @@ namespace apollo::rdr {
 
 #undef COMMAND_TYPE_IMPL
 
-	GPUCommand::GPUCommand(EShaderStage stage, const void* data, size_t size, uint32 slot)
+	GPUCommand::GPUCommand(
+		std::pmr::memory_resource& frameResource,
+		EShaderStage stage,
+		const void* data,
+		size_t size,
+		uint32 slot)
 		: m_Storage{ ._unused = 0 }
 	{
 		APOLLO_ASSERT(
@@ -216,7 +221,8 @@ namespace apollo::rdr {
 		APOLLO_ASSERT(slot < 4, "Shader constant block index {} is out of range", slot);
 
 		const size_t allocSize = sizeof(ShaderConstantCommand) + size - 1;
-		m_Storage.m_Constants = static_cast<ShaderConstantCommand*>(::operator new(allocSize));
+		m_Storage.m_Constants = static_cast<ShaderConstantCommand*>(
+			frameResource.allocate(allocSize, alignof(ShaderConstantCommand)));
 		new (m_Storage.m_Constants) ShaderConstantCommand{
 			.m_Size = static_cast<uint32>(size),
 			.m_Slot = slot,
@@ -313,14 +319,8 @@ namespace apollo::rdr {
 		return *this;
 	}
 
-	GPUCommand::~GPUCommand()
-	{
-		if (m_Type == ECommandType::PushVertexShaderConstants ||
-			m_Type == ECommandType::PushFragmentShaderConstants)
-		{
-			::operator delete(m_Storage.m_Constants);
-		}
-	}
+	// shader constants are allocated from the frame arena, which releases them in bulk
+	GPUCommand::~GPUCommand() = default;
 
 	void GPUCommand::operator()(Context& ctx)
 	{
@@ -9,6 +9,7 @@
 #include "ShaderInfo.hpp"
 #include <core/Poly.hpp>
 #include <core/TypeTraits.hpp>
+#include <memory_resource>
 #include <span>
 
 struct ImDrawData;
@@ -102,15 +103,31 @@ namespace apollo::rdr {
 		};
 
 		/** \name  PushVertexShaderConstants/PushFragmentShaderConstants commands
+		 * \brief The data is copied into memory allocated from \p frameResource, which is never
+		 * deallocated by the command: this is meant for a \ref FrameArena, which releases all of
+		 * its memory at once.
 		 * @{ */
-		APOLLO_API GPUCommand(EShaderStage stage, const void* data, size_t size, uint32 slot = 0);
+		APOLLO_API GPUCommand(
+			std::pmr::memory_resource& frameResource,
+			EShaderStage stage,
+			const void* data,
+			size_t size,
+			uint32 slot = 0);
 		template <class T>
-		GPUCommand(EShaderStage stage, std::span<const T> data, uint32 slot = 0)
-			: GPUCommand(stage, data.data(), data.size_bytes(), slot)
+		GPUCommand(
+			std::pmr::memory_resource& frameResource,
+			EShaderStage stage,
+			std::span<const T> data,
+			uint32 slot = 0)
+			: GPUCommand(frameResource, stage, data.data(), data.size_bytes(), slot)
 		{}
 		template <class T>
-		GPUCommand(EShaderStage stage, const T& data, uint32 slot = 0)
-			: GPUCommand(stage, &data, sizeof(data), slot)
+		GPUCommand(
+			std::pmr::memory_resource& frameResource,
+			EShaderStage stage,
+			const T& data,
+			uint32 slot = 0)
+			: GPUCommand(frameResource, stage, &data, sizeof(data), slot)
 		{}
 		/** @} */
 
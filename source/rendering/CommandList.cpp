@@ -0,0 +1,16 @@
+#include "CommandList.hpp"
+#include "Context.hpp"
+
+namespace apollo::rdr {
+	void CommandList::Execute(Context& ctx)
+	{
+		if (m_RenderPass && m_RenderPass != ctx.GetCurrentRenderPass())
+			ctx.SwitchRenderPass(m_RenderPass);
+
+		while (m_Commands.GetSize())
+		{
+			m_Commands.GetFront()(ctx);
+			m_Commands.PopFront();
+		}
+	}
+} // namespace apollo::rdr
\ No newline at end of file
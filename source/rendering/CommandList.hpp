@@ -0,0 +1,159 @@
+#pragma once
+
+/** \file CommandList.hpp
+ * \brief Lists of deferred GPU commands, which can be recorded from any thread
+ */
+
+#include <PCH.hpp>
+
+#include "Command.hpp"
+#include <core/Memory.hpp>
+#include <core/Queue.hpp>
+
+namespace apollo::rdr {
+	class Context;
+	class RenderPass;
+
+	/**
+	 * \brief A sequence of deferred GPU commands, recorded independently from other lists.
+	 * \details Lists are typically created through \ref Context::CreateCommandList, recorded by
+	 * a worker thread, then handed back to the context with \ref Context::SubmitCommandList.
+	 * At the end of the frame, the context replays all submitted lists in increasing sort key
+	 * order.
+	 *
+	 * A list can target a render pass: the context switches to it before replaying the list,
+	 * unless it is already in progress. Consecutive lists targeting the same pass are thus
+	 * recorded into a single SDL render pass, which is why sort keys should group lists by pass,
+	 * e.g. by storing a pass index in their high bits.
+	 * \note Recording into a list is not thread-safe: each list must only be recorded into by one
+	 * thread at a time.
+	 * \sa Context
+	 */
+	class CommandList
+	{
+	public:
+		/**
+		 * \param frameArena: The arena to allocate command payloads from. Lists are meant to be
+		 * replayed during the frame they were recorded in.
+		 * \param renderPass: The pass to replay the commands in, or nullptr to keep whichever
+		 * pass is in progress at that point
+		 * \param sortKey: Determines the order in which lists are replayed
+		 */
+		explicit CommandList(
+			FrameArena& frameArena,
+			RenderPass* renderPass = nullptr,
+			uint64 sortKey = 0) noexcept
+			: m_FrameArena(&frameArena)
+			, m_RenderPass(renderPass)
+			, m_SortKey(sortKey)
+		{}
+
+		CommandList(CommandList&&) noexcept = default;
+		CommandList& operator=(CommandList&&) noexcept = default;
+
+		[[nodiscard]] RenderPass* GetRenderPass() const noexcept { return m_RenderPass; }
+		[[nodiscard]] uint64 GetSortKey() const noexcept { return m_SortKey; }
+		[[nodiscard]] uint32 GetSize() const noexcept { return m_Commands.GetSize(); }
+		[[nodiscard]] bool IsEmpty() const noexcept { return !m_Commands.GetSize(); }
+
+		/** \name Deferred commands
+		 * \brief These functions add a command to the list. See
+		 * \ref rdr-derrefered-api "the Context's deferred commands" for details.
+		 * @{ */
+
+		/// Starts a new render pass. If a render pass was already in progress, it is ended first.
+		void BeginRenderPass(RenderPass& renderPass) { m_Commands.AddEmplace(renderPass); }
+		/// Sets the viewport region within the current render pass
+		void SetViewport(const RectF& viewport) { m_Commands.AddEmplace(viewport); }
+		/// Sets the scissor region within the current render pass
+		void SetScissor(const ScissorCommand& scissor) { m_Commands.AddEmplace(scissor); }
+
+		/// Pushes vertex shader constants to the GPU, see Context::PushVertexShaderConstants
+		template <class... Args>
+		void PushVertexShaderConstants(Args&&... args)
+		{
+			m_Commands.AddEmplace(*m_FrameArena, EShaderStage::Vertex, std::forward<Args>(args)...);
+		}
+		/// Pushes fragment shader constants to the GPU, see Context::PushFragmentShaderConstants
+		template <class... Args>
+		void PushFragmentShaderConstants(Args&&... args)
+		{
+			m_Commands.AddEmplace(
+				*m_FrameArena,
+				EShaderStage::Fragment,
+				std::forward<Args>(args)...);
+		}
+
+		/// Binds a graphics pipeline to the current render pass
+		void BindGraphicsPipeline(SDL_GPUGraphicsPipeline* pipeline)
+		{
+			m_Commands.AddEmplace(pipeline);
+		}
+		/// Binds a whole material to the current render pass
+		void BindMaterialInstance(const MaterialInstance& mat) { m_Commands.AddEmplace(mat); }
+
+		/// Binds an index buffer to the current render pass
+		void BindIndexBuffer(const Buffer& buffer)
+		{
+			m_Commands.AddEmplace(GPUCommand::BindIndexBuffer, buffer);
+		}
+		/// Binds a vertex buffer to the current render pass
+		void BindVertexBuffer(const Buffer& buffer)
+		{
+			m_Commands.AddEmplace(GPUCommand::BindVertexBuffers, buffer);
+		}
+		/// Binds a vertex storage buffer to the current render pass
+		void BindVertexStorageBuffer(const Buffer& buffer)
+		{
+			m_Commands.AddEmplace(GPUCommand::BindVertexStorageBuffers, buffer);
+		}
+		/// Binds a fragment storage buffer to the current render pass
+		void BindFragmentStorageBuffer(const Buffer& buffer)
+		{
+			m_Commands.AddEmplace(GPUCommand::BindFragmentStorageBuffers, buffer);
+		}
+		/// Binds multiple vertex buffers at once
+		void BindVertexBuffers(std::span<const Buffer> buffers)
+		{
+			m_Commands.AddEmplace(GPUCommand::BindVertexBuffers, buffers);
+		}
+		/// Binds multiple vertex storage buffers at once
+		void BindVertexStorageBuffers(std::span<const Buffer> buffers)
+		{
+			m_Commands.AddEmplace(GPUCommand::BindVertexStorageBuffers, buffers);
+		}
+		/// Binds multiple fragment storage buffers at once
+		void BindFragmentStorageBuffers(std::span<const Buffer> buffers)
+		{
+			m_Commands.AddEmplace(GPUCommand::BindFragmentStorageBuffers, buffers);
+		}
+		/// Issues a direct draw call
+		void DrawPrimitives(const DrawCall& call) { m_Commands.AddEmplace(call); }
+		/// Issues an indexed draw call
+		void DrawIndexedPrimitives(const IndexedDrawCall& call) { m_Commands.AddEmplace(call); }
+
+		/// Used by the editor to draw the ImGui UI layer
+		void DrawImGuiLayer(const ImGuiDrawCommand& call) { m_Commands.AddEmplace(call); }
+
+		/**
+		 * \brief Submits a custom command, as a function object.
+		 * \pre The function object must be a \ref apollo::meta::SmallTrivial "small trivial"
+		 */
+		template <class F>
+		void AddCustomCommand(F&& cmd) requires(std::is_invocable_r_v<void, F, Context&>)
+		{
+			m_Commands.AddEmplace(std::forward<F>(cmd));
+		}
+		/** @} */
+
+		/// \brief Switches to the list's render pass if needed, then replays and removes all of
+		/// its commands. Called by the context at the end of the frame.
+		APOLLO_API void Execute(Context& ctx);
+
+	private:
+		FrameArena* m_FrameArena = nullptr;
+		RenderPass* m_RenderPass = nullptr;
+		uint64 m_SortKey = 0;
+		Queue<GPUCommand> m_Commands;
+	};
+} // namespace apollo::rdr
\ No newline at end of file
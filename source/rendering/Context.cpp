@@ -2,6 +2,7 @@
 #include "Pixel.hpp"
 #include "RenderPass.hpp"
 #include <SDL3/SDL_gpu.h>
+#include <algorithm>
 #include <core/Assert.hpp>
 #include <core/Log.hpp>
 #include <core/Window.hpp>
@@ -23,6 +24,7 @@ namespace apollo::rdr {
 	{
 		if (!m_Device) [[unlikely]]
 			return;
+		UploadHeap::SetThreadHeap(&m_UploadHeap);
 
 		const SDL_GPUSamplerCreateInfo defaultSamplerInfo{
 			.min_filter = SDL_GPU_FILTER_LINEAR,
@@ -85,21 +87,42 @@ namespace apollo::rdr {
 			m_RenderPass->Begin(*this);
 	}
 
+	void Context::SubmitCommandList(CommandList&& list)
+	{
+		if (list.IsEmpty())
+			return;
+		std::unique_lock lock{ m_CommandListsMutex };
+		m_CommandLists.emplace_back(std::move(list));
+	}
+
 	void Context::EndFrame()
 	{
-		while (m_CommandQueue.GetSize())
+		std::vector<CommandList> lists;
 		{
-			m_CommandQueue.GetFront()(*this);
-			m_CommandQueue.PopFront();
+			std::unique_lock lock{ m_CommandListsMutex };
+			lists.swap(m_CommandLists);
 		}
+		const auto compareKeys = [](const CommandList& a, const CommandList& b)
+		{
+			return a.GetSortKey() < b.GetSortKey();
+		};
+		std::stable_sort(lists.begin(), lists.end(), compareKeys);
+
+		const auto mainIt = std::upper_bound(lists.begin(), lists.end(), m_MainList, compareKeys);
+		for (auto it = lists.begin(); it != mainIt; ++it)
+			it->Execute(*this);
+		m_MainList.Execute(*this);
+		for (auto it = mainIt; it != lists.end(); ++it)
+			it->Execute(*this);
 
 		m_SwapchainTexture = nullptr;
 
 		if (m_MainCommandBuffer) [[likely]]
 		{
 			SwitchRenderPass();
-			SDL_SubmitGPUCommandBuffer(m_MainCommandBuffer);
+			m_UploadHeap.EndFrame(SDL_SubmitGPUCommandBufferAndAcquireFence(m_MainCommandBuffer));
 			m_MainCommandBuffer = nullptr;
 		}
+		m_FrameArena.NextFrame();
 	}
 } // namespace apollo::rdr
\ No newline at end of file
@@ -6,9 +6,13 @@
 #include <core/Singleton.hpp>
 
 #include "Command.hpp"
+#include "CommandList.hpp"
 #include "Device.hpp"
 #include "Pixel.hpp"
-#include <core/Queue.hpp>
+#include "UploadHeap.hpp"
+#include <core/Memory.hpp>
+#include <mutex>
+#include <vector>
 
 struct SDL_Window;
 struct SDL_GPUCommandBuffer;
@@ -33,6 +37,11 @@ namespace apollo::rdr {
 	class Context : public Singleton<Context>
 	{
 	public:
+		/// SDL allows at most 3 frames in flight, the frame arena keeps a set of buffers for each
+		static constexpr uint32 NumFramesInFlight = 3;
+		/// Sort key of the commands recorded through the context's deferred commands API
+		static constexpr uint64 MainListSortKey = 1ull << 63;
+
 		APOLLO_API ~Context();
 
 		GPUDevice& GetDevice() noexcept { return m_Device; }
@@ -45,17 +54,19 @@ namespace apollo::rdr {
 
 		/** \anchor rdr-derrefered-api */
 		/** \name Deferred commands
-		 * \brief These functions add a command to the internal queue.
+		 * \brief These functions add a command to the main command list.
 		 * \details For practical reasons, GPU commands are not recorded into the command buffer
-		 * directly. They are first added to a queue and processed at the end of the frame.
+		 * directly. They are first added to a queue and processed at the end of the frame. The
+		 * main list can only be recorded into from the main thread, other threads should record
+		 * their own \ref CommandList "command lists" instead.
 		 * @{ */
 
 		/// Starts a new render pass. If a render pass was already in progress, it is ended first.
-		void BeginRenderPass(RenderPass& renderPass) { m_CommandQueue.AddEmplace(renderPass); }
+		void BeginRenderPass(RenderPass& renderPass) { m_MainList.BeginRenderPass(renderPass); }
 		/// Sets the viewport region within the current render pass
-		void SetViewport(const RectF& viewport) { m_CommandQueue.AddEmplace(viewport); }
+		void SetViewport(const RectF& viewport) { m_MainList.SetViewport(viewport); }
 		/// Sets the scissor region within the current render pass
-		void SetScissor(const ScissorCommand& scissor) { m_CommandQueue.AddEmplace(scissor); }
+		void SetScissor(const ScissorCommand& scissor) { m_MainList.SetScissor(scissor); }
 
 		/**
 		 * \brief Pushes vertex shader constants to the GPU.
@@ -67,7 +78,7 @@ namespace apollo::rdr {
 		template <class... Args>
 		void PushVertexShaderConstants(Args&&... args)
 		{
-			m_CommandQueue.AddEmplace(EShaderStage::Vertex, std::forward<Args>(args)...);
+			m_MainList.PushVertexShaderConstants(std::forward<Args>(args)...);
 		}
 		/**
 		 * \brief Pushes fragment shader constants to the GPU.
@@ -79,7 +90,7 @@ namespace apollo::rdr {
 		template <class... Args>
 		void PushFragmentShaderConstants(Args&&... args)
 		{
-			m_CommandQueue.AddEmplace(EShaderStage::Fragment, std::forward<Args>(args)...);
+			m_MainList.PushFragmentShaderConstants(std::forward<Args>(args)...);
 		}
 
 		/**
@@ -89,57 +100,63 @@ namespace apollo::rdr {
 		 */
 		void BindGraphicsPipeline(SDL_GPUGraphicsPipeline* pipeline)
 		{
-			m_CommandQueue.AddEmplace(pipeline);
+			m_MainList.BindGraphicsPipeline(pipeline);
 		}
 
 		/**
 		 * \brief Binds a whole material to the current render pass: the graphics pipeline along
 		 * with textures/samplers and fragment shader constants
 		 */
-		void BindMaterialInstance(const MaterialInstance& mat) { m_CommandQueue.AddEmplace(mat); }
+		void BindMaterialInstance(const MaterialInstance& mat)
+		{
+			m_MainList.BindMaterialInstance(mat);
+		}
 
 		/// Binds an index buffer to the current render pass
 		void BindIndexBuffer(const Buffer& buffer)
 		{
-			m_CommandQueue.AddEmplace(GPUCommand::BindIndexBuffer, buffer);
+			m_MainList.BindIndexBuffer(buffer);
 		}
 		/// Binds a vertex buffer to the current render pass
 		void BindVertexBuffer(const Buffer& buffer)
 		{
-			m_CommandQueue.AddEmplace(GPUCommand::BindVertexBuffers, buffer);
+			m_MainList.BindVertexBuffer(buffer);
 		}
 		/// Binds a vertex storage buffer to the current render pass
 		void BindVertexStorageBuffer(const Buffer& buffer)
 		{
-			m_CommandQueue.AddEmplace(GPUCommand::BindVertexStorageBuffers, buffer);
+			m_MainList.BindVertexStorageBuffer(buffer);
 		}
 		/// Binds a fragment storage buffer to the current render pass
 		void BindFragmentStorageBuffer(const Buffer& buffer)
 		{
-			m_CommandQueue.AddEmplace(GPUCommand::BindFragmentStorageBuffers, buffer);
+			m_MainList.BindFragmentStorageBuffer(buffer);
 		}
 		/// Binds multiple vertex buffers at once
 		void BindVertexBuffers(std::span<const Buffer> buffers)
 		{
-			m_CommandQueue.AddEmplace(GPUCommand::BindVertexBuffers, buffers);
+			m_MainList.BindVertexBuffers(buffers);
 		}
 		/// Binds multiple vertex storage buffers at once
 		void BindVertexStorageBuffers(std::span<const Buffer> buffers)
 		{
-			m_CommandQueue.AddEmplace(GPUCommand::BindVertexStorageBuffers, buffers);
+			m_MainList.BindVertexStorageBuffers(buffers);
 		}
 		/// Binds multiple fragment storage buffers at once
 		void BindFragmentStorageBuffers(std::span<const Buffer> buffers)
 		{
-			m_CommandQueue.AddEmplace(GPUCommand::BindFragmentStorageBuffers, buffers);
+			m_MainList.BindFragmentStorageBuffers(buffers);
 		}
 		/// Issues a direct draw call
-		void DrawPrimitives(const DrawCall& call) { m_CommandQueue.AddEmplace(call); }
+		void DrawPrimitives(const DrawCall& call) { m_MainList.DrawPrimitives(call); }
 		/// Issues an indexed draw call
-		void DrawIndexedPrimitives(const IndexedDrawCall& call) { m_CommandQueue.AddEmplace(call); }
+		void DrawIndexedPrimitives(const IndexedDrawCall& call)
+		{
+			m_MainList.DrawIndexedPrimitives(call);
+		}
 
 		/// Used by the editor to draw the ImGui UI layer
-		void DrawImGuiLayer(const ImGuiDrawCommand& call) { m_CommandQueue.AddEmplace(call); }
+		void DrawImGuiLayer(const ImGuiDrawCommand& call) { m_MainList.DrawImGuiLayer(call); }
 
 		/**
 		 * \brief Submits a custom command, as a function object.
@@ -148,7 +165,7 @@ namespace apollo::rdr {
 		template <class F>
 		void AddCustomCommand(F&& cmd) requires(requires { cmd(*this); })
 		{
-			m_CommandQueue.AddEmplace(std::forward<F>(cmd));
+			m_MainList.AddCustomCommand(std::forward<F>(cmd));
 		}
 		/** @} */
 
@@ -160,9 +177,43 @@ namespace apollo::rdr {
 		/// Returns `nullptr` if called outside of BeginFrame/EndFrame
 		[[nodiscard]] SDL_GPUTexture* GetSwapchainTexture() noexcept { return m_SwapchainTexture; }
 
-		/// Processes the command queue and submits the command buffer
+		/**
+		 * \brief Creates a command list which can be recorded from any thread, then handed back
+		 * through SubmitCommandList.
+		 * \param renderPass: The pass to replay the list in, or nullptr to keep whichever pass is
+		 * in progress at that point
+		 * \param sortKey: Lists are replayed in increasing sort key order. The main list has a
+		 * key of \ref MainListSortKey.
+		 */
+		[[nodiscard]] CommandList CreateCommandList(
+			RenderPass* renderPass = nullptr,
+			uint64 sortKey = MainListSortKey) noexcept
+		{
+			return CommandList{ m_FrameArena, renderPass, sortKey };
+		}
+		/// \brief Queues a list for replay at the end of the frame. Thread-safe.
+		APOLLO_API void SubmitCommandList(CommandList&& list);
+
+		/// \brief Replays all command lists in sort key order, submits the command buffer and moves
+		/// the \ref GetFrameArena "frame arena" on to the next frame
+		/// \details Lists with the same key are replayed in submission order, the main list being
+		/// replayed after all of the lists submitted with its key.
 		APOLLO_API void EndFrame();
 
+		/**
+		 * \anchor GetFrameArena
+		 * \brief Linear allocator for per-frame scratch memory, usable from any thread.
+		 * \details Memory allocated from it stays valid until EndFrame has been called
+		 * NumFramesInFlight times, and doesn't need to be deallocated.
+		 * \note Only meant for memory rebuilt every frame. Containers which are cleared and refilled
+		 * every frame, but keep their capacity (e.g. a RenderQueue or InstanceBatcher held by a
+		 * system), already stop allocating after the first few frames, and would dangle once the
+		 * arena gets reset.
+		 */
+		[[nodiscard]] FrameArena& GetFrameArena() noexcept { return m_FrameArena; }
+		/// \brief The upload heap used by the main thread
+		[[nodiscard]] UploadHeap& GetUploadHeap() noexcept { return m_UploadHeap; }
+
 		[[nodiscard]] EPixelFormat GetSwapchainTextureFormat() const noexcept
 		{
 			return m_SwapchainFormat;
@@ -194,18 +245,25 @@ namespace apollo::rdr {
 			bool vSync = false);
 
 		friend class Singleton<Context>;
+		friend class CommandList;
 		friend class GPUCommand;
 
 		static APOLLO_API std::unique_ptr<Context> s_Instance;
 
 		GPUDevice m_Device;
 		Window& m_Window;
+		/// Used to upload data from the main thread, fenced with the main command buffer
+		UploadHeap m_UploadHeap{ m_Device.GetHandle() };
 
 		SDL_GPUCommandBuffer* m_MainCommandBuffer = nullptr;
 		SDL_GPUTexture* m_SwapchainTexture = nullptr;
 		EPixelFormat m_SwapchainFormat = EPixelFormat::Invalid;
 		SDL_GPUSampler* m_DefaultSampler = nullptr;
 		RenderPass* m_RenderPass = nullptr;
-		Queue<GPUCommand> m_CommandQueue;
+		FrameArena m_FrameArena{ NumFramesInFlight };
+		CommandList m_MainList{ m_FrameArena, nullptr, MainListSortKey };
+		std::mutex m_CommandListsMutex;
+		/// Lists submitted from any thread, replayed at the end of the frame
+		std::vector<CommandList> m_CommandLists;
 	};
 } // namespace apollo::rdr
\ No newline at end of file
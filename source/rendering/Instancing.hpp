@@ -0,0 +1,139 @@
+#pragma once
+
+/** \file Instancing.hpp
+ * \brief Automatic instancing of draws sharing a mesh and a material instance
+ */
+
+#include <PCH.hpp>
+
+#include "Batch.hpp"
+#include <core/Hash.hpp>
+#include <core/Map.hpp>
+#include <span>
+#include <vector>
+
+namespace apollo::rdr {
+	class MaterialInstance;
+	class Mesh;
+
+	/**
+	 * \brief Groups objects which share a mesh and a material instance, so that each group can be
+	 * drawn with a single instanced draw call.
+	 * \details Per-instance data (typically a model matrix) is packed into a \ref Batch, with the
+	 * instances of each group stored contiguously. Shaders read their instance's data from the
+	 * batch's storage buffer, at the group's first instance plus `SV_InstanceID`. The first
+	 * instance has to be passed as a shader constant: SDL doesn't add the draw's first instance
+	 * to `SV_InstanceID` on all backends.
+	 *
+	 * Meshes and material instances are only used as keys, and are never dereferenced.
+	 * \tparam T: The per-instance data type
+	 */
+	template <class T>
+	class InstanceBatcher
+	{
+	public:
+		/// Objects drawn with a single instanced draw call
+		struct Group
+		{
+			const Mesh* m_Mesh = nullptr;
+			const MaterialInstance* m_Material = nullptr;
+			/// The smallest sort key of the group's instances
+			uint64 m_Key = 0;
+			/// Index of the group's first instance in the packed batch, set by \ref Pack
+			uint32 m_FirstInstance = 0;
+			uint32 m_NumInstances = 0;
+		};
+
+		/// \brief Adds an instance to the group matching \p mesh and \p material, creating it if
+		/// needed
+		void Add(const Mesh& mesh, const MaterialInstance& material, uint64 key, const T& data)
+		{
+			const auto [it, inserted] = m_GroupIndices.try_emplace(
+				GroupKey{ &mesh, &material },
+				uint32(m_Groups.size()));
+			if (inserted)
+				m_Groups.emplace_back(&mesh, &material, key);
+
+			Group& group = m_Groups[it->second];
+			group.m_Key = Min(group.m_Key, key);
+			++group.m_NumInstances;
+			m_Instances.emplace_back(it->second, data);
+		}
+		/// \brief Adds an instance in a group of its own. Used for objects which need to be drawn
+		/// in a specific order, e.g. transparent ones.
+		void AddSingle(
+			const Mesh& mesh,
+			const MaterialInstance& material,
+			uint64 key,
+			const T& data)
+		{
+			m_Instances.emplace_back(uint32(m_Groups.size()), data);
+			m_Groups.emplace_back(&mesh, &material, key, 0, 1);
+		}
+
+		/**
+		 * \brief Packs the instance data of all groups into \p batch, and sets each group's first
+		 * instance.
+		 * \details The batch is cleared first. Within a group, instances keep the order in which
+		 * they were added. Call Batch::EndRecording afterwards to upload the data.
+		 */
+		void Pack(Batch<T>& batch)
+		{
+			uint32 offset = 0;
+			m_Cursors.resize(m_Groups.size());
+			for (uint32 i = 0; i < m_Groups.size(); ++i)
+			{
+				m_Groups[i].m_FirstInstance = offset;
+				m_Cursors[i] = offset;
+				offset += m_Groups[i].m_NumInstances;
+			}
+
+			m_Order.resize(m_Instances.size());
+			for (uint32 i = 0; i < m_Instances.size(); ++i)
+				m_Order[m_Cursors[m_Instances[i].m_Group]++] = i;
+
+			batch.Clear();
+			batch.StartRecording();
+			for (const uint32 index : m_Order)
+				batch.Add(T{ m_Instances[index].m_Data });
+		}
+
+		[[nodiscard]] std::span<const Group> GetGroups() const noexcept { return m_Groups; }
+		[[nodiscard]] size_t GetInstanceCount() const noexcept { return m_Instances.size(); }
+
+		/// \brief Removes all groups and instances, keeping the allocated memory
+		void Clear() noexcept
+		{
+			m_GroupIndices.clear();
+			m_Groups.clear();
+			m_Instances.clear();
+		}
+
+	private:
+		struct GroupKey
+		{
+			const Mesh* m_Mesh;
+			const MaterialInstance* m_Material;
+
+			[[nodiscard]] bool operator==(const GroupKey&) const noexcept = default;
+		};
+		struct GroupKeyHash
+		{
+			[[nodiscard]] uint64 operator()(const GroupKey& key) const noexcept
+			{
+				return HashCombine(0, key.m_Mesh, key.m_Material);
+			}
+		};
+		struct Instance
+		{
+			uint32 m_Group;
+			T m_Data;
+		};
+
+		FlatHashMap<GroupKey, uint32, GroupKeyHash> m_GroupIndices;
+		std::vector<Group> m_Groups;
+		std::vector<Instance> m_Instances;
+		std::vector<uint32> m_Cursors;
+		std::vector<uint32> m_Order;
+	};
+} // namespace apollo::rdr
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include <asset/Asset.hpp>
 #include <asset/AssetRef.hpp>
 #include <core/Assert.hpp>
+#include <nlohmann/json_fwd.hpp>
 
 struct SDL_GPUCommandBuffer;
 struct SDL_GPUGraphicsPipeline;
@@ -18,8 +19,12 @@ struct SDL_GPURenderPass;
 struct SDL_GPUSampler;
 
 namespace apollo {
+	struct AssetLoadTask;
 	struct AssetMetadata;
 	enum class EAssetLoadResult : int8;
+
+	template <class>
+	struct PackAssetHelper;
 } // namespace apollo
 
 namespace apollo::editor {
@@ -114,6 +119,14 @@ namespace apollo::rdr {
 
 	private:
 		friend struct editor::AssetHelper<Material>;
+		friend struct PackAssetHelper<Material>;
+
+		/**
+		 * \brief Creates the pipeline from its JSON description, once both shaders are loaded
+		 * \details Shared by the loaders of all asset managers, which only differ in where they
+		 * read the description from. A discarded document fails the load.
+		 */
+		APOLLO_API AssetLoadTask LoadFromJson(nlohmann::json json, const AssetMetadata& metadata);
 
 		AssetRef<VertexShader> m_VertShader;
 		AssetRef<FragmentShader> m_FragShader;
@@ -192,6 +205,14 @@ namespace apollo::rdr {
 
 	private:
 		friend struct editor::AssetHelper<MaterialInstance>;
+		friend struct PackAssetHelper<MaterialInstance>;
+
+		/**
+		 * \brief Loads the instance from its JSON description, once its material is loaded
+		 * \details Shared by the loaders of all asset managers, which only differ in where they
+		 * read the description from. A discarded document fails the load.
+		 */
+		APOLLO_API AssetLoadTask LoadFromJson(nlohmann::json json, const AssetMetadata& metadata);
 
 		struct ConstantStorage
 		{
@@ -9,7 +9,10 @@
 
 namespace apollo {
 	enum class EAssetLoadResult : int8;
-}
+
+	template <class>
+	struct PackAssetHelper;
+} // namespace apollo
 
 namespace apollo::editor {
 	template <class>
@@ -47,5 +50,6 @@ namespace apollo::rdr {
 		uint32 m_NumIndices = 0;
 
 		friend struct editor::AssetHelper<Mesh>;
+		friend struct PackAssetHelper<Mesh>;
 	};
 } // namespace apollo::rdr
\ No newline at end of file
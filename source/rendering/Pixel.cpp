@@ -0,0 +1,88 @@
+#include "Pixel.hpp"
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define APOLLO_PIXEL_SSE2 1
+#include <emmintrin.h>
+#else
+#define APOLLO_PIXEL_SSE2 0
+#endif
+
+#if !APOLLO_PIXEL_SSE2 && (defined(__ARM_NEON) || defined(_M_ARM64)) && \
+	(defined(__aarch64__) || defined(_M_ARM64))
+#define APOLLO_PIXEL_NEON 1
+#include <arm_neon.h>
+#else
+#define APOLLO_PIXEL_NEON 0
+#endif
+
+namespace {
+	using namespace apollo;
+
+	[[nodiscard]] uint8 ToUNorm8(float x) noexcept
+	{
+		// NaN goes through the clamp, and can't be cast to an integer: the SIMD conversions map it
+		// to 0
+		if (std::isnan(x))
+			return 0;
+		// std::nearbyint rounds ties to even, like the SIMD conversions
+		return uint8(std::nearbyint(255.0f * Clamp(x, 0.0f, 1.0f)));
+	}
+
+#if APOLLO_PIXEL_SSE2
+	[[nodiscard]] __m128i ToUNorm8x4(const float* in) noexcept
+	{
+		const __m128 x = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(in), _mm_setzero_ps()), _mm_set1_ps(1));
+		return _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(255)));
+	}
+#elif APOLLO_PIXEL_NEON
+	[[nodiscard]] int32x4_t ToUNorm8x4(const float* in) noexcept
+	{
+		const float32x4_t x = vminq_f32(vmaxq_f32(vld1q_f32(in), vdupq_n_f32(0)), vdupq_n_f32(1));
+		return vcvtnq_s32_f32(vmulq_f32(x, vdupq_n_f32(255)));
+	}
+#endif
+} // namespace
+
+namespace apollo::rdr {
+	void ConvertToRGBA8(std::span<const RGBAPixel<float>> in, RGBAPixel<uint8>* out)
+	{
+		const float* src = &in.data()->r;
+		uint8* dest = &out->r;
+		size_t i = 0;
+
+		// 4 pixels per iteration
+#if APOLLO_PIXEL_SSE2
+		for (; i + 4 <= in.size(); i += 4)
+		{
+			const __m128i lo = _mm_packs_epi32(ToUNorm8x4(src), ToUNorm8x4(src + 4));
+			const __m128i hi = _mm_packs_epi32(ToUNorm8x4(src + 8), ToUNorm8x4(src + 12));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dest), _mm_packus_epi16(lo, hi));
+			src += 16;
+			dest += 16;
+		}
+#elif APOLLO_PIXEL_NEON
+		for (; i + 4 <= in.size(); i += 4)
+		{
+			const int16x8_t lo = vcombine_s16(
+				vqmovn_s32(ToUNorm8x4(src)),
+				vqmovn_s32(ToUNorm8x4(src + 4)));
+			const int16x8_t hi = vcombine_s16(
+				vqmovn_s32(ToUNorm8x4(src + 8)),
+				vqmovn_s32(ToUNorm8x4(src + 12)));
+			vst1q_u8(dest, vcombine_u8(vqmovun_s16(lo), vqmovun_s16(hi)));
+			src += 16;
+			dest += 16;
+		}
+#endif
+		for (; i < in.size(); ++i)
+		{
+			out[i] = RGBAPixel<uint8>{
+				ToUNorm8(in[i].r),
+				ToUNorm8(in[i].g),
+				ToUNorm8(in[i].b),
+				ToUNorm8(in[i].a),
+			};
+		}
+	}
+} // namespace apollo::rdr
\ No newline at end of file
@@ -4,6 +4,8 @@
 
 #include <PCH.hpp>
 
+#include <span>
+
 namespace apollo::rdr {
 	template <class T, uint32 N>
 	struct Pixel;
@@ -170,4 +172,12 @@ namespace apollo::rdr {
 		NFormats
 	};
 
+	/**
+	 * \brief Converts normalized floating point pixels to 8-bit pixels
+	 * \details Channels are clamped to [0, 1], then scaled and rounded to the nearest integer
+	 * (ties to even). Uses SSE2 or NEON when available, the results are identical on all
+	 * implementations.
+	 * \param out: Must be able to hold `in.size()` pixels
+	 */
+	APOLLO_API void ConvertToRGBA8(std::span<const RGBAPixel<float>> in, RGBAPixel<uint8>* out);
 } // namespace apollo::rdr
\ No newline at end of file
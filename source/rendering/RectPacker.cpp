@@ -0,0 +1,272 @@
+#include "RectPacker.hpp"
+#include <algorithm>
+#include <core/Assert.hpp>
+
+namespace {
+	using apollo::Max;
+	using apollo::Min;
+
+	[[nodiscard]] uint64 GetSortKey(const RectU32& rect, apollo::rdr::EPackingOrder order) noexcept
+	{
+		using apollo::rdr::EPackingOrder;
+		const uint64 width = rect.GetWidth(), height = rect.GetHeight();
+		switch (order)
+		{
+		case EPackingOrder::Height: return height;
+		case EPackingOrder::Area: return width * height;
+		case EPackingOrder::Perimeter: return width + height;
+		case EPackingOrder::MaxSide: return Max(width, height);
+		default: return 0;
+		}
+	}
+
+	[[nodiscard]] constexpr bool Intersect(const RectU32& a, const RectU32& b) noexcept
+	{
+		return a.x0 < b.x1 && b.x0 < a.x1 && a.y0 < b.y1 && b.y0 < a.y1;
+	}
+
+	[[nodiscard]] constexpr bool Contains(const RectU32& outer, const RectU32& inner) noexcept
+	{
+		return outer.x0 <= inner.x0 && outer.y0 <= inner.y0 && outer.x1 >= inner.x1 &&
+			   outer.y1 >= inner.y1;
+	}
+} // namespace
+
+namespace apollo::rdr {
+	RectPacker::RectPacker(
+		uint32 maxWidth,
+		EPackingStrategy strategy,
+		EPackingOrder order,
+		uint32 margin)
+		: m_MaxWidth(maxWidth)
+		, m_Margin(margin)
+		, m_Strategy(strategy)
+		, m_Order(order)
+	{}
+
+	void RectPacker::SortRects(std::span<const RectU32> rects)
+	{
+		m_Indices.clear();
+		m_Indices.reserve(rects.size());
+		for (uint32 i = 0; i < rects.size(); ++i)
+		{
+			if (rects[i].GetWidth() && rects[i].GetHeight())
+				m_Indices.emplace_back(i);
+		}
+		if (m_Order == EPackingOrder::None)
+			return;
+
+		// ties are broken by height, then width, so that similar rectangles end up side by side
+		std::stable_sort(
+			m_Indices.begin(),
+			m_Indices.end(),
+			[&](uint32 a, uint32 b)
+			{
+				const uint64 keyA = GetSortKey(rects[a], m_Order);
+				const uint64 keyB = GetSortKey(rects[b], m_Order);
+				if (keyA != keyB)
+					return keyA > keyB;
+				if (rects[a].GetHeight() != rects[b].GetHeight())
+					return rects[a].GetHeight() > rects[b].GetHeight();
+				return rects[a].GetWidth() > rects[b].GetWidth();
+			});
+	}
+
+	glm::uvec2 RectPacker::Pack(std::span<RectU32> inout_rects)
+	{
+		SortRects(inout_rects);
+
+		uint32 width = m_MaxWidth;
+		for (RectU32& rect : inout_rects)
+		{
+			rect = { 0, 0, rect.GetWidth(), rect.GetHeight() };
+			width = Max(width, rect.x1 + m_Margin);
+		}
+
+		switch (m_Strategy)
+		{
+		case EPackingStrategy::Shelf: PackShelves(inout_rects, width); break;
+		case EPackingStrategy::Skyline: PackSkyline(inout_rects, width); break;
+		case EPackingStrategy::MaxRects: PackMaxRects(inout_rects, width); break;
+		default: APOLLO_ASSERT(false, "Invalid packing strategy {}", uint32(m_Strategy)); break;
+		}
+
+		glm::uvec2 size{ 0, 0 };
+		for (uint32 index : m_Indices)
+		{
+			size.x = Max(size.x, inout_rects[index].x1);
+			size.y = Max(size.y, inout_rects[index].y1);
+		}
+		return size;
+	}
+
+	void RectPacker::PackShelves(std::span<RectU32> inout_rects, uint32 width)
+	{
+		uint32 x = 0, y = 0, rowHeight = 0;
+		for (uint32 index : m_Indices)
+		{
+			RectU32& rect = inout_rects[index];
+			const uint32 w = rect.x1 + m_Margin, h = rect.y1 + m_Margin;
+			if (x + w > width)
+			{
+				y += rowHeight;
+				x = 0;
+				rowHeight = 0;
+			}
+			rect = { x, y, x + rect.x1, y + rect.y1 };
+			x += w;
+			rowHeight = Max(rowHeight, h);
+		}
+	}
+
+	void RectPacker::PackSkyline(std::span<RectU32> inout_rects, uint32 width)
+	{
+		// Horizontal segments of the skyline, covering [0, width) from left to right
+		struct Segment
+		{
+			uint32 m_X;
+			uint32 m_Y;
+			uint32 m_Width;
+		};
+		std::vector<Segment> skyline{ { 0, 0, width } };
+
+		for (uint32 index : m_Indices)
+		{
+			RectU32& rect = inout_rects[index];
+			const uint32 w = rect.x1 + m_Margin, h = rect.y1 + m_Margin;
+
+			// bottom-left rule: lowest top edge, then leftmost
+			uint32 best = 0, bestY = UINT32_MAX, bestTop = UINT32_MAX;
+			for (uint32 i = 0; i < skyline.size() && skyline[i].m_X + w <= width; ++i)
+			{
+				// the rectangle rests on the highest segment it spans
+				uint32 y = 0;
+				uint32 remaining = w;
+				for (uint32 j = i; remaining; ++j)
+				{
+					y = Max(y, skyline[j].m_Y);
+					remaining -= Min(remaining, skyline[j].m_Width);
+				}
+				if (y + h < bestTop)
+				{
+					best = i;
+					bestY = y;
+					bestTop = y + h;
+				}
+			}
+
+			const uint32 x = skyline[best].m_X;
+			rect = { x, bestY, x + rect.x1, bestY + rect.y1 };
+
+			// the new segment covers [x, x + w), shorten or remove the segments below it
+			skyline.insert(skyline.begin() + best, Segment{ x, bestTop, w });
+			for (uint32 i = best + 1; i < skyline.size();)
+			{
+				Segment& segment = skyline[i];
+				const uint32 end = x + w;
+				if (segment.m_X >= end)
+					break;
+				const uint32 overlap = end - segment.m_X;
+				if (segment.m_Width > overlap)
+				{
+					segment.m_X += overlap;
+					segment.m_Width -= overlap;
+					break;
+				}
+				skyline.erase(skyline.begin() + i);
+			}
+			// merge segments at the same height
+			for (uint32 i = 1; i < skyline.size();)
+			{
+				if (skyline[i - 1].m_Y == skyline[i].m_Y)
+				{
+					skyline[i - 1].m_Width += skyline[i].m_Width;
+					skyline.erase(skyline.begin() + i);
+				}
+				else
+					++i;
+			}
+		}
+	}
+
+	void RectPacker::PackMaxRects(std::span<RectU32> inout_rects, uint32 width)
+	{
+		// stacking all rectangles is always possible, which bounds the height of the strip
+		uint32 height = 1;
+		for (uint32 index : m_Indices)
+			height += inout_rects[index].y1 + m_Margin;
+
+		std::vector<RectU32> freeRects{ RectU32{ 0, 0, width, height } };
+		std::vector<RectU32> splitRects;
+
+		for (uint32 index : m_Indices)
+		{
+			RectU32& rect = inout_rects[index];
+			const uint32 w = rect.x1 + m_Margin, h = rect.y1 + m_Margin;
+
+			// bottom-left rule: lowest top edge, then leftmost
+			const RectU32* best = nullptr;
+			for (const RectU32& freeRect : freeRects)
+			{
+				if (freeRect.GetWidth() < w || freeRect.GetHeight() < h)
+					continue;
+				if (!best || freeRect.y0 < best->y0 ||
+					(freeRect.y0 == best->y0 && freeRect.x0 < best->x0))
+				{
+					best = &freeRect;
+				}
+			}
+			APOLLO_ASSERT(best, "No room left to pack a {}x{} rectangle", w, h);
+
+			const RectU32 used{ best->x0, best->y0, best->x0 + w, best->y0 + h };
+			rect = { used.x0, used.y0, used.x0 + rect.x1, used.y0 + rect.y1 };
+
+			// split the free rectangles overlapping the new one into their maximal remainders
+			splitRects.clear();
+			std::erase_if(
+				freeRects,
+				[&](const RectU32& f)
+				{
+					if (!Intersect(f, used))
+						return false;
+					if (used.x0 > f.x0)
+						splitRects.push_back({ f.x0, f.y0, used.x0, f.y1 });
+					if (used.x1 < f.x1)
+						splitRects.push_back({ used.x1, f.y0, f.x1, f.y1 });
+					if (used.y0 > f.y0)
+						splitRects.push_back({ f.x0, f.y0, f.x1, used.y0 });
+					if (used.y1 < f.y1)
+						splitRects.push_back({ f.x0, used.y1, f.x1, f.y1 });
+					return true;
+				});
+
+			// Only the new rectangles can be redundant: the others were maximal before, and the
+			// new ones are smaller than the rectangle they come from.
+			for (uint32 i = 0; i < splitRects.size(); ++i)
+			{
+				const RectU32& candidate = splitRects[i];
+				bool redundant = std::ranges::any_of(
+					freeRects,
+					[&](const RectU32& f) { return Contains(f, candidate); });
+				for (uint32 j = 0; j < splitRects.size() && !redundant; ++j)
+				{
+					// of two identical rectangles, only keep the first one
+					redundant = j != i && Contains(splitRects[j], candidate) &&
+								(j < i || !Contains(candidate, splitRects[j]));
+				}
+				if (!redundant)
+					freeRects.emplace_back(candidate);
+			}
+		}
+	}
+
+	float RectPacker::ComputeEfficiency(std::span<const RectU32> rects, glm::uvec2 size) noexcept
+	{
+		if (!size.x || !size.y)
+			return 0.0f;
+		uint64 area = 0;
+		for (const RectU32& rect : rects)
+			area += uint64(rect.GetWidth()) * rect.GetHeight();
+		return float(double(area) / (double(size.x) * size.y));
+	}
+} // namespace apollo::rdr
\ No newline at end of file
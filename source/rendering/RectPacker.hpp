@@ -0,0 +1,80 @@
+#pragma once
+
+/** \file RectPacker.hpp
+ * \brief Rectangle packing, used to build texture atlases
+ */
+
+#include <PCH.hpp>
+
+#include <span>
+#include <vector>
+
+namespace apollo::rdr {
+	/// Algorithm used to place rectangles
+	enum class EPackingStrategy : uint8
+	{
+		/// Rows of rectangles, starting a new row when the current one is full. Fastest, but wastes
+		/// the space above short rectangles.
+		Shelf,
+		/// Places each rectangle as low as possible on the skyline formed by the rectangles below.
+		Skyline,
+		/// Tracks all maximal free rectangles, placing each rectangle in the lowest one. Slowest,
+		/// but densest.
+		MaxRects,
+		NStrategies
+	};
+
+	/// Order in which rectangles are packed. All orders are decreasing.
+	enum class EPackingOrder : uint8
+	{
+		/// Rectangles are packed in the order they are given
+		None,
+		Height,
+		Area,
+		Perimeter,
+		/// Largest of width and height
+		MaxSide,
+		NOrders
+	};
+
+	/**
+	 * \brief Packs rectangles in a strip of fixed width, minimizing its height.
+	 */
+	class RectPacker
+	{
+	public:
+		/**
+		 * \param maxWidth: The width of the strip. Rectangles wider than that widen the strip.
+		 * \param margin: Space left between rectangles
+		 */
+		APOLLO_API explicit RectPacker(
+			uint32 maxWidth,
+			EPackingStrategy strategy = EPackingStrategy::Skyline,
+			EPackingOrder order = EPackingOrder::Height,
+			uint32 margin = 1);
+
+		/**
+		 * \brief Places \p inout_rects, keeping their width and height.
+		 * \details Empty rectangles are moved to the origin, and don't take up any space.
+		 * \returns The size of the area covered by the packed rectangles
+		 */
+		APOLLO_API glm::uvec2 Pack(std::span<RectU32> inout_rects);
+
+		/// \brief Ratio of the area of \p rects over the \p size of the area they were packed in
+		[[nodiscard]] static APOLLO_API float
+		ComputeEfficiency(std::span<const RectU32> rects, glm::uvec2 size) noexcept;
+
+	private:
+		void SortRects(std::span<const RectU32> rects);
+		void PackShelves(std::span<RectU32> inout_rects, uint32 width);
+		void PackSkyline(std::span<RectU32> inout_rects, uint32 width);
+		void PackMaxRects(std::span<RectU32> inout_rects, uint32 width);
+
+		uint32 m_MaxWidth;
+		uint32 m_Margin;
+		EPackingStrategy m_Strategy;
+		EPackingOrder m_Order;
+		/// Indices of the rectangles to pack, in packing order
+		std::vector<uint32> m_Indices;
+	};
+} // namespace apollo::rdr
\ No newline at end of file
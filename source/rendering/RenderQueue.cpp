@@ -0,0 +1,142 @@
+#include "RenderQueue.hpp"
+#include <cstddef>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define APOLLO_RENDER_QUEUE_SSE2 1
+#include <emmintrin.h>
+#else
+#define APOLLO_RENDER_QUEUE_SSE2 0
+#endif
+
+namespace {
+	template <class UInt, uint8 P>
+	[[nodiscard]] UInt ToFixedPoint(float x)
+	{
+		const UInt pow2 = UInt(1) << P;
+		constexpr UInt mask = pow2 - 1;
+		const float rounding = x < 0 ? -0.5f : 0.5f;
+
+		return static_cast<UInt>((x * pow2 + rounding)) & mask;
+	}
+
+	constexpr uint32 RadixBits = 8;
+	constexpr uint32 RadixSize = 1u << RadixBits;
+	constexpr uint32 NumDigits = 64 / RadixBits;
+
+	using Histograms = uint32[NumDigits][RadixSize];
+
+	/// \brief Counts every digit of every key in a single pass
+	/// \returns A mask of the key bits which differ between entries, used to skip the passes
+	/// which wouldn't move anything
+	template <class Entry>
+	uint64 BuildHistograms(const Entry* entries, size_t n, Histograms& counts)
+	{
+		static_assert(sizeof(Entry) == 16 && offsetof(Entry, m_Key) == 0);
+		std::memset(counts, 0, sizeof(Histograms));
+		if (!n)
+			return 0;
+
+		const uint64 first = entries[0].m_Key;
+#if APOLLO_RENDER_QUEUE_SSE2
+		// set bits flag the bits which differ from the first key, checked 2 keys at a time
+		const __m128i ref = _mm_set1_epi64x(int64(first));
+		__m128i diff = _mm_setzero_si128();
+		size_t i = 0;
+		for (; i + 2 <= n; i += 2)
+		{
+			const __m128i e0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(entries + i));
+			const __m128i e1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(entries + i + 1));
+			diff = _mm_or_si128(diff, _mm_xor_si128(_mm_unpacklo_epi64(e0, e1), ref));
+
+			const uint64 k0 = entries[i].m_Key;
+			const uint64 k1 = entries[i + 1].m_Key;
+			for (uint32 d = 0; d < NumDigits; ++d)
+			{
+				++counts[d][(k0 >> (d * RadixBits)) & (RadixSize - 1)];
+				++counts[d][(k1 >> (d * RadixBits)) & (RadixSize - 1)];
+			}
+		}
+		alignas(16) uint64 lanes[2];
+		_mm_store_si128(reinterpret_cast<__m128i*>(lanes), diff);
+		uint64 mask = lanes[0] | lanes[1];
+#else
+		size_t i = 0;
+		uint64 mask = 0;
+#endif
+		for (; i < n; ++i)
+		{
+			const uint64 key = entries[i].m_Key;
+			mask |= key ^ first;
+			for (uint32 d = 0; d < NumDigits; ++d)
+				++counts[d][(key >> (d * RadixBits)) & (RadixSize - 1)];
+		}
+		return mask;
+	}
+} // namespace
+
+namespace apollo::rdr {
+	uint64 RenderQueue::ComputeKey(MaterialInstanceKey material, float distance) noexcept
+	{
+		if (material.WritesToDepthBuffer())
+		{
+			return ((uint64)material << 24) | ToFixedPoint<uint64, 24>(distance);
+		}
+		else
+		{
+			return BIT(54) | (ToFixedPoint<uint64, 24>(-distance) << 30) | (uint64)material;
+		}
+	}
+
+	void RenderQueue::Submit(
+		const DrawPacket& packet,
+		const void* vertexConstants,
+		uint32 size,
+		uint32 slot)
+	{
+		Submit(packet);
+		Packet& p = m_Packets.back();
+		p.m_ConstantsOffset = uint32(m_Constants.size());
+		p.m_ConstantsSize = size;
+		p.m_ConstantsSlot = slot;
+
+		const uint8* const bytes = static_cast<const uint8*>(vertexConstants);
+		m_Constants.insert(m_Constants.end(), bytes, bytes + size);
+	}
+
+	void RenderQueue::Sort()
+	{
+		const size_t n = m_Entries.size();
+		if (n < 2)
+			return;
+
+		Histograms counts;
+		const uint64 diff = BuildHistograms(m_Entries.data(), n, counts);
+		m_Scratch.resize(n);
+
+		SortEntry* src = m_Entries.data();
+		SortEntry* dst = m_Scratch.data();
+		for (uint32 d = 0; d < NumDigits; ++d)
+		{
+			const uint32 shift = d * RadixBits;
+			if (!((diff >> shift) & (RadixSize - 1)))
+				continue;
+
+			uint32 offsets[RadixSize];
+			uint32 sum = 0;
+			for (uint32 i = 0; i < RadixSize; ++i)
+			{
+				offsets[i] = sum;
+				sum += counts[d][i];
+			}
+			for (size_t i = 0; i < n; ++i)
+			{
+				const SortEntry& entry = src[i];
+				dst[offsets[(entry.m_Key >> shift) & (RadixSize - 1)]++] = entry;
+			}
+			std::swap(src, dst);
+		}
+		if (src != m_Entries.data())
+			m_Entries.swap(m_Scratch);
+	}
+} // namespace apollo::rdr
\ No newline at end of file
@@ -0,0 +1,226 @@
+#pragma once
+
+/** \file RenderQueue.hpp
+ * \brief Sorted draw packets, turned into a minimal stream of GPU commands
+ */
+
+#include <PCH.hpp>
+
+#include "Command.hpp"
+#include "Material.hpp"
+#include <vector>
+
+namespace apollo::rdr {
+	class Buffer;
+
+	/// \brief Everything needed to issue a single draw call
+	struct DrawPacket
+	{
+		/// Draw order, see \ref RenderQueue::ComputeKey
+		uint64 m_Key = 0;
+		const MaterialInstance* m_Material = nullptr;
+		/// May be null, e.g. for procedural geometry generated from the vertex index
+		const Buffer* m_VertexBuffer = nullptr;
+		/// If null, a non-indexed draw call is issued
+		const Buffer* m_IndexBuffer = nullptr;
+		/// Optional per-instance data, see \ref InstanceBatcher
+		const Buffer* m_VertexStorageBuffer = nullptr;
+		/// The number of indices for indexed draws, vertices otherwise
+		uint32 m_NumElements = 0;
+		uint32 m_NumInstances = 1;
+		/// The first index for indexed draws, vertex otherwise
+		uint32 m_FirstElement = 0;
+		uint32 m_FirstInstance = 0;
+		/// Only used by indexed draws
+		int32 m_VertexOffset = 0;
+	};
+
+	/**
+	 * \brief Collects draw packets for a frame, sorts them by key and emits the GPU commands
+	 * needed to draw them.
+	 * \details Packets are sorted with an LSD radix sort, which skips the key bytes shared by all
+	 * packets. The sort is stable: packets with the same key are drawn in submission order.
+	 *
+	 * When emitting commands, the queue keeps track of the bound material instance and buffers,
+	 * and only rebinds them when they change. Since keys are built from the material instance key,
+	 * sorting groups packets by material, which keeps the number of bind commands to a minimum.
+	 * \note This class is not thread-safe: each thread should fill its own queue, and emit it into
+	 * its own \ref CommandList.
+	 */
+	class RenderQueue
+	{
+	public:
+		/// Number of state changes and draws issued by \ref Emit
+		struct Stats
+		{
+			uint32 m_NumDraws = 0;
+			uint32 m_NumMaterialBinds = 0;
+			uint32 m_NumVertexBufferBinds = 0;
+			uint32 m_NumIndexBufferBinds = 0;
+			uint32 m_NumStorageBufferBinds = 0;
+		};
+
+		RenderQueue() = default;
+		RenderQueue(RenderQueue&&) noexcept = default;
+		RenderQueue& operator=(RenderQueue&&) noexcept = default;
+
+		/**
+		 * \brief Computes a sort key from a material instance and a view depth
+		 * \details Opaque materials (which write to the depth buffer) are drawn first, grouped by
+		 * material and front to back. Transparent ones are drawn after, back to front.
+		 * \param material: The key of the material instance to draw with
+		 * \param distance: The depth of the object in view space, normalized to [0, 1)
+		 */
+		[[nodiscard]] APOLLO_API static uint64 ComputeKey(
+			MaterialInstanceKey material,
+			float distance) noexcept;
+
+		void Reserve(size_t n)
+		{
+			m_Packets.reserve(n);
+			m_Entries.reserve(n);
+		}
+
+		/// \brief Adds a packet to the queue
+		/// \pre The packet's material instance must not be null
+		void Submit(const DrawPacket& packet)
+		{
+			APOLLO_ASSERT(packet.m_Material, "Submitted draw packet without a material");
+			m_Entries.emplace_back(packet.m_Key, uint32(m_Packets.size()));
+			m_Packets.emplace_back(packet);
+		}
+		/**
+		 * \brief Adds a packet to the queue, along with vertex shader constants to push before
+		 * drawing it.
+		 * \details The constants are copied into the queue.
+		 */
+		APOLLO_API void Submit(
+			const DrawPacket& packet,
+			const void* vertexConstants,
+			uint32 size,
+			uint32 slot);
+		template <class T>
+		void Submit(const DrawPacket& packet, const T& vertexConstants, uint32 slot)
+			requires(std::is_trivially_copyable_v<T>)
+		{
+			Submit(packet, &vertexConstants, sizeof(T), slot);
+		}
+
+		/// \brief Sorts the packets by increasing key
+		APOLLO_API void Sort();
+
+		/**
+		 * \brief Emits the commands needed to draw all packets, in their current order
+		 * \details Bind commands are only emitted when the bound material instance or buffers
+		 * change, starting from an unknown state. Storage buffers are rebound along with the
+		 * material. Call \ref Sort first to minimize them.
+		 * \param sink: A \ref CommandList, the \ref Context or any type with the same deferred
+		 * commands API
+		 */
+		template <class Sink>
+		Stats Emit(Sink& sink) const;
+
+		/// \brief Removes all packets, keeping the allocated memory
+		void Clear() noexcept
+		{
+			m_Packets.clear();
+			m_Entries.clear();
+			m_Constants.clear();
+		}
+
+		[[nodiscard]] size_t GetSize() const noexcept { return m_Packets.size(); }
+		[[nodiscard]] bool IsEmpty() const noexcept { return m_Packets.empty(); }
+
+	private:
+		struct Packet : DrawPacket
+		{
+			Packet(const DrawPacket& packet) noexcept
+				: DrawPacket(packet)
+			{}
+
+			uint32 m_ConstantsOffset = 0;
+			uint32 m_ConstantsSize = 0;
+			uint32 m_ConstantsSlot = 0;
+		};
+		/// Only keys and indices are moved around while sorting
+		struct SortEntry
+		{
+			uint64 m_Key;
+			uint32 m_Index;
+		};
+
+		std::vector<Packet> m_Packets;
+		std::vector<SortEntry> m_Entries;
+		std::vector<SortEntry> m_Scratch;
+		std::vector<uint8> m_Constants;
+	};
+
+	template <class Sink>
+	RenderQueue::Stats RenderQueue::Emit(Sink& sink) const
+	{
+		Stats stats;
+		const MaterialInstance* material = nullptr;
+		const Buffer* vertexBuffer = nullptr;
+		const Buffer* indexBuffer = nullptr;
+		const Buffer* storageBuffer = nullptr;
+
+		for (const SortEntry& entry : m_Entries)
+		{
+			const Packet& packet = m_Packets[entry.m_Index];
+			if (packet.m_Material != material)
+			{
+				material = packet.m_Material;
+				sink.BindMaterialInstance(*material);
+				++stats.m_NumMaterialBinds;
+				// the storage buffer layout depends on the shaders
+				storageBuffer = nullptr;
+			}
+			if (packet.m_VertexBuffer && packet.m_VertexBuffer != vertexBuffer)
+			{
+				vertexBuffer = packet.m_VertexBuffer;
+				sink.BindVertexBuffer(*vertexBuffer);
+				++stats.m_NumVertexBufferBinds;
+			}
+			if (packet.m_VertexStorageBuffer && packet.m_VertexStorageBuffer != storageBuffer)
+			{
+				storageBuffer = packet.m_VertexStorageBuffer;
+				sink.BindVertexStorageBuffer(*storageBuffer);
+				++stats.m_NumStorageBufferBinds;
+			}
+			if (packet.m_ConstantsSize)
+			{
+				sink.PushVertexShaderConstants(
+					static_cast<const void*>(m_Constants.data() + packet.m_ConstantsOffset),
+					size_t(packet.m_ConstantsSize),
+					packet.m_ConstantsSlot);
+			}
+
+			if (!packet.m_IndexBuffer)
+			{
+				sink.DrawPrimitives(DrawCall{
+					.m_NumVertices = packet.m_NumElements,
+					.m_NumInstances = packet.m_NumInstances,
+					.m_FistVertex = packet.m_FirstElement,
+					.m_FistInstance = packet.m_FirstInstance,
+				});
+				++stats.m_NumDraws;
+				continue;
+			}
+			if (packet.m_IndexBuffer != indexBuffer)
+			{
+				indexBuffer = packet.m_IndexBuffer;
+				sink.BindIndexBuffer(*indexBuffer);
+				++stats.m_NumIndexBufferBinds;
+			}
+			sink.DrawIndexedPrimitives(IndexedDrawCall{
+				.m_NumIndices = packet.m_NumElements,
+				.m_NumInstances = packet.m_NumInstances,
+				.m_FirstIndex = packet.m_FirstElement,
+				.m_VertexOffset = packet.m_VertexOffset,
+				.m_FirstInstance = packet.m_FirstInstance,
+			});
+			++stats.m_NumDraws;
+		}
+		return stats;
+	}
+} // namespace apollo::rdr
\ No newline at end of file
@@ -67,12 +67,12 @@ namespace apollo::rdr {
 		}
 		auto* device = Context::GetInstance()->GetDevice().GetHandle();
 		const SDL_GPUTextureCreateInfo info{
-			.type = SDL_GPU_TEXTURETYPE_2D,
+			.type = settings.m_Layers ? SDL_GPU_TEXTURETYPE_2D_ARRAY : SDL_GPU_TEXTURETYPE_2D,
 			.format = (SDL_GPUTextureFormat)settings.m_Format,
 			.usage = SDL_GPUTextureUsageFlags(settings.m_Usage),
 			.width = settings.m_Width,
 			.height = settings.m_Height,
-			.layer_count_or_depth = 1,
+			.layer_count_or_depth = Max(settings.m_Layers, 1u),
 			.num_levels = 1,
 			.sample_count = SDL_GPU_SAMPLECOUNT_1,
 		};
@@ -40,10 +40,13 @@ namespace apollo::rdr {
 		uint32 m_Height = 0;
 		EPixelFormat m_Format = EPixelFormat::RGBA8_UNorm;
 		ETextureUsageFlags m_Usage = ETextureUsageFlags::Sampled;
+		/// If non-zero, the texture is created as a 2D array with this many layers
+		uint32 m_Layers = 0;
 	};
 
 	/**
 	 * \brief 2D GPU texture abstraction
+	 * \details Also used for 2D texture arrays, see TextureSettings::m_Layers
 	 */
 	class Texture2D : public IAsset, public _internal::HandleWrapper<SDL_GPUTexture*>
 	{
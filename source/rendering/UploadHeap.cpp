@@ -0,0 +1,173 @@
+#include "UploadHeap.hpp"
+#include <SDL3/SDL_gpu.h>
+#include <core/Assert.hpp>
+#include <cstring>
+
+namespace {
+	thread_local apollo::rdr::UploadHeap* t_ThreadHeap = nullptr;
+
+	[[nodiscard]] SDL_GPUTransferBuffer* CreateTransferBuffer(SDL_GPUDevice* device, uint32 size)
+	{
+		const SDL_GPUTransferBufferCreateInfo info{
+			.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+			.size = size,
+		};
+		SDL_GPUTransferBuffer* buffer = SDL_CreateGPUTransferBuffer(device, &info);
+		APOLLO_ASSERT(buffer, "Failed to create transfer buffer: {}", SDL_GetError());
+		return buffer;
+	}
+} // namespace
+
+namespace apollo::rdr {
+	UploadRing::UploadRing(uint32 numBlocks, uint32 blockSize)
+		: m_BlockSerials(numBlocks, 0)
+		, m_BlockSize(blockSize)
+	{
+		APOLLO_ASSERT(numBlocks >= 2, "Upload rings need at least 2 blocks");
+	}
+
+	UploadHeap::UploadHeap(SDL_GPUDevice* device, uint32 numBlocks, uint32 blockSize)
+		: m_Device(device)
+		, m_Ring(numBlocks, blockSize)
+		, m_Blocks(numBlocks, nullptr)
+	{}
+
+	UploadHeap::~UploadHeap()
+	{
+		RetireFrames(m_Ring.GetFrameSerial() - 1, true);
+		for (SDL_GPUTransferBuffer* block : m_Blocks)
+		{
+			if (block)
+				SDL_ReleaseGPUTransferBuffer(m_Device, block);
+		}
+		if (t_ThreadHeap == this)
+			t_ThreadHeap = nullptr;
+	}
+
+	UploadHeap::Allocation UploadHeap::Map(uint32 size, uint32 alignment)
+	{
+		APOLLO_ASSERT(size, "Upload size may not be 0");
+
+		RetireFrames(m_Ring.GetCompletedSerial(), false);
+		const auto wait = [this](uint64 serial) { return RetireFrames(serial, true); };
+		if (const auto allocation = m_Ring.Allocate(size, alignment, wait))
+		{
+			SDL_GPUTransferBuffer*& block = m_Blocks[allocation->m_Block];
+			if (!block)
+				block = CreateTransferBuffer(m_Device, m_Ring.GetBlockSize());
+
+			// Blocks can't stay mapped: SDL requires transfer buffers to be unmapped when uploading
+			// from them
+			auto* ptr = static_cast<std::byte*>(SDL_MapGPUTransferBuffer(m_Device, block, false));
+			return Allocation{
+				.m_Buffer = block,
+				.m_Offset = allocation->m_Offset,
+				.m_Size = size,
+				.m_Ptr = ptr + allocation->m_Offset,
+			};
+		}
+
+		SDL_GPUTransferBuffer* buffer = CreateTransferBuffer(m_Device, size);
+		return Allocation{
+			.m_Buffer = buffer,
+			.m_Size = size,
+			.m_Ptr = SDL_MapGPUTransferBuffer(m_Device, buffer, false),
+			.m_Dedicated = true,
+		};
+	}
+
+	void UploadHeap::UploadToBuffer(
+		SDL_GPUCopyPass* copyPass,
+		const Allocation& allocation,
+		SDL_GPUBuffer* dest,
+		uint32 destOffset)
+	{
+		SDL_UnmapGPUTransferBuffer(m_Device, allocation.m_Buffer);
+		const SDL_GPUTransferBufferLocation location{
+			.transfer_buffer = allocation.m_Buffer,
+			.offset = allocation.m_Offset,
+		};
+		const SDL_GPUBufferRegion destRegion{
+			.buffer = dest,
+			.offset = destOffset,
+			.size = allocation.m_Size,
+		};
+		SDL_UploadToGPUBuffer(copyPass, &location, &destRegion, false);
+		if (allocation.m_Dedicated)
+			SDL_ReleaseGPUTransferBuffer(m_Device, allocation.m_Buffer);
+	}
+
+	void UploadHeap::UploadToTexture(
+		SDL_GPUCopyPass* copyPass,
+		const Allocation& allocation,
+		const SDL_GPUTextureRegion& dest)
+	{
+		APOLLO_ASSERT(
+			!(allocation.m_Offset % TextureAlignment),
+			"Texture uploads must be aligned on {} bytes",
+			TextureAlignment);
+
+		SDL_UnmapGPUTransferBuffer(m_Device, allocation.m_Buffer);
+		const SDL_GPUTextureTransferInfo source{
+			.transfer_buffer = allocation.m_Buffer,
+			.offset = allocation.m_Offset,
+			.pixels_per_row = dest.w,
+			.rows_per_layer = dest.h,
+		};
+		SDL_UploadToGPUTexture(copyPass, &source, &dest, false);
+		if (allocation.m_Dedicated)
+			SDL_ReleaseGPUTransferBuffer(m_Device, allocation.m_Buffer);
+	}
+
+	void UploadHeap::UploadToBuffer(
+		SDL_GPUCopyPass* copyPass,
+		SDL_GPUBuffer* dest,
+		uint32 destOffset,
+		const void* data,
+		uint32 size)
+	{
+		const Allocation allocation = Map(size);
+		std::memcpy(allocation.m_Ptr, data, size);
+		UploadToBuffer(copyPass, allocation, dest, destOffset);
+	}
+
+	void UploadHeap::EndFrame(SDL_GPUFence* fence)
+	{
+		const uint64 serial = m_Ring.EndFrame();
+		if (fence)
+			m_PendingFrames.emplace_back(serial, fence);
+		else if (m_PendingFrames.empty())
+			m_Ring.Complete(serial);
+	}
+
+	bool UploadHeap::RetireFrames(uint64 serial, bool wait)
+	{
+		bool blocked = false;
+		uint32 numRetired = 0;
+		for (const PendingFrame& frame : m_PendingFrames)
+		{
+			if (!SDL_QueryGPUFence(m_Device, frame.m_Fence))
+			{
+				if (!wait || frame.m_Serial > serial)
+					break;
+				SDL_WaitForGPUFences(m_Device, true, &frame.m_Fence, 1);
+				blocked = true;
+			}
+			SDL_ReleaseGPUFence(m_Device, frame.m_Fence);
+			m_Ring.Complete(frame.m_Serial);
+			++numRetired;
+		}
+		m_PendingFrames.erase(m_PendingFrames.begin(), m_PendingFrames.begin() + numRetired);
+		return blocked;
+	}
+
+	UploadHeap* UploadHeap::GetThreadHeap() noexcept
+	{
+		return t_ThreadHeap;
+	}
+
+	void UploadHeap::SetThreadHeap(UploadHeap* heap) noexcept
+	{
+		t_ThreadHeap = heap;
+	}
+} // namespace apollo::rdr
\ No newline at end of file
@@ -0,0 +1,237 @@
+#pragma once
+
+/** \file UploadHeap.hpp
+ * \brief Persistent transfer buffers, suballocated to upload data to the GPU
+ */
+
+#include <PCH.hpp>
+
+#include <optional>
+#include <vector>
+
+struct SDL_GPUBuffer;
+struct SDL_GPUCopyPass;
+struct SDL_GPUDevice;
+struct SDL_GPUFence;
+struct SDL_GPUTextureRegion;
+struct SDL_GPUTransferBuffer;
+
+namespace apollo::rdr {
+	/**
+	 * \brief Bookkeeping of an \ref UploadHeap "upload heap", independent from the GPU.
+	 * \details Memory is split into fixed-size blocks, used in a circular fashion. Allocations are
+	 * carved out of the current block, and move on to the next block when it is full. Each block
+	 * remembers the last frame which used it: before being reused, the GPU must be done with that
+	 * frame.
+	 *
+	 * Frames are identified by a serial number, starting at 1. Frames are completed in order.
+	 */
+	class UploadRing
+	{
+	public:
+		struct Allocation
+		{
+			uint32 m_Block = 0;
+			uint32 m_Offset = 0;
+		};
+		struct Stats
+		{
+			uint64 m_BytesThisFrame = 0;
+			uint64 m_BytesLastFrame = 0;
+			/// Number of times we had to wait for the GPU to release a block
+			uint64 m_Stalls = 0;
+			/// Number of times we went back to the first block
+			uint64 m_Wraparounds = 0;
+			/// Allocations which didn't fit in the ring, either because they were larger than a
+			/// block, or because the whole ring was already used by the current frame
+			uint64 m_Overflows = 0;
+		};
+
+		/// \pre \p numBlocks must be at least 2
+		APOLLO_API UploadRing(uint32 numBlocks, uint32 blockSize);
+
+		/**
+		 * \brief Allocates \p size bytes from the current block, or the next one
+		 * \param alignment: Must be a power of two
+		 * \param wait: Function object called with a frame serial when the next block is still in
+		 * use by that frame. It must only return once the frame is complete, returning whether it
+		 * actually had to block.
+		 * \returns The allocation, or an empty optional if the allocation overflows the ring
+		 */
+		template <class F>
+		[[nodiscard]] std::optional<Allocation> Allocate(uint32 size, uint32 alignment, F&& wait)
+		{
+			if (size > m_BlockSize) [[unlikely]]
+			{
+				++m_Stats.m_Overflows;
+				return std::nullopt;
+			}
+
+			uint32 offset = Align(m_Offset, alignment);
+			if (offset + size > m_BlockSize)
+			{
+				const uint32 next = (m_Current + 1) % uint32(m_BlockSerials.size());
+				const uint64 serial = m_BlockSerials[next];
+				if (serial == m_FrameSerial) [[unlikely]]
+				{
+					++m_Stats.m_Overflows;
+					return std::nullopt;
+				}
+				if (serial > m_CompletedSerial)
+				{
+					m_Stats.m_Stalls += bool(wait(serial));
+					Complete(serial);
+				}
+				m_Stats.m_Wraparounds += !next;
+				m_Current = next;
+				offset = 0;
+			}
+
+			m_BlockSerials[m_Current] = m_FrameSerial;
+			m_Offset = offset + size;
+			m_Stats.m_BytesThisFrame += size;
+			return Allocation{ m_Current, offset };
+		}
+
+		/// \brief Ends the current frame
+		/// \returns The serial of the frame which just ended
+		uint64 EndFrame() noexcept
+		{
+			m_Stats.m_BytesLastFrame = m_Stats.m_BytesThisFrame;
+			m_Stats.m_BytesThisFrame = 0;
+			return m_FrameSerial++;
+		}
+		/// \brief Marks all frames up to \p serial as complete
+		void Complete(uint64 serial) noexcept
+		{
+			m_CompletedSerial = Max(m_CompletedSerial, serial);
+		}
+
+		[[nodiscard]] uint64 GetFrameSerial() const noexcept { return m_FrameSerial; }
+		[[nodiscard]] uint64 GetCompletedSerial() const noexcept { return m_CompletedSerial; }
+		[[nodiscard]] uint32 GetBlockCount() const noexcept
+		{
+			return uint32(m_BlockSerials.size());
+		}
+		[[nodiscard]] uint32 GetBlockSize() const noexcept { return m_BlockSize; }
+		[[nodiscard]] const Stats& GetStats() const noexcept { return m_Stats; }
+
+	private:
+		std::vector<uint64> m_BlockSerials;
+		uint32 m_BlockSize = 0;
+		uint32 m_Current = 0;
+		uint32 m_Offset = 0;
+		uint64 m_FrameSerial = 1;
+		uint64 m_CompletedSerial = 0;
+		Stats m_Stats;
+	};
+
+	/**
+	 * \brief Uploads data to GPU resources through a few large, persistent transfer buffers.
+	 * \details Creating a transfer buffer for every upload is costly. Instead, the heap hands out
+	 * suballocations of an \ref UploadRing "upload ring", where each block is a transfer buffer.
+	 * Blocks are fenced with the command buffer they were used in, see EndFrame. Allocations which
+	 * don't fit in the ring fall back to a dedicated transfer buffer.
+	 *
+	 * Each command buffer stream (the main rendering thread, each asset loader worker) owns its own
+	 * heap. The heap used by the calling thread can be retrieved with GetThreadHeap.
+	 * \note This class is not thread-safe.
+	 */
+	class UploadHeap
+	{
+	public:
+		/// Mapped memory to upload from
+		struct Allocation
+		{
+			SDL_GPUTransferBuffer* m_Buffer = nullptr;
+			uint32 m_Offset = 0;
+			uint32 m_Size = 0;
+			/// The address to write the data to, until the allocation is uploaded
+			void* m_Ptr = nullptr;
+			bool m_Dedicated = false;
+		};
+		using Stats = UploadRing::Stats;
+
+		static constexpr uint32 DefaultBlockCount = 4;
+		static constexpr uint32 DefaultBlockSize = 8 << 20;
+		/// Offset alignment required for texture uploads on all backends
+		static constexpr uint32 TextureAlignment = 512;
+
+		/// \note Transfer buffers are only created when first needed
+		APOLLO_API explicit UploadHeap(
+			SDL_GPUDevice* device,
+			uint32 numBlocks = DefaultBlockCount,
+			uint32 blockSize = DefaultBlockSize);
+		/// Waits for the GPU to be done with all blocks, then releases them
+		APOLLO_API ~UploadHeap();
+
+		UploadHeap(const UploadHeap&) = delete;
+		UploadHeap& operator=(const UploadHeap&) = delete;
+
+		/**
+		 * \brief Allocates and maps \p size bytes of upload memory
+		 * \details This may block if the ring has wrapped around to a block which is still in use
+		 * by the GPU. The returned memory must be uploaded with UploadToBuffer or UploadToTexture
+		 * before the next call to Map.
+		 */
+		[[nodiscard]] APOLLO_API Allocation Map(uint32 size, uint32 alignment = 16);
+
+		/** \name Upload functions
+		 * \brief Unmap \p allocation and record its upload into \p copyPass
+		 * @{ */
+		APOLLO_API void UploadToBuffer(
+			SDL_GPUCopyPass* copyPass,
+			const Allocation& allocation,
+			SDL_GPUBuffer* dest,
+			uint32 destOffset = 0);
+		/// \pre \p allocation must be aligned on TextureAlignment
+		APOLLO_API void UploadToTexture(
+			SDL_GPUCopyPass* copyPass,
+			const Allocation& allocation,
+			const SDL_GPUTextureRegion& dest);
+		/** @} */
+
+		/// \brief Copies \p data to the heap, and records its upload to \p dest
+		APOLLO_API void UploadToBuffer(
+			SDL_GPUCopyPass* copyPass,
+			SDL_GPUBuffer* dest,
+			uint32 destOffset,
+			const void* data,
+			uint32 size);
+
+		/**
+		 * \brief Ends the current frame, after its command buffer was submitted.
+		 * \param fence: The fence acquired when submitting the command buffer. The heap takes
+		 * ownership of it. May be null if nothing was submitted.
+		 */
+		APOLLO_API void EndFrame(SDL_GPUFence* fence);
+
+		[[nodiscard]] const Stats& GetStats() const noexcept { return m_Ring.GetStats(); }
+
+		/** \name Thread heap
+		 * \brief The heap used to upload data from the calling thread, e.g. by
+		 * Buffer::UploadData. Set by the rendering context for the main thread, and by the asset
+		 * loader for its workers.
+		 * @{ */
+		[[nodiscard]] static APOLLO_API UploadHeap* GetThreadHeap() noexcept;
+		static APOLLO_API void SetThreadHeap(UploadHeap* heap) noexcept;
+		/** @} */
+
+	private:
+		/// \brief Releases the fences of completed frames
+		/// \param wait: If true, blocks until frame \p serial is complete
+		/// \returns Whether the call had to block
+		bool RetireFrames(uint64 serial, bool wait);
+
+		struct PendingFrame
+		{
+			uint64 m_Serial;
+			SDL_GPUFence* m_Fence;
+		};
+
+		SDL_GPUDevice* m_Device = nullptr;
+		UploadRing m_Ring;
+		std::vector<SDL_GPUTransferBuffer*> m_Blocks;
+		std::vector<PendingFrame> m_PendingFrames;
+	};
+} // namespace apollo::rdr
\ No newline at end of file
@@ -1,13 +1,13 @@
 #include "FontAtlas.hpp"
 #include <algorithm>
 #include <core/Assert.hpp>
+#include <core/JobGraph.hpp>
 #include <core/Log.hpp>
-#include <core/ThreadPool.hpp>
 #include <core/Utf8.hpp>
 #include <freetype/freetype.h>
 #include <freetype/ftoutln.h>
-#include <latch>
 #include <msdfgen.h>
+#include <numeric>
 #include <span>
 
 namespace {
@@ -89,106 +89,81 @@ namespace {
 		};
 	};
 
-	struct GridPacker
+	/// Renders a glyph's MTSDF into \p dest, which has the size of the glyph's bitmap
+	void RenderGlyph(
+		uint32 size,
+		msdfgen::Range distanceRange,
+		float2 offset,
+		const msdfgen::Shape& shape,
+		apollo::rdr::BitmapView<apollo::rdr::RGBAPixel<uint8>> dest,
+		std::vector<float>& scratch)
 	{
-		GridPacker(uint32 maxWidth)
-			: m_MaxWidth(maxWidth)
-		{}
+		const uint32 width = dest.GetWidth(), height = dest.GetHeight();
+		const uint32 bitmapSize = width * height * 4;
+		if (!bitmapSize)
+			return;
+
+		if (scratch.size() < bitmapSize)
+			scratch.resize(bitmapSize);
+		const msdfgen::SDFTransformation transform{
+			msdfgen::Projection{
+				size,
+				msdfgen::Vector2{ -offset.x, -offset.y },
+			},
+			distanceRange,
+		};
+		msdfgen::BitmapSection<float, 4> section{
+			scratch.data(),
+			static_cast<int>(width),
+			static_cast<int>(height),
+			msdfgen::Y_DOWNWARD,
+		};
+		msdfgen::generateMTSDF(section, shape, transform);
 
-		void Pack(RectU32& inout_rect)
+		for (uint32 j = 0; j < height; ++j)
 		{
-			static constexpr uint32 margin = 1;
-			const uint32 width = inout_rect.GetWidth();
-			const uint32 height = inout_rect.GetHeight();
-
-			if ((m_MaxWidth - m_Pos.x) < (width + margin))
-			{
-				m_Pos = { 0, m_Pos.y + m_RowHeight };
-				m_Height += m_RowHeight;
-				m_RowHeight = 0;
-			}
-			inout_rect.x0 = m_Pos.x;
-			inout_rect.y0 = m_Pos.y;
-			inout_rect.x1 = m_Pos.x + width;
-			inout_rect.y1 = m_Pos.y + height;
-
-			m_Pos.x += width + margin;
-			m_Width = apollo::Max(m_Width, m_Pos.x);
-			m_RowHeight = apollo::Max(m_RowHeight, height + margin);
+			const auto* row = reinterpret_cast<const apollo::rdr::RGBAPixel<float>*>(section(0, j));
+			apollo::rdr::ConvertToRGBA8({ row, width }, &dest(0, j));
 		}
-
-		glm::uvec2 GetTotalSize() const noexcept { return { m_Width, m_Height + m_RowHeight }; }
-
-	private:
-		uint32 m_MaxWidth;
-		uint32 m_Width = 0;
-		uint32 m_Height = 0;
-		uint32 m_RowHeight = 0;
-		glm::uvec2 m_Pos = { 0, 0 };
-	};
+	}
 
 	struct RenderJob
 	{
 		using RGBA8Pixel = apollo::rdr::RGBAPixel<uint8>;
 
-		std::latch& m_Latch;
 		std::span<const apollo::rdr::txt::Glyph> m_Glyphs;
 		std::span<const msdfgen::Shape> m_Shapes;
+		/// Glyph indices, by decreasing area
+		std::span<const uint32> m_Order;
+		/// End of each chunk of m_Order. Chunks cover roughly the same area.
+		std::span<const uint32> m_ChunkEnds;
 		uint32 m_Size;
 		msdfgen::Range m_DistanceRange;
-		std::vector<float> m_Bitmap;
 		RGBA8Pixel* m_OutBuf;
 		uint32 m_BufStride;
 
-		void Render(float2 offset, const RectU32& bounds, const msdfgen::Shape& shape)
+		void Render(
+			float2 offset,
+			const RectU32& bounds,
+			const msdfgen::Shape& shape,
+			std::vector<float>& scratch) const
 		{
-			const uint32 width = bounds.GetWidth(), height = bounds.GetHeight();
-			const uint32 bitmapSize = width * height * 4;
-			if (!bitmapSize)
-				return;
-
-			if (m_Bitmap.size() < bitmapSize)
-				m_Bitmap.resize(bitmapSize);
-			const msdfgen::SDFTransformation transform{
-				msdfgen::Projection{
-					m_Size,
-					msdfgen::Vector2{ -offset.x, -offset.y },
-				},
-				m_DistanceRange,
-			};
-			msdfgen::BitmapSection<float, 4> section{
-				m_Bitmap.data(),
-				static_cast<int>(width),
-				static_cast<int>(height),
-				msdfgen::Y_DOWNWARD,
+			const apollo::rdr::BitmapView<RGBA8Pixel> dest{
+				m_OutBuf, bounds.x0, bounds.y0, bounds.GetWidth(), bounds.GetHeight(), m_BufStride,
 			};
-			msdfgen::generateMTSDF(section, shape, transform);
-
-			apollo::rdr::BitmapView<RGBA8Pixel> dest{
-				m_OutBuf, bounds.x0, bounds.y0, width, height, m_BufStride,
-			};
-			for (uint32 j = 0; j < height; ++j)
-			{
-				for (uint32 i = 0; i < width; ++i)
-				{
-					const float* inPx = section(i, j);
-					dest(i, j) = RGBA8Pixel{
-						uint8(255 * apollo::Clamp(inPx[0], 0.0f, 1.0f) + 0.5),
-						uint8(255 * apollo::Clamp(inPx[1], 0.0f, 1.0f) + 0.5),
-						uint8(255 * apollo::Clamp(inPx[2], 0.0f, 1.0f) + 0.5),
-						uint8(255 * apollo::Clamp(inPx[3], 0.0f, 1.0f) + 0.5),
-					};
-				}
-			}
+			RenderGlyph(m_Size, m_DistanceRange, offset, shape, dest, scratch);
 		}
 
-		void operator()()
+		/// Renders the glyphs of chunks [first, last). Invoked concurrently by mt::ParallelFor
+		void operator()(uint32 first, uint32 last) const
 		{
-			for (uint32 i = 0; i < m_Glyphs.size(); ++i)
+			std::vector<float> scratch(m_Size * m_Size * 4);
+			const uint32 begin = first ? m_ChunkEnds[first - 1] : 0;
+			for (uint32 i = begin; i < m_ChunkEnds[last - 1]; ++i)
 			{
-				Render(m_Glyphs[i].m_Offset, m_Glyphs[i].m_Uv, m_Shapes[i]);
+				const uint32 index = m_Order[i];
+				Render(m_Glyphs[index].m_Offset, m_Glyphs[index].m_Uv, m_Shapes[index], scratch);
 			}
-			m_Latch.count_down();
 		}
 	};
 } // namespace
@@ -255,18 +230,29 @@ namespace apollo::rdr::txt {
 		return true;
 	}
 
+	void AtlasGenerator::ComputeGlyphBounds(Glyph& inout_glyph, const msdfgen::Shape& shape) const
+	{
+		const auto bounds = shape.getBounds(m_Padding);
+
+		inout_glyph.m_Offset = { bounds.l, bounds.b };
+		inout_glyph.m_Uv = {
+			0,
+			0,
+			uint32(m_Res * (bounds.r - bounds.l) + 1.5f),
+			uint32(m_Res * (bounds.t - bounds.b) + 1.5f),
+		};
+	}
+
 	glm::uvec2 AtlasGenerator::LoadGlyphRange(
 		GlyphRange range,
 		std::vector<Glyph>& out_glyphs,
 		std::vector<msdfgen::Shape>& out_shapes,
 		std::vector<uint32>& out_indices)
 	{
-		std::vector<uint32> tempIndices;
 		range.m_First = Max(range.m_First, U' ');
 		out_glyphs.reserve(range.GetSize());
 		out_indices.resize(range.GetSize(), UINT32_MAX);
 		out_shapes.reserve(range.GetSize());
-		tempIndices.reserve(range.GetSize());
 
 		for (char32_t ch = range.m_First; ch <= range.m_Last; ++ch)
 		{
@@ -282,7 +268,6 @@ namespace apollo::rdr::txt {
 
 			const uint32 index = NumCast<uint32>(out_glyphs.size());
 			out_indices[range.GetIndex(ch)] = index;
-			tempIndices.emplace_back(index);
 
 			// if shape has no contour, the character has no glyph per say, just ignore it
 			if (!shape.contours.size())
@@ -292,34 +277,37 @@ namespace apollo::rdr::txt {
 				continue;
 			}
 
-			const auto bounds = shape.getBounds(m_Padding);
-
-			glyph.m_Offset = { bounds.l, bounds.b };
-
-			glyph.m_Uv.x1 = uint32(m_Res * (bounds.r - bounds.l) + 1.5f);
-			glyph.m_Uv.y1 = uint32(m_Res * (bounds.t - bounds.b) + 1.5f);
+			ComputeGlyphBounds(glyph, shape);
 			out_glyphs.emplace_back(std::move(glyph));
 			out_shapes.emplace_back(std::move(shape));
 		}
-		// sort glyphs by decreasing height
-		std::sort(
-			tempIndices.begin(),
-			tempIndices.end(),
-			[&](uint32 a, uint32 b)
-			{
-				return out_glyphs[a].m_Uv.GetHeight() > out_glyphs[b].m_Uv.GetHeight();
-			});
-		GridPacker packer{ m_MaxWidth };
-		for (uint32 index : tempIndices)
-		{
-			if (out_shapes[index].contours.empty())
-				continue;
+		// glyphs without contours have an empty rectangle, which the packer leaves at the origin
+		std::vector<RectU32> rects(out_glyphs.size());
+		for (uint32 i = 0; i < out_glyphs.size(); ++i)
+			rects[i] = out_glyphs[i].m_Uv;
 
-			Glyph& glyph = out_glyphs[index];
-			packer.Pack(glyph.m_Uv);
-		}
+		RectPacker packer{ m_MaxWidth, m_PackingStrategy, m_PackingOrder };
+		const glm::uvec2 size = packer.Pack(rects);
+		for (uint32 i = 0; i < out_glyphs.size(); ++i)
+			out_glyphs[i].m_Uv = rects[i];
 
-		return packer.GetTotalSize();
+		return size;
+	}
+
+	void AtlasGenerator::RasterizeGlyph(
+		double pxRange,
+		const Glyph& glyph,
+		const msdfgen::Shape& shape,
+		rdr::BitmapView<rdr::RGBAPixel<uint8>> out_bitmap,
+		std::vector<float>& scratch) const
+	{
+		RenderGlyph(
+			m_Res,
+			msdfgen::Range{ pxRange / m_Res },
+			glyph.m_Offset,
+			shape,
+			out_bitmap,
+			scratch);
 	}
 
 	void AtlasGenerator::Rasterize(
@@ -330,9 +318,6 @@ namespace apollo::rdr::txt {
 		mt::ThreadPool& threadPool)
 	{
 		const msdfgen::Range distMapping{ pxRange / m_Res };
-
-		const uint32 numThreads = threadPool.GetThreadCount();
-		std::latch latch{ numThreads };
 		const uint32 numGlyphs = NumCast<uint32>(glyphs.size());
 		APOLLO_ASSERT(
 			shapes.size() == numGlyphs,
@@ -340,29 +325,53 @@ namespace apollo::rdr::txt {
 			numGlyphs,
 			shapes.size());
 
-		APOLLO_LOG_TRACE("Running {} threads", numThreads);
-		const uint32 glyphsPerThread = NumCast<uint32>(glyphs.size()) / numThreads;
-		uint32 jobStartIndex = 0;
+		APOLLO_LOG_TRACE(
+			"Rasterizing {} glyphs on {} threads",
+			numGlyphs,
+			threadPool.GetThreadCount());
 
-		for (uint32 i = 0; i < numThreads; ++i)
+		// Rendering time is roughly proportional to the glyph's area. Large glyphs are rendered
+		// first, and the work is split in chunks of similar area, so that no thread ends up with
+		// a single large glyph at the end.
+		const auto getArea = [&](uint32 i)
 		{
-			const Glyph* gPtr = glyphs.data() + jobStartIndex;
-			const msdfgen::Shape* sPtr = shapes.data() + jobStartIndex;
-
-			const uint32 jobSize = glyphsPerThread + (i < (numGlyphs % numThreads));
-			threadPool.Enqueue(
-				RenderJob{
-					.m_Latch = latch,
-					.m_Glyphs = std::span{ gPtr, jobSize },
-					.m_Shapes = std::span{ sPtr, jobSize },
-					.m_Size = m_Res,
-					.m_DistanceRange = distMapping,
-					.m_Bitmap = std::vector<float>(m_Res * m_Res * 3),
-					.m_OutBuf = out_bitmap.GetData(),
-					.m_BufStride = out_bitmap.GetStride(),
-				});
-			jobStartIndex += jobSize;
+			return uint64(glyphs[i].m_Uv.GetWidth()) * glyphs[i].m_Uv.GetHeight();
+		};
+		std::vector<uint32> order(numGlyphs);
+		std::iota(order.begin(), order.end(), 0u);
+		std::stable_sort(
+			order.begin(),
+			order.end(),
+			[&](uint32 a, uint32 b) { return getArea(a) > getArea(b); });
+
+		uint64 totalArea = 0;
+		for (uint32 i = 0; i < numGlyphs; ++i)
+			totalArea += getArea(i);
+		const uint64 chunkArea = Max(totalArea / (4 * threadPool.GetThreadCount()), uint64(1));
+		std::vector<uint32> chunkEnds;
+		uint64 area = 0;
+		for (uint32 i = 0; i < numGlyphs; ++i)
+		{
+			area += getArea(order[i]);
+			if (area >= chunkArea || i + 1 == numGlyphs)
+			{
+				chunkEnds.emplace_back(i + 1);
+				area = 0;
+			}
 		}
-		latch.wait();
+
+		const RenderJob job{
+			.m_Glyphs = glyphs,
+			.m_Shapes = shapes,
+			.m_Order = order,
+			.m_ChunkEnds = chunkEnds,
+			.m_Size = m_Res,
+			.m_DistanceRange = distMapping,
+			.m_OutBuf = out_bitmap.GetData(),
+			.m_BufStride = out_bitmap.GetStride(),
+		};
+		// the calling thread helps rendering glyphs instead of just blocking
+		const uint32 numChunks = NumCast<uint32>(chunkEnds.size());
+		mt::ParallelFor(threadPool, 0, numChunks, std::cref(job)).Wait();
 	}
 } // namespace apollo::rdr::txt
\ No newline at end of file
@@ -2,9 +2,57 @@
 
 #include <SDL3/SDL_gpu.h>
 #include <core/Assert.hpp>
-#include <core/Utf8.hpp>
 #include <rendering/Device.hpp>
 
+namespace {
+	using apollo::rdr::txt::Renderer2d;
+
+	/**
+	 * \brief Adds the quads of \p layout to \p batch
+	 * \param offset: Position of the layout's origin
+	 */
+	template <class Font>
+	void EmitGlyphs(
+		Font& font,
+		apollo::rdr::Batch<Renderer2d::GlyphQuad>& batch,
+		const apollo::rdr::txt::TextStyle& style,
+		const apollo::rdr::txt::TextLayout& layout,
+		float2 offset,
+		float2 uvScale)
+	{
+		using apollo::rdr::txt::Glyph;
+
+		for (const apollo::rdr::txt::LaidOutGlyph& laidOut : layout.m_Glyphs)
+		{
+			// looking the glyph up again lets dynamic fonts render it if it was evicted, or mark
+			// its page as used. Glyphs which aren't resident yet are skipped, but keep their space
+			// in the layout.
+			const Glyph* glyph = font.GetGlyph(laidOut.m_Char);
+			if (!glyph || glyph->m_Page == Glyph::NoPage)
+				continue;
+
+			const uint32 width = glyph->m_Uv.GetWidth(), height = glyph->m_Uv.GetHeight();
+			batch.Add(
+				Renderer2d::GlyphQuad{
+					float4{
+						offset + style.m_Size * float2{ laidOut.m_Rect.x, laidOut.m_Rect.y },
+						style.m_Size * float2{ laidOut.m_Rect.z, laidOut.m_Rect.w },
+					},
+					float4{
+						uvScale.x * glyph->m_Uv.x0,
+						uvScale.y * glyph->m_Uv.y0,
+						uvScale.x * width,
+						uvScale.y * height,
+					},
+					style.m_FgColor,
+					style.m_OutlineColor,
+					style.m_OutlineThickness,
+					glyph->m_Page,
+				});
+		}
+	}
+} // namespace
+
 namespace apollo::rdr::txt {
 	Renderer2d::~Renderer2d()
 	{
@@ -42,106 +90,59 @@ namespace apollo::rdr::txt {
 	{
 		m_CopyPass = SDL_BeginGPUCopyPass(cmdBuffer);
 		m_Batch.StartRecording();
+		m_Layouts.NextFrame();
 	}
 
 	void Renderer2d::AddText(std::string_view str, float2 origin, EAnchorPoint anchor)
 	{
 		APOLLO_ASSERT(IsInitialized(), "Called AddText on uninitialized text renderer");
-		if (!m_Font || !m_Font->IsLoaded())
+		// the offset only depends on the layout's bounds, so it is applied to each quad as it is
+		// emitted
+		const auto getOffset = [&](const TextLayout& layout)
 		{
-			APOLLO_LOG_ERROR("Called AddText on text renderer, but font is not ready");
-			return;
-		}
-		m_Dirty = true;
-		const rdr::TextureSettings settings = m_Font->GetTexture().GetSettings();
-
-		const float2 uvScale{ 1.0f / settings.m_Width, 1.0f / settings.m_Height };
-
-		utf8::Decoder decoder{ str };
-		const float fontScale = 1.0f / m_Font->GetPixelSize();
-		const rdr::txt::Glyph* prev = nullptr;
-		RectF bounds{
-			0,
-			0,
-			0,
-			0,
-		};
-
-		float2 pos = {};
-
-		while (char32_t c = decoder.DecodeNext())
-		{
-			const rdr::txt::Glyph* glyph = m_Font->GetGlyph(c);
-			if (!glyph) [[unlikely]]
-				continue;
-
-			const uint32 width = glyph->m_Uv.GetWidth(), height = glyph->m_Uv.GetHeight();
-			if (c == '\n')
-			{
-				pos = float2{ 0, pos.y - m_Style.m_Size * m_Style.m_LineSpacing };
-				continue;
-			}
-			else if (!(width && height))
+			const RectF& bounds = layout.m_Bounds;
+			const float size = m_Style.m_Size;
+			switch (anchor)
 			{
-				pos.x += m_Style.m_Size * glyph->m_Advance;
-				continue;
+			case EAnchorPoint::Center:
+				return origin - 0.5f * size * float2{ bounds.x0 + bounds.x1, bounds.y0 + bounds.y1 };
+			case EAnchorPoint::TopLeft: return origin - size * float2{ bounds.x0, bounds.y1 };
+			default: return origin;
 			}
-			if (prev && m_Style.m_Kerning)
-				pos += m_Style.m_Size * m_Style.m_Kerning * m_Font->GetKerning(*prev, *glyph);
-
-			const float2 glyphSize{
-				fontScale * width,
-				fontScale * height,
-			};
-			const float4 rect{
-				pos + m_Style.m_Size * glyph->m_Offset,
-				m_Style.m_Size * glyphSize,
-			};
-
-			bounds += RectF{
-				rect.x,
-				rect.y,
-				rect.x + rect.z,
-				rect.y + rect.w,
-			};
-			m_Batch.Add(
-				GlyphQuad{
-					rect,
-					float4{
-						uvScale.x * glyph->m_Uv.x0,
-						uvScale.y * glyph->m_Uv.y0,
-						uvScale.x * width,
-						uvScale.y * height,
-					},
-					m_Style.m_FgColor,
-					m_Style.m_OutlineColor,
-					m_Style.m_OutlineThickness,
-				});
+		};
 
-			pos.x += m_Style.m_Size * glyph->m_Advance * m_Style.m_Tracking;
-			prev = glyph;
+		if (m_DynamicFont)
+		{
+			const float uvScale = 1.0f / m_DynamicFont->GetPageSize();
+			const TextLayout& layout = m_Layouts.GetLayout(*m_DynamicFont, str, m_Style);
+			EmitGlyphs(
+				*m_DynamicFont,
+				m_Batch,
+				m_Style,
+				layout,
+				getOffset(layout),
+				float2{ uvScale, uvScale });
 		}
-
-		float2 offset = {};
-		switch (anchor)
+		else if (m_Font && m_Font->IsLoaded())
 		{
-		case EAnchorPoint::Center:
-			offset = origin - 0.5f * float2{ bounds.x0 + bounds.x1, bounds.y0 + bounds.y1 };
-			break;
-		case EAnchorPoint::TopLeft: offset = origin - float2{ bounds.x0, bounds.y1 }; break;
-		default: break;
+			const rdr::TextureSettings settings = m_Font->GetTexture().GetSettings();
+			const float2 uvScale{ 1.0f / settings.m_Width, 1.0f / settings.m_Height };
+			const TextLayout& layout = m_Layouts.GetLayout(*m_Font, str, m_Style);
+			EmitGlyphs(*m_Font, m_Batch, m_Style, layout, getOffset(layout), uvScale);
 		}
-
-		for (GlyphQuad& q : m_Batch)
+		else
 		{
-			q.m_Rect.x += offset.x;
-			q.m_Rect.y += offset.y;
+			APOLLO_LOG_ERROR("Called AddText on text renderer, but font is not ready");
+			return;
 		}
+		m_Dirty = true;
 	}
 
 	void Renderer2d::StartRender()
 	{
 		APOLLO_ASSERT(IsInitialized(), "Called AddText on uninitialized text renderer");
+		if (m_DynamicFont)
+			m_DynamicFont->Update(m_CopyPass);
 		m_Batch.EndRecording(m_CopyPass);
 		SDL_EndGPUCopyPass(m_CopyPass);
 		m_CopyPass = nullptr;
@@ -152,11 +153,19 @@ namespace apollo::rdr::txt {
 		APOLLO_ASSERT(IsInitialized(), "Called AddText on uninitialized text renderer");
 		const uint32 count = m_Batch.GetCount();
 		auto* const pipeline = static_cast<SDL_GPUGraphicsPipeline*>(m_Mat->GetHandle());
-		if (!count || !m_Font || !m_Font->IsLoaded() || !pipeline)
+		if (!count || !pipeline)
+			return;
+
+		const Texture2D* texture = nullptr;
+		if (m_DynamicFont)
+			texture = &m_DynamicFont->GetTexture();
+		else if (m_Font && m_Font->IsLoaded())
+			texture = &m_Font->GetTexture();
+		else
 			return;
 
 		const SDL_GPUTextureSamplerBinding samplerBinding{
-			.texture = m_Font->GetTexture().GetHandle(),
+			.texture = texture->GetHandle(),
 			.sampler = m_Sampler,
 		};
 
@@ -2,8 +2,10 @@
 
 #include <PCH.hpp>
 
+#include "DynamicFontAtlas.hpp"
 #include "FontAtlas.hpp"
 #include "Style.hpp"
+#include "TextLayout.hpp"
 #include <asset/AssetRef.hpp>
 #include <rendering/Batch.hpp>
 #include <rendering/Buffer.hpp>
@@ -36,6 +38,8 @@ namespace apollo::rdr::txt {
 			GPU_ALIGN(float4) m_MainColor;
 			GPU_ALIGN(float4) m_OutlineColor;
 			GPU_ALIGN(float) m_OutlineThickness;
+			/// Texture array layer, only used with dynamic fonts
+			GPU_ALIGN(uint32) m_Layer;
 		};
 
 		Renderer2d() = default;
@@ -44,7 +48,21 @@ namespace apollo::rdr::txt {
 			AssetRef<Material> material,
 			uint32 batchSize);
 
-		void SetFont(AssetRef<FontAtlas> font) noexcept { m_Font = std::move(font); }
+		void SetFont(AssetRef<FontAtlas> font) noexcept
+		{
+			m_Font = std::move(font);
+			m_Layouts.Clear();
+		}
+		/**
+		 * \brief Renders text with \p font instead of the font atlas, if not null.
+		 * \details Glyphs are rasterized as they are first used, and only drawn once they are
+		 * resident. The material must sample a 2D texture array, indexed with the glyph's page.
+		 */
+		void SetDynamicFont(DynamicFontAtlas* font) noexcept
+		{
+			m_DynamicFont = font;
+			m_Layouts.Clear();
+		}
 
 		[[nodiscard]] bool IsInitialized() const noexcept { return m_Batch && m_Sampler; }
 
@@ -53,11 +71,18 @@ namespace apollo::rdr::txt {
 		void Clear() noexcept { m_Batch.Clear(); }
 
 		APOLLO_API void StartFrame(SDL_GPUCommandBuffer* cmdBuffer);
+		/**
+		 * \brief Adds \p str to the batch, anchored at \p pos
+		 * \details Layouts are cached across frames: only strings which weren't drawn with the same
+		 * font and spacing during the previous frame are decoded and positioned again.
+		 */
 		APOLLO_API void AddText(
 			std::string_view str,
 			float2 pos,
 			EAnchorPoint anchor = EAnchorPoint::Center);
 
+		[[nodiscard]] const TextLayoutCache& GetLayoutCache() const noexcept { return m_Layouts; }
+
 		// Uploads data to the GPU if necessary
 		APOLLO_API void StartRender();
 		APOLLO_API void Render(SDL_GPURenderPass* renderPass);
@@ -70,8 +95,10 @@ namespace apollo::rdr::txt {
 		bool m_Dirty = false;
 
 		AssetRef<FontAtlas> m_Font;
+		DynamicFontAtlas* m_DynamicFont = nullptr;
 		AssetRef<Material> m_Mat;
 		Batch<GlyphQuad> m_Batch;
+		TextLayoutCache m_Layouts;
 		const GPUDevice* m_Device = nullptr;
 		SDL_GPUSampler* m_Sampler = nullptr;
 	};
@@ -83,6 +110,6 @@ namespace apollo::rdr::txt {
 		return lhs.m_Rect != rhs.m_Rect || lhs.m_Uv != rhs.m_Uv ||
 			   lhs.m_MainColor != rhs.m_MainColor ||
 			   lhs.m_OutlineThickness != rhs.m_OutlineThickness ||
-			   lhs.m_OutlineColor != rhs.m_OutlineColor;
+			   lhs.m_OutlineColor != rhs.m_OutlineColor || lhs.m_Layer != rhs.m_Layer;
 	}
 } // namespace apollo::rdr::txt
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include "DynamicFontAtlas.hpp"
+#include "Measure.hpp"
+#include <SDL3/SDL_gpu.h>
+#include <core/Log.hpp>
+#include <cstring>
+#include <msdfgen.h>
+#include <rendering/UploadHeap.hpp>
+
+namespace apollo::rdr::txt {
+	DynamicFontAtlas::DynamicFontAtlas(
+		FT_FaceRec_* face,
+		mt::ThreadPool& threadPool,
+		const Settings& settings)
+		: m_Face(face)
+		, m_ThreadPool(threadPool)
+		, m_Settings(settings)
+		, m_Generator(face, settings.m_PageSize, settings.m_PixelSize, settings.m_EmPadding)
+		, m_Texture(
+			  rdr::TextureSettings{
+				  .m_Width = settings.m_PageSize,
+				  .m_Height = settings.m_PageSize,
+				  .m_Layers = settings.m_NumPages,
+			  })
+		, m_Pages(settings.m_NumPages, settings.m_PageSize)
+		, m_PageEntries(settings.m_NumPages)
+	{}
+
+	DynamicFontAtlas::~DynamicFontAtlas()
+	{
+		for (const mt::JobHandle& job : m_Jobs)
+			job.Wait();
+	}
+
+	uint32 DynamicFontAtlas::FindOrLoad(char32_t ch)
+	{
+		if (const auto it = m_EntryIndices.find(ch); it != m_EntryIndices.end())
+		{
+			if (m_Entries[it->second].m_State == EGlyphState::Unloaded)
+				LoadGlyph(it->second);
+			return it->second;
+		}
+
+		const uint32 index = NumCast<uint32>(m_Entries.size());
+		m_Entries.emplace_back(
+			Entry{
+				.m_Glyph{
+					.m_Char = ch,
+					.m_Offset = float2{ 0, 0 },
+					.m_Uv = {},
+					.m_Page = Glyph::NoPage,
+				},
+			});
+		m_EntryIndices.try_emplace(ch, index);
+		++m_Stats.m_NumGlyphs;
+		LoadGlyph(index);
+		return index;
+	}
+
+	void DynamicFontAtlas::LoadGlyph(uint32 index)
+	{
+		Entry& entry = m_Entries[index];
+		msdfgen::Shape shape;
+		if (!m_Generator.LoadGlyph(entry.m_Glyph, shape))
+		{
+			entry.m_State = EGlyphState::Missing;
+			return;
+		}
+		// no contour: nothing to render
+		if (shape.contours.empty())
+		{
+			entry.m_Glyph.m_Uv = {};
+			entry.m_State = EGlyphState::Resident;
+			return;
+		}
+
+		m_Generator.ComputeGlyphBounds(entry.m_Glyph, shape);
+		const RectU32& uv = entry.m_Glyph.m_Uv;
+		const uint32 width = uv.GetWidth(), height = uv.GetHeight();
+		if (width + GlyphPageAllocator::Margin > m_Settings.m_PageSize ||
+			height + GlyphPageAllocator::Margin > m_Settings.m_PageSize) [[unlikely]]
+		{
+			APOLLO_LOG_ERROR(
+				"Glyph U+{:08X} ({}x{}) doesn't fit in a {}x{} atlas page",
+				uint32(entry.m_Glyph.m_Char),
+				width,
+				height,
+				m_Settings.m_PageSize,
+				m_Settings.m_PageSize);
+			entry.m_State = EGlyphState::Missing;
+			return;
+		}
+
+		entry.m_Glyph.m_Page = Glyph::NoPage;
+		entry.m_State = EGlyphState::Pending;
+		++m_Stats.m_NumPending;
+
+		auto render = [this, index, glyph = entry.m_Glyph, shape = std::move(shape)]()
+		{
+			thread_local std::vector<float> scratch;
+			const uint32 w = glyph.m_Uv.GetWidth(), h = glyph.m_Uv.GetHeight();
+			RenderedGlyph rendered{
+				index,
+				std::vector<RGBAPixel<uint8>>(w * h),
+			};
+			m_Generator.RasterizeGlyph(
+				m_Settings.m_PxRange,
+				glyph,
+				shape,
+				{ rendered.m_Pixels.data(), w, h },
+				scratch);
+
+			std::unique_lock lock{ m_RenderedMutex };
+			m_Rendered.emplace_back(std::move(rendered));
+		};
+		m_Jobs.emplace_back(mt::Schedule(m_ThreadPool, std::move(render)));
+	}
+
+	const Glyph* DynamicFontAtlas::GetGlyph(char32_t ch, char32_t fallback)
+	{
+		const Entry* entry = &m_Entries[FindOrLoad(ch)];
+		if (entry->m_State == EGlyphState::Missing)
+		{
+			if (ch == fallback)
+				return nullptr;
+			entry = &m_Entries[FindOrLoad(fallback)];
+			if (entry->m_State == EGlyphState::Missing)
+				return nullptr;
+		}
+		if (entry->m_Glyph.m_Page != Glyph::NoPage && entry->m_Glyph.m_Uv.GetWidth())
+			m_Pages.Touch(entry->m_Glyph.m_Page);
+		return &entry->m_Glyph;
+	}
+
+	float2 DynamicFontAtlas::MeasureText(
+		std::string_view txt,
+		const TextStyle& style,
+		char32_t fallback)
+	{
+		return _internal::MeasureText(*this, txt, style, fallback);
+	}
+
+	void DynamicFontAtlas::Evict(uint32 page)
+	{
+		for (uint32 index : m_PageEntries[page])
+		{
+			Entry& entry = m_Entries[index];
+			entry.m_Glyph.m_Page = Glyph::NoPage;
+			entry.m_State = EGlyphState::Unloaded;
+		}
+		m_Stats.m_NumResident -= NumCast<uint32>(m_PageEntries[page].size());
+		m_PageEntries[page].clear();
+	}
+
+	void DynamicFontAtlas::Update(SDL_GPUCopyPass* copyPass)
+	{
+		{
+			std::unique_lock lock{ m_RenderedMutex };
+			m_Stats.m_NumRasterized += m_Rendered.size();
+			m_Deferred.insert(
+				m_Deferred.end(),
+				std::make_move_iterator(m_Rendered.begin()),
+				std::make_move_iterator(m_Rendered.end()));
+			m_Rendered.clear();
+		}
+
+		UploadHeap* const heap = UploadHeap::GetThreadHeap();
+		uint32 numDeferred = 0;
+		for (uint32 i = 0; i < m_Deferred.size(); ++i)
+		{
+			RenderedGlyph& rendered = m_Deferred[i];
+			Glyph& glyph = m_Entries[rendered.m_Entry].m_Glyph;
+			const uint32 width = glyph.m_Uv.GetWidth(), height = glyph.m_Uv.GetHeight();
+			const auto allocation = m_Pages.Allocate(width, height);
+			if (!allocation)
+			{
+				// every page is in use: try again next frame
+				if (i != numDeferred)
+					m_Deferred[numDeferred] = std::move(rendered);
+				++numDeferred;
+				continue;
+			}
+			if (allocation->m_EvictedPage != GlyphPageAllocator::NoPage)
+				Evict(allocation->m_EvictedPage);
+
+			const uint32 size = NumCast<uint32>(sizeof(RGBAPixel<uint8>) * width * height);
+			const UploadHeap::Allocation upload = heap->Map(size, UploadHeap::TextureAlignment);
+			std::memcpy(upload.m_Ptr, rendered.m_Pixels.data(), size);
+			const SDL_GPUTextureRegion destRegion{
+				.texture = m_Texture.GetHandle(),
+				.layer = allocation->m_Page,
+				.x = allocation->m_Rect.x0,
+				.y = allocation->m_Rect.y0,
+				.w = width,
+				.h = height,
+				.d = 1,
+			};
+			heap->UploadToTexture(copyPass, upload, destRegion);
+
+			glyph.m_Uv = allocation->m_Rect;
+			glyph.m_Page = allocation->m_Page;
+			m_Entries[rendered.m_Entry].m_State = EGlyphState::Resident;
+			m_PageEntries[allocation->m_Page].emplace_back(rendered.m_Entry);
+			--m_Stats.m_NumPending;
+			++m_Stats.m_NumResident;
+			++m_Stats.m_NumUploaded;
+		}
+		m_Deferred.resize(numDeferred);
+
+		std::erase_if(m_Jobs, [](const mt::JobHandle& job) { return job.IsDone(); });
+		m_Pages.NextFrame();
+	}
+} // namespace apollo::rdr::txt
\ No newline at end of file
@@ -0,0 +1,164 @@
+#pragma once
+
+/** \file DynamicFontAtlas.hpp
+ * \brief Font atlas rasterizing glyphs on demand
+ */
+
+#include <PCH.hpp>
+
+#include "FontAtlas.hpp"
+#include "GlyphPages.hpp"
+#include <core/JobGraph.hpp>
+#include <core/Map.hpp>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+struct SDL_GPUCopyPass;
+
+namespace apollo::rdr::txt {
+	struct DynamicAtlasSettings
+	{
+		/// The pixel size used to rasterize glyphs, see FontAtlas::GetPixelSize
+		uint32 m_PixelSize = 64;
+		/// Width and height of each page
+		uint32 m_PageSize = 1024;
+		uint32 m_NumPages = 4;
+		double m_PxRange = 10.0;
+		double m_EmPadding = 1.0 / 64;
+	};
+
+	/**
+	 * \brief Font atlas which only rasterizes the glyphs actually used.
+	 * \details Unlike FontAtlas, nothing is generated up front, which makes large character sets
+	 * (CJK, emoji...) practical. The first time a glyph is requested, its outline is loaded and its
+	 * metrics are returned right away; its MTSDF is rendered on the thread pool. Update uploads the
+	 * glyphs which finished rendering to the texture, one sub-rectangle each.
+	 *
+	 * The texture is an array of square pages, managed by a GlyphPageAllocator. When all pages are
+	 * full, the least recently used one is evicted: its glyphs are unloaded, and rendered again the
+	 * next time they are requested.
+	 *
+	 * Glyphs which aren't resident yet have their page set to Glyph::NoPage: they must be skipped
+	 * when drawing, but can be used for layout.
+	 * \note Apart from rendering glyphs, which happens on the thread pool, this class is not
+	 * thread-safe.
+	 */
+	class DynamicFontAtlas
+	{
+	public:
+		using Settings = DynamicAtlasSettings;
+		struct Stats
+		{
+			/// Glyphs requested so far
+			uint32 m_NumGlyphs = 0;
+			/// Glyphs currently in the texture
+			uint32 m_NumResident = 0;
+			/// Glyphs being rendered, or waiting to be uploaded
+			uint32 m_NumPending = 0;
+			uint64 m_NumRasterized = 0;
+			uint64 m_NumUploaded = 0;
+		};
+
+		/**
+		 * \param face: The font face to load glyphs from. It must outlive the atlas.
+		 * \param threadPool: The thread pool glyphs are rendered on
+		 */
+		APOLLO_API DynamicFontAtlas(
+			FT_FaceRec_* face,
+			mt::ThreadPool& threadPool,
+			const Settings& settings = {});
+		/// Waits for all pending glyphs to be rendered
+		APOLLO_API ~DynamicFontAtlas();
+
+		DynamicFontAtlas(const DynamicFontAtlas&) = delete;
+		DynamicFontAtlas& operator=(const DynamicFontAtlas&) = delete;
+
+		/**
+		 * \brief Retrieves a glyph, scheduling its rendering if it isn't resident. If the font has
+		 * no glyph for \p ch, the \p fallback character is used instead. Failing that, \b nullptr
+		 * is returned.
+		 * \details Resident glyphs are marked as used during the current frame, so that their page
+		 * doesn't get evicted before they are drawn.
+		 * \returns A pointer to the glyph, which remains valid for the lifetime of the atlas. Its
+		 * page and UV rectangle may change after calls to Update.
+		 */
+		[[nodiscard]] APOLLO_API const Glyph* GetGlyph(char32_t ch, char32_t fallback = U' ');
+
+		[[nodiscard]] float2 GetKerning(const Glyph& left, const Glyph& right) const noexcept
+		{
+			return GetFaceKerning(m_Face, left.m_Index, right.m_Index);
+		}
+
+		/// \note Glyphs used by the text are scheduled for rendering, like with GetGlyph
+		[[nodiscard]] APOLLO_API float2
+		MeasureText(std::string_view txt, const TextStyle& style, char32_t fallback = U' ');
+
+		/**
+		 * \brief Uploads the glyphs rendered since the last call, then starts a new frame.
+		 * \details This should be called once per frame, after the text for the frame was laid out
+		 * and before it is drawn.
+		 */
+		APOLLO_API void Update(SDL_GPUCopyPass* copyPass);
+
+		[[nodiscard]] uint32 GetPixelSize() const noexcept { return m_Settings.m_PixelSize; }
+		[[nodiscard]] uint32 GetPageSize() const noexcept { return m_Settings.m_PageSize; }
+		/// \brief The 2D array texture holding the pages
+		[[nodiscard]] const rdr::Texture2D& GetTexture() const noexcept { return m_Texture; }
+		[[nodiscard]] const Stats& GetStats() const noexcept { return m_Stats; }
+		[[nodiscard]] const GlyphPageAllocator::Stats& GetPageStats() const noexcept
+		{
+			return m_Pages.GetStats();
+		}
+
+	private:
+		enum class EGlyphState : uint8
+		{
+			/// The font has no glyph for this character
+			Missing,
+			/// Being rendered, or waiting to be uploaded
+			Pending,
+			Resident,
+			/// Evicted, will be rendered again on next use
+			Unloaded,
+		};
+		struct Entry
+		{
+			Glyph m_Glyph;
+			EGlyphState m_State = EGlyphState::Missing;
+		};
+		/// A glyph rendered by a worker, to be uploaded on the next Update
+		struct RenderedGlyph
+		{
+			uint32 m_Entry;
+			std::vector<RGBAPixel<uint8>> m_Pixels;
+		};
+
+		/// \brief Retrieves the entry of \p ch, loading the glyph if needed
+		/// \returns The index of the entry
+		[[nodiscard]] uint32 FindOrLoad(char32_t ch);
+		/// \brief Loads the glyph's outline and metrics, then schedules its rendering
+		void LoadGlyph(uint32 index);
+		void Evict(uint32 page);
+
+		FT_FaceRec_* m_Face = nullptr;
+		mt::ThreadPool& m_ThreadPool;
+		Settings m_Settings;
+		AtlasGenerator m_Generator;
+		rdr::Texture2D m_Texture;
+		GlyphPageAllocator m_Pages;
+
+		/// Deque, so that pointers to glyphs remain valid
+		std::deque<Entry> m_Entries;
+		HashMap<char32_t, uint32> m_EntryIndices;
+		/// Entries of the glyphs stored in each page
+		std::vector<std::vector<uint32>> m_PageEntries;
+
+		std::vector<mt::JobHandle> m_Jobs;
+		std::mutex m_RenderedMutex;
+		std::vector<RenderedGlyph> m_Rendered; /*!< Guarded by m_RenderedMutex */
+		/// Rendered glyphs which couldn't be given room in the texture yet
+		std::vector<RenderedGlyph> m_Deferred;
+		Stats m_Stats;
+	};
+} // namespace apollo::rdr::txt
\ No newline at end of file
@@ -1,7 +1,57 @@
 #include "FontAtlas.hpp"
-#include "Style.hpp"
-#include <core/Utf8.hpp>
+#include "Measure.hpp"
+#include <SDL3/SDL_gpu.h>
+#include <asset/AssetLoader.hpp>
+#include <core/App.hpp>
+#include <core/Assert.hpp>
+#include <core/Json.hpp>
+#include <core/Log.hpp>
+#include <core/NumConv.hpp>
 #include <freetype/freetype.h>
+#include <msdfgen.h>
+#include <rendering/UploadHeap.hpp>
+
+namespace {
+	[[nodiscard]] constexpr uint64 GetKerningKey(uint32 left, uint32 right) noexcept
+	{
+		return (uint64(left) << 32) | right;
+	}
+
+	struct FreetypeContext
+	{
+		operator FT_Library() noexcept
+		{
+			if (m_Handle) [[likely]]
+				return m_Handle;
+			const FT_Error err = FT_Init_FreeType(&m_Handle);
+			APOLLO_ASSERT(err == FT_Err_Ok, "Failed to init Freetype: {}", FT_Error_String(err));
+			return m_Handle;
+		}
+		~FreetypeContext()
+		{
+			if (m_Handle)
+				FT_Done_FreeType(m_Handle);
+		}
+
+	private:
+		FT_Library m_Handle = nullptr;
+	};
+
+	thread_local FreetypeContext g_Freetype;
+} // namespace
+
+namespace apollo::json {
+	bool Visit(apollo::rdr::txt::GlyphRange& out_range, const nlohmann::json& json, const char* key)
+	{
+		const auto node = json.find(key);
+		if (node == json.end())
+			return true;
+
+		if (!Visit(out_range.m_First, *node, "first", true))
+			return false;
+		return Visit(out_range.m_Last, *node, "last", true);
+	}
+} // namespace apollo::json
 
 namespace apollo::rdr::txt {
 	FontAtlas::FontAtlas(
@@ -9,15 +59,15 @@ namespace apollo::rdr::txt {
 		uint32 size,
 		GlyphRange range,
 		std::vector<Glyph> glyphs,
-		std::vector<uint32> indices,
 		Texture2D texture)
 		: m_FaceHandle(face)
 		, m_Range(range)
 		, m_Texture(std::move(texture))
 		, m_Glyphs(std::move(glyphs))
-		, m_Indices(std::move(indices))
 		, m_PixelSize(size)
-	{}
+	{
+		IndexGlyphs();
+	}
 
 	FontAtlas::~FontAtlas()
 	{
@@ -27,28 +77,107 @@ namespace apollo::rdr::txt {
 
 	const Glyph* FontAtlas::FindGlyph(char32_t ch) const noexcept
 	{
-		const uint32 i = m_Range.GetIndex(ch);
-		if (i > m_Indices.size())
+		const auto it = m_GlyphIndices.find(ch);
+		if (it == m_GlyphIndices.end())
 			return nullptr;
+		return m_Glyphs.data() + it->second;
+	}
 
-		if (const uint32 j = m_Indices[i]; j < m_Glyphs.size())
-			return m_Glyphs.data() + j;
-		return nullptr;
+	void FontAtlas::IndexGlyphs()
+	{
+		m_GlyphIndices.clear();
+		m_GlyphIndices.reserve(m_Glyphs.size());
+		for (uint32 i = 0; i < m_Glyphs.size(); ++i)
+			m_GlyphIndices.try_emplace(m_Glyphs[i].m_Char, i);
+		m_Kerning.clear();
 	}
 
-	float2 FontAtlas::GetKerning(const Glyph& left, const Glyph& right) const noexcept
+	bool FontAtlas::LoadFace(const nlohmann::json& json)
 	{
-		if (!FT_HAS_KERNING(m_FaceHandle))
+		if (!json::Visit(m_Range, json, "range"))
+		{
+			APOLLO_LOG_ERROR("Failed to parse glyph range from JSON");
+			return false;
+		}
+		if (m_Range.m_Last < m_Range.m_First)
+		{
+			APOLLO_LOG_WARN(
+				"Glyph range has invalid bounds {}:{}",
+				uint32(m_Range.m_First),
+				uint32(m_Range.m_Last));
+			std::swap(m_Range.m_First, m_Range.m_Last);
+		}
+
+		if (!json::Visit(m_PixelSize, json, "pixelSize", true))
+			APOLLO_LOG_WARN("Failed to parse pixel size from JSON");
+
+		std::string_view fontPath;
+		if (!json::Visit(fontPath, json, "fontFile"))
+		{
+			APOLLO_LOG_ERROR("Failed to get font file path from JSON");
+			return false;
+		}
+		const FT_Error err = FT_New_Face(g_Freetype, fontPath.data(), 0, &m_FaceHandle);
+		if (err)
+		{
+			APOLLO_LOG_ERROR("Failed to load font file {}: {}", fontPath, FT_Error_String(err));
+			return false;
+		}
+		return true;
+	}
+
+	void FontAtlas::GenerateTexture(const nlohmann::json& json)
+	{
+		double pxRange = 10.0;
+		double emPadding = 1.0 / m_PixelSize;
+		json::Visit(pxRange, json, "pixelRange", true);
+		json::Visit(emPadding, json, "padding", true);
+
+		AtlasGenerator generator{
+			m_FaceHandle,
+			m_PixelSize * 16,
+			m_PixelSize,
+			emPadding,
+		};
+		std::vector<msdfgen::Shape> shapes;
+		std::vector<uint32> indices;
+		const glm::uvec2 texSize = generator.LoadGlyphRange(m_Range, m_Glyphs, shapes, indices);
+		IndexGlyphs();
+		m_Texture = Texture2D(
+			TextureSettings{
+				.m_Width = texSize.x,
+				.m_Height = texSize.y,
+			});
+		const uint32 pixelCount = texSize.x * texSize.y;
+
+		SDL_GPUCopyPass* const copyPass = AssetLoader::GetCurrentCopyPass();
+		UploadHeap* const heap = UploadHeap::GetThreadHeap();
+		const UploadHeap::Allocation upload = heap->Map(
+			NumCast<uint32>(sizeof(RGBAPixel<uint8>) * pixelCount),
+			UploadHeap::TextureAlignment);
+		auto* buf = static_cast<RGBAPixel<uint8>*>(upload.m_Ptr);
+		APOLLO_ASSERT(buf, "Failed to map transfer buffer: {}", SDL_GetError());
+
+		auto& threadPool = App::GetInstance()->GetThreadPool();
+
+		generator.Rasterize(pxRange, m_Glyphs, shapes, { buf, texSize.x, texSize.y }, threadPool);
+		const SDL_GPUTextureRegion destRegion{
+			.texture = m_Texture.GetHandle(),
+			.w = texSize.x,
+			.h = texSize.y,
+			.d = 1,
+		};
+		heap->UploadToTexture(copyPass, upload, destRegion);
+	}
+
+	float2 GetFaceKerning(FT_FaceRec_* face, uint32 left, uint32 right) noexcept
+	{
+		if (!FT_HAS_KERNING(face))
 			return { 0, 0 };
 
-		const float scale = m_FaceHandle->units_per_EM ? (1.0F / m_FaceHandle->units_per_EM) : 1.0f;
+		const float scale = face->units_per_EM ? (1.0F / face->units_per_EM) : 1.0f;
 		FT_Vector vec{ 0, 0 };
-		const FT_Error err = FT_Get_Kerning(
-			m_FaceHandle,
-			left.m_Index,
-			right.m_Index,
-			FT_KERNING_UNSCALED,
-			&vec);
+		const FT_Error err = FT_Get_Kerning(face, left, right, FT_KERNING_UNSCALED, &vec);
 		(void)err;
 		return {
 			scale * vec.x,
@@ -56,59 +185,26 @@ namespace apollo::rdr::txt {
 		};
 	}
 
-	float2 FontAtlas::MeasureText(std::string_view txt, const TextStyle& style, char32_t fallback)
-		const noexcept
+	float2 FontAtlas::GetKerning(const Glyph& left, const Glyph& right) const
 	{
-		RectF bounds{ 0, 0, 0, 0 };
-		const float scale = 1.0f / m_PixelSize;
-		const Glyph* prev = nullptr;
-		utf8::Decoder decoder{ txt };
-		float2 pos = {};
+		if (!m_FaceHandle || !FT_HAS_KERNING(m_FaceHandle))
+			return { 0, 0 };
 
-		while (char32_t cp = decoder.DecodeNext())
+		const uint64 key = GetKerningKey(left.m_Index, right.m_Index);
+		// freetype faces aren't thread-safe either, the query has to happen under the lock
+		std::unique_lock lock{ m_KerningMutex };
+		auto it = m_Kerning.find(key);
+		if (it == m_Kerning.end())
 		{
-			if (cp == utf8::g_InvalidCodePoint)
-				cp = fallback;
-
-			const Glyph* glyph = GetGlyph(cp, fallback);
-			if (!glyph) [[unlikely]]
-				continue;
-			const uint32 width = glyph->m_Uv.GetWidth(), height = glyph->m_Uv.GetHeight();
-			if (cp == '\n')
-			{
-				pos = float2{ 0, pos.y - style.m_Size * style.m_LineSpacing };
-				continue;
-			}
-			else if (!(width && height))
-			{
-				pos.x += style.m_Size * style.m_Tracking * glyph->m_Advance;
-				continue;
-			}
-			if (prev)
-				pos += style.m_Size * style.m_Kerning * GetKerning(*prev, *glyph);
-
-			const float2 glyphSize{
-				scale * width,
-				scale * height,
-			};
-			const float4 rect{
-				pos + style.m_Size * glyph->m_Offset,
-				style.m_Size * glyphSize,
-			};
-
-			bounds += RectF{
-				rect.x,
-				rect.y,
-				rect.x + rect.z,
-				rect.y + rect.w,
-			};
-			pos.x += style.m_Size * style.m_Tracking * glyph->m_Advance;
-			prev = glyph;
+			const float2 kerning = GetFaceKerning(m_FaceHandle, left.m_Index, right.m_Index);
+			it = m_Kerning.try_emplace(key, kerning).first;
 		}
+		return it->second;
+	}
 
-		return float2{
-			bounds.x1 - bounds.x0,
-			bounds.y1 - bounds.y0,
-		};
+	float2 FontAtlas::MeasureText(std::string_view txt, const TextStyle& style, char32_t fallback)
+		const
+	{
+		return _internal::MeasureText(*this, txt, style, fallback);
 	}
 } // namespace apollo::rdr::txt
\ No newline at end of file
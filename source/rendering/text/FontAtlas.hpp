@@ -4,7 +4,11 @@
 
 #include "Glyph.hpp"
 #include <asset/Asset.hpp>
+#include <core/Map.hpp>
+#include <mutex>
+#include <nlohmann/json_fwd.hpp>
 #include <rendering/Bitmap.hpp>
+#include <rendering/RectPacker.hpp>
 #include <rendering/Texture.hpp>
 #include <vector>
 
@@ -14,6 +18,11 @@ namespace msdfgen {
 	class Shape;
 } // namespace msdfgen
 
+namespace apollo {
+	template <class>
+	struct PackAssetHelper;
+}
+
 namespace apollo::editor {
 	template <class>
 	struct AssetHelper;
@@ -30,6 +39,13 @@ namespace apollo::mt {
 namespace apollo::rdr::txt {
 	struct TextStyle;
 
+	/**
+	 * \brief Retrieves the kerning between two glyphs of \p face, in em units
+	 * \param left, right: The glyph indices, see Glyph::m_Index
+	 */
+	[[nodiscard]] APOLLO_API float2
+	GetFaceKerning(FT_FaceRec_* face, uint32 left, uint32 right) noexcept;
+
 	/**
 	 * \brief This API is used to rasterize a font into an atlas using msdfgen
 	 */
@@ -43,6 +59,11 @@ namespace apollo::rdr::txt {
 			double emPadding = 1.0 / 64);
 
 		APOLLO_API bool LoadGlyph(Glyph& inout_glyph, msdfgen::Shape& out_shape);
+		/*
+		 * Computes the offset of a glyph loaded with LoadGlyph, and the size of its bitmap. The
+		 * glyph's UV rectangle is placed at the origin.
+		 */
+		APOLLO_API void ComputeGlyphBounds(Glyph& inout_glyph, const msdfgen::Shape& shape) const;
 
 		/*
 		 * Loads a range of glyphs, decomposes their shapes, packs them and returns the total atlas
@@ -54,6 +75,13 @@ namespace apollo::rdr::txt {
 			std::vector<msdfgen::Shape>& out_shapes,
 			std::vector<uint32>& out_indices);
 
+		/// Sets the algorithm LoadGlyphRange uses to pack glyphs, see RectPacker
+		void SetPacking(EPackingStrategy strategy, EPackingOrder order) noexcept
+		{
+			m_PackingStrategy = strategy;
+			m_PackingOrder = order;
+		}
+
 		/*
 		 * Generates MSDF data. This assumes the glyphs and shapes have been previously loaded using
 		 * LoadGlyphRange, and that the output bitmap is big enough
@@ -65,16 +93,30 @@ namespace apollo::rdr::txt {
 			rdr::BitmapView<rdr::RGBAPixel<uint8>> out_bitmap,
 			mt::ThreadPool& threadPool);
 
+		/*
+		 * Generates the MSDF data of a single glyph. out_bitmap must have the size of the glyph's
+		 * UV rectangle. This only uses the shape, and can safely be called from any thread.
+		 */
+		APOLLO_API void RasterizeGlyph(
+			double pxRange,
+			const Glyph& glyph,
+			const msdfgen::Shape& shape,
+			rdr::BitmapView<rdr::RGBAPixel<uint8>> out_bitmap,
+			std::vector<float>& scratch) const;
+
 	private:
 		FT_FaceRec_* m_Face;
 		uint32 m_MaxWidth;
 		uint32 m_Res;
 		double m_Padding;
 		double m_Scale = 1.0;
+		EPackingStrategy m_PackingStrategy = EPackingStrategy::Skyline;
+		EPackingOrder m_PackingOrder = EPackingOrder::Height;
 	};
 
 	/**
-	 * \brief Stores a font as a texture atlas and a sparse array of Glyph objects
+	 * \brief Stores a font as a texture atlas and a sparse array of Glyph objects, indexed by code
+	 * point
 	 */
 	class FontAtlas : public IAsset
 	{
@@ -86,16 +128,17 @@ namespace apollo::rdr::txt {
 			uint32 pixelSize,
 			GlyphRange range,
 			std::vector<Glyph> glyphs,
-			std::vector<uint32> indices,
 			Texture2D texture);
 
 		FontAtlas(const FontAtlas&) = delete;
+		/// \note The kerning cache's mutex isn't moved: both atlases keep their own
 		FontAtlas(FontAtlas&& other) noexcept
 			: m_FaceHandle(std::exchange(other.m_FaceHandle, nullptr))
 			, m_Range(std::exchange(other.m_Range, { 0, 0 }))
 			, m_Texture(std::move(other.m_Texture))
 			, m_Glyphs(std::move(other.m_Glyphs))
-			, m_Indices(std::move(other.m_Indices))
+			, m_GlyphIndices(std::move(other.m_GlyphIndices))
+			, m_Kerning(std::move(other.m_Kerning))
 			, m_PixelSize(other.m_PixelSize)
 		{}
 
@@ -112,7 +155,8 @@ namespace apollo::rdr::txt {
 			std::swap(m_Range, other.m_Range);
 			std::swap(m_Texture, other.m_Texture);
 			std::swap(m_Glyphs, other.m_Glyphs);
-			std::swap(m_Indices, other.m_Indices);
+			m_GlyphIndices.swap(other.m_GlyphIndices);
+			m_Kerning.swap(other.m_Kerning);
 			std::swap(m_PixelSize, other.m_PixelSize);
 		}
 
@@ -138,26 +182,53 @@ namespace apollo::rdr::txt {
 		 */
 		[[nodiscard]] uint32 GetPixelSize() const noexcept { return m_PixelSize; }
 
-		[[nodiscard]] APOLLO_API float2
-		GetKerning(const Glyph& left, const Glyph& right) const noexcept;
+		/**
+		 * \brief Retrieves the kerning between two glyphs of the atlas, in em units
+		 * \details The kerning of a pair is only queried from the font the first time it is
+		 * requested, then cached: fonts with thousands of glyphs (e.g. CJK ranges) only pay for the
+		 * pairs which actually show up in text. Thread-safe.
+		 */
+		[[nodiscard]] APOLLO_API float2 GetKerning(const Glyph& left, const Glyph& right) const;
 
 		[[nodiscard]] APOLLO_API float2 MeasureText(
 			std::string_view txt,
 			const TextStyle& style,
-			char32_t fallback = U' ') const noexcept;
+			char32_t fallback = U' ') const;
 
 		GET_ASSET_TYPE_IMPL(EAssetType::FontAtlas);
 
 	private:
 		APOLLO_API const Glyph* FindGlyph(char32_t ch) const noexcept;
+		/// \brief Rebuilds the code point to glyph map from m_Glyphs, and resets the kerning cache
+		APOLLO_API void IndexGlyphs();
+
+		/** \name JSON description
+		 * \brief Shared by the loaders of all asset managers, which only differ in where they read
+		 * the description from
+		 * @{ */
+
+		/// \brief Reads the glyph range and pixel size, and opens the font file
+		APOLLO_API bool LoadFace(const nlohmann::json& json);
+
+		/**
+		 * \brief Rasterizes the glyph range into the atlas texture
+		 * \note This must run in a load task: the texture is uploaded through its copy pass
+		 */
+		APOLLO_API void GenerateTexture(const nlohmann::json& json);
+		/** @} */
 
 		FT_FaceRec_* m_FaceHandle = nullptr;
 		GlyphRange m_Range;
 		rdr::Texture2D m_Texture;
 		std::vector<Glyph> m_Glyphs;
-		std::vector<uint32> m_Indices;
+		HashMap<char32_t, uint32> m_GlyphIndices;
+		/// Kerning of the pairs queried so far, keyed by (left glyph index << 32) | right glyph
+		/// index
+		mutable HashMap<uint64, float2> m_Kerning;
+		mutable std::mutex m_KerningMutex;
 		uint32 m_PixelSize = 64;
 
 		friend struct editor::AssetHelper<FontAtlas>;
+		friend struct PackAssetHelper<FontAtlas>;
 	};
 } // namespace apollo::rdr::txt
\ No newline at end of file
@@ -25,5 +25,9 @@ namespace apollo::rdr::txt {
 		float m_Advance;
 		float2 m_Offset;
 		RectU32 m_Uv;
+		/// Texture layer containing the glyph, NoPage if it isn't resident yet
+		uint32 m_Page = 0;
+
+		static constexpr uint32 NoPage = UINT32_MAX;
 	};
 } // namespace apollo::rdr::txt
\ No newline at end of file
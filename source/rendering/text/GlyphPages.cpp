@@ -0,0 +1,101 @@
+#include "GlyphPages.hpp"
+#include <algorithm>
+#include <core/Assert.hpp>
+#include <numeric>
+
+namespace apollo::rdr::txt {
+	GlyphPageAllocator::GlyphPageAllocator(uint32 numPages, uint32 pageSize)
+		: m_Pages(numPages)
+		, m_PageSize(pageSize)
+	{
+		APOLLO_ASSERT(numPages, "Glyph atlases need at least one page");
+	}
+
+	std::optional<RectU32> GlyphPageAllocator::AllocateInPage(
+		Page& page,
+		uint32 width,
+		uint32 height)
+	{
+		const uint32 paddedWidth = width + Margin;
+		const uint32 paddedHeight = height + Margin;
+
+		// best fit: the shortest shelf which can hold the glyph
+		Shelf* best = nullptr;
+		for (Shelf& shelf : page.m_Shelves)
+		{
+			if (shelf.m_Height < paddedHeight || m_PageSize - shelf.m_Width < paddedWidth)
+				continue;
+			if (!best || shelf.m_Height < best->m_Height)
+				best = &shelf;
+		}
+		// don't waste a tall shelf on a small glyph if a new one fits
+		if ((!best || best->m_Height > 2 * paddedHeight) &&
+			m_PageSize - page.m_Height >= paddedHeight)
+		{
+			best = &page.m_Shelves.emplace_back(Shelf{ page.m_Height, paddedHeight, 0 });
+			page.m_Height += paddedHeight;
+		}
+		if (!best)
+			return std::nullopt;
+
+		const RectU32 rect{
+			best->m_Width,
+			best->m_Y,
+			best->m_Width + width,
+			best->m_Y + height,
+		};
+		best->m_Width += paddedWidth;
+		return rect;
+	}
+
+	std::optional<GlyphPageAllocator::Allocation> GlyphPageAllocator::Allocate(
+		uint32 width,
+		uint32 height)
+	{
+		if (width + Margin > m_PageSize || height + Margin > m_PageSize) [[unlikely]]
+		{
+			++m_Stats.m_NumFailures;
+			return std::nullopt;
+		}
+
+		// try the most recently used pages first: they are the least likely to get evicted
+		if (m_Order.size() != m_Pages.size())
+		{
+			m_Order.resize(m_Pages.size());
+			std::iota(m_Order.begin(), m_Order.end(), 0u);
+		}
+		std::sort(
+			m_Order.begin(),
+			m_Order.end(),
+			[&](uint32 a, uint32 b) { return m_Pages[a].m_LastUsed > m_Pages[b].m_LastUsed; });
+
+		for (uint32 index : m_Order)
+		{
+			Page& page = m_Pages[index];
+			if (const auto rect = AllocateInPage(page, width, height))
+			{
+				page.m_LastUsed = m_Frame;
+				++m_Stats.m_NumAllocations;
+				return Allocation{ index, *rect };
+			}
+		}
+
+		const uint32 lru = m_Order.back();
+		Page& victim = m_Pages[lru];
+		if (victim.m_LastUsed == m_Frame)
+		{
+			++m_Stats.m_NumFailures;
+			return std::nullopt;
+		}
+		victim.m_Shelves.clear();
+		victim.m_Height = 0;
+		++victim.m_Generation;
+		++m_Stats.m_NumEvictions;
+
+		const auto rect = AllocateInPage(victim, width, height);
+		APOLLO_ASSERT(rect, "Glyph doesn't fit in an empty page");
+		victim.m_LastUsed = m_Frame;
+		++m_Stats.m_NumAllocations;
+		return Allocation{ lru, *rect, lru };
+	}
+} // namespace apollo::rdr::txt
\ No newline at end of file
@@ -0,0 +1,95 @@
+#pragma once
+
+/** \file GlyphPages.hpp
+ * \brief Space management for dynamic glyph atlases
+ */
+
+#include <PCH.hpp>
+
+#include <optional>
+#include <vector>
+
+namespace apollo::rdr::txt {
+	/**
+	 * \brief Allocates glyph rectangles in a fixed number of square pages, evicting the least
+	 * recently used page when all of them are full.
+	 * \details Each page is filled with horizontal shelves, glyphs being placed side by side on the
+	 * shelf whose height fits best. Eviction works on whole pages: fragmentation is never an issue,
+	 * at the cost of rasterizing the evicted glyphs again if they are needed later on.
+	 *
+	 * Pages used during the current frame are never evicted, since the glyphs they contain may
+	 * already have been recorded for drawing. Pages are marked as used by Allocate and Touch.
+	 */
+	class GlyphPageAllocator
+	{
+	public:
+		static constexpr uint32 NoPage = UINT32_MAX;
+
+		struct Allocation
+		{
+			uint32 m_Page = 0;
+			RectU32 m_Rect;
+			/// The page which was evicted to make room, or NoPage
+			uint32 m_EvictedPage = NoPage;
+		};
+		struct Stats
+		{
+			uint64 m_NumAllocations = 0;
+			uint64 m_NumEvictions = 0;
+			/// Allocations which failed, because the rectangle was larger than a page or because
+			/// every page was used during the current frame
+			uint64 m_NumFailures = 0;
+		};
+
+		/// Space left between glyphs, so that bilinear filtering doesn't bleed across them
+		static constexpr uint32 Margin = 1;
+
+		APOLLO_API GlyphPageAllocator(uint32 numPages, uint32 pageSize);
+
+		/**
+		 * \brief Allocates a \p width x \p height rectangle
+		 * \returns The allocation, or an empty optional if the rectangle is larger than a page, or
+		 * if making room would require evicting a page used during the current frame.
+		 */
+		[[nodiscard]] APOLLO_API std::optional<Allocation> Allocate(uint32 width, uint32 height);
+
+		/// \brief Marks \p page as used during the current frame
+		void Touch(uint32 page) noexcept { m_Pages[page].m_LastUsed = m_Frame; }
+		/// \brief Starts a new frame: pages which aren't touched anymore become evictable
+		void NextFrame() noexcept { ++m_Frame; }
+
+		/// \brief Incremented every time \p page is evicted
+		[[nodiscard]] uint32 GetGeneration(uint32 page) const noexcept
+		{
+			return m_Pages[page].m_Generation;
+		}
+		[[nodiscard]] uint32 GetPageCount() const noexcept { return uint32(m_Pages.size()); }
+		[[nodiscard]] uint32 GetPageSize() const noexcept { return m_PageSize; }
+		[[nodiscard]] const Stats& GetStats() const noexcept { return m_Stats; }
+
+	private:
+		struct Shelf
+		{
+			uint32 m_Y = 0;
+			uint32 m_Height = 0;
+			uint32 m_Width = 0;
+		};
+		struct Page
+		{
+			std::vector<Shelf> m_Shelves;
+			uint32 m_Height = 0;
+			uint32 m_Generation = 0;
+			uint64 m_LastUsed = 0;
+		};
+
+		[[nodiscard]] std::optional<RectU32>
+		AllocateInPage(Page& page, uint32 width, uint32 height);
+
+		std::vector<Page> m_Pages;
+		/// Page indices, by decreasing last use
+		std::vector<uint32> m_Order;
+		uint32 m_PageSize;
+		uint64 m_Frame = 1;
+		Stats m_Stats;
+	};
+} // namespace apollo::rdr::txt
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+/** \file Measure.hpp
+ * \brief Text measurement, shared by all font types
+ */
+
+#include <PCH.hpp>
+
+#include "Glyph.hpp"
+#include "Style.hpp"
+#include <core/Utf8.hpp>
+
+namespace apollo::rdr::txt::_internal {
+	/**
+	 * \brief Computes the size of the bounding box of \p txt, rendered with \p font
+	 * \tparam Font: A font type, which provides GetGlyph, GetKerning and GetPixelSize
+	 * \note Not noexcept: fonts may allocate when looking up glyphs, e.g. DynamicFontAtlas
+	 */
+	template <class Font>
+	[[nodiscard]] float2 MeasureText(
+		Font& font,
+		std::string_view txt,
+		const TextStyle& style,
+		char32_t fallback)
+	{
+		RectF bounds{ 0, 0, 0, 0 };
+		const float scale = 1.0f / font.GetPixelSize();
+		const Glyph* prev = nullptr;
+		utf8::Decoder decoder{ txt };
+		float2 pos = {};
+
+		while (char32_t cp = decoder.DecodeNext())
+		{
+			if (cp == utf8::g_InvalidCodePoint)
+				cp = fallback;
+
+			const Glyph* glyph = font.GetGlyph(cp, fallback);
+			if (!glyph) [[unlikely]]
+				continue;
+			const uint32 width = glyph->m_Uv.GetWidth(), height = glyph->m_Uv.GetHeight();
+			if (cp == '\n')
+			{
+				pos = float2{ 0, pos.y - style.m_Size * style.m_LineSpacing };
+				prev = nullptr;
+				continue;
+			}
+			else if (!(width && height))
+			{
+				pos.x += style.m_Size * style.m_Tracking * glyph->m_Advance;
+				continue;
+			}
+			if (prev)
+				pos += style.m_Size * style.m_Kerning * font.GetKerning(*prev, *glyph);
+
+			const float2 glyphSize{
+				scale * width,
+				scale * height,
+			};
+			const float4 rect{
+				pos + style.m_Size * glyph->m_Offset,
+				style.m_Size * glyphSize,
+			};
+
+			bounds += RectF{
+				rect.x,
+				rect.y,
+				rect.x + rect.z,
+				rect.y + rect.w,
+			};
+			pos.x += style.m_Size * style.m_Tracking * glyph->m_Advance;
+			prev = glyph;
+		}
+
+		return float2{
+			bounds.x1 - bounds.x0,
+			bounds.y1 - bounds.y0,
+		};
+	}
+} // namespace apollo::rdr::txt::_internal
\ No newline at end of file
@@ -0,0 +1,31 @@
+#include "TextLayout.hpp"
+
+namespace apollo::rdr::txt {
+	uint64 TextLayoutCache::ComputeKey(
+		const void* font,
+		std::string_view str,
+		const TextStyle& style) noexcept
+	{
+		return HashCombine(
+			std::hash<std::string_view>{}(str),
+			font,
+			style.m_Tracking,
+			style.m_Kerning,
+			style.m_LineSpacing);
+	}
+
+	void TextLayoutCache::NextFrame()
+	{
+		if (m_Entries.size() > m_Capacity)
+		{
+			for (auto it = m_Entries.begin(); it != m_Entries.end();)
+			{
+				if (it->second.m_LastUse < m_Frame)
+					it = m_Entries.erase(it);
+				else
+					++it;
+			}
+		}
+		++m_Frame;
+	}
+} // namespace apollo::rdr::txt
\ No newline at end of file
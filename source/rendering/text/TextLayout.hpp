@@ -0,0 +1,187 @@
+#pragma once
+
+/** \file TextLayout.hpp
+ * \brief Glyph positioning, and a cache of positioned strings
+ */
+
+#include <PCH.hpp>
+
+#include "Glyph.hpp"
+#include "Style.hpp"
+#include <core/Hash.hpp>
+#include <core/Map.hpp>
+#include <core/NumConv.hpp>
+#include <core/Utf8.hpp>
+#include <string>
+#include <vector>
+
+namespace apollo::rdr::txt {
+	/// A glyph of a TextLayout
+	struct LaidOutGlyph
+	{
+		/// Position and size of the glyph's quad, relative to the pen's starting point
+		float4 m_Rect;
+		/// Character of the glyph, used to look it up again when drawing
+		char32_t m_Char;
+	};
+
+	/**
+	 * \brief A string's glyphs, positioned for a text size of 1.
+	 * \details Every coordinate scales with TextStyle::m_Size, so one layout serves all sizes.
+	 */
+	struct TextLayout
+	{
+		std::vector<LaidOutGlyph> m_Glyphs;
+		/// Bounds of all visible glyphs, including those which can't be drawn yet
+		RectF m_Bounds{ 0, 0, 0, 0 };
+	};
+
+	namespace _internal {
+		/**
+		 * \brief Positions the glyphs of \p str, using the tracking, kerning and line spacing of
+		 * \p style
+		 * \tparam Font: A font type, which provides GetGlyph, GetKerning and GetPixelSize
+		 */
+		template <class Font>
+		void LayoutText(
+			Font& font,
+			std::string_view str,
+			const TextStyle& style,
+			TextLayout& out_layout)
+		{
+			out_layout.m_Glyphs.clear();
+			out_layout.m_Bounds = { 0, 0, 0, 0 };
+
+			utf8::Decoder decoder{ str };
+			const float fontScale = 1.0f / font.GetPixelSize();
+			const Glyph* prev = nullptr;
+			float2 pos = {};
+
+			while (char32_t c = decoder.DecodeNext())
+			{
+				const Glyph* glyph = font.GetGlyph(c);
+				if (!glyph) [[unlikely]]
+					continue;
+
+				const uint32 width = glyph->m_Uv.GetWidth(), height = glyph->m_Uv.GetHeight();
+				if (c == '\n')
+				{
+					pos = float2{ 0, pos.y - style.m_LineSpacing };
+					prev = nullptr;
+					continue;
+				}
+				else if (!(width && height))
+				{
+					pos.x += glyph->m_Advance;
+					continue;
+				}
+				if (prev && style.m_Kerning)
+					pos += style.m_Kerning * font.GetKerning(*prev, *glyph);
+
+				const float4 rect{
+					pos + glyph->m_Offset,
+					float2{ fontScale * width, fontScale * height },
+				};
+				out_layout.m_Bounds += RectF{
+					rect.x,
+					rect.y,
+					rect.x + rect.z,
+					rect.y + rect.w,
+				};
+				out_layout.m_Glyphs.push_back({ rect, glyph->m_Char });
+
+				pos.x += glyph->m_Advance * style.m_Tracking;
+				prev = glyph;
+			}
+		}
+	} // namespace _internal
+
+	/**
+	 * \brief Remembers the layout of strings, so that text which doesn't change between frames
+	 * isn't decoded, kerned and positioned again.
+	 * \details Layouts are keyed by string, font and the parts of the style which affect glyph
+	 * positions (tracking, kerning and line spacing). Colors are applied when drawing, and
+	 * positions are scaled by the text size, so changing either still hits the cache.
+	 *
+	 * Layouts which weren't used during the last frame are dropped once the cache holds more than
+	 * its capacity.
+	 */
+	class TextLayoutCache
+	{
+	public:
+		struct Stats
+		{
+			uint64 m_NumHits = 0;
+			uint64 m_NumMisses = 0;
+		};
+
+		explicit TextLayoutCache(uint32 capacity = 1024) noexcept
+			: m_Capacity(capacity)
+		{}
+
+		/**
+		 * \brief Retrieves the layout of \p str, laying it out if it isn't cached
+		 * \warning The returned reference is invalidated by the next call to GetLayout
+		 */
+		template <class Font>
+		[[nodiscard]] const TextLayout& GetLayout(
+			Font& font,
+			std::string_view str,
+			const TextStyle& style)
+		{
+			auto [it, inserted] = m_Entries.try_emplace(ComputeKey(&font, str, style));
+			Entry& entry = it->second;
+			if (inserted || !entry.Matches(&font, str, style))
+			{
+				++m_Stats.m_NumMisses;
+				entry.m_Text = str;
+				entry.m_Font = &font;
+				entry.m_Tracking = style.m_Tracking;
+				entry.m_Kerning = style.m_Kerning;
+				entry.m_LineSpacing = style.m_LineSpacing;
+				_internal::LayoutText(font, str, style, entry.m_Layout);
+			}
+			else
+				++m_Stats.m_NumHits;
+			entry.m_LastUse = m_Frame;
+			return entry.m_Layout;
+		}
+
+		/// \brief Starts a new frame, dropping unused layouts if the cache is over capacity
+		APOLLO_API void NextFrame();
+		void Clear() noexcept { m_Entries.clear(); }
+
+		[[nodiscard]] uint32 GetSize() const noexcept { return NumCast<uint32>(m_Entries.size()); }
+		[[nodiscard]] const Stats& GetStats() const noexcept { return m_Stats; }
+
+	private:
+		struct Entry
+		{
+			std::string m_Text;
+			const void* m_Font = nullptr;
+			float m_Tracking = 0;
+			float m_Kerning = 0;
+			float m_LineSpacing = 0;
+			uint64 m_LastUse = 0;
+			TextLayout m_Layout;
+
+			[[nodiscard]] bool Matches(
+				const void* font,
+				std::string_view str,
+				const TextStyle& style) const noexcept
+			{
+				return m_Font == font && m_Tracking == style.m_Tracking &&
+					   m_Kerning == style.m_Kerning && m_LineSpacing == style.m_LineSpacing &&
+					   m_Text == str;
+			}
+		};
+
+		[[nodiscard]] APOLLO_API static uint64
+		ComputeKey(const void* font, std::string_view str, const TextStyle& style) noexcept;
+
+		HashMap<uint64, Entry> m_Entries;
+		uint32 m_Capacity;
+		uint64 m_Frame = 0;
+		Stats m_Stats;
+	};
+} // namespace apollo::rdr::txt
\ No newline at end of file
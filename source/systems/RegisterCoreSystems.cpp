@@ -1,13 +1,17 @@
 #include "InputSystem.hpp"
 
 #include <asset/AssetManager.hpp>
+#include <core/App.hpp>
 #include <ecs/Manager.hpp>
 #include <systems/SceneLoadingSystem.hpp>
+#include <systems/TransformSystem.hpp>
 
 namespace apollo {
 	void RegisterCoreSystems(App& app, ecs::Manager& manager, IAssetManager& assetManager)
 	{
 		manager.AddSystem<inputs::System>(app);
 		manager.AddSystem<SceneLoadingSystem>(assetManager);
+		// runs before the game's systems: their changes are picked up on the next frame
+		manager.AddSystem<TransformSystem>(&app.GetThreadPool());
 	}
 } // namespace apollo
\ No newline at end of file
@@ -2,12 +2,19 @@
 
 #include <PCH.hpp>
 #include <core/Transform.hpp>
+#include <core/Unassigned.hpp>
 #include <ecs/Reflection.hpp>
+#include <entt/entity/fwd.hpp>
 
 /** \file TransformComponent.hpp */
 
 namespace apollo {
-	/// Represents the position of an object in 3D space
+	/**
+	 * \brief Represents the position of an object in 3D space, relative to its parent if it has a
+	 * ParentComponent
+	 * \note Add a TransformDirtyComponent to the entity after modifying it, so that its
+	 * WorldTransformComponent gets updated.
+	 */
 	struct TransformComponent
 	{
 		float3 m_Position = {};
@@ -27,4 +34,28 @@ namespace apollo {
 				},
 			};
 	};
+
+	/**
+	 * \brief Attaches an entity's transform to the one of another entity
+	 * \details Use SetParent to modify it, so that the transform hierarchy gets rebuilt. The
+	 * parent must have a TransformComponent, otherwise the entity is treated as a root.
+	 */
+	struct ParentComponent
+	{
+		entt::entity m_Parent = Unassigned<entt::entity>;
+	};
+
+	/**
+	 * \brief Transform matrix of an entity in world space, cached by the TransformSystem
+	 * \details Added to all entities with a TransformComponent. Read only: it gets recomputed
+	 * whenever the transform of the entity or of one of its ancestors is marked dirty.
+	 */
+	struct WorldTransformComponent
+	{
+		glm::mat4x4 m_Matrix{ 1 };
+	};
+
+	/// Marks a TransformComponent as modified. Removed by the TransformSystem once processed.
+	struct TransformDirtyComponent
+	{};
 } // namespace apollo
\ No newline at end of file
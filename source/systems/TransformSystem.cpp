@@ -0,0 +1,247 @@
+#include "TransformSystem.hpp"
+#include "TransformComponent.hpp"
+#include <algorithm>
+#include <core/JobGraph.hpp>
+#include <core/Log.hpp>
+#include <core/NumConv.hpp>
+#include <entt/entity/registry.hpp>
+
+namespace {
+	/// Below this number of nodes to update, roots are processed on the calling thread
+	constexpr uint32 g_ParallelThreshold = 4096;
+
+	using apollo::TransformComponent;
+
+	/// \returns The parent of \p entity, or Unassigned if it is a root
+	entt::entity GetParent(const entt::registry& world, entt::entity entity)
+	{
+		const auto* parent = world.try_get<apollo::ParentComponent>(entity);
+		if (!parent || parent->m_Parent == entity || !world.valid(parent->m_Parent) ||
+			!world.all_of<TransformComponent>(parent->m_Parent))
+			return apollo::Unassigned<entt::entity>;
+		return parent->m_Parent;
+	}
+} // namespace
+
+namespace apollo {
+	void SetParent(entt::registry& world, entt::entity child, entt::entity parent)
+	{
+		if (parent == Unassigned<entt::entity>)
+			world.remove<ParentComponent>(child);
+		else
+			world.emplace_or_replace<ParentComponent>(child, parent);
+		world.emplace_or_replace<TransformDirtyComponent>(child);
+	}
+
+	TransformSystem::TransformSystem(mt::ThreadPool* threadPool)
+		: m_ThreadPool(threadPool)
+	{}
+
+	void TransformSystem::Update(entt::registry& world, const GameTime&)
+	{
+		if (!MarkDirtyNodes(world))
+			Rebuild(world);
+		world.clear<TransformDirtyComponent>();
+		if (m_DirtyRoots.empty())
+			return;
+
+		const auto& transforms = world.storage<TransformComponent>();
+		auto& worldTransforms = world.storage<WorldTransformComponent>();
+		// nodes are in breadth-first order: parents are always updated before their children
+		const auto updateRoot = [&](uint32 root)
+		{
+			const uint32 first = m_Roots[root], last = m_Roots[root + 1];
+			for (uint32 i = first; i < last; ++i)
+			{
+				const Node& node = m_Nodes[i];
+				if (node.m_Parent != NoParent && m_Dirty[node.m_Parent])
+					m_Dirty[i] = 1;
+				if (!m_Dirty[i])
+					continue;
+
+				const TransformComponent& local = transforms.get(node.m_Entity);
+				glm::mat4x4& matrix = worldTransforms.get(node.m_Entity).m_Matrix;
+				matrix = ComputeTransformMatrix(local.m_Position, local.m_Scale, local.m_Rotation);
+				if (node.m_Parent != NoParent)
+				{
+					const entt::entity parent = m_Nodes[node.m_Parent].m_Entity;
+					matrix = worldTransforms.get(parent).m_Matrix * matrix;
+				}
+			}
+			std::fill(m_Dirty.begin() + first, m_Dirty.begin() + last, uint8(0));
+			m_RootDirty[root] = 0;
+		};
+
+		uint32 dirtyNodes = 0;
+		for (const uint32 root : m_DirtyRoots)
+			dirtyNodes += m_Roots[root + 1] - m_Roots[root];
+
+		const uint32 numRoots = NumCast<uint32>(m_DirtyRoots.size());
+		if (m_ThreadPool && numRoots > 1 && dirtyNodes >= g_ParallelThreshold)
+		{
+			mt::ParallelFor(
+				*m_ThreadPool,
+				0,
+				numRoots,
+				[&](uint32 i)
+				{
+					updateRoot(m_DirtyRoots[i]);
+				})
+				.Wait();
+		}
+		else
+		{
+			for (const uint32 root : m_DirtyRoots)
+				updateRoot(root);
+		}
+		m_DirtyRoots.clear();
+	}
+
+	bool TransformSystem::MarkDirtyNodes(entt::registry& world)
+	{
+		const size_t count = world.storage<TransformComponent>().size();
+		if (count != m_Nodes.size() || world.storage<WorldTransformComponent>().size() != count)
+			return false;
+
+		for (const entt::entity entity : world.view<const TransformDirtyComponent>())
+		{
+			const uint32 index = GetNodeIndex(entity);
+			if (index == NoParent || m_Nodes[index].m_Entity != entity)
+			{
+				if (!world.all_of<TransformComponent>(entity))
+					continue;
+				return false;
+			}
+
+			const Node& node = m_Nodes[index];
+			const entt::entity parent = node.m_Parent == NoParent ? Unassigned<entt::entity>
+																  : m_Nodes[node.m_Parent].m_Entity;
+			if (GetParent(world, entity) != parent)
+				return false;
+
+			m_Dirty[index] = 1;
+			if (!m_RootDirty[node.m_Root])
+			{
+				m_RootDirty[node.m_Root] = 1;
+				m_DirtyRoots.emplace_back(node.m_Root);
+			}
+		}
+		return true;
+	}
+
+	void TransformSystem::Rebuild(entt::registry& world)
+	{
+		std::vector<entt::entity> entities;
+		for (const entt::entity entity :
+			 world.view<const WorldTransformComponent>(entt::exclude<TransformComponent>))
+			entities.emplace_back(entity);
+		world.remove<WorldTransformComponent>(entities.begin(), entities.end());
+
+		entities.clear();
+		for (const entt::entity entity : world.view<const TransformComponent>())
+			entities.emplace_back(entity);
+		const uint32 count = NumCast<uint32>(entities.size());
+
+		m_Indices.clear();
+		for (uint32 i = 0; i < count; ++i)
+		{
+			const uint32 id = uint32(entt::to_entity(entities[i]));
+			if (id >= m_Indices.size())
+				m_Indices.resize(id + 1, NoParent);
+			m_Indices[id] = i;
+		}
+
+		// children of each entity, grouped by parent
+		std::vector<uint32> parents(count);
+		std::vector<uint32> childOffsets(count + 1, 0);
+		for (uint32 i = 0; i < count; ++i)
+		{
+			const entt::entity parent = GetParent(world, entities[i]);
+			parents[i] = parent == Unassigned<entt::entity> ? NoParent : GetNodeIndex(parent);
+			if (parents[i] != NoParent)
+				++childOffsets[parents[i] + 1];
+		}
+		for (uint32 i = 0; i < count; ++i)
+			childOffsets[i + 1] += childOffsets[i];
+		std::vector<uint32> children(childOffsets[count]);
+		{
+			std::vector<uint32> next(childOffsets.begin(), childOffsets.end() - 1);
+			for (uint32 i = 0; i < count; ++i)
+			{
+				if (parents[i] != NoParent)
+					children[next[parents[i]]++] = i;
+			}
+		}
+
+		m_Nodes.clear();
+		m_Nodes.reserve(count);
+		m_Roots.clear();
+		std::vector<uint32> order;
+		order.reserve(count);
+		std::vector<uint8> visited(count, 0);
+		const auto addRoot = [&](uint32 rootIndex)
+		{
+			const uint32 root = NumCast<uint32>(m_Roots.size());
+			const uint32 first = NumCast<uint32>(m_Nodes.size());
+			m_Roots.emplace_back(first);
+			visited[rootIndex] = 1;
+			m_Nodes.emplace_back(Node{ entities[rootIndex], NoParent, root });
+			order.emplace_back(rootIndex);
+			for (uint32 n = first; n < m_Nodes.size(); ++n)
+			{
+				const uint32 src = order[n];
+				for (uint32 c = childOffsets[src]; c < childOffsets[src + 1]; ++c)
+				{
+					const uint32 child = children[c];
+					if (visited[child])
+						continue;
+					visited[child] = 1;
+					m_Nodes.emplace_back(Node{ entities[child], n, root });
+					order.emplace_back(child);
+				}
+			}
+		};
+		for (uint32 i = 0; i < count; ++i)
+		{
+			if (parents[i] == NoParent)
+				addRoot(i);
+		}
+		// only cycles are left: break them up
+		for (uint32 i = 0; i < count; ++i)
+		{
+			if (visited[i])
+				continue;
+			APOLLO_LOG_ERROR("Transform hierarchy has a cycle, treating an entity as a root");
+			addRoot(i);
+		}
+		m_Roots.emplace_back(count);
+
+		for (uint32 i = 0; i < count; ++i)
+		{
+			const entt::entity entity = m_Nodes[i].m_Entity;
+			m_Indices[uint32(entt::to_entity(entity))] = i;
+			if (!world.all_of<WorldTransformComponent>(entity))
+				world.emplace<WorldTransformComponent>(entity);
+		}
+
+		const auto compare = [this](entt::entity lhs, entt::entity rhs)
+		{
+			return GetNodeIndex(lhs) < GetNodeIndex(rhs);
+		};
+		world.sort<TransformComponent>(compare);
+		world.sort<WorldTransformComponent>(compare);
+
+		const uint32 numRoots = NumCast<uint32>(m_Roots.size() - 1);
+		m_Dirty.assign(count, 1);
+		m_RootDirty.assign(numRoots, 1);
+		m_DirtyRoots.resize(numRoots);
+		for (uint32 i = 0; i < numRoots; ++i)
+			m_DirtyRoots[i] = i;
+	}
+
+	uint32 TransformSystem::GetNodeIndex(entt::entity entity) const noexcept
+	{
+		const uint32 id = uint32(entt::to_entity(entity));
+		return id < m_Indices.size() ? m_Indices[id] : NoParent;
+	}
+} // namespace apollo
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <PCH.hpp>
+#include <entt/entity/fwd.hpp>
+#include <vector>
+
+/** \file TransformSystem.hpp */
+
+namespace apollo {
+	class GameTime;
+
+	namespace mt {
+		class ThreadPool;
+	}
+
+	/**
+	 * \brief Sets the parent of \p child, and marks its transform as dirty
+	 * \param parent: The new parent, or Unassigned<entt::entity> to make \p child a root
+	 */
+	APOLLO_API void SetParent(entt::registry& world, entt::entity child, entt::entity parent);
+
+	/**
+	 * \brief This is the system in charge of computing world space transforms
+	 * \details The system keeps a copy of the transform hierarchy, where the subtree of each root
+	 * is stored contiguously in breadth-first order: parents always come before their children.
+	 * The transform and world transform storages are sorted in the same order, so that updating
+	 * the hierarchy walks memory linearly.
+	 *
+	 * Each frame, only the entities marked with a TransformDirtyComponent and their descendants
+	 * get their WorldTransformComponent recomputed. Independent roots are processed in parallel.
+	 * The hierarchy is rebuilt when entities with a transform get created or destroyed, or when a
+	 * dirty entity's parent changed.
+	 *
+	 * The system is registered along with the other core systems, before the game's own systems.
+	 * Transforms modified by a game system are thus only reflected in WorldTransformComponent on the
+	 * next frame: systems which draw from the cached matrices lag one frame behind the objects'
+	 * latest transforms.
+	 * \sa \ref TransformComponent.hpp
+	 */
+	class TransformSystem
+	{
+	public:
+		/// \param threadPool: Used to update independent roots in parallel. May be \b nullptr.
+		APOLLO_API explicit TransformSystem(mt::ThreadPool* threadPool = nullptr);
+		~TransformSystem() = default;
+
+		APOLLO_API void Update(entt::registry& world, const GameTime&);
+
+	private:
+		static constexpr uint32 NoParent = UINT32_MAX;
+
+		struct Node
+		{
+			entt::entity m_Entity;
+			/// Index of the parent in m_Nodes, or NoParent
+			uint32 m_Parent;
+			/// Index of the root's subtree in m_Roots
+			uint32 m_Root;
+		};
+
+		/// Marks dirty nodes, returns false if the hierarchy needs to be rebuilt
+		bool MarkDirtyNodes(entt::registry& world);
+		void Rebuild(entt::registry& world);
+
+		[[nodiscard]] uint32 GetNodeIndex(entt::entity entity) const noexcept;
+
+		mt::ThreadPool* m_ThreadPool = nullptr;
+		std::vector<Node> m_Nodes;
+		/// Offset of each root's subtree in m_Nodes, followed by the total number of nodes
+		std::vector<uint32> m_Roots;
+		/// Index of each entity in m_Nodes, indexed by entity ID
+		std::vector<uint32> m_Indices;
+		/// One per node. Not a vector<bool>, as roots are updated concurrently.
+		std::vector<uint8> m_Dirty;
+		std::vector<uint8> m_RootDirty;
+		std::vector<uint32> m_DirtyRoots;
+	};
+} // namespace apollo
\ No newline at end of file
@@ -0,0 +1,388 @@
+#include "ShaderCompiler.hpp"
+#include <algorithm>
+#include <asset/AssetIndex.hpp>
+#include <asset/AssetPack.hpp>
+#include <asset/MetadataCsv.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <core/NumConv.hpp>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <rendering/Pixel.hpp>
+#include <rendering/VertexTypes.hpp>
+#include <string_view>
+#include <vector>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+struct Options
+{
+	const char* m_AssetRoot = nullptr;
+	const char* m_OutPath = nullptr;
+};
+
+#include "ArgParse.hpp"
+
+namespace {
+	constexpr const char Usage[] = "Usage: AssetCooker [-o <output>] [-h|--help] <asset folder>\n";
+
+	bool IsHelpFlag(std::string_view arg) noexcept
+	{
+		return arg == "--help" || arg == "-h";
+	}
+
+	constexpr auto g_PostProcessFlags = aiProcess_Triangulate | aiProcess_JoinIdenticalVertices |
+										aiProcess_FixInfacingNormals | aiProcess_OptimizeMeshes |
+										aiProcess_OptimizeGraph | aiProcess_FlipUVs;
+
+	using Blob = apollo::rdr::ShaderCompiler::Blob;
+	using ByteBuffer = std::vector<std::byte>;
+
+	template <class T>
+	void Append(ByteBuffer& out_buf, const T* data, size_t count)
+	{
+		const auto* const bytes = reinterpret_cast<const std::byte*>(data);
+		out_buf.insert(out_buf.end(), bytes, bytes + count * sizeof(T));
+	}
+
+	template <class T>
+	void Append(ByteBuffer& out_buf, const T& value)
+	{
+		Append(out_buf, &value, 1);
+	}
+
+	bool ReadFile(ByteBuffer& out_buf, const std::string& path)
+	{
+		std::ifstream file{ path, std::ios::ate | std::ios::binary };
+		if (!file.is_open())
+		{
+			std::cerr << "Failed to open " << path << '\n';
+			return false;
+		}
+		out_buf.resize(file.tellg());
+		file.seekg(0, std::ios::beg);
+		if (!file.read(reinterpret_cast<char*>(out_buf.data()), out_buf.size()))
+		{
+			std::cerr << "Failed to read " << path << '\n';
+			return false;
+		}
+		return true;
+	}
+
+	/// Decodes the image, and stores it in a format which can be copied as is to the GPU
+	bool CookTexture(ByteBuffer& out_buf, const apollo::AssetMetadata& metadata)
+	{
+		using apollo::rdr::EPixelFormat;
+		int32 width = 0, height = 0, numChannels = 0;
+		if (!stbi_info(metadata.m_FilePath.c_str(), &width, &height, &numChannels))
+		{
+			std::cerr << "Failed to load texture from " << metadata.m_FilePath << ": "
+					  << stbi_failure_reason() << '\n';
+			return false;
+		}
+
+		// RGB isn't supported for GPU textures, we need to create the 4th channel ourself
+		const int32 numComponents = numChannels == 3 ? 4 : numChannels;
+		uint8* data = stbi_load(
+			metadata.m_FilePath.c_str(),
+			&width,
+			&height,
+			&numChannels,
+			numComponents);
+		if (!data)
+		{
+			std::cerr << "Failed to load texture from " << metadata.m_FilePath << ": "
+					  << stbi_failure_reason() << '\n';
+			return false;
+		}
+
+		EPixelFormat format = EPixelFormat::Invalid;
+		switch (numComponents)
+		{
+		case 1: format = EPixelFormat::R8_UNorm; break;
+		case 2: format = EPixelFormat::RG8_UNorm; break;
+		case 4: format = EPixelFormat::RGBA8_UNorm; break;
+		default:
+			std::cerr << "Unsupported number of channels in " << metadata.m_FilePath << '\n';
+			stbi_image_free(data);
+			return false;
+		}
+
+		const apollo::CookedTextureHeader header{
+			.m_Width = apollo::NumCast<uint32>(width),
+			.m_Height = apollo::NumCast<uint32>(height),
+			.m_Format = int32(format),
+			.m_PixelSize = apollo::NumCast<uint32>(numComponents),
+		};
+		Append(out_buf, header);
+		Append(out_buf, data, size_t(width) * height * numComponents);
+		stbi_image_free(data);
+		return true;
+	}
+
+	bool CookMesh(ByteBuffer& out_buf, const apollo::AssetMetadata& metadata)
+	{
+		Assimp::Importer importer;
+		const aiScene* scene = importer.ReadFile(metadata.m_FilePath.c_str(), g_PostProcessFlags);
+		if (!scene || !scene->mNumMeshes)
+		{
+			std::cerr << "Failed to load mesh from " << metadata.m_FilePath << ": "
+					  << importer.GetErrorString() << '\n';
+			return false;
+		}
+
+		const aiMesh* am = scene->mMeshes[0];
+		std::vector<apollo::rdr::Vertex3d> vertices;
+		vertices.reserve(am->mNumVertices);
+		std::vector<uint32> indices;
+		indices.reserve(am->mNumFaces * 3);
+
+		for (uint32 i = 0; i < am->mNumVertices; ++i)
+		{
+			const float3 pos{ am->mVertices[i].x, am->mVertices[i].y, am->mVertices[i].z };
+			const float3 nor{ am->mNormals[i].x, am->mNormals[i].y, am->mNormals[i].z };
+			const float2 uv{ am->mTextureCoords[0][i].x, am->mTextureCoords[0][i].y };
+			vertices.emplace_back(apollo::rdr::Vertex3d{ pos, nor, uv });
+		}
+		for (uint32 i = 0; i < am->mNumFaces; ++i)
+		{
+			const aiFace& face = am->mFaces[i];
+			indices.insert(indices.end(), face.mIndices, face.mIndices + face.mNumIndices);
+		}
+
+		const apollo::CookedMeshHeader header{
+			.m_NumVertices = apollo::NumCast<uint32>(vertices.size()),
+			.m_NumIndices = apollo::NumCast<uint32>(indices.size()),
+		};
+		Append(out_buf, header);
+		Append(out_buf, vertices.data(), vertices.size());
+		Append(out_buf, indices.data(), indices.size());
+		return true;
+	}
+
+	/// Same rules as in the editor: the entry point marked with the stage's [shader(...)]
+	/// attribute, or the one called main
+	std::string FindEntryPoint(slang::IModule& module, std::string_view stageName)
+	{
+		auto& compiler = apollo::rdr::ShaderCompiler::s_Instance;
+		std::string main;
+
+		for (int32 i = 0; i < module.getDefinedEntryPointCount(); ++i)
+		{
+			Slang::ComPtr<slang::IEntryPoint> ep;
+			module.getDefinedEntryPoint(i, ep.writeRef());
+			slang::FunctionReflection* const func = ep->getFunctionReflection();
+			const std::string_view name = func->getName();
+			if (name == "main")
+				main = name;
+
+			auto* attr = compiler.FindAttributeByName(*func, "shader");
+			if (!attr)
+				continue;
+
+			size_t len = 0;
+			if (std::string_view{ attr->getArgumentValueString(0, &len), len } == stageName)
+				return std::string{ name };
+		}
+		return main;
+	}
+
+	/// Compiles the shader to Slang's intermediate representation
+	bool CookShader(ByteBuffer& out_buf, const apollo::AssetMetadata& metadata)
+	{
+		auto& compiler = apollo::rdr::ShaderCompiler::s_Instance;
+		ByteBuffer source;
+		if (!ReadFile(source, metadata.m_FilePath))
+			return false;
+
+		Slang::ComPtr sourceBlob{ Blob::Allocate(source.size(), source.data()) };
+		Slang::ComPtr<slang::IBlob> diagnostics;
+		slang::IModule* module = nullptr;
+		if (source.size() >= 4 && !std::memcmp(source.data(), "RIFF", 4))
+		{
+			module = compiler.LoadFromIntermediate(
+				metadata.m_Name.c_str(),
+				sourceBlob,
+				nullptr,
+				diagnostics.writeRef());
+		}
+		else
+		{
+			module = compiler.LoadModuleFromSource(
+				sourceBlob,
+				metadata.m_Name.c_str(),
+				nullptr,
+				diagnostics.writeRef());
+		}
+		if (!module)
+		{
+			std::cerr << "Failed to compile shader " << metadata.m_Name << '\n';
+			if (diagnostics)
+			{
+				std::cerr.write(
+					static_cast<const char*>(diagnostics->getBufferPointer()),
+					diagnostics->getBufferSize());
+			}
+			return false;
+		}
+
+		const bool isVertex = metadata.m_Type == apollo::EAssetType::VertexShader;
+		const std::string entryPoint = FindEntryPoint(
+			*module,
+			isVertex ? "vertex" : "fragment");
+		if (entryPoint.empty())
+		{
+			std::cerr << "Failed to deduce entry point for shader " << metadata.m_Name << '\n';
+			return false;
+		}
+
+		Slang::ComPtr<slang::IBlob> code;
+		if (SLANG_FAILED(module->serialize(code.writeRef())))
+		{
+			std::cerr << "Failed to serialize shader " << metadata.m_Name << '\n';
+			return false;
+		}
+
+		const apollo::CookedShaderHeader header{
+			.m_EntryPointLength = apollo::NumCast<uint32>(entryPoint.size()),
+			.m_ModuleSize = apollo::NumCast<uint32>(code->getBufferSize()),
+		};
+		Append(out_buf, header);
+		Append(out_buf, entryPoint.data(), entryPoint.size());
+		Append(
+			out_buf,
+			static_cast<const std::byte*>(code->getBufferPointer()),
+			header.m_ModuleSize);
+		return true;
+	}
+
+	bool CookAsset(ByteBuffer& out_buf, const apollo::AssetMetadata& metadata)
+	{
+		using apollo::EAssetType;
+		switch (metadata.m_Type)
+		{
+		case EAssetType::Texture2D: return CookTexture(out_buf, metadata);
+		case EAssetType::Mesh: return CookMesh(out_buf, metadata);
+		case EAssetType::VertexShader:
+		case EAssetType::FragmentShader: return CookShader(out_buf, metadata);
+		default: return ReadFile(out_buf, metadata.m_FilePath);
+		}
+	}
+} // namespace
+
+int main(int argc, const char* const* argv)
+{
+	if (argc < 2)
+	{
+		std::cerr << Usage;
+		return 1;
+	}
+	// checked first: the last argument is only the asset folder when help wasn't requested
+	if (std::ranges::any_of(std::span{ argv + 1, size_t(argc - 1) }, IsHelpFlag))
+	{
+		std::cout << Usage
+				  << "Cooks all assets listed in <asset folder>/metadata.csv into a single pack "
+					 "file. The pack is written to <asset folder>/assets.pak by default, and its "
+					 "metadata index to metadata.idx in the same folder.\n";
+		return 0;
+	}
+
+	Options options;
+	options.m_AssetRoot = argv[argc - 1];
+	std::span args{ argv + 1, size_t(argc - 2) };
+
+	using argp::NamedArgument;
+	try
+	{
+		using NamedArgs = argp::ArgList<NamedArgument{ &Options::m_OutPath, "-o" }>;
+		NamedArgs::Parse(options, args);
+	}
+	catch (const argp::MissingArgumentError& err)
+	{
+		std::cerr << "Missing value for argument " << err.m_Name << '\n';
+		return 1;
+	}
+	catch (const argp::UnknownArgumentError& err)
+	{
+		std::cerr << "Unknown argument: '" << err.m_Arg << "'\n";
+		return 1;
+	}
+	catch (const argp::InvalidValueError& err)
+	{
+		std::cerr << "Value '" << err.m_Value << "' is invalid for '" << err.m_Name << "'\n";
+		return 1;
+	}
+
+	const std::string assetRoot = std::filesystem::absolute(options.m_AssetRoot).string();
+	const std::string outPath = options.m_OutPath
+									? std::string{ options.m_OutPath }
+									: (std::filesystem::path{ assetRoot } / "assets.pak").string();
+
+	apollo::ULIDMap<apollo::AssetMetadata> metadataBank;
+	if (!apollo::ImportMetadataCsv(assetRoot, metadataBank))
+		return 1;
+
+	const char* includePaths[] = { assetRoot.c_str() };
+	const auto rc = apollo::rdr::ShaderCompiler::s_Instance.Init(
+		SLANG_SPIRV,
+		"spirv_1_3",
+		{},
+		includePaths);
+	if (SLANG_FAILED(rc))
+	{
+		std::cerr << "Failed to initialize the shader compiler\n";
+		return 1;
+	}
+
+	apollo::AssetPackWriter writer;
+	uint32 numFailed = 0;
+	ByteBuffer data;
+	for (const auto& [id, metadata] : metadataBank)
+	{
+		data.clear();
+		if (!CookAsset(data, metadata))
+		{
+			++numFailed;
+			continue;
+		}
+		writer.AddAsset(id, metadata.m_Type, metadata.m_Name, data);
+	}
+
+	if (!writer.Write(outPath))
+		return 1;
+
+	std::cout << "Cooked " << writer.GetNumAssets() << " assets into " << outPath << '\n';
+
+	// the runtime locates assets through the metadata index, which lives next to the pack
+	apollo::AssetPack pack;
+	if (!pack.Open(outPath))
+		return 1;
+
+	const std::filesystem::path packPath{ outPath };
+	const std::string packFileName = packPath.filename().generic_string();
+	apollo::AssetIndexWriter indexWriter;
+	for (const apollo::AssetPackEntry& entry : pack.GetEntries())
+	{
+		indexWriter.AddAsset(
+			entry.m_Id,
+			entry.m_Type,
+			pack.GetName(entry),
+			packFileName,
+			entry.m_Offset,
+			entry.m_Size);
+	}
+	const std::string indexPath = (packPath.parent_path() / apollo::AssetIndex::FileName).string();
+	if (!indexWriter.Write(indexPath))
+		return 1;
+
+	if (numFailed)
+	{
+		std::cerr << numFailed << " assets failed to cook\n";
+		return 1;
+	}
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <asset/AssetIndex.hpp>
+#include <asset/MetadataCsv.hpp>
+#include <filesystem>
+#include <iostream>
+#include <string_view>
+
+struct Options
+{
+	const char* m_OutPath = nullptr;
+};
+
+#include "ArgParse.hpp"
+
+namespace {
+	constexpr const char Usage[] = "Usage: AssetIndexer [-o <output>] [-h|--help] <asset folder>\n";
+
+	bool IsHelpFlag(std::string_view arg) noexcept
+	{
+		return arg == "--help" || arg == "-h";
+	}
+} // namespace
+
+int main(int argc, const char* const* argv)
+{
+	if (argc < 2)
+	{
+		std::cerr << Usage;
+		return 1;
+	}
+	// checked first: the last argument is only the asset folder when help wasn't requested
+	if (std::ranges::any_of(std::span{ argv + 1, size_t(argc - 1) }, IsHelpFlag))
+	{
+		std::cout << Usage
+				  << "Converts <asset folder>/metadata.csv into a binary metadata index, written "
+					 "to <asset folder>/metadata.idx by default.\n";
+		return 0;
+	}
+
+	Options options;
+	std::span args{ argv + 1, size_t(argc - 2) };
+
+	using argp::NamedArgument;
+	try
+	{
+		using NamedArgs = argp::ArgList<NamedArgument{ &Options::m_OutPath, "-o" }>;
+		NamedArgs::Parse(options, args);
+	}
+	catch (const argp::MissingArgumentError& err)
+	{
+		std::cerr << "Missing value for argument " << err.m_Name << '\n';
+		return 1;
+	}
+	catch (const argp::UnknownArgumentError& err)
+	{
+		std::cerr << "Unknown argument: '" << err.m_Arg << "'\n";
+		return 1;
+	}
+	catch (const argp::InvalidValueError& err)
+	{
+		std::cerr << "Value '" << err.m_Value << "' is invalid for '" << err.m_Name << "'\n";
+		return 1;
+	}
+
+	const std::filesystem::path assetRoot = std::filesystem::absolute(argv[argc - 1]);
+	const std::string outPath = options.m_OutPath
+									? std::string{ options.m_OutPath }
+									: (assetRoot / apollo::AssetIndex::FileName).string();
+
+	apollo::ULIDMap<apollo::AssetMetadata> metadataBank;
+	if (!apollo::ImportMetadataCsv(assetRoot.string(), metadataBank))
+		return 1;
+
+	apollo::AssetIndexWriter writer;
+	for (const auto& [id, metadata] : metadataBank)
+	{
+		// the index stores paths relative to the asset folder, so that it can be relocated
+		const std::string path = std::filesystem::path{ metadata.m_FilePath }
+									 .lexically_relative(assetRoot)
+									 .generic_string();
+		writer.AddAsset(id, metadata.m_Type, metadata.m_Name, path);
+	}
+
+	if (!writer.Write(outPath))
+		return 1;
+
+	std::cout << "Indexed " << writer.GetNumAssets() << " assets into " << outPath << " ("
+			  << writer.GetStringTableSize() << " bytes of strings)\n";
+	return 0;
+}
\ No newline at end of file
@@ -64,6 +64,29 @@ namespace {
 		return true;
 	}
 
+	/// Parses an enum value from its name, \p names being indexed by value
+	template <class E, size_t N>
+	bool ParseEnum(std::span<const char*>& inout_args, const char* const (&names)[N], E& out_val)
+	{
+		std::string_view name;
+		if (!ParseValue(inout_args, name))
+			return false;
+		for (size_t i = 0; i < N; ++i)
+		{
+			if (name == names[i])
+			{
+				out_val = E(i);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	static constexpr const char* g_StrategyNames[] = { "shelf", "skyline", "maxrects" };
+	static constexpr const char* g_OrderNames[] = {
+		"none", "height", "area", "perimeter", "maxside",
+	};
+
 	struct Settings
 	{
 		const char* m_InputPath;
@@ -74,6 +97,8 @@ namespace {
 		bool m_HelpMessage = false;
 		bool m_PaddingSpecified = false;
 		double m_PixelRange = 10.0;
+		apollo::rdr::EPackingStrategy m_Packing = apollo::rdr::EPackingStrategy::Skyline;
+		apollo::rdr::EPackingOrder m_PackingOrder = apollo::rdr::EPackingOrder::Height;
 	};
 
 	bool ParseSettings(std::span<const char*> args, Settings& out_settings)
@@ -142,6 +167,22 @@ namespace {
 					return false;
 				}
 			}
+			else if (name == "--packer")
+			{
+				if (!ParseEnum(args, g_StrategyNames, out_settings.m_Packing))
+				{
+					std::cerr << "Invalid value for packer parameter\n";
+					return false;
+				}
+			}
+			else if (name == "--sort")
+			{
+				if (!ParseEnum(args, g_OrderNames, out_settings.m_PackingOrder))
+				{
+					std::cerr << "Invalid value for sort parameter\n";
+					return false;
+				}
+			}
 		}
 		return true;
 	}
@@ -149,7 +190,7 @@ namespace {
 	std::ostream& PrintHelp(std::ostream& out)
 	{
 		static constexpr const char* helpMsg =
-			R"(Usage: atlasGen fontFile] [-o|--output outputName] [-r|--range first last] [-s|--size pixelSize] [-p|--padding glyphPadding] [-h|--help]
+			R"(Usage: atlasGen fontFile] [-o|--output outputName] [-r|--range first last] [-s|--size pixelSize] [-p|--padding glyphPadding] [--packer strategy] [--sort order] [-h|--help]
 
 -fontFile: Path to the font truetype/opentype font file.
 -o|--ouput: The base path where to put the result files. Extensions will be appended to this. Defaults to ./out
@@ -158,7 +199,10 @@ The default is Latin-1 Unicode range U+0020 U+00FF, that is: the 'space' charact
 -s|--size: The vertical resolution of the MSDF bitmaps, in pixels. This is a scale factor, the actual
 sizes will depend on the glyphs themselves. The default is 64.
 -p|--padding: The padding to put around glyphs in the atlas, expressed in normalized font units (em). The default is 1/pixelSize.
--d|--distanceRange: The spread of the distance fields, in pixel. The default is 10.0.)";
+-d|--distanceRange: The spread of the distance fields, in pixel. The default is 10.0.
+--packer: How glyphs are packed in the atlas: shelf, skyline or maxrects. The default is skyline.
+--sort: The order in which glyphs are packed, by decreasing height, area, perimeter or maxside
+(largest of width and height), or none to keep the codepoint order. The default is height.)";
 		return out << helpMsg;
 	}
 
@@ -248,6 +292,7 @@ int main(int argc, const char** argv)
 	std::vector<apollo::rdr::txt::Glyph> glyphs;
 	std::vector<msdfgen::Shape> shapes;
 	std::vector<uint32> indices;
+	generator.SetPacking(settings.m_Packing, settings.m_PackingOrder);
 	const glm::uvec2 atlasSize = generator.LoadGlyphRange(settings.m_Range, glyphs, shapes, indices);
 	using Pixel = apollo::rdr::RGBAPixel<uint8>;
 	auto buffer = std::make_unique<Pixel[]>(atlasSize.x * atlasSize.y);
@@ -282,5 +327,10 @@ int main(int argc, const char** argv)
 		{ "glyphs", glyphs },
 	};
 	atlasFile << json.dump(1, '\t');
-	std::cout << "Packed " << glyphs.size() << " glyphs\n";
+	std::vector<RectU32> uvs(glyphs.size());
+	for (size_t i = 0; i < glyphs.size(); ++i)
+		uvs[i] = glyphs[i].m_Uv;
+	std::cout << "Packed " << glyphs.size() << " glyphs in " << atlasSize.x << 'x' << atlasSize.y
+			  << " (" << 100.0f * apollo::rdr::RectPacker::ComputeEfficiency(uvs, atlasSize)
+			  << "% used)\n";
 }
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <asset/AssetManager.hpp>
+#include <asset/SceneFile.hpp>
+#include <core/Errno.hpp>
+#include <core/Json.hpp>
+#include <ecs/ComponentRegistry.hpp>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+#include <systems/SceneComponents.hpp>
+#include <systems/TransformComponent.hpp>
+#include <vector>
+
+struct Options
+{
+	const char* m_OutPath = nullptr;
+};
+
+#include "ArgParse.hpp"
+
+namespace {
+	constexpr const char Usage[] = "Usage: SceneConverter [-o <output>] [-h|--help] <scene file>\n";
+
+	bool IsHelpFlag(std::string_view arg) noexcept
+	{
+		return arg == "--help" || arg == "-h";
+	}
+
+	bool ReadFile(const std::filesystem::path& path, std::vector<std::byte>& out_data)
+	{
+		std::ifstream file{ path, std::ios::binary | std::ios::ate };
+		if (!file.is_open())
+		{
+			std::cerr << "Failed to open " << path << ": " << apollo::GetErrnoMessage(errno)
+					  << '\n';
+			return false;
+		}
+		out_data.resize(static_cast<size_t>(file.tellg()));
+		file.seekg(0, std::ios::beg);
+		return bool(file.read(reinterpret_cast<char*>(out_data.data()), out_data.size()));
+	}
+
+	bool WriteFile(const std::filesystem::path& path, const void* data, size_t size)
+	{
+		std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+		if (!file.is_open() || !file.write(static_cast<const char*>(data), size))
+		{
+			std::cerr << "Failed to write " << path << ": " << apollo::GetErrnoMessage(errno)
+					  << '\n';
+			return false;
+		}
+		return true;
+	}
+} // namespace
+
+int main(int argc, const char* const* argv)
+{
+	if (argc < 2)
+	{
+		std::cerr << Usage;
+		return 1;
+	}
+	// checked first: the last argument is only the input file when help wasn't requested
+	if (std::ranges::any_of(std::span{ argv + 1, size_t(argc - 1) }, IsHelpFlag))
+	{
+		std::cout << Usage
+				  << "Converts a JSON scene to the binary scene format, or a binary scene back to "
+					 "JSON. The direction is deduced from the contents of <scene file>.\n"
+					 "By default, the output is written next to the input, with a .scnb "
+					 "extension for binary scenes and .scn for JSON scenes.\n"
+					 "Only the engine's components are known to this tool.\n";
+		return 0;
+	}
+
+	Options options;
+	std::span args{ argv + 1, size_t(argc - 2) };
+
+	using argp::NamedArgument;
+	try
+	{
+		using NamedArgs = argp::ArgList<NamedArgument{ &Options::m_OutPath, "-o" }>;
+		NamedArgs::Parse(options, args);
+	}
+	catch (const argp::MissingArgumentError& err)
+	{
+		std::cerr << "Missing value for argument " << err.m_Name << '\n';
+		return 1;
+	}
+	catch (const argp::UnknownArgumentError& err)
+	{
+		std::cerr << "Unknown argument: '" << err.m_Arg << "'\n";
+		return 1;
+	}
+	catch (const argp::InvalidValueError& err)
+	{
+		std::cerr << "Value '" << err.m_Value << "' is invalid for '" << err.m_Name << "'\n";
+		return 1;
+	}
+
+	auto& componentRegistry = apollo::ecs::ComponentRegistry::Init();
+	componentRegistry.RegisterComponent<apollo::TransformComponent>();
+	componentRegistry.RegisterComponent<apollo::SceneComponent>();
+
+	const std::filesystem::path inPath = argv[argc - 1];
+	std::vector<std::byte> input;
+	if (!ReadFile(inPath, input))
+		return 1;
+
+	const bool toJson = apollo::IsBinaryScene(input);
+	std::filesystem::path outPath = options.m_OutPath
+										? std::filesystem::path{ options.m_OutPath }
+										: std::filesystem::path{ inPath }.replace_extension(
+											  toJson ? ".scn" : ".scnb");
+	if (!options.m_OutPath && outPath == inPath)
+		outPath += toJson ? ".json" : ".bin";
+
+	if (toJson)
+	{
+		nlohmann::json json;
+		if (!apollo::SceneBinaryToJson(input, componentRegistry, json))
+			return 1;
+		const std::string str = json.dump(1, '\t');
+		if (!WriteFile(outPath, str.data(), str.size()))
+			return 1;
+	}
+	else
+	{
+		const nlohmann::json json =
+			nlohmann::json::parse(input.begin(), input.end(), nullptr, false);
+		if (json.is_discarded())
+		{
+			std::cerr << "Failed to parse " << inPath << " as JSON\n";
+			return 1;
+		}
+		std::vector<std::byte> output;
+		if (!apollo::SceneJsonToBinary(json, componentRegistry, output))
+			return 1;
+		if (!WriteFile(outPath, output.data(), output.size()))
+			return 1;
+	}
+
+	std::cout << "Converted " << inPath << " to " << outPath << '\n';
+	return 0;
+}
\ No newline at end of file
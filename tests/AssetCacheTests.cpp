@@ -0,0 +1,150 @@
+#include <asset/AssetCache.hpp>
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace apollo::asset_cache_ut {
+#define ASSET_CACHE_TEST(name) TEST_CASE(name, "[asset][asset_cache]")
+
+	struct CachedAsset : public IAsset
+	{
+		using IAsset::IAsset;
+		GET_ASSET_TYPE_IMPL(EAssetType::Texture2D);
+	};
+
+	std::vector<std::unique_ptr<CachedAsset>> MakeAssets(uint32 n)
+	{
+		std::vector<std::unique_ptr<CachedAsset>> assets;
+		for (uint32 i = 0; i < n; ++i)
+			assets.emplace_back(std::make_unique<CachedAsset>(ULID::Generate()));
+		return assets;
+	}
+
+	ASSET_CACHE_TEST("Insert and find")
+	{
+		AssetCache cache;
+		CachedAsset a{ ULID::Generate() };
+		CHECK_FALSE(cache.Find(a.GetId()));
+
+		CHECK(cache.Insert(&a) == &a);
+		CHECK(cache.Find(a.GetId()) == &a);
+		CHECK(cache.GetSize() == 1);
+
+		SECTION("Same ID")
+		{
+			CachedAsset b{ a.GetId() };
+			CHECK(cache.Insert(&b) == &a);
+			CHECK(cache.Find(a.GetId()) == &a);
+			CHECK(cache.GetSize() == 1);
+		}
+		SECTION("Erase")
+		{
+			CHECK(cache.Erase(a.GetId()));
+			CHECK_FALSE(cache.Find(a.GetId()));
+			CHECK_FALSE(cache.Erase(a.GetId()));
+			CHECK(cache.GetSize() == 0);
+
+			CachedAsset b{ a.GetId() };
+			CHECK(cache.Insert(&b) == &b);
+			CHECK(cache.Find(a.GetId()) == &b);
+			CHECK(cache.GetSize() == 1);
+		}
+	}
+
+	ASSET_CACHE_TEST("Many assets")
+	{
+		constexpr uint32 n = 10000;
+		const auto assets = MakeAssets(n);
+		AssetCache cache;
+		for (const auto& asset : assets)
+			cache.Insert(asset.get());
+		REQUIRE(cache.GetSize() == n);
+
+		bool ok = true;
+		for (const auto& asset : assets)
+			ok = ok && cache.Find(asset->GetId()) == asset.get();
+		CHECK(ok);
+
+		uint32 count = 0;
+		cache.ForEach(
+			[&](IAsset*)
+			{
+				++count;
+			});
+		CHECK(count == n);
+
+		for (uint32 i = 0; i < n; i += 2)
+			cache.Erase(assets[i]->GetId());
+		CHECK(cache.GetSize() == n / 2);
+		for (uint32 i = 0; i < n; ++i)
+			ok = ok && bool(cache.Find(assets[i]->GetId())) == bool(i % 2);
+		CHECK(ok);
+
+		SECTION("Reclaim retired tables")
+		{
+			cache.ReclaimRetiredTables();
+			for (uint32 i = 0; i < n; ++i)
+				ok = ok && bool(cache.Find(assets[i]->GetId())) == bool(i % 2);
+			CHECK(ok);
+
+			for (uint32 i = 0; i < n; i += 2)
+				cache.Insert(assets[i].get());
+			CHECK(cache.GetSize() == n);
+			for (const auto& asset : assets)
+				ok = ok && cache.Find(asset->GetId()) == asset.get();
+			CHECK(ok);
+		}
+	}
+
+	ASSET_CACHE_TEST("Concurrent lookups")
+	{
+		constexpr uint32 numReaders = 4;
+		const auto stable = MakeAssets(256);
+		const auto churn = MakeAssets(4096);
+		AssetCache cache;
+		for (const auto& asset : stable)
+			cache.Insert(asset.get());
+
+		std::atomic_bool done = false;
+		std::atomic_uint32_t failures = 0;
+		std::vector<std::thread> readers;
+		for (uint32 i = 0; i < numReaders; ++i)
+		{
+			readers.emplace_back(
+				[&]()
+				{
+					while (!done)
+					{
+						for (const auto& asset : stable)
+						{
+							if (cache.Find(asset->GetId()) != asset.get())
+								++failures;
+						}
+						for (const auto& asset : churn)
+						{
+							IAsset* const found = cache.Find(asset->GetId());
+							if (found && found != asset.get())
+								++failures;
+						}
+					}
+				});
+		}
+
+		// the writer keeps rebuilding tables and leaving tombstones behind
+		for (uint32 round = 0; round < 8; ++round)
+		{
+			for (const auto& asset : churn)
+				cache.Insert(asset.get());
+			for (const auto& asset : churn)
+				cache.Erase(asset->GetId());
+		}
+		done = true;
+		for (std::thread& th : readers)
+			th.join();
+
+		CHECK(failures == 0);
+		CHECK(cache.GetSize() == stable.size());
+	}
+} // namespace apollo::asset_cache_ut
\ No newline at end of file
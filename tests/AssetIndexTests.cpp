@@ -0,0 +1,151 @@
+#include <asset/GameAssetManager.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <core/ThreadPool.hpp>
+#include <filesystem>
+#include <fstream>
+#include <rendering/Device.hpp>
+
+#define ASSET_INDEX_TEST(name) TEST_CASE(name, "[asset][asset_index]")
+
+namespace {
+	using namespace apollo::ulid_literal;
+
+	constexpr apollo::ULID g_Id1 = "01JA0000000000000000000001"_ulid;
+	constexpr apollo::ULID g_Id2 = "01JA0000000000000000000002"_ulid;
+	constexpr apollo::ULID g_Id3 = "01JB0000000000000000000000"_ulid;
+
+	/// Temporary folder, deleted on scope exit
+	struct TempDir
+	{
+		explicit TempDir(const char* name)
+			: m_Path(std::filesystem::temp_directory_path() / name)
+		{
+			std::filesystem::create_directories(m_Path);
+		}
+		~TempDir() { std::filesystem::remove_all(m_Path); }
+
+		std::string GetIndexPath() const
+		{
+			return (m_Path / apollo::AssetIndex::FileName).string();
+		}
+
+		std::filesystem::path m_Path;
+	};
+
+	void WriteTestIndex(const std::string& path)
+	{
+		apollo::AssetIndexWriter writer;
+		writer.AddAsset(g_Id3, apollo::EAssetType::Mesh, "mesh", "assets.pak", 128, 64);
+		writer.AddAsset(g_Id1, apollo::EAssetType::Texture2D, "texture", "assets.pak", 0, 128);
+		writer.AddAsset(g_Id2, apollo::EAssetType::Scene, "scene", "scenes/main.json");
+		REQUIRE(writer.Write(path));
+	}
+
+	struct TestAssetManager : public apollo::GameAssetManager
+	{
+		using GameAssetManager::GameAssetManager;
+
+		const apollo::AssetTypeInfo& GetTypeInfo(apollo::EAssetType) const override
+		{
+			return m_TypeInfo;
+		}
+
+		const apollo::AssetTypeInfo m_TypeInfo;
+	};
+} // namespace
+
+namespace apollo::ut {
+	ASSET_INDEX_TEST("String interning")
+	{
+		AssetIndexWriter writer;
+		writer.AddAsset(g_Id1, EAssetType::Texture2D, "a", "assets.pak");
+		writer.AddAsset(g_Id2, EAssetType::Texture2D, "b", "assets.pak");
+		writer.AddAsset(g_Id3, EAssetType::Texture2D, "a", "assets.pak");
+		CHECK(writer.GetNumAssets() == 3);
+		CHECK(writer.GetStringTableSize() == std::string_view{ "aassets.pakb" }.size());
+	}
+
+	ASSET_INDEX_TEST("Index round trip")
+	{
+		TempDir dir{ "apollo_asset_index_test" };
+		WriteTestIndex(dir.GetIndexPath());
+
+		AssetIndex index;
+		REQUIRE(index.Load(dir.GetIndexPath()));
+		CHECK(index.IsLoaded());
+
+		const std::span records = index.GetRecords();
+		REQUIRE(records.size() == 3);
+		CHECK(records[0].m_Id == g_Id1);
+		CHECK(records[1].m_Id == g_Id2);
+		CHECK(records[2].m_Id == g_Id3);
+		// both packed assets share the same path string
+		CHECK(records[0].m_PathOffset == records[2].m_PathOffset);
+
+		const AssetIndexRecord* record = index.FindRecord(g_Id3);
+		REQUIRE(record);
+		CHECK(record->m_Type == EAssetType::Mesh);
+		CHECK(index.GetName(*record) == "mesh");
+		CHECK(index.GetPath(*record) == "assets.pak");
+		CHECK(record->m_Offset == 128);
+		CHECK(record->m_Size == 64);
+
+		record = index.FindRecord(g_Id2);
+		REQUIRE(record);
+		const AssetMetadata metadata = index.MakeMetadata(*record, "root");
+		CHECK(metadata.m_Id == g_Id2);
+		CHECK(metadata.m_Name == "scene");
+		CHECK(metadata.m_Type == EAssetType::Scene);
+		CHECK(
+			metadata.m_FilePath ==
+			(std::filesystem::path{ "root" } / "scenes/main.json").string());
+
+		CHECK_FALSE(index.FindRecord("01JA0000000000000000000003"_ulid));
+	}
+
+	ASSET_INDEX_TEST("Invalid index files")
+	{
+		TempDir dir{ "apollo_asset_index_invalid" };
+		AssetIndex index;
+		SECTION("Missing file")
+		{
+			CHECK_FALSE(index.Load(dir.GetIndexPath()));
+		}
+		SECTION("Truncated file")
+		{
+			WriteTestIndex(dir.GetIndexPath());
+			std::filesystem::resize_file(dir.GetIndexPath(), sizeof(AssetIndexHeader) + 10);
+			CHECK_FALSE(index.Load(dir.GetIndexPath()));
+		}
+		SECTION("Bad magic")
+		{
+			{
+				std::ofstream out{ dir.GetIndexPath(), std::ios::binary };
+				out << "definitely not an asset index";
+			}
+			CHECK_FALSE(index.Load(dir.GetIndexPath()));
+		}
+		CHECK_FALSE(index.IsLoaded());
+	}
+
+	ASSET_INDEX_TEST("Game asset manager")
+	{
+		TempDir dir{ "apollo_asset_index_manager" };
+		WriteTestIndex(dir.GetIndexPath());
+
+		rdr::GPUDevice device;
+		mt::ThreadPool threadPool{ 1 };
+		TestAssetManager manager{ dir.m_Path.string(), device, threadPool };
+		REQUIRE(manager.ImportMetadataBank());
+
+		const AssetMetadata* metadata = manager.GetAssetMetadata(g_Id1);
+		REQUIRE(metadata);
+		CHECK(metadata->m_Name == "texture");
+		CHECK(metadata->m_FilePath == (dir.m_Path / "assets.pak").string());
+		CHECK(metadata->m_Size == 128);
+		// metadata objects are created once, then reused
+		CHECK(manager.GetAssetMetadata(g_Id1) == metadata);
+
+		CHECK_FALSE(manager.GetAssetMetadata("01JA0000000000000000000003"_ulid));
+	}
+} // namespace apollo::ut
\ No newline at end of file
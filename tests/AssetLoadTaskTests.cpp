@@ -1,5 +1,6 @@
 #include <asset/AssetLoader.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <span>
 
 namespace apollo::asset_ut {
 	struct TestAsset : public IAsset
@@ -10,7 +11,7 @@ namespace apollo::asset_ut {
 		{}
 		TestAsset(EAssetState state = EAssetState::Loading) { m_State = state; }
 
-		void SetState(EAssetState state) noexcept { m_State.store(state); }
+		using IAsset::SetState;
 		void Swap(TestAsset&) {};
 	};
 
@@ -20,6 +21,49 @@ namespace apollo::asset_ut {
 		co_return await && await->IsLoaded();
 	}
 
+	AssetLoadTask AwaitAll(std::span<TestAsset> assets) noexcept
+	{
+		for (TestAsset& asset : assets)
+		{
+			AssetRef<TestAsset> ref = co_await AssetRef<TestAsset>{ &asset };
+			if (!ref->IsLoaded())
+				co_return false;
+		}
+		co_return true;
+	}
+
+	/**
+	 * Drives a load task the same way the asset loader does: the task only gets invoked again
+	 * once the asset it waits on has completed.
+	 */
+	struct TaskRunner : public AssetWaiter
+	{
+		TaskRunner(AssetLoadTask task, TestAsset* target = nullptr)
+			: AssetWaiter{ &Resume }
+			, m_Task(std::move(task))
+			, m_Target(target)
+		{}
+
+		void Run()
+		{
+			++m_NumAttempts;
+			m_Result = m_Task();
+			if (m_Result == EAssetLoadResult::TryAgain)
+				m_Task->GetAwaitedAsset()->AddWaiter(*this);
+			else if (m_Target)
+				m_Target->SetState(
+					m_Result == EAssetLoadResult::Success ? EAssetState::Loaded
+														  : EAssetState::LoadingFailed);
+		}
+
+		static void Resume(AssetWaiter& waiter) { static_cast<TaskRunner&>(waiter).Run(); }
+
+		AssetLoadTask m_Task;
+		TestAsset* m_Target;
+		EAssetLoadResult m_Result = EAssetLoadResult::TryAgain;
+		uint32 m_NumAttempts = 0;
+	};
+
 #define LOAD_TEST(name) TEST_CASE(name, "[asset_load_task]")
 
 	LOAD_TEST("Load success")
@@ -78,4 +122,50 @@ namespace apollo::asset_ut {
 		asset.SetState(EAssetState::Invalid);
 		CHECK(task() == EAssetLoadResult::Failure);
 	}
+	LOAD_TEST("Waiter on completed asset")
+	{
+		TestAsset asset{ EAssetState::Loaded };
+		TaskRunner runner{ AwaitAndReturn(AssetRef<TestAsset>{}) };
+		asset.AddWaiter(runner);
+		CHECK(runner.m_NumAttempts == 1);
+		CHECK(runner.m_Result == EAssetLoadResult::Failure);
+	}
+	LOAD_TEST("Resume attempts per dependency")
+	{
+		TestAsset dependencies[3];
+		TaskRunner runner{ AwaitAll(dependencies) };
+		runner.Run();
+		CHECK(runner.m_Result == EAssetLoadResult::TryAgain);
+
+		// state changes which don't complete the asset must not resume the task
+		dependencies[0].SetState(EAssetState::Loading | EAssetState::LoadingDeferred);
+		CHECK(runner.m_NumAttempts == 1);
+
+		for (uint32 i = 0; i < 3; ++i)
+		{
+			dependencies[i].SetState(EAssetState::Loaded);
+			CHECK(runner.m_NumAttempts == i + 2);
+		}
+		CHECK(runner.m_Result == EAssetLoadResult::Success);
+	}
+	LOAD_TEST("Resume attempts in dependency chain")
+	{
+		// MaterialInstance -> Material -> Shader -> Texture
+		TestAsset assets[4];
+		TaskRunner runners[] = {
+			{ AwaitAndReturn(AssetRef<TestAsset>{ &assets[1] }), &assets[0] },
+			{ AwaitAndReturn(AssetRef<TestAsset>{ &assets[2] }), &assets[1] },
+			{ AwaitAndReturn(AssetRef<TestAsset>{ &assets[3] }), &assets[2] },
+		};
+		for (TaskRunner& runner : runners)
+			runner.Run();
+
+		assets[3].SetState(EAssetState::Loaded);
+		for (const TaskRunner& runner : runners)
+		{
+			CHECK(runner.m_NumAttempts == 2);
+			CHECK(runner.m_Result == EAssetLoadResult::Success);
+		}
+		CHECK(assets[0].IsLoaded());
+	}
 } // namespace apollo::asset_ut
\ No newline at end of file
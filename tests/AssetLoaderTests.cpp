@@ -2,8 +2,10 @@
 #include <asset/AssetLoader.hpp>
 #include <asset/AssetManager.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <core/JobGraph.hpp>
 #include <core/ThreadPool.hpp>
 #include <rendering/Device.hpp>
+#include <rendering/UploadHeap.hpp>
 #include <semaphore>
 
 namespace apollo::asset_ut {
@@ -14,6 +16,13 @@ namespace apollo::asset_ut {
 	struct TestAsset : public IAsset
 	{
 		TestAsset() { m_State = EAssetState::Loading; }
+		TestAsset(const ULID& id)
+			: IAsset(id)
+		{
+			m_State = EAssetState::Loading;
+		}
+
+		void Swap(TestAsset&) {}
 
 		GET_ASSET_TYPE_IMPL(EAssetType::Invalid);
 	};
@@ -23,10 +32,16 @@ namespace apollo::asset_ut {
 		co_return true;
 	}
 
+	AssetLoadTask LoadDependent(AssetRef<TestAsset> dependency)
+	{
+		co_await dependency;
+		co_return dependency->IsLoaded();
+	}
+
 	struct Helper
 	{
-		Helper(bool registerCallback = true)
-			: m_ThreadPool(1)
+		Helper(bool registerCallback = true, uint32 numThreads = 1)
+			: m_ThreadPool(numThreads)
 			, m_Loader(m_Dev, m_ThreadPool)
 		{
 			if (registerCallback)
@@ -86,5 +101,93 @@ namespace apollo::asset_ut {
 		CHECK(state == EAssetState::Loaded);
 	}
 
+	ASSET_LOADER_TEST("Load Assets With Dependency")
+	{
+		constexpr uint32 numDependents = 16;
+		Helper helper{ true, 4 };
+		TestAsset dependents[numDependents];
+		AssetRef<TestAsset> dependency{ &helper.m_Dummy };
+		// dependents are queued first, so that most of them have to wait
+		for (TestAsset& asset : dependents)
+		{
+			helper.m_Loader.AddRequest(
+				AssetLoadRequest{
+					AssetRef<IAsset>{ &asset },
+					LoadDependent(dependency),
+					&g_DummyMeta,
+				});
+		}
+		helper.m_Loader.AddRequest(
+			AssetLoadRequest{
+				StaticPointerCast<IAsset>(dependency),
+				LoadDummy(*dependency, g_DummyMeta),
+				&g_DummyMeta,
+			});
+		helper.m_Loader.ProcessRequests();
+		helper.m_Sem.acquire();
+		helper.m_Loader.WaitForCompletion();
+
+		CHECK(dependency->IsLoaded());
+		for (const TestAsset& asset : dependents)
+			CHECK(asset.IsLoaded());
+	}
+
+	ASSET_LOADER_TEST("Nested Loader Jobs Keep The Upload Context")
+	{
+		Helper helper{ true, 2 };
+		TestAsset outer, inner;
+		// stands for the heap of the thread which started waiting, never used to upload anything
+		rdr::UploadHeap outerHeap{ nullptr };
+		bool innerNested = false;
+		bool outerInWait = false;
+		bool contextKept = false;
+
+		const auto loadInner = [&](IAsset&) -> AssetLoadTask
+		{
+			innerNested = outerInWait;
+			co_return true;
+		};
+		const auto loadOuter = [&](IAsset&) -> AssetLoadTask
+		{
+			SDL_GPUCopyPass* const copyPass = AssetLoader::GetCurrentCopyPass();
+			rdr::UploadHeap* const heap = rdr::UploadHeap::GetThreadHeap();
+			rdr::UploadHeap::SetThreadHeap(&outerHeap);
+			const mt::JobHandle job = mt::ParallelFor(helper.m_ThreadPool, 0, 1, [](uint32) {});
+			// pushed last, so the wait below pops it first
+			helper.m_Loader.AddRequest(
+				AssetLoadRequest{ AssetRef<IAsset>{ &inner }, loadInner(inner), &g_DummyMeta });
+			outerInWait = true;
+			job.Wait();
+			outerInWait = false;
+			contextKept = AssetLoader::GetCurrentCopyPass() == copyPass &&
+						  rdr::UploadHeap::GetThreadHeap() == &outerHeap;
+			rdr::UploadHeap::SetThreadHeap(heap);
+			co_return true;
+		};
+
+		// keeps the other worker busy, so that the inner request can't be stolen from the outer
+		// request's worker
+		std::binary_semaphore blockerStarted{ 0 }, releaseBlocker{ 0 };
+		helper.m_ThreadPool.Enqueue(
+			[&]()
+			{
+				blockerStarted.release();
+				releaseBlocker.acquire();
+			});
+		blockerStarted.acquire();
+
+		helper.m_Loader.AddRequest(
+			AssetLoadRequest{ AssetRef<IAsset>{ &outer }, loadOuter(outer), &g_DummyMeta });
+		helper.m_Loader.ProcessRequests();
+		helper.m_Sem.acquire();
+		releaseBlocker.release();
+		helper.m_Loader.WaitForCompletion();
+
+		CHECK(outer.IsLoaded());
+		CHECK(inner.IsLoaded());
+		CHECK(innerNested);
+		CHECK(contextKept);
+	}
+
 #undef ASSET_LOADER_TEST
 } // namespace apollo::asset_ut
\ No newline at end of file
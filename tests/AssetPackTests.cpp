@@ -0,0 +1,156 @@
+#include <asset/AssetPack.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#define ASSET_PACK_TEST(name) TEST_CASE(name, "[asset][asset_pack]")
+
+namespace {
+	using namespace apollo::ulid_literal;
+
+	constexpr apollo::ULID g_Id1 = "01JA0000000000000000000001"_ulid;
+	constexpr apollo::ULID g_Id2 = "01JA0000000000000000000002"_ulid;
+	constexpr apollo::ULID g_Id3 = "01JB0000000000000000000000"_ulid;
+
+	std::span<const std::byte> AsBytes(std::string_view str)
+	{
+		return std::as_bytes(std::span{ str.data(), str.size() });
+	}
+
+	std::string_view AsString(std::span<const std::byte> data)
+	{
+		return { reinterpret_cast<const char*>(data.data()), data.size() };
+	}
+
+	/// Temporary file, deleted on scope exit
+	struct TempFile
+	{
+		explicit TempFile(const char* name)
+			: m_Path((std::filesystem::temp_directory_path() / name).string())
+		{}
+		~TempFile() { std::filesystem::remove(m_Path); }
+
+		std::string m_Path;
+	};
+} // namespace
+
+namespace apollo::ut {
+	ASSET_PACK_TEST("Write and read back")
+	{
+		TempFile file{ "apollo_asset_pack_test.pak" };
+		{
+			AssetPackWriter writer;
+			// added out of order on purpose: the writer has to sort the entries
+			writer.AddAsset(g_Id3, EAssetType::Scene, "scene", AsBytes("{}"));
+			writer.AddAsset(g_Id1, EAssetType::Texture2D, "texture", AsBytes("pixels"));
+			writer.AddAsset(g_Id2, EAssetType::Material, "material", AsBytes("material data"));
+			REQUIRE(writer.Write(file.m_Path));
+		}
+
+		AssetPack pack;
+		REQUIRE(pack.Open(file.m_Path));
+		CHECK(pack.IsOpen());
+		CHECK(pack.GetPath() == file.m_Path);
+
+		const std::span entries = pack.GetEntries();
+		REQUIRE(entries.size() == 3);
+		CHECK(entries[0].m_Id == g_Id1);
+		CHECK(entries[1].m_Id == g_Id2);
+		CHECK(entries[2].m_Id == g_Id3);
+
+		SECTION("Lookup")
+		{
+			const AssetPackEntry* entry = pack.FindEntry(g_Id2);
+			REQUIRE(entry);
+			CHECK(entry->m_Type == EAssetType::Material);
+			CHECK(pack.GetName(*entry) == "material");
+			CHECK(AsString(pack.GetData(*entry)) == "material data");
+
+			entry = pack.FindEntry(g_Id3);
+			REQUIRE(entry);
+			CHECK(entry->m_Type == EAssetType::Scene);
+			CHECK(pack.GetName(*entry) == "scene");
+			CHECK(AsString(pack.GetData(*entry)) == "{}");
+		}
+		SECTION("Missing asset")
+		{
+			CHECK_FALSE(pack.FindEntry("01JA0000000000000000000003"_ulid));
+			CHECK_FALSE(pack.FindEntry(ULID{}));
+		}
+		SECTION("Data alignment")
+		{
+			for (const AssetPackEntry& entry : entries)
+				CHECK(entry.m_Offset % AssetPack::DataAlignment == 0);
+		}
+		SECTION("Move")
+		{
+			AssetPack other = std::move(pack);
+			CHECK_FALSE(pack.IsOpen());
+			REQUIRE(other.IsOpen());
+			CHECK(other.FindEntry(g_Id1));
+		}
+		SECTION("Close")
+		{
+			pack.Close();
+			CHECK_FALSE(pack.IsOpen());
+			CHECK(pack.GetEntries().empty());
+		}
+	}
+
+	ASSET_PACK_TEST("Duplicate IDs")
+	{
+		TempFile file{ "apollo_asset_pack_duplicates.pak" };
+		AssetPackWriter writer;
+		writer.AddAsset(g_Id1, EAssetType::Texture2D, "a", AsBytes("a"));
+		writer.AddAsset(g_Id1, EAssetType::Texture2D, "b", AsBytes("b"));
+		CHECK_FALSE(writer.Write(file.m_Path));
+	}
+
+	ASSET_PACK_TEST("Invalid files")
+	{
+		AssetPack pack;
+		SECTION("Missing file")
+		{
+			CHECK_FALSE(pack.Open("this/file/does/not/exist.pak"));
+		}
+		SECTION("Bad magic")
+		{
+			TempFile file{ "apollo_asset_pack_invalid.pak" };
+			{
+				std::ofstream out{ file.m_Path, std::ios::binary };
+				const char garbage[64] = "definitely not an asset pack";
+				out.write(garbage, sizeof(garbage));
+			}
+			CHECK_FALSE(pack.Open(file.m_Path));
+		}
+		SECTION("Truncated table of contents")
+		{
+			TempFile file{ "apollo_asset_pack_truncated.pak" };
+			{
+				AssetPackHeader header;
+				header.m_NumEntries = 10;
+				header.m_EntriesOffset = sizeof(header);
+				header.m_StringTableOffset = sizeof(header);
+				std::ofstream out{ file.m_Path, std::ios::binary };
+				out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			}
+			CHECK_FALSE(pack.Open(file.m_Path));
+		}
+		SECTION("Offsets wrapping around")
+		{
+			TempFile file{ "apollo_asset_pack_wrapping.pak" };
+			{
+				AssetPackHeader header;
+				header.m_NumEntries = 1;
+				// offset + size overflows to a small value
+				header.m_EntriesOffset = UINT64_MAX - sizeof(AssetPackEntry) + 1;
+				header.m_StringTableOffset = sizeof(header);
+				std::ofstream out{ file.m_Path, std::ios::binary };
+				out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			}
+			CHECK_FALSE(pack.Open(file.m_Path));
+		}
+		CHECK_FALSE(pack.IsOpen());
+	}
+} // namespace apollo::ut
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include <catch2/catch_test_macros.hpp>
+#include <rendering/Batch.hpp>
+
+#define BATCH_TEST(name) TEST_CASE(name, "[batch]")
+
+namespace apollo::rdr::batch_ut {
+	using Range = Batch<uint32>::DirtyRange;
+
+	void Record(Batch<uint32>& batch, uint32 count, auto&& generator)
+	{
+		batch.Clear();
+		batch.StartRecording();
+		for (uint32 i = 0; i < count; ++i)
+			batch.Add(generator(i));
+	}
+
+	BATCH_TEST("Batch dirty ranges")
+	{
+		static constexpr uint32 count = 1000;
+		static constexpr uint32 distance = Batch<uint32>::MergeDistance;
+		Batch<uint32> batch;
+		Record(batch, count, [](uint32 i) { return i; });
+		REQUIRE(batch.GetDirtyRanges().size() == 1);
+		CHECK(batch.GetDirtyRanges()[0].m_First == 0);
+		CHECK(batch.GetDirtyRanges()[0].m_Count == count);
+
+		SECTION("Unchanged")
+		{
+			Record(batch, count, [](uint32 i) { return i; });
+			CHECK(batch.GetDirtyRanges().empty());
+		}
+		SECTION("Sparse changes")
+		{
+			Record(batch, count, [](uint32 i) { return i == 10 || i == 500 ? 0 : i; });
+			REQUIRE(batch.GetDirtyRanges().size() == 2);
+			CHECK(batch.GetDirtyRanges()[0].m_First == 10);
+			CHECK(batch.GetDirtyRanges()[0].m_Count == 1);
+			CHECK(batch.GetDirtyRanges()[1].m_First == 500);
+			CHECK(batch.GetDirtyRanges()[1].m_Count == 1);
+		}
+		SECTION("Close changes are merged")
+		{
+			Record(batch, count, [](uint32 i) { return i == 10 || i == 10 + distance ? 0 : i; });
+			REQUIRE(batch.GetDirtyRanges().size() == 1);
+			CHECK(batch.GetDirtyRanges()[0].m_First == 10);
+			CHECK(batch.GetDirtyRanges()[0].m_Count == distance + 1);
+		}
+		SECTION("Growing")
+		{
+			Record(batch, count + 10, [](uint32 i) { return i; });
+			REQUIRE(batch.GetDirtyRanges().size() == 1);
+			CHECK(batch.GetDirtyRanges()[0].m_First == count);
+			CHECK(batch.GetDirtyRanges()[0].m_Count == 10);
+			for (uint32 i = 0; i < count + 10; ++i)
+				REQUIRE(batch[i] == i);
+		}
+		SECTION("Shrinking then growing")
+		{
+			Record(batch, 100, [](uint32 i) { return i; });
+			CHECK(batch.GetDirtyRanges().empty());
+			// elements past the previous size are always uploaded
+			Record(batch, 200, [](uint32 i) { return i; });
+			REQUIRE(batch.GetDirtyRanges().size() == 1);
+			CHECK(batch.GetDirtyRanges()[0].m_First == 100);
+			CHECK(batch.GetDirtyRanges()[0].m_Count == 100);
+		}
+	}
+
+	BATCH_TEST("Batch manual dirty ranges")
+	{
+		Batch<uint32> batch;
+		batch.MarkDirty(100, 10);
+		batch.MarkDirty(500, 10);
+		REQUIRE(batch.GetDirtyRanges().size() == 2);
+
+		// overlaps both ranges, which get merged
+		batch.MarkDirty(0, 505);
+		REQUIRE(batch.GetDirtyRanges().size() == 1);
+		CHECK(batch.GetDirtyRanges()[0].m_First == 0);
+		CHECK(batch.GetDirtyRanges()[0].m_Count == 510);
+
+		batch.MarkDirty(2000, 0);
+		CHECK(batch.GetDirtyRanges().size() == 1);
+	}
+} // namespace apollo::rdr::batch_ut
\ No newline at end of file
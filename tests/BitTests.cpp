@@ -1,6 +1,7 @@
 #include <catch2/catch_test_macros.hpp>
 #include <core/Bit.hpp>
 #include <format>
+#include <random>
 
 #define BIT_TEST(name) TEST_CASE(name, "[bits]")
 
@@ -133,4 +134,80 @@ namespace apollo::bitspan_ut {
 		span[7] = false;
 		CHECK(!span[7]);
 	}
+	BIT_TEST("Set and clear bit ranges")
+	{
+		uint64 words[3] = {};
+		SetBits(words, 60, 72);
+		CHECK(words[0] == 0xf000000000000000);
+		CHECK(words[1] == ~0ull);
+		CHECK(words[2] == 0xf);
+
+		ClearBits(words, 62, 64);
+		CHECK(words[0] == 0x3000000000000000);
+		CHECK(words[1] == 0xc000000000000000);
+		CHECK(words[2] == 0xf);
+	}
+
+	BIT_TEST("Find bit")
+	{
+		static constexpr uint64 words[3] = { ~0ull, ~0ull ^ (1ull << 40), 1ull << 3 };
+		static_assert(FindBit(words, 0, 192, false) == 104);
+		static_assert(FindBit(words, 105, 192, false) == 128);
+		static_assert(FindBit(words, 64, 100, false) == 100);
+		static_assert(FindBit(words, 128, 192, true) == 131);
+		static_assert(FindBit(words, 132, 192, true) == 192);
+	}
+
+	BIT_TEST("Find cleared bit runs")
+	{
+		// every other bit set, except for a run of 5 straddling the first two words
+		uint64 words[4] = {};
+		for (size_t i = 0; i < 256; i += 2)
+			SetBits(words, i, 1);
+		ClearBits(words, 61, 5);
+
+		CHECK(FindZeroRun(words, 0, 256, 1) == 1);
+		CHECK(FindZeroRun(words, 0, 256, 2) == 61);
+		CHECK(FindZeroRun(words, 0, 256, 5) == 61);
+		CHECK(FindZeroRun(words, 0, 256, 6) == 256);
+		CHECK(FindZeroRun(words, 62, 256, 4) == 62);
+		CHECK(FindZeroRun(words, 0, 64, 3) == 61);
+		CHECK(FindZeroRun(words, 0, 64, 4) == 64);
+
+		SECTION("Runs across whole words")
+		{
+			// bit 99 was already cleared
+			ClearBits(words, 100, 156);
+			CHECK(FindZeroRun(words, 0, 256, 6) == 99);
+			CHECK(FindZeroRun(words, 0, 256, 157) == 99);
+			CHECK(FindZeroRun(words, 0, 255, 157) == 255);
+		}
+	}
+	BIT_TEST("Find cleared bit runs in random bitmaps")
+	{
+		std::mt19937_64 rng{ 42 };
+		uint64 words[8];
+		bool ok = true;
+		for (uint32 round = 0; round < 1000; ++round)
+		{
+			// sparse bitmaps have long runs, dense ones have short runs
+			for (uint64& word : words)
+				word = round % 2 ? rng() & rng() & rng() : rng() | rng();
+			const size_t begin = rng() % 100;
+			const size_t n = rng() % 150 + 1;
+
+			size_t expected = 512;
+			for (size_t i = begin, length = 0; i < 512; ++i)
+			{
+				length = (words[i / 64] >> (i % 64)) & 1 ? 0 : length + 1;
+				if (length == n)
+				{
+					expected = i + 1 - n;
+					break;
+				}
+			}
+			ok = ok && FindZeroRun(words, begin, 512, n) == expected;
+		}
+		CHECK(ok);
+	}
 } // namespace apollo::bitspan_ut
\ No newline at end of file
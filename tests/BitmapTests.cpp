@@ -1,5 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <limits>
+#include <random>
 #include <rendering/Bitmap.hpp>
+#include <vector>
 
 namespace apollo::rdr::bitmap_ut {
 #define BITMAP_TEST(name) TEST_CASE(name, "[bitmap]")
@@ -93,4 +97,57 @@ namespace apollo::rdr::bitmap_ut {
 			}
 		}
 	}
+
+	BITMAP_TEST("Float to RGBA8 conversion")
+	{
+		const auto expected = [](float x)
+		{
+			return std::isnan(x) ? uint8(0) : uint8(std::nearbyint(255.0f * Clamp(x, 0.0f, 1.0f)));
+		};
+
+		// out of range values, NaN, exact ties, and a pixel count which isn't a multiple of 4
+		constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+		std::vector<RGBAPixel<float>> in{
+			{ -1.0f, 0.0f, 1.0f, 2.0f },
+			{ nan, 0.25f, -nan, 0.75f },
+			{ 0.5f / 255, 1.5f / 255, 254.5f / 255, 0.5f },
+			{ 1e-8f, 0.99999f, -0.0f, 1e30f },
+		};
+		std::mt19937 rng{ 42 };
+		std::uniform_real_distribution<float> dist{ -0.1f, 1.1f };
+		for (uint32 i = 0; i < 1000; ++i)
+			in.push_back({ dist(rng), dist(rng), dist(rng), dist(rng) });
+
+		for (const size_t count : { size_t(0), size_t(3), size_t(4), in.size() })
+		{
+			std::vector<RGBA8Pixel> out(count + 1, RGBA8Pixel{ 1, 2, 3, 4 });
+			ConvertToRGBA8({ in.data(), count }, out.data());
+			bool ok = true;
+			for (size_t i = 0; i < count; ++i)
+			{
+				ok = ok && out[i] == RGBA8Pixel{
+					expected(in[i].r),
+					expected(in[i].g),
+					expected(in[i].b),
+					expected(in[i].a),
+				};
+			}
+			CHECK(ok);
+			// nothing is written past the end
+			CHECK(out[count] == RGBA8Pixel{ 1, 2, 3, 4 });
+		}
+
+		// the first pixels go through the scalar path, the following ones through the SIMD path
+		// when available
+		for (const size_t count : { size_t(3), size_t(4) })
+		{
+			std::vector<RGBA8Pixel> out(count);
+			ConvertToRGBA8({ in.data(), count }, out.data());
+			CHECK(out[1] == RGBA8Pixel{ 0, 64, 0, 191 });
+			// ties round to even
+			CHECK(out[2].r == 0);
+			CHECK(out[2].g == 2);
+			CHECK(out[2].b == 254);
+		}
+	}
 } // namespace apollo::rdr::bitmap_ut
\ No newline at end of file
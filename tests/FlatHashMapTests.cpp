@@ -0,0 +1,227 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <core/Hash.hpp>
+#include <core/HashedString.hpp>
+#include <core/Map.hpp>
+#include <core/ULID.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define FLAT_MAP_TEST(name) TEST_CASE(name, "[flat_hash_map][containers]")
+
+namespace {
+	/// Sends every key to the same probe sequence, to exercise collision handling
+	struct CollidingHash
+	{
+		uint64 operator()(uint32) const noexcept { return 0; }
+	};
+
+	/// Counts live instances, to check that every value gets destroyed exactly once
+	struct Counted
+	{
+		static inline int32 s_Count = 0;
+
+		Counted() { ++s_Count; }
+		Counted(const Counted&) { ++s_Count; }
+		Counted(Counted&&) noexcept { ++s_Count; }
+		~Counted() { --s_Count; }
+	};
+} // namespace
+
+namespace apollo::containers::ut {
+	FLAT_MAP_TEST("Empty FlatHashMap")
+	{
+		const HashMap<uint32, uint32> map;
+		CHECK(map.empty());
+		CHECK(map.size() == 0);
+		CHECK(map.capacity() == 0);
+		CHECK(map.begin() == map.end());
+		CHECK(map.find(0) == map.end());
+		CHECK_FALSE(map.contains(0));
+	}
+
+	FLAT_MAP_TEST("FlatHashMap insertion and lookup")
+	{
+		HashMap<uint32, std::string> map;
+		const auto [it, inserted] = map.try_emplace(1u, "one");
+		CHECK(inserted);
+		CHECK(it->first == 1);
+		CHECK(it->second == "one");
+
+		const auto res = map.try_emplace(1u, "uno");
+		CHECK_FALSE(res.second);
+		CHECK(res.first->second == "one");
+
+		map.emplace(2u, "two");
+		map[3] = "three";
+		CHECK(map.size() == 3);
+		CHECK(map.at(2) == "two");
+		CHECK(map.at(3) == "three");
+		CHECK_THROWS_AS(map.at(4), std::out_of_range);
+		CHECK(map.count(1) == 1);
+		CHECK(map.count(4) == 0);
+	}
+
+	FLAT_MAP_TEST("FlatHashMap growth")
+	{
+		constexpr uint32 n = 10000;
+		HashMap<uint32, uint32> map;
+		for (uint32 i = 0; i < n; ++i)
+			map.try_emplace(i, 2 * i);
+		REQUIRE(map.size() == n);
+		CHECK(map.size() <= map.capacity() - map.capacity() / 8);
+
+		bool ok = true;
+		for (uint32 i = 0; i < n; ++i)
+		{
+			const auto it = map.find(i);
+			ok = ok && it != map.end() && it->second == 2 * i;
+		}
+		CHECK(ok);
+		CHECK(map.find(n) == map.end());
+
+		std::vector<bool> visited(n, false);
+		for (const auto& [key, value] : map)
+			visited[key] = true;
+		CHECK(std::find(visited.begin(), visited.end(), false) == visited.end());
+	}
+
+	FLAT_MAP_TEST("FlatHashMap erasure")
+	{
+		HashMap<uint32, uint32> map;
+		for (uint32 i = 0; i < 1000; ++i)
+			map.try_emplace(i, i);
+
+		SECTION("By key")
+		{
+			for (uint32 i = 0; i < 1000; i += 2)
+				CHECK(map.erase(i) == 1);
+			CHECK(map.erase(0) == 0);
+			CHECK(map.size() == 500);
+
+			bool ok = true;
+			for (uint32 i = 0; i < 1000; ++i)
+				ok = ok && map.contains(i) == bool(i % 2);
+			CHECK(ok);
+		}
+		SECTION("While iterating")
+		{
+			for (auto it = map.begin(); it != map.end();)
+			{
+				if (it->first % 3)
+					it = map.erase(it);
+				else
+					++it;
+			}
+			CHECK(map.size() == 334);
+			for (const auto& [key, value] : map)
+				CHECK(key % 3 == 0);
+		}
+		SECTION("Reuse erased slots")
+		{
+			const size_t capacity = map.capacity();
+			for (uint32 round = 0; round < 100; ++round)
+			{
+				for (uint32 i = 0; i < 1000; ++i)
+					map.erase(i);
+				for (uint32 i = 0; i < 1000; ++i)
+					map.try_emplace(i, round);
+			}
+			CHECK(map.size() == 1000);
+			CHECK(map.capacity() == capacity);
+			CHECK(map.at(999) == 99);
+		}
+	}
+
+	FLAT_MAP_TEST("FlatHashMap collisions")
+	{
+		FlatHashMap<uint32, uint32, CollidingHash> map;
+		for (uint32 i = 0; i < 100; ++i)
+			map.try_emplace(i, i);
+		for (uint32 i = 0; i < 100; i += 2)
+			map.erase(i);
+
+		bool ok = true;
+		for (uint32 i = 0; i < 100; ++i)
+			ok = ok && (map.find(i) != map.end()) == bool(i % 2);
+		CHECK(ok);
+
+		map.try_emplace(0u, 42u);
+		CHECK(map.at(0) == 42);
+		CHECK(map.size() == 51);
+	}
+
+	FLAT_MAP_TEST("FlatHashMap object lifetimes")
+	{
+		Counted::s_Count = 0;
+		{
+			HashMap<uint32, Counted> map;
+			for (uint32 i = 0; i < 100; ++i)
+				map.try_emplace(i);
+			CHECK(Counted::s_Count == 100);
+
+			map.erase(0);
+			CHECK(Counted::s_Count == 99);
+
+			HashMap<uint32, Counted> copy{ map };
+			CHECK(Counted::s_Count == 198);
+
+			copy.clear();
+			CHECK(copy.empty());
+			CHECK(Counted::s_Count == 99);
+		}
+		CHECK(Counted::s_Count == 0);
+	}
+
+	FLAT_MAP_TEST("FlatHashMap copy and move")
+	{
+		HashMap<uint32, std::unique_ptr<uint32>> map;
+		map.try_emplace(1u, std::make_unique<uint32>(1));
+		map.try_emplace(2u, std::make_unique<uint32>(2));
+
+		HashMap<uint32, std::unique_ptr<uint32>> moved{ std::move(map) };
+		CHECK(map.empty());
+		REQUIRE(moved.size() == 2);
+		CHECK(*moved.at(2) == 2);
+
+		map = std::move(moved);
+		CHECK(moved.empty());
+		CHECK(*map.at(1) == 1);
+
+		HashMap<uint32, uint32> a{ { 1, 10 }, { 2, 20 } };
+		HashMap<uint32, uint32> b;
+		b = a;
+		a[1] = 0;
+		CHECK(b.at(1) == 10);
+		CHECK(b.at(2) == 20);
+	}
+
+	FLAT_MAP_TEST("FlatHashMap engine keys")
+	{
+		const ULIDMap<uint32> ids{
+			{ ULID{ 0x018f2cc2f910, 0xffc6, 0xa32afbe92dec762c }, 1 },
+			{ ULID{ 0x018f2cc2f910, 0xffc6, 0xa32afbe92dec762d }, 2 },
+		};
+		CHECK(ids.at(ULID{ 0x018f2cc2f910, 0xffc6, 0xa32afbe92dec762d }) == 2);
+
+		const HashedStringMap<uint32> strings{
+			{ HashedString{ "foo" }, 1 },
+			{ HashedString{ "bar" }, 2 },
+		};
+		CHECK(strings.at("foo") == 1);
+		CHECK(strings.at(std::string_view{ "bar" }) == 2);
+		CHECK_FALSE(strings.contains("baz"));
+	}
+
+	FLAT_MAP_TEST("FlatHashMap reserve")
+	{
+		HashMap<uint32, uint32> map;
+		map.reserve(1000);
+		const size_t capacity = map.capacity();
+		CHECK(capacity - capacity / 8 >= 1000);
+		for (uint32 i = 0; i < 1000; ++i)
+			map.try_emplace(i, i);
+		CHECK(map.capacity() == capacity);
+	}
+} // namespace apollo::containers::ut
\ No newline at end of file
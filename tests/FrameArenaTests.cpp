@@ -0,0 +1,120 @@
+#include <catch2/catch_test_macros.hpp>
+#include <core/Memory.hpp>
+#include <memory_resource>
+#include <set>
+#include <thread>
+#include <vector>
+
+#define FRAME_ARENA_TEST(name) TEST_CASE(name, "[frame_arena]")
+
+namespace apollo::frame_arena_ut {
+	FRAME_ARENA_TEST("Frame arena linear allocation")
+	{
+		FrameArena arena{ 2, 1024 };
+		std::byte* const a = static_cast<std::byte*>(arena.allocate(16, 8));
+		std::byte* const b = static_cast<std::byte*>(arena.allocate(24, 8));
+		CHECK(b == a + 16);
+		CHECK(arena.GetUsedSize() == 40);
+
+		void* const aligned = arena.allocate(1, 64);
+		CHECK(reinterpret_cast<uintptr_t>(aligned) % 64 == 0);
+
+		// deallocating does nothing
+		arena.deallocate(b, 24, 8);
+		CHECK(arena.allocate(8, 8) != b);
+	}
+
+	FRAME_ARENA_TEST("Frame arena buffers reuse")
+	{
+		AllocationTracker<> tracker{ *std::pmr::new_delete_resource() };
+		{
+			FrameArena arena{ 3, 1024, &tracker };
+			CHECK(arena.GetFrameIndex() == 0);
+			void* const first = arena.allocate(32, 8);
+			const size_t allocated = tracker.GetAllocatedSize();
+
+			// the other frames get their own blocks...
+			for (uint32 i = 1; i < 3; ++i)
+			{
+				arena.NextFrame();
+				CHECK(arena.GetFrameIndex() == i);
+				CHECK(arena.GetUsedSize() == 0);
+				CHECK(arena.allocate(32, 8) != first);
+			}
+			CHECK(tracker.GetAllocatedSize() == 3 * allocated);
+
+			// ...and once we're back to the first frame, its memory gets reused
+			arena.NextFrame();
+			CHECK(arena.GetFrameIndex() == 0);
+			CHECK(arena.GetUsedSize() == 0);
+			CHECK(arena.allocate(32, 8) == first);
+			CHECK(tracker.GetAllocatedSize() == 3 * allocated);
+		}
+		CHECK(tracker.GetAllocatedSize() == 0);
+	}
+
+	FRAME_ARENA_TEST("Frame arena big allocations")
+	{
+		FrameArena arena{ 1, 256 };
+		std::byte* const small = static_cast<std::byte*>(arena.allocate(200, 8));
+		std::byte* const big = static_cast<std::byte*>(arena.allocate(1000, 8));
+		CHECK((big + 1000 <= small || big >= small + 200));
+		CHECK(arena.GetUsedSize() >= 1200);
+
+		// both blocks are kept, and used again in the same order
+		arena.NextFrame();
+		CHECK(arena.allocate(200, 8) == small);
+		CHECK(arena.allocate(1000, 8) == big);
+	}
+
+	FRAME_ARENA_TEST("Frame arena per-thread sub-arenas")
+	{
+		constexpr uint32 numThreads = 4;
+		constexpr uint32 numAllocations = 1000;
+		FrameArena arena{ 2, 4096 };
+		std::vector<std::vector<uint32*>> allocations(numThreads);
+		std::vector<std::thread> threads;
+		for (uint32 i = 0; i < numThreads; ++i)
+		{
+			threads.emplace_back(
+				[&, i]()
+				{
+					for (uint32 j = 0; j < numAllocations; ++j)
+					{
+						void* const mem = arena.allocate(sizeof(uint32), alignof(uint32));
+						uint32* const ptr = static_cast<uint32*>(mem);
+						*ptr = i;
+						allocations[i].emplace_back(ptr);
+					}
+				});
+		}
+		for (std::thread& th : threads)
+			th.join();
+
+		CHECK(arena.GetUsedSize() == numThreads * numAllocations * sizeof(uint32));
+		std::set<uint32*> unique;
+		bool ok = true;
+		for (uint32 i = 0; i < numThreads; ++i)
+		{
+			for (uint32* ptr : allocations[i])
+			{
+				ok = ok && *ptr == i;
+				unique.insert(ptr);
+			}
+		}
+		CHECK(ok);
+		CHECK(unique.size() == numThreads * numAllocations);
+	}
+
+	FRAME_ARENA_TEST("Frame arena with std::pmr containers")
+	{
+		FrameArena arena{ 2, 1024 };
+		std::pmr::vector<uint32> vec{ arena.GetPolymorphicAllocator<uint32>() };
+		for (uint32 i = 0; i < 1000; ++i)
+			vec.emplace_back(i);
+		CHECK(vec.size() == 1000);
+		CHECK(vec[999] == 999);
+	}
+} // namespace apollo::frame_arena_ut
+
+#undef FRAME_ARENA_TEST
\ No newline at end of file
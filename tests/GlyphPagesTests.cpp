@@ -0,0 +1,107 @@
+#include <catch2/catch_test_macros.hpp>
+#include <rendering/text/GlyphPages.hpp>
+
+#define GLYPH_PAGES_TEST(name) TEST_CASE(name, "[glyph_pages]")
+
+namespace apollo::rdr::txt::glyph_pages_ut {
+	[[nodiscard]] bool Overlap(const RectU32& a, const RectU32& b)
+	{
+		return a.x0 < b.x1 && b.x0 < a.x1 && a.y0 < b.y1 && b.y0 < a.y1;
+	}
+
+	GLYPH_PAGES_TEST("Glyph page shelf packing")
+	{
+		GlyphPageAllocator allocator{ 1, 64 };
+
+		const auto a = allocator.Allocate(20, 10);
+		REQUIRE(a);
+		CHECK(a->m_Page == 0);
+		CHECK(a->m_Rect == RectU32{ 0, 0, 20, 10 });
+		CHECK(a->m_EvictedPage == GlyphPageAllocator::NoPage);
+
+		// same shelf, with a margin
+		const auto b = allocator.Allocate(20, 8);
+		REQUIRE(b);
+		CHECK(b->m_Rect == RectU32{ 21, 0, 41, 8 });
+
+		// too tall for the first shelf
+		const auto c = allocator.Allocate(10, 16);
+		REQUIRE(c);
+		CHECK(c->m_Rect == RectU32{ 0, 11, 10, 27 });
+
+		// doesn't fit on the first shelf's remaining width
+		const auto d = allocator.Allocate(30, 10);
+		REQUIRE(d);
+		CHECK(d->m_Rect.y0 == 11);
+
+		CHECK_FALSE(Overlap(a->m_Rect, b->m_Rect));
+		CHECK_FALSE(Overlap(c->m_Rect, d->m_Rect));
+		CHECK(allocator.GetStats().m_NumAllocations == 4);
+
+		CHECK_FALSE(allocator.Allocate(64, 1));
+		CHECK(allocator.GetStats().m_NumFailures == 1);
+	}
+
+	GLYPH_PAGES_TEST("Glyph pages evict the least recently used page")
+	{
+		GlyphPageAllocator allocator{ 3, 32 };
+
+		// fill each page with a single glyph, one frame each
+		for (uint32 i = 0; i < 3; ++i)
+		{
+			const auto a = allocator.Allocate(31, 31);
+			REQUIRE(a);
+			CHECK(a->m_EvictedPage == GlyphPageAllocator::NoPage);
+			allocator.NextFrame();
+		}
+
+		SECTION("Oldest page")
+		{
+			const auto a = allocator.Allocate(16, 16);
+			REQUIRE(a);
+			CHECK(a->m_Page == 0);
+			CHECK(a->m_EvictedPage == a->m_Page);
+			CHECK(allocator.GetGeneration(a->m_Page) == 1);
+			CHECK(a->m_Rect == RectU32{ 0, 0, 16, 16 });
+			CHECK(allocator.GetStats().m_NumEvictions == 1);
+
+			// the rest of the fresh page is used before evicting anything else
+			const auto b = allocator.Allocate(8, 8);
+			REQUIRE(b);
+			CHECK(b->m_Page == a->m_Page);
+			CHECK(allocator.GetStats().m_NumEvictions == 1);
+		}
+		SECTION("Touched pages are kept")
+		{
+			// page 0 is the oldest, but it is used during this frame
+			allocator.Touch(0);
+			const auto a = allocator.Allocate(31, 31);
+			REQUIRE(a);
+			CHECK(a->m_EvictedPage == 1);
+			CHECK(allocator.GetGeneration(0) == 0);
+		}
+	}
+
+	GLYPH_PAGES_TEST("Glyph pages used during the current frame are never evicted")
+	{
+		GlyphPageAllocator allocator{ 2, 32 };
+
+		REQUIRE(allocator.Allocate(31, 31));
+		REQUIRE(allocator.Allocate(31, 31));
+		CHECK_FALSE(allocator.Allocate(31, 31));
+		CHECK(allocator.GetStats().m_NumEvictions == 0);
+		CHECK(allocator.GetStats().m_NumFailures == 1);
+
+		allocator.NextFrame();
+		allocator.Touch(0);
+		allocator.Touch(1);
+		CHECK_FALSE(allocator.Allocate(31, 31));
+
+		allocator.NextFrame();
+		allocator.Touch(1);
+		const auto a = allocator.Allocate(31, 31);
+		REQUIRE(a);
+		CHECK(a->m_Page == 0);
+		CHECK(a->m_EvictedPage == 0);
+	}
+} // namespace apollo::rdr::txt::glyph_pages_ut
\ No newline at end of file
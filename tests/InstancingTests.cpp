@@ -0,0 +1,92 @@
+#include <catch2/catch_test_macros.hpp>
+#include <rendering/Instancing.hpp>
+#include <rendering/Material.hpp>
+#include <rendering/Mesh.hpp>
+
+#define INSTANCING_TEST(name) TEST_CASE(name, "[instancing]")
+
+namespace apollo::rdr::instancing_ut {
+	// Only used as keys: assets can't be created without a rendering context
+	template <class T>
+	const T& FakeAsset(uint32 i)
+	{
+		alignas(T) static std::byte storage[2 * sizeof(T)];
+		return *reinterpret_cast<const T*>(storage + i * sizeof(T));
+	}
+
+	INSTANCING_TEST("Instances sharing a mesh and material are grouped")
+	{
+		InstanceBatcher<uint32> batcher;
+		const Mesh& meshA = FakeAsset<Mesh>(0);
+		const Mesh& meshB = FakeAsset<Mesh>(1);
+		const MaterialInstance& matA = FakeAsset<MaterialInstance>(0);
+		const MaterialInstance& matB = FakeAsset<MaterialInstance>(1);
+
+		batcher.Add(meshA, matA, 10, 0);
+		batcher.Add(meshB, matA, 20, 1);
+		batcher.Add(meshA, matA, 5, 2);
+		batcher.Add(meshA, matB, 30, 3);
+		batcher.Add(meshB, matA, 25, 4);
+		batcher.Add(meshA, matA, 15, 5);
+
+		const auto groups = batcher.GetGroups();
+		REQUIRE(groups.size() == 3);
+		CHECK(groups[0].m_Mesh == &meshA);
+		CHECK(groups[0].m_Material == &matA);
+		CHECK(groups[0].m_Key == 5);
+		CHECK(groups[0].m_NumInstances == 3);
+		CHECK(groups[1].m_Mesh == &meshB);
+		CHECK(groups[1].m_Key == 20);
+		CHECK(groups[1].m_NumInstances == 2);
+		CHECK(groups[2].m_Material == &matB);
+		CHECK(groups[2].m_NumInstances == 1);
+
+		Batch<uint32> batch;
+		batcher.Pack(batch);
+		REQUIRE(batch.GetCount() == 6);
+		CHECK(groups[0].m_FirstInstance == 0);
+		CHECK(groups[1].m_FirstInstance == 3);
+		CHECK(groups[2].m_FirstInstance == 5);
+
+		// instances are contiguous per group, in insertion order
+		const uint32 expected[] = { 0, 2, 5, 1, 4, 3 };
+		for (uint32 i = 0; i < 6; ++i)
+			CHECK(batch[i] == expected[i]);
+	}
+
+	INSTANCING_TEST("Single instances are never grouped")
+	{
+		InstanceBatcher<uint32> batcher;
+		const Mesh& mesh = FakeAsset<Mesh>(0);
+		const MaterialInstance& mat = FakeAsset<MaterialInstance>(0);
+
+		batcher.AddSingle(mesh, mat, 2, 0);
+		batcher.Add(mesh, mat, 3, 1);
+		batcher.AddSingle(mesh, mat, 1, 2);
+		batcher.Add(mesh, mat, 4, 3);
+
+		const auto groups = batcher.GetGroups();
+		REQUIRE(groups.size() == 3);
+		CHECK(groups[0].m_NumInstances == 1);
+		CHECK(groups[1].m_NumInstances == 2);
+		CHECK(groups[2].m_NumInstances == 1);
+		CHECK(groups[2].m_Key == 1);
+
+		Batch<uint32> batch;
+		batcher.Pack(batch);
+		const uint32 expected[] = { 0, 1, 3, 2 };
+		for (uint32 i = 0; i < 4; ++i)
+			CHECK(batch[i] == expected[i]);
+
+		SECTION("Clear")
+		{
+			batcher.Clear();
+			CHECK(batcher.GetGroups().empty());
+			batcher.Add(mesh, mat, 0, 42);
+			batcher.Pack(batch);
+			REQUIRE(batcher.GetGroups().size() == 1);
+			REQUIRE(batch.GetCount() == 1);
+			CHECK(batch[0] == 42);
+		}
+	}
+} // namespace apollo::rdr::instancing_ut
\ No newline at end of file
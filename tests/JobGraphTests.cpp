@@ -0,0 +1,235 @@
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <core/JobGraph.hpp>
+#include <semaphore>
+#include <vector>
+
+#define JOB_GRAPH_TEST(name) TEST_CASE(name, "[mt][job_graph]")
+
+namespace apollo::mt::ut {
+	JOB_GRAPH_TEST("Schedule")
+	{
+		ThreadPool tp{ 2 };
+		SECTION("Null handle")
+		{
+			JobHandle handle;
+			CHECK_FALSE(handle);
+			CHECK(handle.IsDone());
+			handle.Wait();
+		}
+		SECTION("Single job")
+		{
+			bool result = false;
+			JobHandle handle = Schedule(
+				tp,
+				[&]()
+				{
+					result = true;
+				});
+			REQUIRE(handle);
+			handle.Wait();
+			CHECK(handle.IsDone());
+			CHECK(result);
+		}
+		SECTION("Dependencies")
+		{
+			std::atomic_uint32_t counter = 0;
+			uint32 observed = 0;
+			JobHandle a = Schedule(
+				tp,
+				[&]()
+				{
+					++counter;
+				});
+			JobHandle b = Schedule(
+				tp,
+				[&]()
+				{
+					++counter;
+				});
+			JobHandle c = Schedule(
+				tp,
+				[&]()
+				{
+					observed = counter;
+				},
+				{ a, b });
+			c.Wait();
+			CHECK(a.IsDone());
+			CHECK(b.IsDone());
+			CHECK(observed == 2);
+		}
+	}
+
+	JOB_GRAPH_TEST("Continuations")
+	{
+		ThreadPool tp{ 2 };
+		std::vector<uint32> order;
+		JobHandle handle = Schedule(
+							   tp,
+							   [&]()
+							   {
+								   order.push_back(0);
+							   })
+							   .Then(
+								   [&]()
+								   {
+									   order.push_back(1);
+								   })
+							   .Then(
+								   [&]()
+								   {
+									   order.push_back(2);
+								   });
+		handle.Wait();
+		CHECK(order == std::vector<uint32>{ 0, 1, 2 });
+	}
+
+	JOB_GRAPH_TEST("Stopped pool")
+	{
+		ThreadPool tp{ 1 };
+		bool result = false;
+		SECTION("Scheduled after Stop")
+		{
+			tp.Stop();
+			const JobHandle handle = Schedule(
+				tp,
+				[&]()
+				{
+					result = true;
+				});
+			CHECK(handle.IsDone());
+		}
+		SECTION("Left behind by Stop")
+		{
+			std::binary_semaphore started{ 0 }, release{ 0 };
+			tp.Enqueue(
+				[&]()
+				{
+					started.release();
+					release.acquire();
+				});
+			started.acquire();
+			const JobHandle handle = Schedule(
+				tp,
+				[&]()
+				{
+					result = true;
+				});
+			tp.Stop();
+			release.release();
+			handle.Wait();
+		}
+		CHECK(result);
+	}
+
+	JOB_GRAPH_TEST("WhenAll")
+	{
+		ThreadPool tp{ 4 };
+		SECTION("Empty")
+		{
+			JobHandle handle = WhenAll(tp, std::span<const JobHandle>{});
+			CHECK(handle.IsDone());
+		}
+		SECTION("Many jobs")
+		{
+			constexpr uint32 jobCount = 100;
+			std::atomic_uint32_t counter = 0;
+			std::vector<JobHandle> jobs;
+			for (uint32 i = 0; i < jobCount; ++i)
+			{
+				jobs.emplace_back(Schedule(
+					tp,
+					[&]()
+					{
+						++counter;
+					}));
+			}
+			WhenAll(tp, jobs).Wait();
+			CHECK(counter == jobCount);
+		}
+	}
+
+	JOB_GRAPH_TEST("ParallelFor")
+	{
+		ThreadPool tp{ 4 };
+		SECTION("Empty range")
+		{
+			bool called = false;
+			ParallelFor(
+				tp,
+				4,
+				4,
+				[&](uint32)
+				{
+					called = true;
+				})
+				.Wait();
+			CHECK_FALSE(called);
+		}
+		SECTION("Per-index body")
+		{
+			std::vector<uint32> values(10000, 0);
+			ParallelFor(
+				tp,
+				0,
+				NumCast<uint32>(values.size()),
+				[&](uint32 i)
+				{
+					values[i] += i;
+				})
+				.Wait();
+
+			bool ok = true;
+			for (uint32 i = 0; i < values.size(); ++i)
+				ok = ok && (values[i] == i);
+			CHECK(ok);
+		}
+		SECTION("Chunked body")
+		{
+			constexpr uint32 minChunkSize = 16;
+			std::atomic_uint32_t total = 0;
+			std::atomic_bool chunksOk = true;
+			ParallelFor(
+				tp,
+				10,
+				1010,
+				[&](uint32 first, uint32 last)
+				{
+					if (first < 10 || last > 1010 || (last - first) < minChunkSize)
+					{
+						// only the very last chunk may be smaller than the minimum size
+						if (last != 1010)
+							chunksOk = false;
+					}
+					total += last - first;
+				},
+				minChunkSize)
+				.Wait();
+			CHECK(total == 1000);
+			CHECK(chunksOk);
+		}
+		SECTION("Nested waits")
+		{
+			std::atomic_uint32_t counter = 0;
+			ParallelFor(
+				tp,
+				0,
+				8,
+				[&](uint32)
+				{
+					ParallelFor(
+						tp,
+						0,
+						100,
+						[&](uint32)
+						{
+							++counter;
+						})
+						.Wait();
+				})
+				.Wait();
+			CHECK(counter == 800);
+		}
+	}
+} // namespace apollo::mt::ut
\ No newline at end of file
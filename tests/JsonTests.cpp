@@ -1,5 +1,6 @@
 #include <catch2/catch_test_macros.hpp>
 #include <core/Json.hpp>
+#include <core/JsonStream.hpp>
 #include <glm/glm.hpp>
 
 #define JSON_TEST(name) TEST_CASE(name, "[json]")
@@ -219,6 +220,74 @@ namespace apollo::json::ut {
 		}
 	}
 
+	JSON_TEST("Stream parser")
+	{
+		constexpr std::string_view doc = R"({
+			"name": "doc",
+			"items": [ { "val1": 1, "val2": "a" }, { "val2": "b" }, 3, [ 4 ] ],
+			"nested": { "items": [ 5 ] },
+			"notArray": { "x": 6 }
+		})";
+
+		StreamParser parser;
+		std::vector<nlohmann::json> items;
+		S1 first;
+		parser.StreamArray(
+			"items",
+			[&](const nlohmann::json& element)
+			{
+				// elements are destroyed once the callback returns: val2 doesn't outlive it
+				if (items.empty())
+				{
+					CHECK(Converter<S1>::FromJson(first, element));
+					CHECK((first.val2 == "a"));
+				}
+				items.emplace_back(element);
+				return true;
+			});
+		uint32 numCalls = 0;
+		parser.StreamArray(
+			"notArray",
+			[&](const nlohmann::json&)
+			{
+				++numCalls;
+				return true;
+			});
+		REQUIRE(parser.Parse(doc));
+
+		REQUIRE(items.size() == 4);
+		CHECK(first.val1 == 1);
+		CHECK(items[1] == nlohmann::json{ { "val2", "b" } });
+		CHECK(items[2] == 3);
+		CHECK(items[3] == nlohmann::json::array({ 4 }));
+
+		// the rest of the document is kept, and only the top level array is streamed
+		const nlohmann::json& root = parser.GetRoot();
+		CHECK(root["name"] == "doc");
+		CHECK(root["items"] == nlohmann::json::array());
+		CHECK(root["nested"]["items"] == nlohmann::json::array({ 5 }));
+		CHECK(root["notArray"]["x"] == 6);
+		CHECK(numCalls == 0);
+	}
+
+	JSON_TEST("Stream parser errors")
+	{
+		StreamParser parser;
+		uint32 numCalls = 0;
+		parser.StreamArray(
+			"items",
+			[&](const nlohmann::json&)
+			{
+				return ++numCalls < 2;
+			});
+		CHECK_FALSE(parser.Parse(R"({ "items": [ 1, 2, 3 ] })"));
+		CHECK(numCalls == 2);
+
+		numCalls = 0;
+		CHECK_FALSE(parser.Parse(R"({ "items": [ 1, )"));
+		CHECK(numCalls == 1);
+	}
+
 	static_assert(std::is_convertible_v<glm::vec1, nlohmann::json>);
 	static_assert(std::is_convertible_v<glm::vec2, nlohmann::json>);
 	static_assert(std::is_convertible_v<glm::vec3, nlohmann::json>);
@@ -1,5 +1,11 @@
 #include <PCH.hpp>
+#include <algorithm>
 #include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <core/Transform.hpp>
+#include <limits>
+#include <random>
+#include <vector>
 
 #define MATH_TEST(name) TEST_CASE(name, "[math]")
 
@@ -28,4 +34,55 @@ namespace apollo::math_ut {
 		static_assert(MapRange(2, 1, 3, 0, 1) == 0.5f);
 		static_assert(MapRange(3, 1, 3, 0, 1) == 1);
 	}
+
+	MATH_TEST("Batch transform matrices")
+	{
+		// odd size: covers both the 4-wide path and the remainder
+		constexpr size_t count = 103;
+		std::mt19937 rng{ 1234 };
+		std::uniform_real_distribution<float> dist{ -100.0f, 100.0f };
+		std::vector<float3> positions, scales;
+		std::vector<glm::quat> rotations;
+		for (size_t i = 0; i < count; ++i)
+		{
+			positions.emplace_back(dist(rng), dist(rng), dist(rng));
+			scales.emplace_back(dist(rng), dist(rng), dist(rng));
+			// not normalized on purpose, to cover the full range of the products
+			rotations.emplace_back(dist(rng), dist(rng), dist(rng), dist(rng));
+		}
+		positions[1] = { -0.0f, 0, -0.0f };
+		scales[2] = { 0, -0.0f, 1 };
+		rotations[3] = { 1, 0, 0, 0 };
+		rotations[4] = { -0.0f, 0, -0.0f, 0 };
+
+		for (const size_t n : { count, size_t(3), size_t(0) })
+		{
+			std::vector<glm::mat4x4> matrices(n);
+			ComputeTransformMatrices(
+				{ positions.data(), n },
+				{ scales.data(), n },
+				{ rotations.data(), n },
+				matrices.data());
+			bool ok = true;
+			for (size_t i = 0; i < n; ++i)
+			{
+				const glm::mat4x4 expected =
+					ComputeTransformMatrix(positions[i], scales[i], rotations[i]);
+				// FMA contraction may change the rounding of each product of quaternion
+				// components: allow a few ulps of the largest intermediate value
+				const float quatNorm = glm::dot(rotations[i], rotations[i]);
+				for (int c = 0; c < 3; ++c)
+				{
+					// only the diagonal is scaled
+					const float tolerance = 8 * std::numeric_limits<float>::epsilon() *
+											(1 + 2 * quatNorm) *
+											std::max(1.0f, std::abs(scales[i][c]));
+					for (int r = 0; r < 4; ++r)
+						ok = ok && std::abs(matrices[i][c][r] - expected[c][r]) <= tolerance;
+				}
+				ok = ok && matrices[i][3] == expected[3];
+			}
+			CHECK(ok);
+		}
+	}
 } // namespace apollo::math_ut
\ No newline at end of file
@@ -1,7 +1,9 @@
+#include <atomic>
 #include <catch2/catch_test_macros.hpp>
 #include <core/Memory.hpp>
 #include <list>
 #include <memory_resource>
+#include <thread>
 #include <vector>
 
 #define MEMPOOL_TEST(name) TEST_CASE(name, "[memory_pool]")
@@ -220,6 +222,152 @@ namespace apollo::mempool_ut {
 			list.emplace_back(i);
 		}
 	}
+
+	MEMPOOL_TEST("Concurrent pool block reuse")
+	{
+		AllocationTracker<> tracker{ *std::pmr::new_delete_resource() };
+		ConcurrentMemoryPool pool{ 12, 4096, &tracker };
+		CHECK(pool.GetBlockSize() == 16);
+		CHECK(pool.GetBlockAlignment() == 16);
+		CHECK(tracker.GetAllocatedSize() == 0);
+
+		void* const a = pool.AllocateBlock();
+		void* const b = pool.AllocateBlock();
+		REQUIRE(a);
+		CHECK(static_cast<std::byte*>(b) - static_cast<std::byte*>(a) == 16);
+		CHECK(tracker.GetAllocatedSize() == 4096);
+
+		pool.DeallocateBlock(a);
+		CHECK(pool.AllocateBlock() == a);
+		CHECK(pool.GetThreadCacheCount() == 1);
+	}
+
+	MEMPOOL_TEST("Concurrent pool upstream fallback")
+	{
+		AllocationTracker<> tracker{ *std::pmr::new_delete_resource() };
+		{
+			ConcurrentMemoryPool pool{ 32, 4096, &tracker };
+			void* const big = pool.allocate(64, 8);
+			CHECK(tracker.GetAllocatedSize() == 64);
+			void* const aligned = pool.allocate(32, 64);
+			CHECK(tracker.GetAllocatedSize() == 96);
+			void* const small = pool.allocate(24, 8);
+			CHECK(tracker.GetAllocatedSize() == 96 + 4096);
+
+			pool.deallocate(big, 64, 8);
+			pool.deallocate(aligned, 32, 64);
+			pool.deallocate(small, 24, 8);
+			CHECK(tracker.GetAllocatedSize() == 4096);
+		}
+		CHECK(tracker.GetAllocatedSize() == 0);
+	}
+
+	MEMPOOL_TEST("Concurrent pool cross-thread deallocation")
+	{
+		ConcurrentMemoryPool pool{ 16, 4096 };
+		void* const ptr = pool.AllocateBlock();
+		std::thread{ [&]() { pool.DeallocateBlock(ptr); } }.join();
+		// other threads don't get to allocate the block...
+		void* other = nullptr;
+		std::thread{ [&]() { other = pool.AllocateBlock(); } }.join();
+		CHECK(other != ptr);
+		CHECK(pool.GetThreadCacheCount() == 2);
+
+		// ...which goes back to its owner, once it runs out of fresh blocks
+		bool found = false;
+		for (uint32 i = 0; i < 4096 / 16 && !found; ++i)
+			found = pool.AllocateBlock() == ptr;
+		CHECK(found);
+	}
+
+	MEMPOOL_TEST("Concurrent pool stress")
+	{
+		constexpr uint32 numThreads = 8;
+		constexpr uint32 numRounds = 200;
+		constexpr uint32 batchSize = 64;
+		ConcurrentMemoryPool pool{ sizeof(uint64), 1024 };
+		std::atomic<std::vector<uint64*>*> mailbox = nullptr;
+		std::atomic_uint32_t failures = 0;
+
+		const auto check = [&](std::vector<uint64*>* batch)
+		{
+			for (uint64* ptr : *batch)
+			{
+				if (*ptr != reinterpret_cast<uintptr_t>(ptr))
+					++failures;
+				pool.DeallocateBlock(ptr);
+			}
+			delete batch;
+		};
+
+		std::vector<std::thread> threads;
+		for (uint32 i = 0; i < numThreads; ++i)
+		{
+			threads.emplace_back(
+				[&]()
+				{
+					for (uint32 round = 0; round < numRounds; ++round)
+					{
+						auto* batch = new std::vector<uint64*>;
+						for (uint32 j = 0; j < batchSize; ++j)
+						{
+							uint64* const ptr = static_cast<uint64*>(pool.AllocateBlock());
+							*ptr = reinterpret_cast<uintptr_t>(ptr);
+							batch->emplace_back(ptr);
+						}
+						// most batches get freed by another thread
+						if (auto* other = mailbox.exchange(batch))
+							check(other);
+					}
+				});
+		}
+		for (std::thread& th : threads)
+			th.join();
+		if (auto* batch = mailbox.exchange(nullptr))
+			check(batch);
+
+		CHECK(failures == 0);
+	}
+
+	MEMPOOL_TEST("Concurrent pool with std::pmr containers")
+	{
+		ConcurrentMemoryPool pool{ 32 };
+		std::pmr::list<int32> list{ pool.GetPolymorphicAllocator<int32>() };
+		for (int32 i = 0; i < 1000; ++i)
+			list.emplace_back(i);
+		CHECK(list.size() == 1000);
+		CHECK(list.back() == 999);
+
+		// too big for a single block, forwarded upstream
+		std::pmr::vector<int32> vec{ pool.GetPolymorphicAllocator<int32>() };
+		vec.resize(100);
+		CHECK(vec.size() == 100);
+	}
+
+	MEMPOOL_TEST("Fragmented chunk")
+	{
+		constexpr uint32 n = 3 * 4096;
+		MemoryPool pool{ 8, n };
+		std::vector<uint64*> blocks;
+		for (uint32 i = 0; i < n; ++i)
+			blocks.emplace_back(static_cast<uint64*>(pool.AllocateBlocks(1)));
+		REQUIRE(blocks.back() == blocks.front() + n - 1);
+
+		// the first group only has scattered free blocks, the second one is full
+		for (uint32 i = 0; i < 4096; i += 2)
+			pool.DeallocateBlocks(blocks[i], 1);
+		pool.DeallocateBlocks(blocks[n - 10], 3);
+
+		CHECK(pool.AllocateBlocks(1) == blocks[0]);
+		CHECK(pool.AllocateBlocks(3) == blocks[n - 10]);
+		CHECK(pool.AllocateBlocks(1) == blocks[2]);
+
+		pool.DeallocateBlocks(blocks[5000], 2);
+		CHECK(pool.AllocateBlocks(2) == blocks[5000]);
+
+		void* const other = pool.AllocateBlocks(2);
+		CHECK((other < blocks.front() || other > blocks.back()));
+	}
 } // namespace apollo::mempool_ut
 
 #undef MEMPOOL_TEST
\ No newline at end of file
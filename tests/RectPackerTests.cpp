@@ -0,0 +1,138 @@
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <rendering/RectPacker.hpp>
+#include <vector>
+
+#define RECT_PACKER_TEST(name) TEST_CASE(name, "[rect_packer]")
+
+namespace apollo::rdr::rect_packer_ut {
+	/// Checks that no two rectangles overlap, including the margin to their right and bottom
+	[[nodiscard]] bool CheckNoOverlap(const std::vector<RectU32>& rects, uint32 margin)
+	{
+		for (size_t i = 0; i < rects.size(); ++i)
+		{
+			const RectU32& a = rects[i];
+			for (size_t j = i + 1; j < rects.size(); ++j)
+			{
+				const RectU32& b = rects[j];
+				if (!(a.GetWidth() && a.GetHeight() && b.GetWidth() && b.GetHeight()))
+					continue;
+				if (a.x0 < b.x1 + margin && b.x0 < a.x1 + margin && a.y0 < b.y1 + margin &&
+					b.y0 < a.y1 + margin)
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	[[nodiscard]] std::vector<RectU32> GenerateRects(uint32 count, uint32 seed)
+	{
+		std::mt19937 rng{ seed };
+		std::uniform_int_distribution<uint32> dist{ 1, 48 };
+		std::vector<RectU32> rects(count);
+		for (RectU32& rect : rects)
+			rect = { 0, 0, dist(rng), dist(rng) };
+		return rects;
+	}
+
+	RECT_PACKER_TEST("RectPacker keeps rectangles apart and inside the strip")
+	{
+		const std::vector<RectU32> original = GenerateRects(300, 42);
+		for (uint8 strategy = 0; strategy < uint8(EPackingStrategy::NStrategies); ++strategy)
+		{
+			for (uint8 order = 0; order < uint8(EPackingOrder::NOrders); ++order)
+			{
+				std::vector<RectU32> rects = original;
+				RectPacker packer{ 256, EPackingStrategy(strategy), EPackingOrder(order) };
+				const glm::uvec2 size = packer.Pack(rects);
+
+				CHECK(size.x <= 256);
+				for (size_t i = 0; i < rects.size(); ++i)
+				{
+					REQUIRE(rects[i].GetWidth() == original[i].GetWidth());
+					REQUIRE(rects[i].GetHeight() == original[i].GetHeight());
+					REQUIRE(rects[i].x1 <= size.x);
+					REQUIRE(rects[i].y1 <= size.y);
+				}
+				CHECK(CheckNoOverlap(rects, 1));
+
+				const float efficiency = RectPacker::ComputeEfficiency(rects, size);
+				CHECK(efficiency > 0.0f);
+				CHECK(efficiency <= 1.0f);
+			}
+		}
+	}
+
+	RECT_PACKER_TEST("RectPacker strategies")
+	{
+		const std::vector<RectU32> rects = GenerateRects(500, 7);
+		const auto pack = [&](EPackingStrategy strategy)
+		{
+			std::vector<RectU32> packed = rects;
+			RectPacker packer{ 512, strategy, EPackingOrder::Height };
+			return RectPacker::ComputeEfficiency(packed, packer.Pack(packed));
+		};
+
+		const float shelf = pack(EPackingStrategy::Shelf);
+		const float skyline = pack(EPackingStrategy::Skyline);
+		const float maxRects = pack(EPackingStrategy::MaxRects);
+		CHECK(skyline > shelf);
+		CHECK(maxRects > shelf);
+		CHECK(skyline > 0.8f);
+		CHECK(maxRects > 0.8f);
+	}
+
+	RECT_PACKER_TEST("RectPacker skyline placement")
+	{
+		std::vector<RectU32> rects{
+			{ 0, 0, 6, 2 },
+			{ 0, 0, 4, 4 },
+			{ 0, 0, 3, 1 },
+		};
+		RectPacker packer{ 10, EPackingStrategy::Skyline, EPackingOrder::Height, 0 };
+		const glm::uvec2 size = packer.Pack(rects);
+
+		// the tallest rectangle goes first, the short ones fill the space to its right
+		CHECK(rects[1] == RectU32{ 0, 0, 4, 4 });
+		CHECK(rects[0] == RectU32{ 4, 0, 10, 2 });
+		CHECK(rects[2] == RectU32{ 4, 2, 7, 3 });
+		CHECK(size == glm::uvec2{ 10, 4 });
+	}
+
+	RECT_PACKER_TEST("RectPacker edge cases")
+	{
+		SECTION("Empty rectangles")
+		{
+			std::vector<RectU32> rects{
+				{ 5, 5, 5, 12 },
+				{ 3, 3, 13, 13 },
+			};
+			RectPacker packer{ 64 };
+			const glm::uvec2 size = packer.Pack(rects);
+			CHECK(rects[0] == RectU32{ 0, 0, 0, 7 });
+			CHECK(rects[1] == RectU32{ 0, 0, 10, 10 });
+			CHECK(size == glm::uvec2{ 10, 10 });
+		}
+		SECTION("Rectangles wider than the strip")
+		{
+			for (uint8 strategy = 0; strategy < uint8(EPackingStrategy::NStrategies); ++strategy)
+			{
+				std::vector<RectU32> rects{
+					{ 0, 0, 100, 10 },
+					{ 0, 0, 10, 10 },
+				};
+				RectPacker packer{ 64, EPackingStrategy(strategy) };
+				const glm::uvec2 size = packer.Pack(rects);
+				CHECK(size.x == 100);
+				CHECK(CheckNoOverlap(rects, 1));
+			}
+		}
+		SECTION("Nothing to pack")
+		{
+			RectPacker packer{ 64 };
+			CHECK(packer.Pack({}) == glm::uvec2{ 0, 0 });
+		}
+	}
+} // namespace apollo::rdr::rect_packer_ut
\ No newline at end of file
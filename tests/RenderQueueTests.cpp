@@ -0,0 +1,173 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstring>
+#include <random>
+#include <rendering/Buffer.hpp>
+#include <rendering/RenderQueue.hpp>
+#include <vector>
+
+#define RENDER_QUEUE_TEST(name) TEST_CASE(name, "[render_queue]")
+
+namespace apollo::rdr::render_queue_ut {
+	/// Records the commands emitted by a render queue
+	struct RecordingSink
+	{
+		struct Draw
+		{
+			const MaterialInstance* m_Material;
+			const Buffer* m_VertexBuffer;
+			const Buffer* m_IndexBuffer;
+			uint32 m_FirstInstance;
+			uint32 m_Constant;
+		};
+
+		void BindMaterialInstance(const MaterialInstance& mat) { m_Material = &mat; }
+		void BindVertexBuffer(const Buffer& buffer) { m_VertexBuffer = &buffer; }
+		void BindIndexBuffer(const Buffer& buffer) { m_IndexBuffer = &buffer; }
+		void BindVertexStorageBuffer(const Buffer& buffer) { m_StorageBuffer = &buffer; }
+		void PushVertexShaderConstants(const void* data, size_t size, uint32 slot)
+		{
+			REQUIRE(size == sizeof(uint32));
+			CHECK(slot == 1);
+			std::memcpy(&m_Constant, data, size);
+		}
+		void DrawPrimitives(const DrawCall& call)
+		{
+			m_Draws.emplace_back(m_Material, m_VertexBuffer, nullptr, call.m_FistInstance);
+		}
+		void DrawIndexedPrimitives(const IndexedDrawCall& call)
+		{
+			m_Draws.emplace_back(
+				m_Material,
+				m_VertexBuffer,
+				m_IndexBuffer,
+				call.m_FirstInstance,
+				m_Constant);
+		}
+
+		const MaterialInstance* m_Material = nullptr;
+		const Buffer* m_VertexBuffer = nullptr;
+		const Buffer* m_IndexBuffer = nullptr;
+		const Buffer* m_StorageBuffer = nullptr;
+		uint32 m_Constant = 0;
+		std::vector<Draw> m_Draws;
+	};
+
+	// The queue never dereferences material instances, which can't be created without a
+	// rendering context
+	alignas(MaterialInstance) static std::byte g_Materials[4 * sizeof(MaterialInstance)];
+	const MaterialInstance* GetMaterial(uint32 i)
+	{
+		return reinterpret_cast<const MaterialInstance*>(g_Materials + i * sizeof(MaterialInstance));
+	}
+
+	RENDER_QUEUE_TEST("Render queue sorting is stable")
+	{
+		std::mt19937_64 rng{ 42 };
+		RenderQueue queue;
+		std::vector<uint64> keys;
+		for (uint32 i = 0; i < 10000; ++i)
+		{
+			// keys only differ in a few bytes, with many duplicates
+			keys.emplace_back(((rng() % 16) << 40) | ((rng() % 8) << 8) | 0xf000000000000000);
+			queue.Submit(DrawPacket{
+				.m_Key = keys.back(),
+				.m_Material = GetMaterial(0),
+				.m_FirstInstance = i,
+			});
+		}
+		queue.Sort();
+
+		RecordingSink sink;
+		queue.Emit(sink);
+		REQUIRE(sink.m_Draws.size() == keys.size());
+		bool ok = true;
+		for (size_t i = 1; i < sink.m_Draws.size(); ++i)
+		{
+			const uint32 prev = sink.m_Draws[i - 1].m_FirstInstance;
+			const uint32 cur = sink.m_Draws[i].m_FirstInstance;
+			ok = ok && (keys[prev] < keys[cur] || (keys[prev] == keys[cur] && prev < cur));
+		}
+		CHECK(ok);
+	}
+
+	RENDER_QUEUE_TEST("Render queue redundant state elimination")
+	{
+		Buffer vertexBuffers[2];
+		Buffer indexBuffers[2];
+		Buffer storageBuffer;
+		RenderQueue queue;
+		// submitted in the worst order, sorting groups them by material then mesh
+		for (uint32 i = 0; i < 64; ++i)
+		{
+			const uint32 material = i % 4;
+			const uint32 mesh = (i / 4) % 2;
+			queue.Submit(
+				DrawPacket{
+					.m_Key = (uint64(material) << 32) | (mesh << 16) | i,
+					.m_Material = GetMaterial(material),
+					.m_VertexBuffer = vertexBuffers + mesh,
+					.m_IndexBuffer = indexBuffers + mesh,
+					.m_VertexStorageBuffer = &storageBuffer,
+					.m_FirstInstance = i,
+				},
+				i * 10,
+				1);
+		}
+
+		SECTION("Unsorted")
+		{
+			RecordingSink sink;
+			const RenderQueue::Stats stats = queue.Emit(sink);
+			CHECK(stats.m_NumDraws == 64);
+			CHECK(stats.m_NumMaterialBinds == 64);
+			CHECK(stats.m_NumVertexBufferBinds == 16);
+			CHECK(stats.m_NumIndexBufferBinds == 16);
+			// rebound along with each material
+			CHECK(stats.m_NumStorageBufferBinds == 64);
+		}
+		SECTION("Sorted")
+		{
+			queue.Sort();
+			RecordingSink sink;
+			const RenderQueue::Stats stats = queue.Emit(sink);
+			CHECK(stats.m_NumDraws == 64);
+			CHECK(stats.m_NumMaterialBinds == 4);
+			CHECK(stats.m_NumVertexBufferBinds == 8);
+			CHECK(stats.m_NumIndexBufferBinds == 8);
+			CHECK(stats.m_NumStorageBufferBinds == 4);
+
+			// every draw still sees its own state and constants
+			bool ok = true;
+			for (const RecordingSink::Draw& draw : sink.m_Draws)
+			{
+				const uint32 i = draw.m_FirstInstance;
+				ok = ok && draw.m_Material == GetMaterial(i % 4);
+				ok = ok && draw.m_VertexBuffer == vertexBuffers + (i / 4) % 2;
+				ok = ok && draw.m_IndexBuffer == indexBuffers + (i / 4) % 2;
+				ok = ok && draw.m_Constant == i * 10;
+			}
+			CHECK(ok);
+		}
+	}
+
+	RENDER_QUEUE_TEST("Render queue non-indexed draws")
+	{
+		RenderQueue queue;
+		queue.Submit(DrawPacket{ .m_Key = 1, .m_Material = GetMaterial(1), .m_FirstInstance = 1 });
+		queue.Submit(DrawPacket{ .m_Key = 0, .m_Material = GetMaterial(0), .m_FirstInstance = 0 });
+		queue.Sort();
+
+		RecordingSink sink;
+		const RenderQueue::Stats stats = queue.Emit(sink);
+		CHECK(stats.m_NumVertexBufferBinds == 0);
+		CHECK(stats.m_NumIndexBufferBinds == 0);
+		REQUIRE(sink.m_Draws.size() == 2);
+		CHECK(sink.m_Draws[0].m_Material == GetMaterial(0));
+		CHECK(sink.m_Draws[1].m_Material == GetMaterial(1));
+		CHECK(sink.m_Draws[1].m_IndexBuffer == nullptr);
+
+		queue.Clear();
+		CHECK(queue.IsEmpty());
+		CHECK(queue.Emit(sink).m_NumDraws == 0);
+	}
+} // namespace apollo::rdr::render_queue_ut
\ No newline at end of file
@@ -0,0 +1,270 @@
+#include <asset/SceneFile.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <ecs/ComponentRegistry.hpp>
+
+#define SCENE_FILE_TEST(name) TEST_CASE(name, "[scene_file]")
+
+namespace apollo::scene_file_ut {
+	struct Position
+	{
+		float3 m_Value = {};
+		int32 m_Layer = 0;
+
+		static constexpr ecs::ComponentReflection<&Position::m_Value, &Position::m_Layer>
+			Reflection{
+				"position",
+				{ "value", "layer" },
+			};
+	};
+
+	struct Label
+	{
+		std::string m_Text;
+		glm::quat m_Rotation;
+
+		static constexpr ecs::ComponentReflection<&Label::m_Text, &Label::m_Rotation> Reflection{
+			"label",
+			{ "text", "rotation" },
+		};
+	};
+
+	/// Views can't be stored in binary files
+	struct View
+	{
+		std::string_view m_Str;
+
+		static constexpr ecs::ComponentReflection<&View::m_Str> Reflection{ "view", { "str" } };
+	};
+
+	struct Helper
+	{
+		ecs::ComponentRegistry* m_Registry = &ecs::ComponentRegistry::Init();
+		entt::registry m_World;
+		~Helper() { ecs::ComponentRegistry::Shutdown(); }
+	};
+
+	const nlohmann::json g_Scene = nlohmann::json::parse(R"({
+		"gameObjects": [
+			{
+				"id": "01K8EC89XVHA1N3ZRZTFGNMYT5",
+				"name": "first",
+				"components": {
+					"position": { "value": { "x": 1, "y": 2, "z": 3 }, "layer": 4 },
+					"label": {
+						"text": "hello",
+						"rotation": { "x": 0, "y": 0, "z": 0, "w": 1 }
+					}
+				}
+			},
+			{
+				"id": "01K9QES25H7A9TWBQM6C5X7Z8B",
+				"name": "second",
+				"components": {
+					"label": {
+						"text": "",
+						"rotation": { "x": 1, "y": 0, "z": 0, "w": 0 }
+					}
+				}
+			},
+			{
+				"id": "01K9T0WA3KCXNY66J7JWF2V53G",
+				"name": "third",
+				"components": {
+					"position": { "value": { "x": -1, "y": 0.5, "z": 0 }, "layer": -2 }
+				}
+			}
+		]
+	})");
+
+	constexpr ULID g_FirstId = "01K8EC89XVHA1N3ZRZTFGNMYT5"_ulid;
+	constexpr ULID g_SecondId = "01K9QES25H7A9TWBQM6C5X7Z8B"_ulid;
+	constexpr ULID g_ThirdId = "01K9T0WA3KCXNY66J7JWF2V53G"_ulid;
+
+	SCENE_FILE_TEST("Binary scene conversion round trip")
+	{
+		Helper helper;
+		helper.m_Registry->RegisterComponent<Position>();
+		helper.m_Registry->RegisterComponent<Label>();
+
+		std::vector<std::byte> data;
+		REQUIRE(SceneJsonToBinary(g_Scene, *helper.m_Registry, data));
+		CHECK(IsBinaryScene(data));
+
+		nlohmann::json json;
+		REQUIRE(SceneBinaryToJson(data, *helper.m_Registry, json));
+		CHECK(json == g_Scene);
+
+		SECTION("Truncated data is rejected")
+		{
+			for (size_t size = 0; size < data.size(); ++size)
+			{
+				const std::span truncated{ data.data(), size };
+				CHECK_FALSE(SceneBinaryToJson(truncated, *helper.m_Registry, json));
+			}
+		}
+	}
+
+	SCENE_FILE_TEST("Load binary scene")
+	{
+		Helper helper;
+		const ecs::ComponentInfo& positionInfo = helper.m_Registry->RegisterComponent<Position>();
+		helper.m_Registry->RegisterComponent<Label>();
+
+		std::vector<std::byte> data;
+		REQUIRE(SceneJsonToBinary(g_Scene, *helper.m_Registry, data));
+
+		SECTION("All components")
+		{
+			ULIDMap<GameObject> objects;
+			REQUIRE(LoadBinaryScene(data, *helper.m_Registry, helper.m_World, objects));
+			REQUIRE(objects.size() == 3);
+
+			const GameObject& first = objects.at(g_FirstId);
+			CHECK(first.m_Name == "first");
+			CHECK(first.m_Components.size() == 2);
+			const Position* pos = helper.m_World.try_get<Position>(first.m_Entity);
+			REQUIRE(pos);
+			CHECK(pos->m_Value == float3{ 1, 2, 3 });
+			CHECK(pos->m_Layer == 4);
+			const Label* label = helper.m_World.try_get<Label>(first.m_Entity);
+			REQUIRE(label);
+			CHECK(label->m_Text == "hello");
+			CHECK(label->m_Rotation.w == 1.0f);
+
+			const GameObject& second = objects.at(g_SecondId);
+			CHECK(second.m_Name == "second");
+			REQUIRE(second.m_Components.size() == 1);
+			CHECK(!helper.m_World.try_get<Position>(second.m_Entity));
+			label = helper.m_World.try_get<Label>(second.m_Entity);
+			REQUIRE(label);
+			CHECK(label->m_Text.empty());
+			CHECK(label->m_Rotation.x == 1.0f);
+
+			const GameObject& third = objects.at(g_ThirdId);
+			REQUIRE(third.m_Components.size() == 1);
+			CHECK(third.m_Components[0] == &positionInfo);
+			pos = helper.m_World.try_get<Position>(third.m_Entity);
+			REQUIRE(pos);
+			CHECK(pos->m_Value == float3{ -1, 0.5f, 0 });
+			CHECK(pos->m_Layer == -2);
+		}
+		SECTION("Unknown components are skipped")
+		{
+			ecs::ComponentRegistry::Shutdown();
+			helper.m_Registry = &ecs::ComponentRegistry::Init();
+			helper.m_Registry->RegisterComponent<Position>();
+
+			ULIDMap<GameObject> objects;
+			REQUIRE(LoadBinaryScene(data, *helper.m_Registry, helper.m_World, objects));
+			REQUIRE(objects.size() == 3);
+			CHECK(objects.at(g_FirstId).m_Components.size() == 1);
+			CHECK(objects.at(g_SecondId).m_Components.empty());
+			CHECK(helper.m_World.try_get<Position>(objects.at(g_ThirdId).m_Entity));
+		}
+		SECTION("Corrupted data leaves the world untouched")
+		{
+			ULIDMap<GameObject> objects;
+			for (size_t size = 0; size < data.size(); ++size)
+			{
+				const std::span truncated{ data.data(), size };
+				CHECK_FALSE(
+					LoadBinaryScene(truncated, *helper.m_Registry, helper.m_World, objects));
+			}
+			CHECK(objects.empty());
+			CHECK(helper.m_World.view<const Position>().empty());
+			CHECK(helper.m_World.view<const Label>().empty());
+		}
+		SECTION("Columns must be consumed entirely")
+		{
+			std::vector<std::byte> trailing;
+			BinaryWriter writer{ trailing };
+			writer.Write(SceneFileHeader{ .m_NumObjects = 1, .m_NumColumns = 1 });
+			writer.Write(g_FirstId);
+			writer.WriteString("first");
+			writer.WriteString("position");
+			writer.Write(uint32(1));
+			writer.Write(uint32(0));
+			const size_t sizeOffset = writer.GetSize();
+			writer.Write(uint64(0));
+			BinaryCodec<float3>::Write(writer, float3{ 1, 2, 3 });
+			BinaryCodec<int32>::Write(writer, 4);
+			writer.Write(uint32(0));
+			writer.Patch(sizeOffset, uint64(writer.GetSize() - sizeOffset - sizeof(uint64)));
+
+			ULIDMap<GameObject> objects;
+			CHECK_FALSE(LoadBinaryScene(trailing, *helper.m_Registry, helper.m_World, objects));
+			CHECK(objects.empty());
+			CHECK(helper.m_World.view<const Position>().empty());
+
+			nlohmann::json json;
+			CHECK_FALSE(SceneBinaryToJson(trailing, *helper.m_Registry, json));
+		}
+	}
+
+	SCENE_FILE_TEST("Load JSON scene")
+	{
+		Helper helper;
+		helper.m_Registry->RegisterComponent<Position>();
+		helper.m_Registry->RegisterComponent<Label>();
+		const std::string str = g_Scene.dump();
+
+		SECTION("Valid scene")
+		{
+			ULIDMap<GameObject> objects;
+			REQUIRE(LoadJsonScene(str, *helper.m_Registry, helper.m_World, objects));
+			REQUIRE(objects.size() == 3);
+			CHECK(objects.at(g_FirstId).m_Name == "first");
+			const Position* pos = helper.m_World.try_get<Position>(objects.at(g_ThirdId).m_Entity);
+			REQUIRE(pos);
+			CHECK(pos->m_Value == float3{ -1, 0.5f, 0 });
+			CHECK(pos->m_Layer == -2);
+		}
+		SECTION("Invalid documents leave the world untouched")
+		{
+			// the first game object is complete, and gets created before the error is found
+			const std::string_view truncated{ str.data(), str.find("second") };
+			ULIDMap<GameObject> objects;
+			CHECK_FALSE(LoadJsonScene(truncated, *helper.m_Registry, helper.m_World, objects));
+			CHECK(objects.empty());
+			CHECK(helper.m_World.view<const Position>().empty());
+			CHECK(helper.m_World.view<const Label>().empty());
+		}
+	}
+
+	SCENE_FILE_TEST("Binary bool values")
+	{
+		std::vector<std::byte> data;
+		BinaryWriter writer{ data };
+		BinaryCodec<bool>::Write(writer, true);
+		BinaryCodec<bool>::Write(writer, false);
+		writer.Write(uint8(2));
+
+		BinaryReader reader{ data };
+		bool value = false;
+		REQUIRE(BinaryCodec<bool>::Read(reader, value));
+		CHECK(value);
+		REQUIRE(BinaryCodec<bool>::Read(reader, value));
+		CHECK_FALSE(value);
+		CHECK_FALSE(BinaryCodec<bool>::Read(reader, value));
+	}
+
+	SCENE_FILE_TEST("Components without a binary format")
+	{
+		Helper helper;
+		const ecs::ComponentInfo& info = helper.m_Registry->RegisterComponent<View>();
+		CHECK(!info.m_LoadColumn);
+		CHECK(!info.m_JsonToColumn);
+		CHECK(!info.m_ColumnToJson);
+
+		const nlohmann::json scene = nlohmann::json::parse(R"({
+			"gameObjects": [
+				{
+					"id": "01K8EC89XVHA1N3ZRZTFGNMYT5",
+					"components": { "view": { "str": "text" } }
+				}
+			]
+		})");
+		std::vector<std::byte> data;
+		CHECK_FALSE(SceneJsonToBinary(scene, *helper.m_Registry, data));
+	}
+} // namespace apollo::scene_file_ut
\ No newline at end of file
@@ -1,7 +1,11 @@
+#include <atomic>
 #include <catch2/catch_test_macros.hpp>
 #include <core/GameTime.hpp>
+#include <core/ThreadPool.hpp>
+#include <ecs/Scheduler.hpp>
 #include <ecs/System.hpp>
 #include <entt/entity/registry.hpp>
+#include <thread>
 
 namespace {
 	struct S1
@@ -17,6 +21,88 @@ namespace {
 		~S2() { ++m_OnDelete; }
 		void Update(entt::registry&, const apollo::GameTime&) {}
 	};
+
+	struct Position
+	{
+		float x = 0;
+	};
+	struct Velocity
+	{
+		float x = 1;
+	};
+
+	struct SchedulerState
+	{
+		std::atomic_uint32_t m_ActiveWriters = 0;
+		std::atomic_bool m_Overlap = false;
+		std::atomic_uint32_t m_LastWriter = 0;
+		std::atomic_bool m_OutOfOrder = false;
+		std::atomic_bool m_ExclusiveOffThread = false;
+		std::thread::id m_MainThread = std::this_thread::get_id();
+	};
+
+	/// Writes positions, checking that no other writer is running at the same time
+	template <uint32 N>
+	struct PositionWriter
+	{
+		using Access = apollo::ecs::Access<
+			apollo::ecs::Read<const Velocity>,
+			apollo::ecs::Write<Position>>;
+		SchedulerState& m_State;
+
+		void Update(entt::registry& world, const apollo::GameTime&)
+		{
+			if (m_State.m_ActiveWriters.fetch_add(1) != 0)
+				m_State.m_Overlap = true;
+			// writers run in the order they were added
+			if (m_State.m_LastWriter.exchange(N) != N - 1)
+				m_State.m_OutOfOrder = true;
+
+			for (auto&& [entity, pos, vel] : world.view<Position, const Velocity>().each())
+				pos.x += vel.x;
+			std::this_thread::sleep_for(std::chrono::microseconds{ 50 });
+			m_State.m_ActiveWriters.fetch_sub(1);
+		}
+	};
+
+	struct VelocityReader
+	{
+		using Access = apollo::ecs::Access<apollo::ecs::Read<Velocity>>;
+		SchedulerState& m_State;
+		float m_Sum = 0;
+
+		void Update(entt::registry& world, const apollo::GameTime&)
+		{
+			for (auto&& [entity, vel] : world.view<const Velocity>().each())
+				m_Sum += vel.x;
+		}
+	};
+
+	struct ExclusiveSystem
+	{
+		SchedulerState& m_State;
+
+		void Update(entt::registry&, const apollo::GameTime&)
+		{
+			// the last writer of the previous group completed before this system runs
+			if (m_State.m_ActiveWriters != 0 ||
+				std::this_thread::get_id() != m_State.m_MainThread)
+			{
+				m_State.m_ExclusiveOffThread = true;
+			}
+			m_State.m_LastWriter = 0;
+		}
+	};
+
+	struct InvalidAccess
+	{
+		using Access = int;
+		void Update(entt::registry&, const apollo::GameTime&) {}
+	};
+
+	static_assert(apollo::ecs::System<PositionWriter<1>>);
+	static_assert(apollo::ecs::System<S1>);
+	static_assert(!apollo::ecs::System<InvalidAccess>);
 } // namespace
 
 namespace apollo::ecs::ut {
@@ -67,4 +153,78 @@ namespace apollo::ecs::ut {
 		}
 		CHECK(deleteCount == 2);
 	}
-} // namespace apollo::ecs::ut
+
+	TEST_CASE("System access conflicts", "[ecs]")
+	{
+		const AccessInfo& writer = PositionWriter<1>::Access::GetInfo();
+		const AccessInfo& reader = VelocityReader::Access::GetInfo();
+		const AccessInfo& positionReader = Access<Read<const Position>>::GetInfo();
+
+		CHECK(writer.ConflictsWith(writer));
+		CHECK_FALSE(writer.ConflictsWith(reader));
+		CHECK_FALSE(reader.ConflictsWith(reader));
+		CHECK(writer.ConflictsWith(positionReader));
+		CHECK(positionReader.ConflictsWith(writer));
+		CHECK_FALSE(positionReader.ConflictsWith(reader));
+	}
+
+	TEST_CASE("Scheduler dependencies", "[ecs]")
+	{
+		SchedulerState state;
+		std::vector<SystemInstance> systems;
+		systems.emplace_back(SystemInstance::Create<PositionWriter<1>>(state));
+		systems.emplace_back(SystemInstance::Create<VelocityReader>(state));
+		systems.emplace_back(SystemInstance::Create<PositionWriter<2>>(state));
+		systems.emplace_back(SystemInstance::Create<ExclusiveSystem>(state));
+		systems.emplace_back(SystemInstance::Create<PositionWriter<1>>(state));
+
+		entt::registry world;
+		Scheduler scheduler;
+		scheduler.Build(systems, world);
+
+		CHECK(scheduler.GetDependencies(0).empty());
+		CHECK(scheduler.GetDependencies(1).empty());
+		REQUIRE(scheduler.GetDependencies(2).size() == 1);
+		CHECK(scheduler.GetDependencies(2)[0] == 0);
+		CHECK(scheduler.GetDependencies(3).empty());
+		// the exclusive system already waits for the first writers
+		CHECK(scheduler.GetDependencies(4).empty());
+	}
+
+	TEST_CASE("Scheduler never overlaps conflicting writers", "[ecs]")
+	{
+		SchedulerState state;
+		std::vector<SystemInstance> systems;
+		systems.emplace_back(SystemInstance::Create<PositionWriter<1>>(state));
+		systems.emplace_back(SystemInstance::Create<VelocityReader>(state));
+		systems.emplace_back(SystemInstance::Create<PositionWriter<2>>(state));
+		systems.emplace_back(SystemInstance::Create<PositionWriter<3>>(state));
+		systems.emplace_back(SystemInstance::Create<ExclusiveSystem>(state));
+
+		entt::registry world;
+		for (uint32 i = 0; i < 256; ++i)
+		{
+			const entt::entity entity = world.create();
+			world.emplace<Position>(entity);
+			world.emplace<Velocity>(entity);
+		}
+
+		Scheduler scheduler;
+		scheduler.Build(systems, world);
+		mt::ThreadPool pool{ 4 };
+		GameTime time;
+		constexpr uint32 numFrames = 100;
+		for (uint32 i = 0; i < numFrames; ++i)
+			scheduler.Run(systems, world, time, &pool);
+
+		CHECK_FALSE(state.m_Overlap);
+		CHECK_FALSE(state.m_OutOfOrder);
+		CHECK_FALSE(state.m_ExclusiveOffThread);
+		for (auto&& [entity, pos] : world.view<const Position>().each())
+			REQUIRE(pos.x == 3.0f * numFrames);
+		CHECK(systems[1].GetAs<VelocityReader>()->m_Sum == 256.0f * numFrames);
+
+		for (const Scheduler::SystemStats& stats : scheduler.GetStats())
+			CHECK(stats.m_Last.count() > 0);
+	}
+} // namespace apollo::ecs::ut
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <rendering/text/TextLayout.hpp>
+
+#define TEXT_LAYOUT_TEST(name) TEST_CASE(name, "[text_layout]")
+
+namespace apollo::rdr::txt::text_layout_ut {
+	/// Font with glyphs 20 pixels tall for 'A', 'V' and ' ', and kerning between 'A' and 'V'
+	struct FakeFont
+	{
+		Glyph m_Glyphs[3] = {
+			{ U' ', 0, 0.25f, { 0, 0 }, { 0, 0, 0, 0 } },
+			{ U'A', 1, 0.5f, { 0, 0.1f }, { 0, 0, 10, 20 } },
+			{ U'V', 2, 0.5f, { 0, 0 }, { 10, 0, 20, 20 } },
+		};
+		uint32 m_NumKerningQueries = 0;
+
+		[[nodiscard]] const Glyph* GetGlyph(char32_t ch, char32_t fallback = U' ') const noexcept
+		{
+			for (const Glyph& glyph : m_Glyphs)
+			{
+				if (glyph.m_Char == ch)
+					return &glyph;
+			}
+			return ch == fallback ? nullptr : GetGlyph(fallback, fallback);
+		}
+		[[nodiscard]] float2 GetKerning(const Glyph& left, const Glyph& right) noexcept
+		{
+			++m_NumKerningQueries;
+			if (left.m_Char == U'A' && right.m_Char == U'V')
+				return { -0.1f, 0 };
+			return { 0, 0 };
+		}
+		[[nodiscard]] uint32 GetPixelSize() const noexcept { return 20; }
+	};
+
+	[[nodiscard]] bool Near(float a, float b)
+	{
+		return std::abs(a - b) < 1e-5f;
+	}
+
+	TEXT_LAYOUT_TEST("Text layout positions")
+	{
+		FakeFont font;
+		TextLayout layout;
+		const TextStyle style{ .m_LineSpacing = 2.0f };
+		_internal::LayoutText(font, "AV A\nV?", style, layout);
+
+		// the space isn't visible, and the unknown character falls back to a space
+		REQUIRE(layout.m_Glyphs.size() == 4);
+		CHECK(layout.m_Glyphs[0].m_Char == U'A');
+		CHECK(Near(layout.m_Glyphs[0].m_Rect.x, 0));
+		CHECK(Near(layout.m_Glyphs[0].m_Rect.y, 0.1f));
+		CHECK(Near(layout.m_Glyphs[0].m_Rect.z, 0.5f));
+		CHECK(Near(layout.m_Glyphs[0].m_Rect.w, 1.0f));
+
+		// kerned towards the 'A'
+		CHECK(layout.m_Glyphs[1].m_Char == U'V');
+		CHECK(Near(layout.m_Glyphs[1].m_Rect.x, 0.4f));
+
+		// after the space, kerning still applies between 'V' and 'A'
+		CHECK(Near(layout.m_Glyphs[2].m_Rect.x, 1.15f));
+		CHECK(font.m_NumKerningQueries == 2);
+
+		// new line
+		CHECK(Near(layout.m_Glyphs[3].m_Rect.x, 0));
+		CHECK(Near(layout.m_Glyphs[3].m_Rect.y, -2.0f));
+
+		CHECK(Near(layout.m_Bounds.x0, 0));
+		CHECK(Near(layout.m_Bounds.x1, 1.65f));
+		CHECK(Near(layout.m_Bounds.y0, -2.0f));
+		CHECK(Near(layout.m_Bounds.y1, 1.1f));
+	}
+
+	TEXT_LAYOUT_TEST("Text layout cache")
+	{
+		FakeFont font, otherFont;
+		TextLayoutCache cache{ 2 };
+		TextStyle style;
+
+		const TextLayout* layout = &cache.GetLayout(font, "AVA", style);
+		CHECK(layout->m_Glyphs.size() == 3);
+		CHECK(cache.GetStats().m_NumMisses == 1);
+
+		SECTION("Size and colors don't affect the layout")
+		{
+			style.m_Size = 3.0f;
+			style.m_FgColor = { 1, 0, 0, 1 };
+			CHECK(&cache.GetLayout(font, "AVA", style) == layout);
+			CHECK(cache.GetStats().m_NumHits == 1);
+			CHECK(font.m_NumKerningQueries == 2);
+		}
+		SECTION("Spacing, font and text do")
+		{
+			style.m_Tracking = 2.0f;
+			CHECK(cache.GetLayout(font, "AVA", style).m_Glyphs.size() == 3);
+			CHECK(cache.GetLayout(otherFont, "AVA", style).m_Glyphs.size() == 3);
+			CHECK(cache.GetLayout(otherFont, "AV", style).m_Glyphs.size() == 2);
+			CHECK(cache.GetStats().m_NumMisses == 4);
+			CHECK(cache.GetStats().m_NumHits == 0);
+			CHECK(cache.GetSize() == 4);
+		}
+		SECTION("Unused layouts are dropped when over capacity")
+		{
+			std::ignore = cache.GetLayout(font, "A", style);
+			std::ignore = cache.GetLayout(font, "V", style);
+			cache.NextFrame();
+			// all layouts were used during the last frame
+			CHECK(cache.GetSize() == 3);
+
+			std::ignore = cache.GetLayout(font, "AVA", style);
+			cache.NextFrame();
+			CHECK(cache.GetSize() == 1);
+			CHECK(cache.GetStats().m_NumHits == 1);
+		}
+	}
+} // namespace apollo::rdr::txt::text_layout_ut
\ No newline at end of file
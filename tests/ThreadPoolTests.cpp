@@ -1,5 +1,7 @@
+#include <atomic>
 #include <catch2/catch_test_macros.hpp>
 #include <core/ThreadPool.hpp>
+#include <latch>
 #include <semaphore>
 
 #define THREADPOOL_TEST(name) TEST_CASE(name, "[mt][thread_pool]")
@@ -123,6 +125,62 @@ namespace apollo::mt::ut {
 		}
 	}
 
+	THREADPOOL_TEST("Many jobs")
+	{
+		constexpr uint32 jobCount = 10000;
+		std::atomic_uint32_t counter = 0;
+		std::latch latch{ jobCount };
+		ThreadPool tp{ 4 };
+		for (uint32 i = 0; i < jobCount; ++i)
+		{
+			tp.Enqueue(
+				[&]()
+				{
+					++counter;
+					latch.count_down();
+				});
+		}
+		latch.wait();
+		CHECK(counter == jobCount);
+	}
+
+	THREADPOOL_TEST("Nested jobs")
+	{
+		SECTION("IsWorkerThread")
+		{
+			ThreadPool tp{ 1 };
+			CHECK_FALSE(tp.IsWorkerThread());
+			std::future result = tp.EnqueueAndGetFuture(
+				[&]()
+				{
+					return tp.IsWorkerThread();
+				});
+			CHECK(result.get());
+		}
+		SECTION("Fan-out from a worker")
+		{
+			constexpr uint32 childCount = 1000;
+			std::atomic_uint32_t counter = 0;
+			std::latch latch{ childCount };
+			ThreadPool tp{ 4 };
+			tp.Enqueue(
+				[&]()
+				{
+					for (uint32 i = 0; i < childCount; ++i)
+					{
+						tp.Enqueue(
+							[&]()
+							{
+								++counter;
+								latch.count_down();
+							});
+					}
+				});
+			latch.wait();
+			CHECK(counter == childCount);
+		}
+	}
+
 	THREADPOOL_TEST("Broken promise")
 	{
 		std::binary_semaphore sem{ 0 };
@@ -0,0 +1,139 @@
+#include <catch2/catch_test_macros.hpp>
+#include <core/GameTime.hpp>
+#include <core/ThreadPool.hpp>
+#include <entt/entity/registry.hpp>
+#include <systems/TransformComponent.hpp>
+#include <systems/TransformSystem.hpp>
+
+#define TRANSFORM_TEST(name) TEST_CASE(name, "[transform]")
+
+namespace apollo::transform_ut {
+	struct Helper
+	{
+		explicit Helper(mt::ThreadPool* pool = nullptr)
+			: m_System(pool)
+		{}
+
+		entt::entity Create(float3 pos, entt::entity parent = Unassigned<entt::entity>)
+		{
+			const entt::entity entity = m_World.create();
+			m_World.emplace<TransformComponent>(entity).m_Position = pos;
+			if (parent != Unassigned<entt::entity>)
+				m_World.emplace<ParentComponent>(entity, parent);
+			return entity;
+		}
+
+		float4 GetWorldPos(entt::entity entity)
+		{
+			return m_World.get<WorldTransformComponent>(entity).m_Matrix[3];
+		}
+
+		void Update() { m_System.Update(m_World, m_Time); }
+
+		entt::registry m_World;
+		GameTime m_Time;
+		TransformSystem m_System;
+	};
+
+	TRANSFORM_TEST("World transforms")
+	{
+		Helper helper;
+		const entt::entity root = helper.Create({ 1, 0, 0 });
+		const entt::entity child = helper.Create({ 0, 2, 0 }, root);
+		const entt::entity grandChild = helper.Create({ 0, 0, 3 }, child);
+		const entt::entity other = helper.Create({ 4, 0, 0 });
+		helper.Update();
+
+		CHECK(helper.GetWorldPos(root) == float4{ 1, 0, 0, 1 });
+		CHECK(helper.GetWorldPos(child) == float4{ 1, 2, 0, 1 });
+		CHECK(helper.GetWorldPos(grandChild) == float4{ 1, 2, 3, 1 });
+		CHECK(helper.GetWorldPos(other) == float4{ 4, 0, 0, 1 });
+
+		SECTION("Only dirty transforms are updated")
+		{
+			helper.m_World.get<TransformComponent>(root).m_Position = { 5, 0, 0 };
+			helper.Update();
+			CHECK(helper.GetWorldPos(grandChild) == float4{ 1, 2, 3, 1 });
+
+			helper.m_World.emplace<TransformDirtyComponent>(root);
+			helper.Update();
+			CHECK(helper.GetWorldPos(root) == float4{ 5, 0, 0, 1 });
+			CHECK(helper.GetWorldPos(child) == float4{ 5, 2, 0, 1 });
+			CHECK(helper.GetWorldPos(grandChild) == float4{ 5, 2, 3, 1 });
+			CHECK(!helper.m_World.all_of<TransformDirtyComponent>(root));
+		}
+		SECTION("Reparenting")
+		{
+			SetParent(helper.m_World, child, other);
+			helper.Update();
+			CHECK(helper.GetWorldPos(child) == float4{ 4, 2, 0, 1 });
+			CHECK(helper.GetWorldPos(grandChild) == float4{ 4, 2, 3, 1 });
+
+			SetParent(helper.m_World, child, Unassigned<entt::entity>);
+			helper.Update();
+			CHECK(helper.GetWorldPos(child) == float4{ 0, 2, 0, 1 });
+			CHECK(helper.GetWorldPos(grandChild) == float4{ 0, 2, 3, 1 });
+		}
+		SECTION("New entities")
+		{
+			const entt::entity newChild = helper.Create({ 1, 1, 1 }, grandChild);
+			helper.Update();
+			CHECK(helper.GetWorldPos(newChild) == float4{ 2, 3, 4, 1 });
+		}
+		SECTION("Destroyed parent")
+		{
+			helper.m_World.destroy(child);
+			helper.Update();
+			CHECK(helper.GetWorldPos(grandChild) == float4{ 0, 0, 3, 1 });
+		}
+		SECTION("Removed transform")
+		{
+			helper.m_World.remove<TransformComponent>(other);
+			helper.Update();
+			CHECK(!helper.m_World.all_of<WorldTransformComponent>(other));
+		}
+	}
+
+	TRANSFORM_TEST("Parenting cycles")
+	{
+		Helper helper;
+		const entt::entity first = helper.Create({ 1, 0, 0 });
+		const entt::entity second = helper.Create({ 0, 1, 0 }, first);
+		SetParent(helper.m_World, first, second);
+		helper.Update();
+
+		// one of them gets treated as a root, and the other one as its child
+		const float4 firstPos = helper.GetWorldPos(first);
+		const float4 secondPos = helper.GetWorldPos(second);
+		CHECK((firstPos == float4{ 1, 1, 0, 1 } || secondPos == float4{ 1, 1, 0, 1 }));
+	}
+
+	TRANSFORM_TEST("Parallel update")
+	{
+		constexpr uint32 numRoots = 64;
+		constexpr uint32 depth = 128;
+
+		mt::ThreadPool pool{ 4 };
+		Helper serial, parallel{ &pool };
+		// both worlds are built the same way, so entities are the same in both
+		std::vector<entt::entity> leaves;
+		for (Helper* helper : { &serial, &parallel })
+		{
+			leaves.clear();
+			for (uint32 r = 0; r < numRoots; ++r)
+			{
+				entt::entity node = helper->Create({ float(r), 0, 0 });
+				for (uint32 d = 1; d < depth; ++d)
+					node = helper->Create({ 0, 1, 0 }, node);
+				leaves.emplace_back(node);
+			}
+			helper->Update();
+		}
+
+		for (uint32 r = 0; r < numRoots; ++r)
+		{
+			CHECK(serial.GetWorldPos(leaves[r]) == float4{ float(r), depth - 1, 0, 1 });
+			CHECK(parallel.GetWorldPos(leaves[r]) == serial.GetWorldPos(leaves[r]));
+		}
+	}
+} // namespace apollo::transform_ut
\ No newline at end of file
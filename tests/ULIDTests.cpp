@@ -22,6 +22,16 @@ namespace apollo::ulid::ut {
 		static_assert(id == ULID{});
 	}
 
+	ULID_TEST("Ordering")
+	{
+		constexpr ULID older{ 0x018f2cc2f910, 0xffff, 0xffffffffffffffff };
+		constexpr ULID newer{ 0x018f2cc2f911, 0, 0 };
+		static_assert(older < newer);
+		static_assert(!(newer < older));
+		static_assert(!(g_Id1 < g_Id1));
+		static_assert(ULID{ 1, 0, 1 } < ULID{ 1, 0, 2 });
+	}
+
 	ULID_TEST("Conversion from string")
 	{
 		constexpr ULID id = apollo::ULID::FromString(g_StrId1);
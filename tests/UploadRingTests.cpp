@@ -0,0 +1,104 @@
+#include <catch2/catch_test_macros.hpp>
+#include <rendering/UploadHeap.hpp>
+#include <vector>
+
+#define UPLOAD_RING_TEST(name) TEST_CASE(name, "[upload_ring]")
+
+namespace apollo::rdr::upload_ring_ut {
+	/// Records the frames the ring waited on, and pretends they were still in flight
+	struct WaitRecorder
+	{
+		bool operator()(uint64 serial)
+		{
+			m_Serials.emplace_back(serial);
+			return true;
+		}
+
+		std::vector<uint64> m_Serials;
+	};
+
+	UPLOAD_RING_TEST("Upload ring suballocation")
+	{
+		UploadRing ring{ 4, 1024 };
+		WaitRecorder wait;
+
+		const auto a = ring.Allocate(100, 16, wait);
+		REQUIRE(a);
+		CHECK(a->m_Block == 0);
+		CHECK(a->m_Offset == 0);
+
+		const auto b = ring.Allocate(100, 256, wait);
+		REQUIRE(b);
+		CHECK(b->m_Block == 0);
+		CHECK(b->m_Offset == 256);
+
+		// doesn't fit in the rest of the block
+		const auto c = ring.Allocate(800, 16, wait);
+		REQUIRE(c);
+		CHECK(c->m_Block == 1);
+		CHECK(c->m_Offset == 0);
+
+		CHECK(ring.GetStats().m_BytesThisFrame == 1000);
+		CHECK(wait.m_Serials.empty());
+
+		ring.EndFrame();
+		CHECK(ring.GetStats().m_BytesThisFrame == 0);
+		CHECK(ring.GetStats().m_BytesLastFrame == 1000);
+	}
+
+	UPLOAD_RING_TEST("Upload ring waits for the GPU before reusing a block")
+	{
+		UploadRing ring{ 2, 1024 };
+		WaitRecorder wait;
+
+		// frame 1 uses block 0, frame 2 uses block 1
+		REQUIRE(ring.Allocate(1000, 16, wait));
+		CHECK(ring.EndFrame() == 1);
+		REQUIRE(ring.Allocate(1000, 16, wait));
+		CHECK(ring.GetStats().m_Wraparounds == 0);
+		CHECK(ring.EndFrame() == 2);
+
+		SECTION("Frame still in flight")
+		{
+			// back to block 0, last used by frame 1
+			const auto a = ring.Allocate(1000, 16, wait);
+			REQUIRE(a);
+			CHECK(a->m_Block == 0);
+			REQUIRE(wait.m_Serials.size() == 1);
+			CHECK(wait.m_Serials[0] == 1);
+			CHECK(ring.GetCompletedSerial() == 1);
+			CHECK(ring.GetStats().m_Stalls == 1);
+			CHECK(ring.GetStats().m_Wraparounds == 1);
+		}
+		SECTION("Frame already completed")
+		{
+			ring.Complete(1);
+			REQUIRE(ring.Allocate(1000, 16, wait));
+			CHECK(wait.m_Serials.empty());
+			CHECK(ring.GetStats().m_Stalls == 0);
+			CHECK(ring.GetStats().m_Wraparounds == 1);
+		}
+	}
+
+	UPLOAD_RING_TEST("Upload ring overflow")
+	{
+		UploadRing ring{ 2, 1024 };
+		WaitRecorder wait;
+
+		CHECK_FALSE(ring.Allocate(2048, 16, wait));
+		CHECK(ring.GetStats().m_Overflows == 1);
+
+		// the whole ring is used by the current frame: nothing to wait for
+		REQUIRE(ring.Allocate(1000, 16, wait));
+		REQUIRE(ring.Allocate(1000, 16, wait));
+		CHECK_FALSE(ring.Allocate(1000, 16, wait));
+		CHECK(ring.GetStats().m_Overflows == 2);
+		CHECK(wait.m_Serials.empty());
+
+		// smaller allocations can still fit at the end of the current block
+		const auto a = ring.Allocate(16, 16, wait);
+		REQUIRE(a);
+		CHECK(a->m_Block == 1);
+		CHECK(a->m_Offset == 1008);
+	}
+} // namespace apollo::rdr::upload_ring_ut
\ No newline at end of file